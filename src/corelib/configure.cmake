@@ -208,6 +208,24 @@ int main(void)
 }"
 )
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll"
+    CODE
+"#include <sys/epoll.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+epoll_event ev[1];
+int fd = epoll_create1(EPOLL_CLOEXEC);
+epoll_ctl(fd, EPOLL_CTL_ADD, 0, ev);
+epoll_wait(fd, ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # eventfd
 qt_config_compile_test(eventfd
     LABEL "eventfd"
@@ -590,6 +608,10 @@ qt_feature("dladdr" PRIVATE
     LABEL "dladdr"
     CONDITION QT_FEATURE_dlopen AND TEST_dladdr
 )
+qt_feature("epoll" PRIVATE
+    LABEL "epoll"
+    CONDITION LINUX AND TEST_epoll
+)
 qt_feature("eventfd" PUBLIC
     LABEL "eventfd"
     CONDITION NOT WASM AND TEST_eventfd
@@ -1022,6 +1044,7 @@ qt_configure_add_summary_section(NAME "Qt Core")
 qt_configure_add_summary_entry(ARGS "backtrace")
 qt_configure_add_summary_entry(ARGS "doubleconversion")
 qt_configure_add_summary_entry(ARGS "system-doubleconversion")
+qt_configure_add_summary_entry(ARGS "epoll" CONDITION LINUX)
 qt_configure_add_summary_entry(ARGS "forkfd_pidfd" CONDITION LINUX)
 qt_configure_add_summary_entry(ARGS "glib")
 qt_configure_add_summary_entry(ARGS "icu")
@@ -60,3 +60,13 @@ bool isExeFile(QFile *file)
     return file->peek(2) == "MZ";
 }
 //! [5]
+
+
+//! [6]
+void sendMessage(QIODevice *device, const QByteArray &payload)
+{
+    QByteArray header;
+    QDataStream(&header, QIODevice::WriteOnly) << quint32(payload.size());
+    device->write({ header, payload });
+}
+//! [6]
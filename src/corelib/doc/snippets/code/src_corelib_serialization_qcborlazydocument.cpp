@@ -0,0 +1,19 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    const uchar *map = file.map(0, file.size());
+    const auto data = QByteArray::fromRawData(reinterpret_cast<const char *>(map), file.size());
+    const QCborLazyDocument doc = QCborLazyDocument::fromCbor(data);
+    if (doc.validate() != QCborError::NoError)
+        return {};
+
+    // only the items visited are decoded; the strings are not copied
+    for (const QCborLazyValue record : doc["records"]) {
+        if (record["id"].toInteger() == id)
+            return record["name"].toString();
+    }
+//! [0]
@@ -0,0 +1,22 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    struct Measurement
+    {
+        Q_GADGET
+        Q_PROPERTY(QString sensor MEMBER sensor)
+        Q_PROPERTY(qint64 timestamp MEMBER timestamp)
+        Q_PROPERTY(double value MEMBER value)
+    public:
+        QString sensor;
+        qint64 timestamp = 0;
+        double value = 0;
+    };
+
+    QCborStreamWriter writer(&file);
+    writer.startArray();
+    for (const Measurement &m : measurements)
+        QGadgetSerializer::toCbor(writer, m);       // {"sensor": ..., "timestamp": ..., "value": ...}
+    writer.endArray();
+//! [0]
@@ -0,0 +1,17 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    QJsonParseError error;
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(reply->readAll(), &error);
+    if (doc.isNull()) {
+        qWarning() << "Invalid response:" << error.errorString();
+        return;
+    }
+
+    // only these values are parsed; the rest of the document is skipped
+    const QString status = doc["status"].toString();
+    const qint64 total = doc["paging"]["total"].toInteger();
+    for (const QJsonLazyValue item : doc["items"])
+        names.append(item["name"].toString());
+//! [0]
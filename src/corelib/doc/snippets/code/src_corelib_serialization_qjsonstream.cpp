@@ -0,0 +1,35 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    QJsonStreamReader reader(&file);
+    if (!reader.isArray() || !reader.enterContainer())
+        return false;
+
+    // only one record is in memory at a time
+    while (reader.hasNext()) {
+        const QJsonValue record = reader.readValue();
+        if (record.isUndefined())
+            break;
+        process(record.toObject());
+    }
+    if (reader.lastError().error != QJsonParseError::NoError) {
+        qWarning() << "Invalid records:" << reader.lastError().errorString();
+        return false;
+    }
+    return reader.leaveContainer();
+//! [0]
+
+//! [1]
+    QJsonStreamWriter writer(&file);
+    writer.startArray();
+    for (const Record &record : records) {
+        writer.startObject();
+        writer.append("name"_L1);
+        writer.append(record.name);
+        writer.append("size"_L1);
+        writer.append(record.size);
+        writer.endObject();
+    }
+    writer.endArray();
+//! [1]
@@ -0,0 +1,13 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QMultiStringMatcher matcher({u"error"_s, u"warning"_s, u"warn"_s}, Qt::CaseInsensitive);
+const QString line = u"Warning: disk almost full, error expected soon"_s;
+for (const QMultiStringMatcher::Match &match : matcher.matchAll(line))
+    qDebug() << match.patternIndex << match.offset << match.length;
+// prints:
+// 2 0 4
+// 1 0 7
+// 0 27 5
+//! [0]
@@ -339,4 +339,16 @@ if (m.hasMatch()) {
 //! [36]
 }
 
+{
+//! [37]
+QRegularExpression re(R"(^(\w+)=(.*)$)");
+QStringList lines = { "name=Qt", "# a comment", "version=6.7" };
+QHash<QString, QString> settings;
+re.matchEach(lines, [&](qsizetype, const QRegularExpressionMatch &match) {
+    if (match.hasMatch())
+        settings.insert(match.captured(1), match.captured(2));
+});
+//! [37]
+}
+
 }
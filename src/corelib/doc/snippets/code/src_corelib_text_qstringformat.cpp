@@ -0,0 +1,20 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QString status = qFormat(QT_FORMAT_STRING(u"Loaded %1 items in %2 ms"), count, elapsed);
+
+QString path = u"/home/"_s % qFormat(QT_FORMAT_STRING(u"{}/{}.log"), user, day);
+
+// Does not compile: the format string uses two arguments
+// QString s = qFormat(QT_FORMAT_STRING(u"{} of {}"), done);
+//! [0]
+
+//! [1]
+QString line;
+for (const Entry &entry : entries) {
+    line.resize(0);     // keeps the capacity, unlike clear()
+    qFormatTo(line, QT_FORMAT_STRING(u"{}: {} ({})\n"), entry.name, entry.value, entry.unit);
+    file.write(line.toUtf8());
+}
+//! [1]
@@ -0,0 +1,28 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QConcurrentHash<QString, QImage> thumbnails;
+
+// called from many threads at once
+QImage thumbnail(const QString &path)
+{
+    return thumbnails.computeIfAbsent(path, [&] {
+        return QImage(path).scaled(64, 64, Qt::KeepAspectRatio);
+    });
+}
+
+void invalidate(const QString &path)
+{
+    thumbnails.remove(path);
+}
+
+qint64 cachedBytes()
+{
+    qint64 total = 0;
+    thumbnails.forEach([&](const QString &, const QImage &image) {
+        total += image.sizeInBytes();
+    });
+    return total;
+}
+//! [0]
@@ -0,0 +1,16 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QList<std::pair<QString, int>> items;
+for (const Setting &setting : settings)
+    items.emplaceBack(setting.name, setting.value);
+const QFlatMap<QString, int> table(items.cbegin(), items.cend());
+//! [0]
+
+
+//! [1]
+QStringList keys = { "blue", "green", "red" };
+QList<int> values = { 3, 2, 1 };
+const QFlatMap<QString, int> colors(Qt::OrderedUniqueRange, std::move(keys), std::move(values));
+//! [1]
@@ -1148,6 +1148,12 @@ qint64 QAbstractFileEngine::readLine(char *data, qint64 maxlen)
 
    \value UnMapExtension Whether the file engine provides the ability to
    unmap memory that was previously mapped.
+
+   \value WriteVectorExtension Whether the file engine can write several
+   buffers with one operation, at the current position. The input is a
+   WriteVectorExtensionOption, and the number of bytes written, or -1 on
+   error, is returned in a WriteVectorExtensionReturn. This extension is
+   introduced in Qt 6.7.
 */
 
 /*!
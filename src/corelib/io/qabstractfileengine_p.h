@@ -140,7 +140,8 @@ public:
         AtEndExtension,
         FastReadLineExtension,
         MapExtension,
-        UnMapExtension
+        UnMapExtension,
+        WriteVectorExtension
     };
     class ExtensionOption
     {};
@@ -163,6 +164,16 @@ public:
         uchar *address;
     };
 
+    class WriteVectorExtensionOption : public ExtensionOption {
+    public:
+        const QByteArrayView *chunks;
+        qsizetype count;
+    };
+    class WriteVectorExtensionReturn : public ExtensionReturn {
+    public:
+        qint64 written;
+    };
+
     virtual bool extension(Extension extension, const ExtensionOption *option = nullptr, ExtensionReturn *output = nullptr);
     virtual bool supportsExtension(Extension extension) const;
 
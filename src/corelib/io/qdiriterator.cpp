@@ -51,6 +51,19 @@
     enables iterating through all subdirectories of the assigned path,
     following all symbolic links. Symbolic link loops (e.g., "link" => "." or
     "link" => "..") are automatically detected and ignored.
+
+    \value ParallelTraversal When combined with Subdirectories, subdirectories
+    are listed concurrently by a pool of threads owned by the iterator, ahead
+    of the entries being returned. The entries are still returned in the same
+    order as without this flag. This flag was introduced in Qt 6.7. It has no
+    effect on directories handled by a custom file engine, such as
+    \l{The Qt Resource System}{resources}.
+
+    \value UnorderedResults When combined with ParallelTraversal, the entries
+    of each directory are returned as soon as the directory has been listed,
+    rather than in depth-first order, so that iteration never waits for a
+    slow subdirectory while others are ready. This flag was introduced in
+    Qt 6.7.
 */
 
 #include "qdiriterator.h"
@@ -60,6 +73,12 @@
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qvariant.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+#endif
 #if QT_CONFIG(regularexpression)
 #include <QtCore/qregularexpression.h>
 #endif
@@ -87,18 +106,28 @@ public:
     }
 };
 
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+#define QT_DIRITERATOR_PARALLEL
+class QDirIteratorParallelScan;
+#endif
+
 class QDirIteratorPrivate
 {
 public:
     QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
                         QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true);
 
+    ~QDirIteratorPrivate();
+
     void advance();
 
     bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
     void pushDirectory(const QFileInfo &fileInfo);
     void checkAndPushDirectory(const QFileInfo &);
+    bool shouldDescend(const QFileInfo &fileInfo) const;
     bool matchesFilters(const QString &fileName, const QFileInfo &fi) const;
+    static const QFileSystemEntry &fileEntry(const QFileInfo &fileInfo)
+    { return fileInfo.d_ptr->fileEntry; }
 
     std::unique_ptr<QAbstractFileEngine> engine;
 
@@ -115,6 +144,9 @@ public:
 #ifndef QT_NO_FILESYSTEMITERATOR
     QDirIteratorPrivateIteratorStack<QFileSystemIterator> nativeIterators;
 #endif
+#ifdef QT_DIRITERATOR_PARALLEL
+    std::unique_ptr<QDirIteratorParallelScan> parallelScan;
+#endif
 
     QFileInfo currentFileInfo;
     QFileInfo nextFileInfo;
@@ -123,6 +155,91 @@ public:
     QDuplicateTracker<QString> visitedLinks;
 };
 
+#ifdef QT_DIRITERATOR_PARALLEL
+/*
+    Lists the directories of a recursive iteration concurrently, for
+    QDirIterator::ParallelTraversal.
+
+    Each directory is a Node that is filled, by a worker thread or by the
+    iterating thread, with the entries the filters accept and the
+    subdirectories to descend into. Listing a node makes nodes of its
+    subdirectories, which are queued on the thread pool while fewer than
+    MaxBufferedEntries listed entries are waiting to be returned; otherwise
+    they are left for the iterating thread to list when it gets to them.
+
+    In order, the iterating thread walks the nodes depth-first like the
+    sequential iterator, listing itself any node that no worker has started.
+    With FollowSymlinks, it also checks for link loops when it enters a node,
+    so that the same directories are skipped as by the sequential iterator;
+    workers then only list ahead the symbolic links of the node being
+    entered, which keeps them from following a loop. With UnorderedResults,
+    the nodes are checked when listed and returned in the order they are
+    listed.
+*/
+class QDirIteratorParallelScan
+{
+public:
+    QDirIteratorParallelScan(const QDirIteratorPrivate *d, const QFileInfo &root);
+    ~QDirIteratorParallelScan();
+
+    bool next(QFileInfo &fileInfo);
+    bool atEnd() const { return exhausted; }
+
+private:
+    static constexpr qsizetype MaxBufferedEntries = 64 * 1024;
+
+    struct Node;
+    using NodePointer = std::shared_ptr<Node>;
+    struct Entry
+    {
+        QFileInfo fileInfo;
+        NodePointer child;      // only in order
+        bool matches = false;
+    };
+    struct Node
+    {
+        enum State { Pending, Queued, Listing, Listed };
+
+        explicit Node(const QFileInfo &fileInfo) : fileInfo(fileInfo) {}
+
+        QFileInfo fileInfo;
+        QString canonicalPath;  // only in order, with FollowSymlinks
+        QList<Entry> entries;
+        QRunnable *task = nullptr;
+        State state = Pending;
+    };
+    struct Position
+    {
+        NodePointer node;
+        qsizetype index = 0;
+    };
+
+    void list(const NodePointer &node);
+    void schedule(const NodePointer &node);
+    void take(const NodePointer &node);
+    void release(const NodePointer &node);
+    void discard(const NodePointer &node);
+    bool hasBudget() const { return bufferedEntries < MaxBufferedEntries; }
+
+    const QDirIteratorPrivate *d;
+    const bool ordered;
+    bool exhausted = false;
+    QThreadPool pool;
+    QAtomicInt cancelled;
+
+    QMutex mutex;               // protects everything below and the nodes
+    QWaitCondition listed;
+    QDuplicateTracker<QString> visitedLinks;
+    qsizetype bufferedEntries = 0;
+    int running = 0;            // nodes queued or being listed
+
+    QStack<Position> stack;             // in order
+    Position current;                   // unordered
+    QQueue<NodePointer> finished;       // unordered: listed, not returned yet
+    QQueue<NodePointer> deferred;       // unordered: left for lack of budget
+};
+#endif // QT_DIRITERATOR_PARALLEL
+
 /*!
     \internal
 */
@@ -146,11 +263,25 @@ QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QS
         engine.reset(QFileSystemEngine::resolveEntryAndCreateLegacyEngine(dirEntry, metaData));
     QFileInfo fileInfo(new QFileInfoPrivate(dirEntry, metaData));
 
+#ifdef QT_DIRITERATOR_PARALLEL
+    const auto parallelFlags = QDirIterator::Subdirectories | QDirIterator::ParallelTraversal;
+    if (!engine && (iteratorFlags & parallelFlags) == parallelFlags) {
+        parallelScan = std::make_unique<QDirIteratorParallelScan>(this, fileInfo);
+        advance();
+        return;
+    }
+#endif
+
     // Populate fields for hasNext() and next()
     pushDirectory(fileInfo);
     advance();
 }
 
+/*!
+    \internal
+*/
+QDirIteratorPrivate::~QDirIteratorPrivate() = default;
+
 /*!
     \internal
 */
@@ -209,6 +340,16 @@ inline bool QDirIteratorPrivate::entryMatches(const QString & fileName, const QF
 */
 void QDirIteratorPrivate::advance()
 {
+#ifdef QT_DIRITERATOR_PARALLEL
+    if (parallelScan) {
+        QFileInfo fileInfo;
+        if (parallelScan->next(fileInfo)) {
+            currentFileInfo = nextFileInfo;
+            nextFileInfo = fileInfo;
+            return;
+        }
+    } else
+#endif
     if (engine) {
         while (!fileEngineIterators.isEmpty()) {
             // Find the next valid iterator that matches the filters.
@@ -252,29 +393,42 @@ void QDirIteratorPrivate::advance()
     \internal
  */
 void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
+{
+    if (shouldDescend(fileInfo))
+        pushDirectory(fileInfo);
+}
+
+/*!
+    \internal
+
+    Returns \c true if the iteration should continue into the directory
+    \a fileInfo. This function is called from the threads of a parallel
+    traversal.
+ */
+bool QDirIteratorPrivate::shouldDescend(const QFileInfo &fileInfo) const
 {
     // If we're doing flat iteration, we're done.
     if (!(iteratorFlags & QDirIterator::Subdirectories))
-        return;
+        return false;
 
     // Never follow non-directory entries
     if (!fileInfo.isDir())
-        return;
+        return false;
 
     // Follow symlinks only when asked
     if (!(iteratorFlags & QDirIterator::FollowSymlinks) && fileInfo.isSymLink())
-        return;
+        return false;
 
     // Never follow . and ..
     QString fileName = fileInfo.fileName();
     if ("."_L1 == fileName || ".."_L1 == fileName)
-        return;
+        return false;
 
     // No hidden directories unless requested
     if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && fileInfo.isHidden())
-        return;
+        return false;
 
-    pushDirectory(fileInfo);
+    return true;
 }
 
 /*!
@@ -364,6 +518,241 @@ bool QDirIteratorPrivate::matchesFilters(const QString &fileName, const QFileInf
     return true;
 }
 
+#ifdef QT_DIRITERATOR_PARALLEL
+QDirIteratorParallelScan::QDirIteratorParallelScan(const QDirIteratorPrivate *d,
+                                                   const QFileInfo &root)
+    : d(d), ordered(!(d->iteratorFlags & QDirIterator::UnorderedResults))
+{
+    pool.setObjectName("QDirIterator"_L1);
+
+    if (d->iteratorFlags & QDirIterator::FollowSymlinks)
+        Q_UNUSED(visitedLinks.hasSeen(root.canonicalFilePath()));
+
+    auto node = std::make_shared<Node>(root);
+    if (ordered) {
+        take(node);
+        stack.push({ std::move(node) });
+    } else {
+        deferred.enqueue(std::move(node));
+    }
+}
+
+QDirIteratorParallelScan::~QDirIteratorParallelScan()
+{
+    cancelled.storeRelaxed(1);
+    pool.clear();
+    pool.waitForDone();
+}
+
+// Called without the mutex held, by a worker or the iterating thread
+void QDirIteratorParallelScan::list(const NodePointer &node)
+{
+    const bool followSymlinks = d->iteratorFlags.testFlag(QDirIterator::FollowSymlinks);
+    QList<Entry> entries;
+    QList<NodePointer> children;
+
+    QFileSystemIterator it(QDirIteratorPrivate::fileEntry(node->fileInfo), d->filters,
+                           d->nameFilters, d->iteratorFlags);
+    QFileSystemEntry entry;
+    QFileSystemMetaData metaData;
+    while (!cancelled.loadRelaxed() && it.advance(entry, metaData)) {
+        Entry e;
+        e.fileInfo = QFileInfo(new QFileInfoPrivate(entry, metaData));
+        metaData = QFileSystemMetaData();
+
+        if (d->shouldDescend(e.fileInfo)) {
+            bool seen = false;
+            QString canonicalPath;
+            if (followSymlinks) {
+                canonicalPath = e.fileInfo.canonicalFilePath();
+                if (!ordered) {
+                    // Stop link loops
+                    QMutexLocker locker(&mutex);
+                    seen = visitedLinks.hasSeen(canonicalPath);
+                }
+            }
+            if (!seen) {
+                auto child = std::make_shared<Node>(e.fileInfo);
+                if (ordered) {
+                    // next() checks for link loops when it enters the child
+                    child->canonicalPath = std::move(canonicalPath);
+                    e.child = child;
+                }
+                // only take() lists symbolic links ahead in order, see above
+                if (!(ordered && followSymlinks && e.fileInfo.isSymLink()))
+                    children.append(std::move(child));
+            }
+        }
+        e.matches = d->matchesFilters(entry.fileName(), e.fileInfo);
+        if (e.matches || e.child)
+            entries.append(std::move(e));
+    }
+
+    QMutexLocker locker(&mutex);
+    node->entries = std::move(entries);
+    node->task = nullptr;
+    node->state = Node::Listed;
+    bufferedEntries += node->entries.size();
+    --running;
+    if (cancelled.loadRelaxed())
+        children.clear();
+    for (NodePointer &child : children) {
+        if (hasBudget())
+            schedule(child);
+        else if (!ordered)
+            deferred.enqueue(std::move(child));
+    }
+    if (!ordered)
+        finished.enqueue(node);
+    listed.wakeAll();
+}
+
+// Called with the mutex held
+void QDirIteratorParallelScan::schedule(const NodePointer &node)
+{
+    Q_ASSERT(node->state == Node::Pending);
+    node->state = Node::Queued;
+    node->task = QRunnable::create([this, node] { list(node); });
+    ++running;
+    pool.start(node->task);
+}
+
+// Makes sure that \a node is listed, listing it in this thread unless a
+// worker already started
+void QDirIteratorParallelScan::take(const NodePointer &node)
+{
+    QMutexLocker locker(&mutex);
+    bool listHere = false;
+    if (node->state == Node::Pending) {
+        ++running;
+        listHere = true;
+    } else if (node->state == Node::Queued && pool.tryTake(node->task)) {
+        delete node->task;
+        listHere = true;
+    }
+    if (listHere) {
+        node->task = nullptr;
+        node->state = Node::Listing;
+        locker.unlock();
+        list(node);
+        locker.relock();
+    }
+    while (node->state != Node::Listed)
+        listed.wait(&mutex);
+
+    // keep the workers busy with the directories we are about to descend into
+    for (const Entry &e : std::as_const(node->entries)) {
+        if (!hasBudget())
+            break;
+        if (e.child && e.child->state == Node::Pending)
+            schedule(e.child);
+    }
+}
+
+void QDirIteratorParallelScan::release(const NodePointer &node)
+{
+    QMutexLocker locker(&mutex);
+    bufferedEntries -= node->entries.size();
+    while (!deferred.isEmpty() && hasBudget())
+        schedule(deferred.dequeue());
+}
+
+// Drops \a node, which next() skips in order, and the nodes below it that
+// were scheduled, so that they neither run nor count against the budget
+void QDirIteratorParallelScan::discard(const NodePointer &node)
+{
+    QMutexLocker locker(&mutex);
+    QList<NodePointer> nodes = { node };
+    while (!nodes.isEmpty()) {
+        const NodePointer n = nodes.takeLast();
+        if (n->state == Node::Pending)
+            continue;
+        if (n->state == Node::Queued && pool.tryTake(n->task)) {
+            delete std::exchange(n->task, nullptr);
+            n->state = Node::Pending;
+            --running;
+            continue;
+        }
+        while (n->state != Node::Listed)
+            listed.wait(&mutex);
+        bufferedEntries -= n->entries.size();
+        for (const Entry &e : std::as_const(n->entries)) {
+            if (e.child)
+                nodes.append(e.child);
+        }
+    }
+}
+
+bool QDirIteratorParallelScan::next(QFileInfo &fileInfo)
+{
+    if (ordered) {
+        while (!stack.isEmpty()) {
+            Position &top = stack.top();
+            if (top.index == top.node->entries.size()) {
+                release(top.node);
+                stack.pop();
+                continue;
+            }
+
+            Entry &e = top.node->entries[top.index++];
+            if (e.child) {
+                NodePointer child = std::move(e.child);
+                bool seen = false;
+                if (d->iteratorFlags & QDirIterator::FollowSymlinks) {
+                    // Stop link loops
+                    QMutexLocker locker(&mutex);
+                    seen = visitedLinks.hasSeen(child->canonicalPath);
+                }
+                if (seen) {
+                    discard(child);
+                } else {
+                    take(child);
+                    stack.push({ std::move(child) });
+                }
+            }
+            if (e.matches) {
+                fileInfo = std::move(e.fileInfo);
+                return true;
+            }
+        }
+        exhausted = true;
+        return false;
+    }
+
+    for (;;) {
+        if (current.node) {
+            while (current.index < current.node->entries.size()) {
+                Entry &e = current.node->entries[current.index++];
+                if (e.matches) {
+                    fileInfo = std::move(e.fileInfo);
+                    return true;
+                }
+            }
+            release(current.node);
+            current = {};
+        }
+
+        QMutexLocker locker(&mutex);
+        while (finished.isEmpty()) {
+            if (!deferred.isEmpty()) {
+                NodePointer node = deferred.dequeue();
+                node->state = Node::Listing;
+                ++running;
+                locker.unlock();
+                list(node);
+                locker.relock();
+            } else if (running == 0) {
+                exhausted = true;
+                return false;
+            } else {
+                listed.wait(&mutex);
+            }
+        }
+        current = { finished.dequeue() };
+    }
+}
+#endif // QT_DIRITERATOR_PARALLEL
+
 /*!
     Constructs a QDirIterator that can iterate over \a dir's entrylist, using
     \a dir's name filters and regular filters. You can pass options via \a
@@ -497,6 +886,10 @@ QFileInfo QDirIterator::nextFileInfo()
 */
 bool QDirIterator::hasNext() const
 {
+#ifdef QT_DIRITERATOR_PARALLEL
+    if (d->parallelScan)
+        return !d->parallelScan->atEnd();
+#endif
     if (d->engine)
         return !d->fileEngineIterators.isEmpty();
     else
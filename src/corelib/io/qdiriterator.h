@@ -15,7 +15,9 @@ public:
     enum IteratorFlag {
         NoIteratorFlags = 0x0,
         FollowSymlinks = 0x1,
-        Subdirectories = 0x2
+        Subdirectories = 0x2,
+        ParallelTraversal = 0x4,
+        UnorderedResults = 0x8
     };
     Q_DECLARE_FLAGS(IteratorFlags, IteratorFlag)
 
@@ -545,6 +545,81 @@ qint64 QFileDevice::writeData(const char *data, qint64 len)
     return len;
 }
 
+/*!
+    \internal
+
+    Writes the byte arrays to the buffer if they fit, or otherwise writes the
+    buffered data and all of them with one call to the file engine, if it
+    supports that.
+*/
+qint64 QFileDevicePrivate::writeVector(const QByteArrayList &data)
+{
+    Q_Q(QFileDevice);
+#ifdef Q_OS_WIN
+    if (openMode & QIODevice::Text)
+        return QIODevicePrivate::writeVector(data);
+#endif
+    if (!fileEngine->supportsExtension(QAbstractFileEngine::WriteVectorExtension))
+        return QIODevicePrivate::writeVector(data);
+
+    // Make sure the device is positioned correctly.
+    const bool sequential = isSequential();
+    if (pos != devicePos && !sequential && !q->seek(pos))
+        return qint64(-1);
+
+    q->unsetError();
+    lastWasWrite = true;
+    const bool buffered = !(openMode & QIODevice::Unbuffered);
+
+    qint64 len = 0;
+    for (const QByteArray &chunk : data)
+        len += chunk.size();
+
+    qint64 written;
+    if (buffered && writeBuffer.size() + len <= writeBufferChunkSize) {
+        for (const QByteArray &chunk : data)
+            writeBuffer.append(chunk.constData(), chunk.size());
+        written = len;
+    } else {
+        QVarLengthArray<QByteArrayView, 16> vector;
+        const qint64 bufferedSize = writeBuffer.size();
+        for (qint64 offset = 0; offset < bufferedSize; ) {
+            qint64 blockSize;
+            const char *block = writeBuffer.readPointerAtPosition(offset, blockSize);
+            vector.append(QByteArrayView(block, blockSize));
+            offset += blockSize;
+        }
+        for (const QByteArray &chunk : data)
+            vector.append(chunk);
+
+        QAbstractFileEngine::WriteVectorExtensionOption option;
+        option.chunks = vector.constData();
+        option.count = vector.size();
+        QAbstractFileEngine::WriteVectorExtensionReturn result;
+        result.written = -1;
+        fileEngine->extension(QAbstractFileEngine::WriteVectorExtension, &option, &result);
+
+        if (result.written > 0)
+            writeBuffer.free(qMin(result.written, bufferedSize));
+        if (result.written < bufferedSize) {
+            // not even the buffered data could be written
+            QFileDevice::FileError err = fileEngine->error();
+            if (err == QFileDevice::UnspecifiedError)
+                err = QFileDevice::WriteError;
+            setError(err, fileEngine->errorString());
+            return qint64(-1);
+        }
+        written = result.written - bufferedSize;
+    }
+
+    if (!sequential && written > 0) {
+        pos += written;
+        devicePos += written;
+        buffer.skip(written);
+    }
+    return written;
+}
+
 /*!
     Returns the file error status.
 
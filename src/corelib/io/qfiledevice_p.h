@@ -50,6 +50,7 @@ protected:
     inline bool ensureFlushed() const;
 
     bool putCharHelper(char c) override;
+    qint64 writeVector(const QByteArrayList &data) override;
 
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
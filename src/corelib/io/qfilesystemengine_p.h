@@ -92,11 +92,17 @@ public:
 #if defined(Q_OS_UNIX)
     static bool cloneFile(int srcfd, int dstfd, const QFileSystemMetaData &knownData);
     static bool fillMetaData(int fd, QFileSystemMetaData &data); // what = PosixStatFlags
+    static bool fillMetaDataAt(int dirfd, const char *name, QFileSystemMetaData &data,
+                               QFileSystemMetaData::MetaDataFlags what);
     static QByteArray id(int fd);
     static bool setFileTime(int fd, const QDateTime &newDate,
                             QAbstractFileEngine::FileTime whatTime, QSystemError &error);
     static bool setPermissions(int fd, QFile::Permissions permissions, QSystemError &error,
                                QFileSystemMetaData *data = nullptr);
+
+    enum class MetaDataChange { Modified, Removed };
+    static void invalidateMetaDataCache(const QFileSystemEntry &entry,
+                                        MetaDataChange change = MetaDataChange::Modified);
 #endif
 #if defined(Q_OS_WIN)
     static QFileSystemEntry junctionTarget(const QFileSystemEntry &link, QFileSystemMetaData &data);
@@ -148,6 +154,11 @@ private:
 #if defined(Q_OS_WIN)
     static void clearWinStatData(QFileSystemMetaData &data);
 #endif
+#if defined(Q_OS_UNIX)
+    static bool fillMetaDataUncached(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                                     QFileSystemMetaData::MetaDataFlags what);
+    friend class QFileSystemMetaDataCache;
+#endif
 };
 
 QT_END_NAMESPACE
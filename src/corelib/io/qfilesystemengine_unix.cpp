@@ -10,11 +10,16 @@
 #include "qurl.h"
 
 #include <QtCore/qoperatingsystemversion.h>
+#include <QtCore/qscopeguard.h>
 #include <QtCore/private/qcore_unix_p.h>
 #include <QtCore/private/qfiledevice_p.h>
 #include <QtCore/qvarlengtharray.h>
 #ifndef QT_BOOTSTRAPPED
 # include <QtCore/qstandardpaths.h>
+# if QT_CONFIG(filesystemwatcher) && QT_CONFIG(inotify) && QT_CONFIG(thread)
+#  include "qfilesystemmetadatacache_p.h"
+#  define QT_FILESYSTEM_METADATA_CACHE
+# endif
 #endif // QT_BOOTSTRAPPED
 
 #include <pwd.h>
@@ -265,9 +270,9 @@ mtime(const T &statBuffer, int)
 } // unnamed namespace
 
 #ifdef STATX_BASIC_STATS
-static int qt_real_statx(int fd, const char *pathname, int flags, struct statx *statxBuffer)
+static int qt_real_statx(int fd, const char *pathname, int flags, struct statx *statxBuffer,
+                         unsigned mask = STATX_BASIC_STATS | STATX_BTIME)
 {
-    unsigned mask = STATX_BASIC_STATS | STATX_BTIME;
     int ret = statx(fd, pathname, flags | AT_NO_AUTOMOUNT, mask, statxBuffer);
     return ret == -1 ? -errno : 0;
 }
@@ -287,6 +292,52 @@ static int qt_fstatx(int fd, struct statx *statxBuffer)
     return qt_real_statx(fd, "", AT_EMPTY_PATH, statxBuffer);
 }
 
+// The statx(2) fields needed to answer the \a what flags
+static unsigned statxMask(QFileSystemMetaData::MetaDataFlags what)
+{
+    unsigned mask = 0;
+    if (what & (QFileSystemMetaData::Type | QFileSystemMetaData::ExistsAttribute))
+        mask |= STATX_TYPE;
+    if (what & (QFileSystemMetaData::OtherPermissions | QFileSystemMetaData::GroupPermissions
+                | QFileSystemMetaData::OwnerPermissions))
+        mask |= STATX_MODE;
+    if (what & QFileSystemMetaData::SizeAttribute)
+        mask |= STATX_SIZE;
+    if (what & QFileSystemMetaData::WasDeletedAttribute)
+        mask |= STATX_NLINK;
+    if (what & QFileSystemMetaData::Times)
+        mask |= STATX_ATIME | STATX_MTIME | STATX_CTIME | STATX_BTIME;
+    if (what & QFileSystemMetaData::UserId)
+        mask |= STATX_UID;
+    if (what & QFileSystemMetaData::GroupId)
+        mask |= STATX_GID;
+    return mask;
+}
+
+// The flags that fillFromStatxBuf() could fill from the fields the kernel
+// reported in stx_mask
+static QFileSystemMetaData::MetaDataFlags statxKnownFlags(unsigned mask)
+{
+    QFileSystemMetaData::MetaDataFlags flags;
+    if (mask & STATX_TYPE)
+        flags |= QFileSystemMetaData::FileType | QFileSystemMetaData::DirectoryType
+                | QFileSystemMetaData::SequentialType;
+    if (mask & STATX_MODE)
+        flags |= QFileSystemMetaData::OtherPermissions | QFileSystemMetaData::GroupPermissions
+                | QFileSystemMetaData::OwnerPermissions;
+    if (mask & STATX_SIZE)
+        flags |= QFileSystemMetaData::SizeAttribute;
+    if (mask & STATX_NLINK)
+        flags |= QFileSystemMetaData::WasDeletedAttribute;
+    if ((mask & (STATX_ATIME | STATX_MTIME | STATX_CTIME)) == (STATX_ATIME | STATX_MTIME | STATX_CTIME))
+        flags |= QFileSystemMetaData::Times;
+    if (mask & STATX_UID)
+        flags |= QFileSystemMetaData::UserId;
+    if (mask & STATX_GID)
+        flags |= QFileSystemMetaData::GroupId;
+    return flags;
+}
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffer)
 {
     // Permissions
@@ -348,6 +399,12 @@ static int qt_lstatx(const char *, struct statx *)
 static int qt_fstatx(int, struct statx *)
 { return -ENOSYS; }
 
+static int qt_real_statx(int, const char *, int, struct statx *, unsigned = 0)
+{ return -ENOSYS; }
+
+static unsigned statxMask(QFileSystemMetaData::MetaDataFlags)
+{ return 0; }
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &)
 { }
 #endif
@@ -496,10 +553,20 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
         }
     }
 #elif defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
+    fillFromDirEntType(entry.d_type);
+#else
+    Q_UNUSED(entry);
+#endif
+}
+
+// \a type is the d_type of a directory entry
+void QFileSystemMetaData::fillFromDirEntType(unsigned char type)
+{
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
     // BSD4 includes OS X and iOS
 
     // ### This will clear all entry flags and knownFlagsMask
-    switch (entry.d_type)
+    switch (type)
     {
     case DT_DIR:
         knownFlagsMask = QFileSystemMetaData::LinkType
@@ -566,7 +633,8 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
         clear();
     }
 #else
-    Q_UNUSED(entry);
+    Q_UNUSED(type);
+    clear();
 #endif
 }
 
@@ -847,6 +915,48 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
 {
     Q_CHECK_FILE_NAME(entry, false);
 
+#ifdef QT_FILESYSTEM_METADATA_CACHE
+    if (QFileSystemMetaDataCache *cache = QFileSystemMetaDataCache::instance())
+        return cache->fillMetaData(entry, data, what);
+#endif
+    return fillMetaDataUncached(entry, data, what);
+}
+
+/*!
+    \internal
+
+    Invalidates what the process-wide metadata cache, if enabled, knows about
+    \a entry and its parent directory after the file system was changed through
+    it. If \a change is MetaDataChange::Removed, \a entry no longer refers to
+    the same file and, if it was a directory, nothing below it is cached
+    anymore either.
+*/
+void QFileSystemEngine::invalidateMetaDataCache(const QFileSystemEntry &entry,
+                                                MetaDataChange change)
+{
+#ifdef QT_FILESYSTEM_METADATA_CACHE
+    QFileSystemMetaDataCache *cache = QFileSystemMetaDataCache::instance();
+    if (!cache || entry.isEmpty())
+        return;
+
+    QString path = absoluteName(entry).filePath();
+    while (path.size() > 1 && path.endsWith(u'/'))
+        path.chop(1);
+    if (change == MetaDataChange::Removed)
+        cache->removed(path);
+    else
+        cache->changed(path);
+#else
+    Q_UNUSED(entry);
+    Q_UNUSED(change);
+#endif
+}
+
+//static
+bool QFileSystemEngine::fillMetaDataUncached(const QFileSystemEntry &entry,
+                                             QFileSystemMetaData &data,
+                                             QFileSystemMetaData::MetaDataFlags what)
+{
 #if defined(Q_OS_DARWIN)
     if (what & QFileSystemMetaData::BundleType) {
         if (!data.hasFlags(QFileSystemMetaData::DirectoryType))
@@ -1025,6 +1135,129 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
     return true;
 }
 
+static int qt_fstatat(int dirfd, const char *name, QT_STATBUF *statBuffer, int flags)
+{
+#if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+    return ::fstatat64(dirfd, name, statBuffer, flags);
+#else
+    return ::fstatat(dirfd, name, statBuffer, flags);
+#endif
+}
+
+/*!
+    \internal
+
+    Fills the \a what flags of \a data for the entry \a name in the directory
+    open as \a dirfd, as QFileSystemIterator does for the entries it lists.
+    Unlike fillMetaData(), the lookup is relative to the directory instead of
+    walking the full path again, and statx(2) is only asked for the fields
+    needed; only the flags the kernel could answer are marked as known.
+*/
+bool QFileSystemEngine::fillMetaDataAt(int dirfd, const char *name, QFileSystemMetaData &data,
+                                       QFileSystemMetaData::MetaDataFlags what)
+{
+#if defined(Q_OS_DARWIN)
+    // these need the CoreFoundation lookups done by fillMetaData()
+    what &= ~(QFileSystemMetaData::HiddenAttribute | QFileSystemMetaData::BundleType
+              | QFileSystemMetaData::AliasType);
+#endif
+#ifdef UF_HIDDEN
+    if (what & QFileSystemMetaData::HiddenAttribute)
+        what |= QFileSystemMetaData::PosixStatFlags;
+#endif
+
+    data.entryFlags &= ~what;
+
+    QT_STATBUF statBuffer;
+    struct statx statxBuffer;
+    const unsigned mask = statxMask(what);
+    // returns 1 if statx(2) succeeded, 0 if fstatat(2) did, -1 on error
+    auto statAt = [&](int flags) {
+        int ret = qt_real_statx(dirfd, name, flags, &statxBuffer, mask);
+        if (ret != -ENOSYS) {
+            if (ret == 0)
+                return 1;
+            errno = -ret;
+            return -1;
+        }
+        return qt_fstatat(dirfd, name, &statBuffer, flags);
+    };
+    auto fill = [&](int statResult) {
+        if (statResult) {
+#ifdef STATX_BASIC_STATS
+            data.fillFromStatxBuf(statxBuffer);
+            data.knownFlagsMask |= statxKnownFlags(statxBuffer.stx_mask);
+#endif
+        } else {
+            data.fillFromStatBuf(statBuffer);
+            data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags;
+        }
+    };
+
+    // the same sequence as fillMetaData(): lstat, then stat for symlinks,
+    // then access
+    int entryErrno = 0;
+    int statResult = -1;
+    if (what & QFileSystemMetaData::LinkType) {
+        statResult = statAt(AT_SYMLINK_NOFOLLOW);
+        if (statResult >= 0) {
+            const mode_t mode = statResult ? statxBuffer.stx_mode : statBuffer.st_mode;
+            if (S_ISLNK(mode)) {
+                data.entryFlags |= QFileSystemMetaData::LinkType;
+                statResult = -1;
+            } else {
+                fill(statResult);
+                data.knownFlagsMask |= QFileSystemMetaData::ExistsAttribute;
+                data.entryFlags |= QFileSystemMetaData::ExistsAttribute;
+            }
+        } else {
+            entryErrno = errno;
+            data.knownFlagsMask |= QFileSystemMetaData::ExistsAttribute;
+        }
+        data.knownFlagsMask |= QFileSystemMetaData::LinkType;
+    }
+
+    if (statResult == -1 && entryErrno == 0
+            && (what & (QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::ExistsAttribute))) {
+        statResult = statAt(0);
+        if (statResult >= 0) {
+            fill(statResult);
+            data.entryFlags |= QFileSystemMetaData::ExistsAttribute;
+        } else {
+            entryErrno = errno;
+        }
+        data.knownFlagsMask |= QFileSystemMetaData::ExistsAttribute;
+    }
+
+    if (entryErrno == 0 && (what & QFileSystemMetaData::UserPermissions)) {
+        auto checkAccess = [&](QFileSystemMetaData::MetaDataFlag flag, int mode) {
+            if (entryErrno != 0 || (what & flag) == 0)
+                return;
+            if (::faccessat(dirfd, name, mode, 0) == 0)
+                data.entryFlags |= flag;
+            else if (errno != EACCES && errno != EROFS)
+                entryErrno = errno;
+        };
+        checkAccess(QFileSystemMetaData::UserReadPermission, R_OK);
+        checkAccess(QFileSystemMetaData::UserWritePermission, W_OK);
+        checkAccess(QFileSystemMetaData::UserExecutePermission, X_OK);
+        data.knownFlagsMask |= what & QFileSystemMetaData::UserPermissions;
+    }
+
+    if ((what & QFileSystemMetaData::HiddenAttribute) && !data.isHidden()) {
+        if (name[0] == '.')
+            data.entryFlags |= QFileSystemMetaData::HiddenAttribute;
+        data.knownFlagsMask |= QFileSystemMetaData::HiddenAttribute;
+    }
+
+    if (entryErrno != 0) {
+        what &= ~QFileSystemMetaData::LinkType; // don't clear link: could be broken symlink
+        data.clearFlags(what);
+        return false;
+    }
+    return true;
+}
+
 // static
 bool QFileSystemEngine::cloneFile(int srcfd, int dstfd, const QFileSystemMetaData &knownData)
 {
@@ -1094,8 +1327,14 @@ static bool createDirectoryWithParents(const QByteArray &nativeName, mode_t mode
         return QT_STAT(nativeName.constData(), &st) == 0 && (st.st_mode & S_IFMT) == S_IFDIR;
     };
 
-    if (shouldMkdirFirst && QT_MKDIR(nativeName, mode) == 0)
+    const auto created = [&nativeName] {
+        QFileSystemEngine::invalidateMetaDataCache(
+                QFileSystemEntry(nativeName, QFileSystemEntry::FromNativePath()));
         return true;
+    };
+
+    if (shouldMkdirFirst && QT_MKDIR(nativeName, mode) == 0)
+        return created();
     if (errno == EISDIR)
         return true;
     if (errno == EEXIST)
@@ -1114,7 +1353,7 @@ static bool createDirectoryWithParents(const QByteArray &nativeName, mode_t mode
 
     // try again
     if (QT_MKDIR(nativeName, mode) == 0)
-        return true;
+        return created();
     return errno == EEXIST && isDir(nativeName);
 }
 
@@ -1132,8 +1371,10 @@ bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool crea
     // try to mkdir this directory
     QByteArray nativeName = QFile::encodeName(dirName);
     mode_t mode = permissions ? QtPrivate::toMode_t(*permissions) : 0777;
-    if (QT_MKDIR(nativeName, mode) == 0)
+    if (QT_MKDIR(nativeName, mode) == 0) {
+        invalidateMetaDataCache(entry);
         return true;
+    }
     if (!createParents)
         return false;
 
@@ -1155,6 +1396,8 @@ bool QFileSystemEngine::removeDirectory(const QFileSystemEntry &entry, bool remo
                     return false;
                 if (::rmdir(chunk.constData()) != 0)
                     return oldslash != 0;
+                invalidateMetaDataCache(QFileSystemEntry(chunk, QFileSystemEntry::FromNativePath()),
+                                        MetaDataChange::Removed);
             } else {
                 return false;
             }
@@ -1162,7 +1405,10 @@ bool QFileSystemEngine::removeDirectory(const QFileSystemEntry &entry, bool remo
         }
         return true;
     }
-    return rmdir(QFile::encodeName(entry.filePath()).constData()) == 0;
+    if (rmdir(QFile::encodeName(entry.filePath()).constData()) != 0)
+        return false;
+    invalidateMetaDataCache(entry, MetaDataChange::Removed);
+    return true;
 }
 
 //static
@@ -1171,8 +1417,10 @@ bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSy
     Q_CHECK_FILE_NAME(source, false);
     Q_CHECK_FILE_NAME(target, false);
 
-    if (::symlink(source.nativeFilePath().constData(), target.nativeFilePath().constData()) == 0)
+    if (::symlink(source.nativeFilePath().constData(), target.nativeFilePath().constData()) == 0) {
+        invalidateMetaDataCache(target);
         return true;
+    }
     error = QSystemError(errno, QSystemError::StandardLibraryError);
     return false;
 }
@@ -1423,6 +1671,12 @@ bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSy
     Q_CHECK_FILE_NAME(srcPath, false);
     Q_CHECK_FILE_NAME(tgtPath, false);
 
+    // even a failed attempt may have linked the target for a moment
+    const auto invalidate = qScopeGuard([&] {
+        invalidateMetaDataCache(source, MetaDataChange::Removed);
+        invalidateMetaDataCache(target, MetaDataChange::Removed);
+    });
+
 #if defined(RENAME_NOREPLACE) && QT_CONFIG(renameat2)
     if (renameat2(AT_FDCWD, srcPath, AT_FDCWD, tgtPath, RENAME_NOREPLACE) == 0)
         return true;
@@ -1492,8 +1746,11 @@ bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, cons
     Q_CHECK_FILE_NAME(source, false);
     Q_CHECK_FILE_NAME(target, false);
 
-    if (::rename(source.nativeFilePath().constData(), target.nativeFilePath().constData()) == 0)
+    if (::rename(source.nativeFilePath().constData(), target.nativeFilePath().constData()) == 0) {
+        invalidateMetaDataCache(source, MetaDataChange::Removed);
+        invalidateMetaDataCache(target, MetaDataChange::Removed);
         return true;
+    }
     error = QSystemError(errno, QSystemError::StandardLibraryError);
     return false;
 }
@@ -1502,8 +1759,10 @@ bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, cons
 bool QFileSystemEngine::removeFile(const QFileSystemEntry &entry, QSystemError &error)
 {
     Q_CHECK_FILE_NAME(entry, false);
-    if (unlink(entry.nativeFilePath().constData()) == 0)
+    if (unlink(entry.nativeFilePath().constData()) == 0) {
+        invalidateMetaDataCache(entry, MetaDataChange::Removed);
         return true;
+    }
     error = QSystemError(errno, QSystemError::StandardLibraryError);
     return false;
 
@@ -1516,6 +1775,8 @@ bool QFileSystemEngine::setPermissions(const QFileSystemEntry &entry, QFile::Per
 
     mode_t mode = QtPrivate::toMode_t(permissions);
     bool success = ::chmod(entry.nativeFilePath().constData(), mode) == 0;
+    if (success)
+        invalidateMetaDataCache(entry);
     if (success && data) {
         data->entryFlags &= ~QFileSystemMetaData::Permissions;
         data->entryFlags |= QFileSystemMetaData::MetaDataFlag(uint(permissions.toInt()));
@@ -30,6 +30,9 @@
 #if !defined(Q_OS_WIN)
 #include <QtCore/qscopedpointer.h>
 #endif
+#if defined(Q_OS_LINUX)
+#include <memory>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -54,9 +57,18 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#else
+#if defined(Q_OS_LINUX)
+    // entries are read in getdents64(2) batches
+    int dirFd;
+    int bufferSize;
+    int bufferPos;
+    std::unique_ptr<char[]> buffer;
 #else
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
+#endif
+    QFileSystemMetaData::MetaDataFlags prefetchedMetaData;
     int lastError;
 #endif
 
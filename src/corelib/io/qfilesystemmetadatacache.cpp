@@ -0,0 +1,405 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qfilesystemmetadatacache_p.h"
+#include "qfilesystemengine_p.h"
+#include "qfilesystemwatcher_inotify_p.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/private/qcore_unix_p.h>
+#include <QtCore/private/qthread_p.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+    \class QFileSystemMetaDataCache
+    \internal
+    \brief The QFileSystemMetaDataCache class caches QFileSystemEngine::fillMetaData()
+    results process-wide.
+
+    The cache is opt-in: it is only created when the \c QT_FILESYSTEM_METADATA_CACHE
+    environment variable is set to a positive value before the first file system
+    query. Only absolute, clean paths whose directory is its own canonical path are
+    cached, and only for regular files, directories and paths that do not exist.
+
+    Entries are invalidated through an inotify QFileSystemWatcherEngine running in a
+    thread of its own: the directory of every cached entry is watched (so creation,
+    removal and renaming are seen), as are its parent directories up to the root (so
+    moving an ancestor is seen), and every cached file or directory is watched itself
+    (so modifications are seen). Changes made through QFileSystemEngine and
+    QFSFileEngine are applied synchronously; changes made by other processes become
+    visible once the watcher thread has read the inotify event. Hard links and bind
+    mounts that make the same inode reachable under more than one cached path are
+    not supported, inotify reports the change under only one of the names.
+
+    Concurrent misses for the same path are coalesced: the first thread stats the
+    path while the others wait for its result.
+*/
+
+// the watcher engine stats paths itself while adding them
+Q_CONSTINIT static thread_local bool inWatcherThread = false;
+Q_CONSTINIT static QBasicAtomicPointer<QFileSystemMetaDataCache> globalCache =
+        Q_BASIC_ATOMIC_INITIALIZER(nullptr);
+
+static constexpr QFileSystemMetaData::MetaDataFlags CachedFlags =
+        QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType
+        | QFileSystemMetaData::ExistsAttribute | QFileSystemMetaData::HiddenAttribute;
+
+static QString parentPath(const QString &path)
+{
+    const qsizetype slash = path.lastIndexOf(u'/');
+    return slash > 0 ? path.left(slash) : u"/"_s;
+}
+
+static bool isCacheable(const QFileSystemEntry &entry)
+{
+    // the key must be the name inotify reports the changes under
+    const QString &path = entry.filePath();
+    return path.size() > 1 && !path.endsWith(u'/') && entry.isAbsolute() && entry.isClean();
+}
+
+static bool isCanonical(const QString &path)
+{
+    const QByteArray nativePath = QFile::encodeName(path);
+    char *resolved = ::realpath(nativePath.constData(), nullptr);
+    const bool canonical = resolved && nativePath == resolved;
+    ::free(resolved);
+    return canonical;
+}
+
+static qsizetype watchLimit()
+{
+    // leave most of the per-user inotify watches to QFileSystemWatcher and to
+    // other processes
+    qsizetype limit = 8192;
+    int fd = qt_safe_open("/proc/sys/fs/inotify/max_user_watches", O_RDONLY);
+    if (fd != -1) {
+        char buffer[32];
+        const qint64 n = qt_safe_read(fd, buffer, sizeof(buffer) - 1);
+        qt_safe_close(fd);
+        bool ok = false;
+        const qsizetype max = n > 0 ? QByteArrayView(buffer, n).trimmed().toLongLong(&ok) : 0;
+        if (ok && max > 0)
+            limit = max / 4;
+    }
+    return limit;
+}
+
+QFileSystemMetaDataCache::QFileSystemMetaDataCache(QDaemonThread *thread,
+                                                   QInotifyFileSystemWatcherEngine *engine)
+    : maxWatches(watchLimit()), thread(thread), engine(engine)
+{
+    maxEntries = 4 * maxWatches;
+
+    // the engine emits from the watcher thread
+    QObject::connect(engine, &QFileSystemWatcherEngine::fileChanged, engine,
+                     [this](const QString &path, bool removed) {
+                         onFileChanged(path, removed);
+                     }, Qt::DirectConnection);
+    QObject::connect(engine, &QFileSystemWatcherEngine::directoryChanged, engine,
+                     [this](const QString &path, bool removed) {
+                         onDirectoryChanged(path, removed);
+                     }, Qt::DirectConnection);
+}
+
+QFileSystemMetaDataCache *QFileSystemMetaDataCache::create()
+{
+    if (qEnvironmentVariableIntValue("QT_FILESYSTEM_METADATA_CACHE") <= 0)
+        return nullptr;
+
+    auto thread = new QDaemonThread;
+    thread->setObjectName(u"QFileSystemMetaDataCache"_s);
+    auto context = new QObject;
+    context->moveToThread(thread);
+    thread->start();
+
+    QInotifyFileSystemWatcherEngine *engine = nullptr;
+    QMetaObject::invokeMethod(context, [context, &engine] {
+        inWatcherThread = true;
+        engine = QInotifyFileSystemWatcherEngine::create(nullptr);
+        if (engine)
+            engine->setDirectoryMovesAsRemovals(true);
+        delete context;
+    }, Qt::BlockingQueuedConnection);
+
+    if (!engine) {
+        thread->quit();
+        thread->wait();
+        delete thread;
+        return nullptr;
+    }
+
+    // the watcher thread does not survive fork()
+    pthread_atfork(nullptr, nullptr, [] { globalCache.storeRelaxed(nullptr); });
+    return new QFileSystemMetaDataCache(thread, engine);
+}
+
+QFileSystemMetaDataCache *QFileSystemMetaDataCache::instance()
+{
+    if (inWatcherThread)
+        return nullptr;
+    static const bool initialized = [] {
+        globalCache.storeRelease(create());
+        return true;
+    }();
+    Q_UNUSED(initialized);
+    return globalCache.loadAcquire();
+}
+
+bool QFileSystemMetaDataCache::fillMetaData(const QFileSystemEntry &entry,
+                                            QFileSystemMetaData &data,
+                                            QFileSystemMetaData::MetaDataFlags what)
+{
+    // access(2) also depends on the parent directories, don't cache it
+    if ((what & ~CachedFlags) || !isCacheable(entry))
+        return QFileSystemEngine::fillMetaDataUncached(entry, data, what);
+
+    const QString &path = entry.filePath();
+    QMutexLocker locker(&mutex);
+    for (;;) {
+        auto it = entries.constFind(path);
+        if (it == entries.cend())
+            break;
+        if (it->loading) {
+            loaded.wait(&mutex);
+            continue;
+        }
+        if (it->bypass) {
+            locker.unlock();
+            return QFileSystemEngine::fillMetaDataUncached(entry, data, what);
+        }
+        if (!it->result || it->data.hasFlags(what)) {
+            data = it->data;
+            return it->result;
+        }
+        break;
+    }
+
+    const QString dirPath = parentPath(path);
+    Directory *dir = entries.size() < maxEntries ? watchedDirectory(locker, dirPath) : nullptr;
+    if (!dir) {
+        locker.unlock();
+        return QFileSystemEngine::fillMetaDataUncached(entry, data, what);
+    }
+
+    // someone else may have loaded it while we waited for the directory
+    if (auto it = entries.constFind(path); it != entries.cend()
+            && (it->loading || it->bypass || !it->result || it->data.hasFlags(what))) {
+        locker.unlock();
+        return fillMetaData(entry, data, what);
+    }
+
+    entries[path] = Entry();
+    dir->children.insert(path);
+    const bool watched = watches.contains(path);
+    const bool canWatch = watches.size() < maxWatches;
+    locker.unlock();
+
+    QFileSystemMetaData fresh;
+    bool result = QFileSystemEngine::fillMetaDataUncached(entry, fresh, CachedFlags);
+    bool cacheable = !fresh.isLink() && (!result || fresh.isFile() || fresh.isDirectory());
+    bool addedWatch = false;
+    if (cacheable && result && !watched) {
+        // whatever changed before the watch was added is seen by a second look
+        cacheable = canWatch && addWatch(path);
+        if (cacheable) {
+            addedWatch = true;
+            fresh = QFileSystemMetaData();
+            result = QFileSystemEngine::fillMetaDataUncached(entry, fresh, CachedFlags);
+            cacheable = !fresh.isLink() && (!result || fresh.isFile() || fresh.isDirectory());
+        }
+    }
+
+    locker.relock();
+    auto it = entries.find(path);
+    Q_ASSERT(it != entries.end() && it->loading);
+    if (it->invalidated) {
+        entries.erase(it);
+        directories[dirPath].children.remove(path);
+    } else {
+        if (addedWatch)
+            watches.insert(path);
+        it->data = fresh;
+        it->result = result;
+        it->loading = false;
+        // keep the entry to bypass the cache until the path changes
+        it->bypass = !cacheable;
+    }
+    loaded.wakeAll();
+    locker.unlock();
+
+    data = fresh;
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns the bucket for the directory \a path, after making sure it and all
+    its parents are watched. Returns \nullptr if it cannot be watched, in which
+    case the entries in it must not be cached. May unlock \a locker while it
+    waits for the watcher thread.
+*/
+QFileSystemMetaDataCache::Directory *
+QFileSystemMetaDataCache::watchedDirectory(QMutexLocker<QMutex> &locker, const QString &path)
+{
+    for (;;) {
+        auto it = directories.find(path);
+        if (it != directories.end()) {
+            switch (it->state) {
+            case Directory::Watched:
+                return &*it;
+            case Directory::Uncacheable:
+                return nullptr;
+            case Directory::Watching:
+                loaded.wait(&mutex);
+                continue;
+            case Directory::Unwatched:
+                break;
+            }
+        }
+
+        if (path != u"/"_s && !watchedDirectory(locker, parentPath(path)))
+            return nullptr;
+        if (watches.size() >= maxWatches)
+            return nullptr;
+
+        it = directories.find(path);
+        if (it != directories.end() && it->state != Directory::Unwatched)
+            continue;       // someone else got to it while we watched the parent
+        if (it == directories.end())
+            it = directories.insert(path, Directory());
+        if (watches.contains(path)) {
+            // already watched as an entry of its parent
+            it->state = Directory::Watched;
+            return &*it;
+        }
+        it->state = Directory::Watching;
+        const uint generation = it->generation;
+        locker.unlock();
+
+        Directory::State state = Directory::Uncacheable;
+        if (isCanonical(path))
+            state = addWatch(path) ? Directory::Watched : Directory::Unwatched;
+        else if (::access(QFile::encodeName(path).constData(), F_OK) != 0)
+            state = Directory::Unwatched;   // might be created later
+
+        locker.relock();
+        it = directories.find(path);
+        if (it->generation != generation && state == Directory::Watched)
+            state = Directory::Unwatched;   // removed while we added the watch
+        it->state = state;
+        if (state == Directory::Watched)
+            watches.insert(path);
+        loaded.wakeAll();
+        if (state != Directory::Watched)
+            return nullptr;
+        return &*it;
+    }
+}
+
+bool QFileSystemMetaDataCache::addWatch(const QString &path)
+{
+    bool added = false;
+    QMetaObject::invokeMethod(engine, [this, &path, &added] {
+        QStringList files, directories;
+        // drop a watch left behind on an inode that is no longer at this path
+        engine->removePaths({ path }, &files, &directories);
+        added = engine->addPaths({ path }, &files, &directories).isEmpty();
+    }, Qt::BlockingQueuedConnection);
+    return added;
+}
+
+void QFileSystemMetaDataCache::eraseEntry(const QString &path)
+{
+    auto it = entries.find(path);
+    if (it == entries.end())
+        return;
+    if (it->loading) {
+        it->invalidated = true;
+        return;
+    }
+    entries.erase(it);
+    if (auto dir = directories.find(parentPath(path)); dir != directories.end())
+        dir->children.remove(path);
+}
+
+void QFileSystemMetaDataCache::clearDirectory(Directory &directory, bool dropWatches)
+{
+    for (auto child = directory.children.begin(); child != directory.children.end(); ) {
+        if (dropWatches)
+            watches.remove(*child);
+        auto it = entries.find(*child);
+        if (it != entries.end() && it->loading) {
+            it->invalidated = true;
+            ++child;
+            continue;
+        }
+        if (it != entries.end())
+            entries.erase(it);
+        child = directory.children.erase(child);
+    }
+}
+
+void QFileSystemMetaDataCache::removeTree(const QString &path)
+{
+    eraseEntry(path);
+    watches.remove(path);
+
+    // every directory with cached entries has its parents in directories too
+    if (!directories.contains(path))
+        return;
+    const QString prefix = path + u'/';
+    for (auto it = directories.begin(); it != directories.end(); ++it) {
+        if (it.key() != path && !it.key().startsWith(prefix))
+            continue;
+        clearDirectory(*it, true);
+        watches.remove(it.key());
+        it->state = Directory::Unwatched;
+        ++it->generation;
+    }
+}
+
+void QFileSystemMetaDataCache::changed(const QString &path)
+{
+    QMutexLocker locker(&mutex);
+    eraseEntry(path);
+    eraseEntry(parentPath(path));
+}
+
+void QFileSystemMetaDataCache::removed(const QString &path)
+{
+    QMutexLocker locker(&mutex);
+    removeTree(path);
+    eraseEntry(parentPath(path));
+}
+
+void QFileSystemMetaDataCache::onFileChanged(const QString &path, bool removed)
+{
+    Q_UNUSED(removed);
+    QMutexLocker locker(&mutex);
+    // a file replaced by rename(2) reports the link count change of the old
+    // inode, the path needs a new watch
+    watches.remove(path);
+    eraseEntry(path);
+}
+
+void QFileSystemMetaDataCache::onDirectoryChanged(const QString &path, bool removed)
+{
+    QMutexLocker locker(&mutex);
+    if (removed) {
+        removeTree(path);
+        eraseEntry(parentPath(path));
+        return;
+    }
+    if (auto it = directories.find(path); it != directories.end())
+        clearDirectory(*it, false);
+    eraseEntry(path);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,94 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFILESYSTEMMETADATACACHE_P_H
+#define QFILESYSTEMMETADATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qfilesystementry_p.h"
+#include "qfilesystemmetadata_p.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qwaitcondition.h>
+
+QT_REQUIRE_CONFIG(filesystemwatcher);
+QT_REQUIRE_CONFIG(inotify);
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class QDaemonThread;
+class QInotifyFileSystemWatcherEngine;
+
+class QFileSystemMetaDataCache
+{
+public:
+    // null unless enabled with QT_FILESYSTEM_METADATA_CACHE
+    static QFileSystemMetaDataCache *instance();
+
+    bool fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                      QFileSystemMetaData::MetaDataFlags what);
+
+    // called by QFileSystemEngine after it changed the file system itself
+    void changed(const QString &path);
+    void removed(const QString &path);
+
+private:
+    struct Entry
+    {
+        QFileSystemMetaData data;
+        bool result = false;
+        bool loading = true;
+        bool invalidated = false;   // while loading
+        bool bypass = false;        // not cacheable until it changes
+    };
+
+    struct Directory
+    {
+        enum State { Unwatched, Watching, Watched, Uncacheable };
+        QSet<QString> children;
+        State state = Unwatched;
+        uint generation = 0;
+    };
+
+    QFileSystemMetaDataCache(QDaemonThread *thread, QInotifyFileSystemWatcherEngine *engine);
+    ~QFileSystemMetaDataCache() = delete;   // lives as long as the process
+    static QFileSystemMetaDataCache *create();
+
+    Directory *watchedDirectory(QMutexLocker<QMutex> &locker, const QString &path);
+    bool addWatch(const QString &path);
+
+    void eraseEntry(const QString &path);
+    void clearDirectory(Directory &directory, bool dropWatches);
+    void removeTree(const QString &path);
+
+    void onFileChanged(const QString &path, bool removed);
+    void onDirectoryChanged(const QString &path, bool removed);
+
+    QMutex mutex;
+    QWaitCondition loaded;
+    QHash<QString, Entry> entries;
+    QHash<QString, Directory> directories;
+    QSet<QString> watches;
+    qsizetype maxWatches;
+    qsizetype maxEntries;
+
+    QDaemonThread *thread;
+    QInotifyFileSystemWatcherEngine *engine;
+};
+
+QT_END_NAMESPACE
+
+#endif // QFILESYSTEMMETADATACACHE_P_H
@@ -255,6 +255,7 @@ QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
                                        | IN_CREATE
                                        | IN_DELETE
                                        | IN_DELETE_SELF
+                                       | (directoryMovesAsRemovals ? IN_MOVE_SELF : 0)
                                        )
                                     : (0
                                        | IN_ATTRIB
@@ -37,6 +37,10 @@ public:
     QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
     QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
 
+    // report a watched directory that is moved away as removed, for watches
+    // added afterwards
+    void setDirectoryMovesAsRemovals(bool enable) { directoryMovesAsRemovals = enable; }
+
 private Q_SLOTS:
     void readFromInotify();
 
@@ -49,6 +53,7 @@ private:
     QHash<QString, int> pathToID;
     QMultiHash<int, QString> idToPath;
     QSocketNotifier notifier;
+    bool directoryMovesAsRemovals = false;
 };
 
 
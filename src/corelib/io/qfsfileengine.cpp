@@ -856,6 +856,16 @@ bool QFSFileEngine::extension(Extension extension, const ExtensionOption *option
         const UnMapExtensionOption *options = (const UnMapExtensionOption*)option;
         return d->unmap(options->address);
     }
+#ifdef Q_OS_UNIX
+    if (extension == WriteVectorExtension && d->fd != -1 && !d->fh) {
+        const auto *options = static_cast<const WriteVectorExtensionOption *>(option);
+        auto *returnValue = static_cast<WriteVectorExtensionReturn *>(output);
+        d->metaData.clearFlags(QFileSystemMetaData::Times);
+        d->lastIOCommand = QFSFileEnginePrivate::IOWriteCommand;
+        returnValue->written = d->writeVectorFd(options->chunks, options->count);
+        return true;
+    }
+#endif
 
     return false;
 }
@@ -874,6 +884,10 @@ bool QFSFileEngine::supportsExtension(Extension extension) const
         return true;
     if (extension == UnMapExtension || extension == MapExtension)
         return true;
+#ifdef Q_OS_UNIX
+    if (extension == WriteVectorExtension && d->fd != -1 && !d->fh)
+        return true;
+#endif
     return false;
 }
 
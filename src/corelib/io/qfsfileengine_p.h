@@ -146,6 +146,9 @@ public:
     qint64 readLineFdFh(char *data, qint64 maxlen);
     qint64 nativeWrite(const char *data, qint64 len);
     qint64 writeFdFh(const char *data, qint64 len);
+#ifdef Q_OS_UNIX
+    qint64 writeVectorFd(const QByteArrayView *chunks, qsizetype count);
+#endif
     int nativeHandle() const;
     bool nativeIsSequential() const;
 #ifndef Q_OS_WIN
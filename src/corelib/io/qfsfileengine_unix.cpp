@@ -128,6 +128,10 @@ bool QFSFileEnginePrivate::nativeOpenImpl(QIODevice::OpenMode openMode, mode_t m
         }
 
         fh = nullptr;
+
+        // the file may have been created or truncated
+        if (openMode & QIODevice::WriteOnly)
+            QFileSystemEngine::invalidateMetaDataCache(fileEntry);
     }
 
     closeFileHandle = true;
@@ -148,7 +152,11 @@ bool QFSFileEnginePrivate::nativeClose()
 */
 bool QFSFileEnginePrivate::nativeFlush()
 {
-    return fh ? flushFh() : fd != -1;
+    const bool flushed = fh ? flushFh() : fd != -1;
+    // QFileDevice::close() flushes too, so this also covers the last write
+    if (flushed)
+        QFileSystemEngine::invalidateMetaDataCache(fileEntry);
+    return flushed;
 }
 
 /*!
@@ -246,6 +254,58 @@ qint64 QFSFileEnginePrivate::nativeWrite(const char *data, qint64 len)
     return writeFdFh(data, len);
 }
 
+/*!
+    \internal
+
+    Writes the \a count buffers in \a chunks to the file descriptor with as
+    few writev() calls as possible. Like writeFdFh(), this keeps writing
+    until everything has been written or an error occurred, and returns the
+    number of bytes written, or -1 if nothing could be written.
+*/
+qint64 QFSFileEnginePrivate::writeVectorFd(const QByteArrayView *chunks, qsizetype count)
+{
+    Q_Q(QFSFileEngine);
+    Q_ASSERT(fd != -1 && !fh);
+
+    QVarLengthArray<iovec, 16> vector;
+    qint64 len = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (chunks[i].isEmpty())
+            continue;
+        vector.append({ const_cast<char *>(chunks[i].data()), size_t(chunks[i].size()) });
+        len += chunks[i].size();
+    }
+
+    qint64 writtenBytes = 0;
+    iovec *next = vector.begin();
+    while (next != vector.end()) {
+        qint64 result = qt_safe_writev(fd, next, int(qMin(vector.end() - next, qptrdiff(INT_MAX))));
+        if (result <= 0)
+            break;
+        writtenBytes += result;
+
+        // skip what was written, which may end in the middle of a buffer
+        while (next != vector.end() && size_t(result) >= next->iov_len) {
+            result -= next->iov_len;
+            ++next;
+        }
+        if (next != vector.end()) {
+            next->iov_base = static_cast<char *>(next->iov_base) + result;
+            next->iov_len -= result;
+        }
+    }
+
+    if (len && writtenBytes == 0) {
+        writtenBytes = -1;
+        q->setError(errno == ENOSPC ? QFile::ResourceError : QFile::WriteError, QSystemError::stdString());
+    } else {
+        // reset the cached size, if any
+        metaData.clearFlags(QFileSystemMetaData::SizeAttribute);
+    }
+
+    return writtenBytes;
+}
+
 /*!
     \internal
 */
@@ -507,6 +567,7 @@ bool QFSFileEngine::setPermissions(uint perms)
         setError(QFile::PermissionsError, error.toString());
         return false;
     }
+    QFileSystemEngine::invalidateMetaDataCache(d->fileEntry);
     return true;
 }
 
@@ -522,6 +583,8 @@ bool QFSFileEngine::setSize(qint64 size)
         ret = QT_TRUNCATE(d->fileEntry.nativeFilePath().constData(), size) == 0;
     if (!ret)
         setError(QFile::ResizeError, qt_error_string(errno));
+    else
+        QFileSystemEngine::invalidateMetaDataCache(d->fileEntry);
     return ret;
 }
 
@@ -541,6 +604,7 @@ bool QFSFileEngine::setFileTime(const QDateTime &newDate, FileTime time)
     }
 
     d->metaData.clearFlags(QFileSystemMetaData::Times);
+    QFileSystemEngine::invalidateMetaDataCache(d->fileEntry);
     return true;
 }
 
@@ -1754,6 +1754,59 @@ qint64 QIODevice::write(const QByteArray &data)
     return ret;
 }
 
+/*!
+    \since 6.7
+    \overload
+
+    Writes the byte arrays in \a data to the device, one after the other.
+    Returns the number of bytes that were actually written, or -1 if an
+    error occurred before anything could be written.
+
+    The result is the same as calling write() for each byte array in turn,
+    but devices can write them more efficiently: QFile passes them, together
+    with what it has buffered, to the operating system with a single system
+    call where the platform supports it, and QAbstractSocket and QLocalSocket
+    keep references to large byte arrays in their write buffers instead of
+    copying them, and send several buffered blocks at once. This suits
+    protocols that send a header, a payload and a trailer, which no longer
+    need to be concatenated first:
+
+    \snippet code/src_corelib_io_qiodevice.cpp 6
+
+    \sa read(), writeData()
+*/
+qint64 QIODevice::write(const QByteArrayList &data)
+{
+    Q_D(QIODevice);
+    CHECK_WRITABLE(write, qint64(-1));
+
+    return d->writeVector(data);
+}
+
+/*!
+    \internal
+
+    Called by QIODevice::write(const QByteArrayList &). The default
+    implementation writes the byte arrays one at a time, stopping after a
+    short write.
+*/
+qint64 QIODevicePrivate::writeVector(const QByteArrayList &data)
+{
+    Q_Q(QIODevice);
+    qint64 writtenSoFar = 0;
+    for (const QByteArray &chunk : data) {
+        if (chunk.isEmpty())
+            continue;
+        const qint64 ret = q->write(chunk);
+        if (ret < 0)
+            return writtenSoFar ? writtenSoFar : ret;
+        writtenSoFar += ret;
+        if (ret < chunk.size())
+            break;
+    }
+    return writtenSoFar;
+}
+
 /*!
     \internal
 */
@@ -88,6 +88,7 @@ public:
     qint64 write(const char *data, qint64 len);
     qint64 write(const char *data);
     qint64 write(const QByteArray &data);
+    qint64 write(const QByteArrayList &data);
 
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
@@ -150,6 +150,7 @@ public:
     virtual QByteArray peek(qint64 maxSize);
     qint64 skipByReading(qint64 maxSize);
     void write(const char *data, qint64 size);
+    virtual qint64 writeVector(const QByteArrayList &data);
 
     inline bool isWriteChunkCached(const char *data, qint64 size) const
     {
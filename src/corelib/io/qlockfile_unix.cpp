@@ -16,6 +16,7 @@
 
 #include "private/qcore_unix_p.h" // qt_safe_open
 #include "private/qabstractfileengine_p.h"
+#include "private/qfilesystemengine_p.h"
 #include "private/qfilesystementry_p.h"
 #include "private/qtemporaryfile_p.h"
 
@@ -146,6 +147,7 @@ QLockFile::LockError QLockFilePrivate::tryLock_sys()
 
     // We hold the lock, continue.
     fileHandle = fd;
+    QFileSystemEngine::invalidateMetaDataCache(QFileSystemEntry(fileName));
 
     // Sync to disk if possible. Ignore errors (e.g. not supported).
 #if defined(_POSIX_SYNCHRONIZED_IO) && _POSIX_SYNCHRONIZED_IO > 0
@@ -165,6 +167,9 @@ bool QLockFilePrivate::removeStaleLock()
         return false;
     bool success = setNativeLocks(fd) && (::unlink(lockFileName) == 0);
     close(fd);
+    if (success)
+        QFileSystemEngine::invalidateMetaDataCache(QFileSystemEntry(fileName),
+                                                   QFileSystemEngine::MetaDataChange::Removed);
     return success;
 }
 
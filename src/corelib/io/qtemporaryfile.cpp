@@ -213,8 +213,11 @@ static bool createFileFromTemplate(NativeFileHandle &file, QTemporaryFileName &t
                 QT_OPEN_CREAT | QT_OPEN_EXCL | QT_OPEN_RDWR | QT_OPEN_LARGEFILE,
                 static_cast<mode_t>(mode));
 
-        if (file != -1)
+        if (file != -1) {
+            QFileSystemEngine::invalidateMetaDataCache(
+                    QFileSystemEntry(path, QFileSystemEntry::FromNativePath()));
             return true;
+        }
 
         int err = errno;
         if (err != EEXIST) {
@@ -425,7 +428,10 @@ bool QTemporaryFileEngine::materializeUnnamedFile(const QString &newName, QTempo
     Q_D(QFSFileEngine);
     const QByteArray src = "/proc/self/fd/" + QByteArray::number(d->fd);
     auto materializeAt = [=](const QFileSystemEntry &dst) {
-        return ::linkat(AT_FDCWD, src, AT_FDCWD, dst.nativeFilePath(), AT_SYMLINK_FOLLOW) == 0;
+        if (::linkat(AT_FDCWD, src, AT_FDCWD, dst.nativeFilePath(), AT_SYMLINK_FOLLOW) != 0)
+            return false;
+        QFileSystemEngine::invalidateMetaDataCache(dst);
+        return true;
     };
 #else
     auto materializeAt = [](const QFileSystemEntry &) { return false; };
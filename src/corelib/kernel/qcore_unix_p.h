@@ -40,6 +40,7 @@
 #endif
 
 #include <chrono>
+#include <sys/uio.h>
 #include <sys/wait.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -325,6 +326,25 @@ static inline qint64 qt_safe_write_nosignal(int fd, const void *data, qint64 len
     return qt_safe_write(fd, data, len);
 }
 
+#if defined(IOV_MAX)
+static constexpr int QT_IOV_MAX = IOV_MAX;
+#else
+static constexpr int QT_IOV_MAX = 16;       // the POSIX minimum
+#endif
+
+static inline qint64 qt_safe_writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    qint64 ret = 0;
+    EINTR_LOOP(ret, ::writev(fd, iov, qMin(iovcnt, QT_IOV_MAX)));
+    return ret;
+}
+
+static inline qint64 qt_safe_writev_nosignal(int fd, const struct iovec *iov, int iovcnt)
+{
+    qt_ignore_sigpipe();
+    return qt_safe_writev(fd, iov, iovcnt);
+}
+
 static inline int qt_safe_close(int fd)
 {
     int ret;
@@ -41,6 +41,7 @@
 #include <private/qfunctions_p.h>
 #include <private/qlocale_p.h>
 #include <private/qlocking_p.h>
+#include <private/qorderedmutexlocker_p.h>
 #include <private/qhooks_p.h>
 
 #if QT_CONFIG(permissions)
@@ -336,7 +337,7 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 qsizetype qGlobalPostedEventsCount()
 {
     const QPostEventList &l = QThreadData::current()->postEventList;
-    return l.size() - l.startOffset;
+    return l.size() - l.startOffset + l.pendingEventCount.loadRelaxed();
 }
 
 Q_CONSTINIT QAbstractEventDispatcher *QCoreApplicationPrivate::eventDispatcher = nullptr;
@@ -485,6 +486,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->postEventList.addPendingEvents();
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -828,6 +830,10 @@ void Q_TRACE_INSTRUMENT(qtcore) QCoreApplicationPrivate::init()
     Q_ASSERT_X(!QCoreApplication::self, "QCoreApplication", "there should be only one application object");
     QCoreApplication::self = q;
 
+#ifndef QT_NO_QOBJECT
+    QObjectAllocationPool::enableFromEnvironment();
+#endif
+
 #if QT_CONFIG(thread)
 #ifdef Q_OS_WASM
     emscripten::val hardwareConcurrency = emscripten::val::global("navigator")["hardwareConcurrency"];
@@ -1619,6 +1625,14 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // Posting to an object of the current thread never contends on the lock,
+    // and the locked path does not need to allocate a pending event node.
+    if (QCoreApplicationPrivate::canPostWithoutLocking(event)
+            && receiver->d_func()->threadData.loadRelaxed() != QThreadData::current(false)) {
+        QCoreApplicationPrivate::postEventWithoutLocking(receiver, event, priority);
+        return;
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1628,6 +1642,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QThreadData *data = locker.threadData;
 
+    // keep the events in the order they were posted in
+    data->postEventList.addPendingEvents();
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1676,6 +1693,106 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+    \internal
+    Returns \c true if \a event can be posted without locking the receiver
+    thread's list of posted events. That is the case for the events that are
+    never compressed (see compressEvent()) nor need the receiver thread's
+    state, like the ones of queued connections and user-defined events, which
+    are also the ones that are posted at high rates between threads.
+*/
+bool QCoreApplicationPrivate::canPostWithoutLocking(const QEvent *event)
+{
+    const int type = event->type();
+    return type == QEvent::MetaCall || (type >= QEvent::User && type <= QEvent::MaxUser);
+}
+
+/*!
+    \internal
+    Posts \a event to \a receiver by pushing it to the lock-free stack of
+    pending events of the receiver's thread, which is added to the list of
+    posted events whenever the list is read.
+*/
+void QCoreApplicationPrivate::postEventWithoutLocking(QObject *receiver, QEvent *event, int priority)
+{
+    // synchronizes with the storeRelease in QObject::moveToThread
+    QThreadData *data = receiver->d_func()->threadData.loadAcquire();
+    if (!data) {
+        // posting during destruction? just delete the event to prevent a leak
+        delete event;
+        return;
+    }
+
+    // delete the event on exceptions to protect against memory leaks till the event is
+    // properly owned by the pending event
+    std::unique_ptr<QEvent> eventDeleter(event);
+    auto *pending = new QPostEventList::PendingEvent{ QPostEvent(receiver, event, priority), nullptr };
+    Q_UNUSED(eventDeleter.release());
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    event->m_posted = true;
+    ++receiver->d_func()->postedEvents;
+    data->postEventList.pushPendingEvent(pending);
+
+    // QObject::moveToThread() adds the pending events before and after moving
+    // the objects, so if we don't see that the receiver has moved by now, the
+    // event either was moved along, or is sent in the receiver's thread.
+    if (Q_UNLIKELY(receiver->d_func()->threadData.loadAcquire() != data)) {
+        movePendingEvent(data, receiver, event);
+        return;
+    }
+
+    // like postEvent() does under the mutex, for the dispatchers that check
+    // canWait rather than calling canWaitLocked()
+    data->canWait = false;
+    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+}
+
+/*!
+    \internal
+    Moves \a event, which postEventWithoutLocking() pushed to the pending
+    events of \a data while \a receiver was moved to another thread, to the
+    list of the thread \a receiver lives in now. sendPostedEvents() does not
+    send such events.
+*/
+void QCoreApplicationPrivate::movePendingEvent(QThreadData *data, QObject *receiver, QEvent *event)
+{
+    auto &threadData = receiver->d_func()->threadData;
+
+    // if object has moved to another thread, follow it
+    for (;;) {
+        QThreadData *targetData = threadData.loadAcquire();
+        if (!targetData) {
+            // destruction in progress
+            return;
+        }
+
+        QOrderedMutexLocker locker(&data->postEventList.mutex, &targetData->postEventList.mutex);
+        if (targetData != threadData.loadAcquire())
+            continue;
+
+        data->postEventList.addPendingEvents();
+        targetData->postEventList.addPendingEvents();
+        if (targetData != data) {
+            for (const QPostEvent &pe : std::as_const(data->postEventList)) {
+                if (pe.event == event && pe.receiver == receiver) {
+                    targetData->postEventList.addEvent(pe);
+                    const_cast<QPostEvent &>(pe).event = nullptr;
+                    break;
+                }
+            }
+        }
+        targetData->canWait = false;
+        locker.unlock();
+
+        QAbstractEventDispatcher* dispatcher = targetData->eventDispatcher.loadAcquire();
+        if (dispatcher)
+            dispatcher->wakeUp();
+        return;
+    }
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1771,6 +1888,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.addPendingEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1778,6 +1896,8 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     data->canWait = (data->postEventList.size() == 0);
 
     if (data->postEventList.size() == 0 || (receiver && !receiver->d_func()->postedEvents)) {
+        if (data->postEventList.hasPendingEvents())
+            data->canWait = false;
         --data->postEventList.recursion;
         return;
     }
@@ -1808,6 +1928,10 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
             }
 
             --data->postEventList.recursion;
+            // an event posted without locking may have been overwritten
+            // by the canWait = true above
+            if (data->postEventList.hasPendingEvents())
+                data->canWait = false;
             if (!data->postEventList.recursion && !data->canWait && data->hasEventDispatcher())
                 data->eventDispatcher.loadRelaxed()->wakeUp();
 
@@ -1839,6 +1963,15 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
             continue;
         }
 
+        if (Q_UNLIKELY(pe.receiver->d_func()->threadData.loadRelaxed() != data)) {
+            // posted without locking while the receiver was moved to another
+            // thread; movePendingEvent() takes it there, so keep it for now
+            QPostEvent pe_copy = pe;
+            const_cast<QPostEvent &>(pe).event = nullptr;
+            data->postEventList.addEvent(pe_copy);
+            continue;
+        }
+
         if (pe.event->type() == QEvent::DeferredDelete) {
             // DeferredDelete events are sent either
             // 1) when the event loop that posted the event has returned; or
@@ -1933,6 +2066,8 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
     if (receiver && !receiver->d_func()->postedEvents)
         return;
 
+    data->postEventList.addPendingEvents();
+
     //we will collect all the posted events for the QObject
     //and we'll delete after the mutex was unlocked
     QVarLengthArray<QEvent*> events;
@@ -1988,6 +2123,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.addPendingEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
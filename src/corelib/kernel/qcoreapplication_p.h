@@ -107,6 +107,9 @@ public:
     static bool threadRequiresCoreApplication();
 
     static void sendPostedEvents(QObject *receiver, int event_type, QThreadData *data);
+    static bool canPostWithoutLocking(const QEvent *event);
+    static void postEventWithoutLocking(QObject *receiver, QEvent *event, int priority);
+    static void movePendingEvent(QThreadData *data, QObject *receiver, QEvent *event);
 
     static void checkReceiverThread(QObject *receiver);
     void cleanupThreadData();
@@ -19,10 +19,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <limits>
+
 #ifndef QT_NO_EVENTFD
 #  include <sys/eventfd.h>
 #endif
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 // VxWorks doesn't correctly set the _POSIX_... options
 #if defined(Q_OS_VXWORKS)
 #  if defined(_POSIX_MONOTONIC_CLOCK) && (_POSIX_MONOTONIC_CLOCK <= 0)
@@ -190,14 +196,125 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0)
+        initEpoll();
+#endif
+
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_TIMER_WHEEL") > 0)
+        timerList.setTimerWheelEnabled(true);
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+
     // cleanup timers
     qDeleteAll(timerList);
 }
 
+#if QT_CONFIG(epoll)
+// The poll(2) and epoll(7) event bits are interchangeable on Linux, which
+// lets both backends share QSocketNotifierSetUNIX::events() and
+// markPendingSocketNotifiers().
+static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLPRI == POLLPRI
+              && EPOLLERR == POLLERR && EPOLLHUP == POLLHUP);
+
+/*
+    Creates the epoll instance and registers the thread pipe with it. Socket
+    notifiers are then kept in the epoll interest list as they are enabled and
+    disabled, so that processEvents() no longer rebuilds and scans a pollfd
+    array whose size is the number of registered notifiers.
+*/
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        qErrnoWarning("QEventDispatcherUNIX: epoll_create1() failed, using poll() instead");
+        return false;
+    }
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+        qErrnoWarning("QEventDispatcherUNIX: Unable to watch the thread pipe, using poll() instead");
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpoll(int fd, short oldEvents, short newEvents)
+{
+    if (epollFd < 0 || oldEvents == newEvents)
+        return;
+
+    epoll_event ev = {};
+    ev.events = uint(newEvents);
+    ev.data.fd = fd;
+
+    const int op = !oldEvents ? EPOLL_CTL_ADD : !newEvents ? EPOLL_CTL_DEL : EPOLL_CTL_MOD;
+    if (epoll_ctl(epollFd, op, fd, &ev) == 0)
+        return;
+
+    // A descriptor that was closed while its notifiers were still enabled has
+    // already been dropped from the interest list by the kernel.
+    if (op == EPOLL_CTL_DEL && (errno == ENOENT || errno == EBADF))
+        return;
+    if (op == EPOLL_CTL_MOD && errno == ENOENT && epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0)
+        return;
+
+    // Anything else is a descriptor epoll cannot watch (e.g. a regular file)
+    // or an invalid one. poll() reports both with the established semantics,
+    // so fall back to it for the rest of this dispatcher's lifetime.
+    qt_safe_close(epollFd);
+    epollFd = -1;
+}
+
+/*
+    Waits for activity like qt_safe_poll() does and fills pollfds with the
+    ready socket notifier descriptors, followed by the thread pipe, so that
+    processEvents() can handle both backends the same way.
+*/
+int QEventDispatcherUNIXPrivate::epollWait(const timespec *timeout)
+{
+    int msecs = -1;
+    if (timeout) {
+        // round up, so that we don't wake up just before a timer is due, and
+        // clamp, as a negative timeout would make epoll_wait() block forever
+        const qint64 ms = qint64(timeout->tv_sec) * 1000 + (timeout->tv_nsec + 999999) / 1000000;
+        msecs = int(qMin(ms, qint64(std::numeric_limits<int>::max())));
+    }
+
+    epoll_event events[256];
+    const int n = epoll_wait(epollFd, events, int(std::size(events)), msecs);
+    if (n <= 0)
+        return (n == -1 && errno == EINTR) ? 0 : n;
+
+    pollfd pipeFd = threadPipe.prepare();
+    pollfds.clear();
+    pollfds.reserve(n + 1);
+    for (int i = 0; i < n; ++i) {
+        const epoll_event &ev = events[i];
+        if (ev.data.fd == pipeFd.fd)
+            pipeFd.revents = short(ev.events);
+        else if (socketNotifiers.contains(ev.data.fd)) // skip stale registrations of dup()ed fds
+            pollfds.append({ ev.data.fd, 0, short(ev.events) });
+    }
+
+    // This must be last, as it's popped off the end in processEvents()
+    pollfds.append(pipeFd);
+    return n;
+}
+#endif // QT_CONFIG(epoll)
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -375,7 +492,13 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = notifier;
+    d->updateEpoll(sockfd, oldEvents, sn_set.events());
+#else
     sn_set.notifiers[type] = notifier;
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -414,7 +537,13 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = nullptr;
+    d->updateEpoll(sockfd, oldEvents, sn_set.events());
+#else
     sn_set.notifiers[type] = nullptr;
+#endif
 
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
@@ -451,21 +580,34 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
-    d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+    const char *waitFunction = "qt_safe_poll";
+    int ready;
+
+#if QT_CONFIG(epoll)
+    if (include_notifiers && d->epollFd >= 0) {
+        waitFunction = "epoll_wait";
+        ready = d->epollWait(tm);
+    } else
+#endif
+    {
+        d->pollfds.clear();
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+
+        if (include_notifiers)
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
 
-    if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+        // This must be last, as it's popped off the end below
+        d->pollfds.append(d->threadPipe.prepare());
 
-    // This must be last, as it's popped off the end below
-    d->pollfds.append(d->threadPipe.prepare());
+        ready = qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm);
+    }
 
     int nevents = 0;
 
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
+    switch (ready) {
     case -1:
-        qErrnoWarning("qt_safe_poll");
+        qErrnoWarning(waitFunction);
         if (QT_CONFIG(poll_exit_on_error))
             abort();
         break;
@@ -103,8 +103,17 @@ public:
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpoll(int fd, short oldEvents, short newEvents);
+    int epollWait(const timespec *timeout);
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
+#if QT_CONFIG(epoll)
+    int epollFd = -1;
+#endif
 
     QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
     QList<QSocketNotifier *> pendingNotifiers;
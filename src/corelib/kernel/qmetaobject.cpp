@@ -2726,7 +2726,6 @@ auto QMetaMethodInvoker::invokeImpl(QMetaMethod self, void *target,
 
         auto event = std::make_unique<QMetaCallEvent>(idx_offset, idx_relative, callFunction, nullptr, -1, paramCount);
         QMetaType *types = event->types();
-        void **args = event->args();
 
         // fill in the meta types first
         for (int i = 1; i < paramCount; ++i) {
@@ -2746,7 +2745,7 @@ auto QMetaMethodInvoker::invokeImpl(QMetaMethod self, void *target,
 
         // now create copies of our parameters using those meta types
         for (int i = 1; i < paramCount; ++i)
-            args[i] = types[i].create(parameters[i]);
+            event->createArgument(i, parameters[i]);
 
         QCoreApplication::postEvent(object, event.release());
     } else { // blocking queued connection
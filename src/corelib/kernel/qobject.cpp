@@ -156,6 +156,173 @@ QMetaObject *QObjectData::dynamicMetaObject() const
     return metaObject->toDynamicMetaObject(q_ptr);
 }
 
+namespace {
+// Per-thread cache of the memory of QObjectPrivate, QObjectPrivate::ExtraData
+// and connection objects last deleted in a thread, sorted by size. Objects of
+// the same class have the same size, so blocks are only reused for the same
+// size and never need to be rounded up. Applications creating and destroying
+// many short-lived objects enable it on the threads doing so; blocks freed in
+// one thread can be reused by another.
+struct QObjectAllocationPoolData
+{
+    static constexpr size_t Granularity = 8;
+    static constexpr int SizeClasses = 64;      // blocks of up to 512 bytes
+    static constexpr int Capacity = 32;         // cached blocks per size
+
+    struct FreeBlock { FreeBlock *next; };
+    FreeBlock *freeLists[SizeClasses] = {};
+    int counts[SizeClasses] = {};
+    bool enabled = false;
+
+    ~QObjectAllocationPoolData();
+    void clear() noexcept;
+};
+Q_CONSTINIT thread_local bool objectAllocationPoolDestroyed = false;
+Q_CONSTINIT thread_local QObjectAllocationPoolData objectAllocationPool;
+
+// The number of threads that have their pool enabled. While it is zero,
+// allocate() and deallocate() do not touch the thread-local pools at all.
+Q_CONSTINIT QBasicAtomicInt objectAllocationPoolThreads = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+QObjectAllocationPoolData::~QObjectAllocationPoolData()
+{
+    objectAllocationPoolDestroyed = true;
+    if (enabled)
+        objectAllocationPoolThreads.deref();
+    clear();
+}
+
+void QObjectAllocationPoolData::clear() noexcept
+{
+    for (int i = 0; i < SizeClasses; ++i) {
+        while (FreeBlock *block = freeLists[i]) {
+            freeLists[i] = block->next;
+            ::operator delete(block, size_t(i + 1) * Granularity);
+        }
+        counts[i] = 0;
+    }
+}
+
+constexpr bool isPoolableSize(size_t size) noexcept
+{
+    return size && size % QObjectAllocationPoolData::Granularity == 0
+            && size <= QObjectAllocationPoolData::Granularity * QObjectAllocationPoolData::SizeClasses;
+}
+
+constexpr int sizeClass(size_t size) noexcept
+{
+    return int(size / QObjectAllocationPoolData::Granularity - 1);
+}
+} // unnamed namespace
+
+/*!
+    \internal
+    \class QObjectAllocationPool
+    \inmodule QtCore
+
+    Recycles the memory of the private objects of QObjects and of their
+    connections on the current thread, instead of returning it to the
+    system allocator. This trades a bounded amount of memory per thread for
+    cheaper construction, connection and destruction of QObjects.
+
+    The pool is disabled by default; setEnabled() enables it for the calling
+    thread only. Applications enable it for the main thread and every
+    QThread with the \c QT_ENABLE_QOBJECT_ALLOCATION_POOL environment
+    variable, see enableFromEnvironment(). Memory freed while the pool is
+    disabled is released immediately. As long as no thread has it enabled,
+    allocate() and deallocate() call the global operator new and operator
+    delete directly.
+ */
+
+/*!
+    \internal
+
+    Enables or disables the allocation pool of the current thread, depending
+    on \a enable. Disabling it releases the memory it caches.
+ */
+void QObjectAllocationPool::setEnabled(bool enable)
+{
+    if (objectAllocationPoolDestroyed)
+        return;
+    QObjectAllocationPoolData &pool = objectAllocationPool;
+    if (pool.enabled == enable)
+        return;
+    pool.enabled = enable;
+    if (enable) {
+        objectAllocationPoolThreads.ref();
+    } else {
+        objectAllocationPoolThreads.deref();
+        pool.clear();
+    }
+}
+
+/*!
+    \internal
+
+    Enables the allocation pool of the current thread if the
+    \c QT_ENABLE_QOBJECT_ALLOCATION_POOL environment variable is set to a
+    non-zero value; it is read only once. QCoreApplication calls this for the
+    main thread, and QThread for each thread it starts.
+ */
+void QObjectAllocationPool::enableFromEnvironment()
+{
+    static const bool enable = qEnvironmentVariableIntValue("QT_ENABLE_QOBJECT_ALLOCATION_POOL") != 0;
+    if (enable)
+        setEnabled(true);
+}
+
+/*!
+    \internal
+
+    Returns whether the allocation pool of the current thread is enabled.
+ */
+bool QObjectAllocationPool::isEnabled()
+{
+    return !objectAllocationPoolDestroyed && objectAllocationPool.enabled;
+}
+
+/*!
+    \internal
+
+    Returns a block of \a size bytes, from the current thread's pool if it
+    has one of that size cached.
+ */
+void *QObjectAllocationPool::allocate(size_t size)
+{
+    if (objectAllocationPoolThreads.loadRelaxed() && isPoolableSize(size)
+        && !objectAllocationPoolDestroyed) {
+        QObjectAllocationPoolData &pool = objectAllocationPool;
+        const int index = sizeClass(size);
+        if (QObjectAllocationPoolData::FreeBlock *block = pool.freeLists[index]) {
+            pool.freeLists[index] = block->next;
+            --pool.counts[index];
+            return block;
+        }
+    }
+    return ::operator new(size);
+}
+
+/*!
+    \internal
+
+    Releases the block \a ptr of \a size bytes, which must have been returned
+    by allocate() for the same size, possibly in another thread.
+ */
+void QObjectAllocationPool::deallocate(void *ptr, size_t size) noexcept
+{
+    if (ptr && objectAllocationPoolThreads.loadRelaxed() && isPoolableSize(size)
+        && !objectAllocationPoolDestroyed) {
+        QObjectAllocationPoolData &pool = objectAllocationPool;
+        const int index = sizeClass(size);
+        if (pool.enabled && pool.counts[index] < QObjectAllocationPoolData::Capacity) {
+            pool.freeLists[index] = new (ptr) QObjectAllocationPoolData::FreeBlock{ pool.freeLists[index] };
+            ++pool.counts[index];
+            return;
+        }
+    }
+    ::operator delete(ptr, size);
+}
+
 QObjectPrivate::QObjectPrivate(int version)
     : threadData(nullptr), currentChildBeingDeleted(nullptr)
 {
@@ -601,7 +768,11 @@ QMetaCallEvent::~QMetaCallEvent()
     if (d.nargs_) {
         QMetaType *t = types();
         for (int i = 0; i < d.nargs_; ++i) {
-            if (t[i].isValid() && d.args_[i])
+            if (!t[i].isValid() || !d.args_[i])
+                continue;
+            if (isInlineArgument(d.args_[i]))
+                t[i].destruct(d.args_[i]);
+            else
                 t[i].destroy(d.args_[i]);
         }
         if (reinterpret_cast<void *>(d.args_) != reinterpret_cast<void *>(prealloc_))
@@ -611,6 +782,89 @@ QMetaCallEvent::~QMetaCallEvent()
         d.slotObj_->destroyIfLastRef();
 }
 
+inline bool QMetaCallEvent::isInlineArgument(const void *arg) const
+{
+    return std::less_equal<const void *>()(argumentStorage_, arg)
+            && std::less<const void *>()(arg, argumentStorage_ + sizeof(argumentStorage_));
+}
+
+/*!
+    \internal
+
+    Creates the argument \a n as a copy of \a copy, or default-constructed if
+    \a copy is \nullptr, using the meta type types()[n], and stores it in
+    args()[n]. Small arguments are constructed inside the event, so that most
+    queued calls need no allocation besides the event itself. Returns the
+    argument.
+ */
+void *QMetaCallEvent::createArgument(int n, const void *copy)
+{
+    Q_ASSERT(n < d.nargs_);
+    const QMetaType type = types()[n];
+    if (!type.isValid())
+        return d.args_[n] = nullptr;
+
+    const size_t align = size_t(type.alignOf());
+    const size_t size = size_t(type.sizeOf());
+    const size_t offset = (argumentStorageUsed_ + align - 1) & ~(align - 1);
+    if (align <= alignof(std::max_align_t) && offset + size <= sizeof(argumentStorage_)) {
+        argumentStorageUsed_ = ushort(offset + size);
+        return d.args_[n] = type.construct(argumentStorage_ + offset, copy);
+    }
+    return d.args_[n] = type.create(copy);
+}
+
+namespace {
+// The memory of the QMetaCallEvents last deleted in a thread, for the next
+// ones created in it. Events of queued calls within a thread, and of calls
+// going back and forth between two threads, thus rarely need to allocate.
+struct QMetaCallEventFreeList
+{
+    static constexpr int Capacity = 32;
+    void *blocks[Capacity] = {};
+    int size = 0;
+
+    ~QMetaCallEventFreeList();
+};
+Q_CONSTINIT thread_local bool metaCallEventFreeListDestroyed = false;
+Q_CONSTINIT thread_local QMetaCallEventFreeList metaCallEventFreeList;
+
+QMetaCallEventFreeList::~QMetaCallEventFreeList()
+{
+    metaCallEventFreeListDestroyed = true;
+    while (size)
+        ::operator delete(blocks[--size]);
+}
+} // unnamed namespace
+
+/*!
+    \internal
+ */
+void *QMetaCallEvent::operator new(size_t size)
+{
+    if (size == sizeof(QMetaCallEvent) && !metaCallEventFreeListDestroyed) {
+        QMetaCallEventFreeList &freeList = metaCallEventFreeList;
+        if (freeList.size)
+            return freeList.blocks[--freeList.size];
+    }
+    return ::operator new(size);
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr, size_t size) noexcept
+{
+    if (ptr && size == sizeof(QMetaCallEvent) && !metaCallEventFreeListDestroyed) {
+        QMetaCallEventFreeList &freeList = metaCallEventFreeList;
+        if (freeList.size < QMetaCallEventFreeList::Capacity) {
+            freeList.blocks[freeList.size++] = ptr;
+            return;
+        }
+    }
+    ::operator delete(ptr);
+}
+
 /*!
     \internal
  */
@@ -626,6 +880,178 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+QBatchedCallBuffer::QBatchedCallBuffer(const int *argumentTypes, bool latestValueOnly)
+    : latestValueOnly(latestValueOnly)
+{
+    for (const int *type = argumentTypes; *type; ++type) {
+        const QMetaType metaType(*type);
+        const size_t align = qMax(size_t(metaType.alignOf()), size_t(1));
+        stride = (stride + align - 1) & ~(align - 1);
+        types.append(metaType);
+        offsets.append(stride);
+        stride += size_t(metaType.sizeOf());
+        alignment = qMax(alignment, align);
+    }
+    stride = qMax((stride + alignment - 1) & ~(alignment - 1), alignment);
+}
+
+QBatchedCallBuffer::~QBatchedCallBuffer()
+{
+    destroy(pending);
+    deallocate(pending);
+}
+
+void QBatchedCallBuffer::reserve(Calls &calls, qsizetype capacity)
+{
+    Calls grown;
+    grown.data = static_cast<char *>(::operator new(capacity * stride, std::align_val_t(alignment)));
+    grown.capacity = capacity;
+
+    // the types need not be relocatable, so copy the calls over
+    QVarLengthArray<void *, 16> argv(types.size());
+    for (qsizetype i = 0; i < calls.count; ++i) {
+        arguments(calls, i, argv.data());
+        char *call = grown.data + i * stride;
+        for (qsizetype n = 0; n < types.size(); ++n)
+            types[n].construct(call + offsets[n], argv[n]);
+    }
+    grown.count = calls.count;
+    destroy(calls);
+    deallocate(calls);
+    calls = grown;
+}
+
+void QBatchedCallBuffer::destroy(Calls &calls)
+{
+    QVarLengthArray<void *, 16> argv(types.size());
+    for (qsizetype i = 0; i < calls.count; ++i) {
+        arguments(calls, i, argv.data());
+        for (qsizetype n = 0; n < types.size(); ++n)
+            types[n].destruct(argv[n]);
+    }
+    calls.count = 0;
+}
+
+void QBatchedCallBuffer::deallocate(Calls &calls)
+{
+    if (calls.data)
+        ::operator delete(calls.data, std::align_val_t(alignment));
+    calls = Calls();
+}
+
+/*!
+    \internal
+    Copies the arguments \a argv of a queued emission, \a argv[0] being the
+    return value.
+*/
+void QBatchedCallBuffer::append(void **argv)
+{
+    if (latestValueOnly)
+        destroy(pending);
+    if (pending.count == pending.capacity)
+        reserve(pending, qMax(pending.capacity * 2, qsizetype(latestValueOnly ? 1 : 8)));
+
+    char *call = pending.data + pending.count * stride;
+    for (qsizetype n = 0; n < types.size(); ++n)
+        types[n].construct(call + offsets[n], argv[n + 1]);
+    ++pending.count;
+}
+
+/*!
+    \internal
+    Takes the calls appended so far, which the caller invokes and then hands
+    back to recycle(), without holding the lock.
+*/
+QBatchedCallBuffer::Calls QBatchedCallBuffer::take()
+{
+    eventPending.storeRelaxed(0);
+    return std::exchange(pending, Calls());
+}
+
+/*!
+    \internal
+    Destroys the arguments of \a calls, and keeps their memory for the next
+    calls if none have been appended in the meantime.
+*/
+void QBatchedCallBuffer::recycle(Calls &&calls)
+{
+    destroy(calls);
+    if (!pending.data)
+        pending = std::exchange(calls, Calls());
+    else
+        deallocate(calls);
+}
+
+namespace {
+/*
+    Posted for a Qt::BatchedConnection when the first emission is queued,
+    invokes the slot for all the emissions queued until it is delivered.
+*/
+class QBatchedMetaCallEvent : public QAbstractMetaCallEvent
+{
+public:
+    QBatchedMetaCallEvent(QObjectPrivate::Connection *c, const QObject *sender, int signalId)
+        : QAbstractMetaCallEvent(sender, signalId), c(c),
+          slotObj(c->isSlotObject ? c->slotObj : nullptr),
+          callFunction(c->isSlotObject ? nullptr : c->callFunction),
+          method_offset(c->isSlotObject ? 0 : c->method_offset),
+          method_relative(c->isSlotObject ? ushort(-1) : c->method_relative)
+    {
+        c->ref();
+        if (slotObj)
+            slotObj->ref();
+    }
+
+    ~QBatchedMetaCallEvent() override
+    {
+        // if we were never delivered, let the next emission post a new event
+        if (!delivered)
+            c->batchedCalls->eventPending.storeRelease(0);
+        if (slotObj)
+            slotObj->destroyIfLastRef();
+        c->deref();
+    }
+
+    void placeMetaCall(QObject *object) override;
+
+private:
+    QObjectPrivate::Connection *c;
+    QtPrivate::QSlotObjectBase *slotObj;
+    QObjectPrivate::StaticMetaCallFunction callFunction;
+    ushort method_offset;
+    ushort method_relative;
+    bool delivered = false;
+};
+} // unnamed namespace
+
+void QBatchedMetaCallEvent::placeMetaCall(QObject *object)
+{
+    QBatchedCallBuffer *buffer = c->batchedCalls;
+    QBatchedCallBuffer::Calls calls;
+    {
+        QBasicMutexLocker locker(signalSlotLock(object));
+        calls = buffer->take();
+    }
+    delivered = true;
+
+    QVarLengthArray<void *, 8> argv(buffer->argumentCount() + 1);
+    argv[0] = nullptr; // return value
+    for (qsizetype i = 0; i < calls.count; ++i) {
+        buffer->arguments(calls, i, argv.data() + 1);
+        if (slotObj) {
+            slotObj->call(object, argv.data());
+        } else if (callFunction && method_offset <= object->metaObject()->methodOffset()) {
+            callFunction(object, QMetaObject::InvokeMetaMethod, method_relative, argv.data());
+        } else {
+            QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod,
+                                  method_offset + method_relative, argv.data());
+        }
+    }
+
+    QBasicMutexLocker locker(signalSlotLock(object));
+    buffer->recycle(std::move(calls));
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -853,6 +1279,16 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     and both standard Qt widgets and user-created forms can be given dynamic
     properties.
 
+    \section1 Memory Allocation
+
+    Applications that create and destroy many short-lived objects can set
+    the \c QT_ENABLE_QOBJECT_ALLOCATION_POOL environment variable to \c 1.
+    The main thread and each QThread then keep the memory of the private
+    data and the connections of the objects deleted in it, and reuse it for
+    the next objects, instead of returning it to the system allocator. Each
+    thread keeps the memory of at most 32 objects of each size. The variable
+    is read once, when the QCoreApplication is created.
+
     \section1 Internationalization (I18n)
 
     All QObject subclasses support Qt's translation features, making it possible
@@ -1121,6 +1557,7 @@ QObject::~QObject()
 
 inline QObjectPrivate::Connection::~Connection()
 {
+    delete batchedCalls;
     if (ownArgumentTypes) {
         const int *v = argumentTypes.loadRelaxed();
         if (v != &DIRECT_CONNECTION_ONLY)
@@ -1660,6 +2097,9 @@ void QObject::moveToThread(QThread *targetThread)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
+    // move the events posted without locking, too
+    currentData->postEventList.addPendingEvents();
+
     // move the object
     auto threadPrivate =  targetThread
         ? static_cast<QThreadPrivate *>(QThreadPrivate::get(targetThread))
@@ -1672,6 +2112,24 @@ void QObject::moveToThread(QThread *targetThread)
     }
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
 
+    // Events that were posted without locking after the objects' events were
+    // moved, but before the posting thread could see the new thread data, are
+    // moved here; later ones are moved by QCoreApplicationPrivate::movePendingEvent().
+    if (currentData->postEventList.addPendingEvents()) {
+        bool eventsMoved = false;
+        for (const QPostEvent &pe : std::as_const(currentData->postEventList)) {
+            if (pe.event && pe.receiver->d_func()->threadData.loadRelaxed() == targetData) {
+                targetData->postEventList.addEvent(pe);
+                const_cast<QPostEvent &>(pe).event = nullptr;
+                eventsMoved = true;
+            }
+        }
+        if (eventsMoved && targetData->hasEventDispatcher()) {
+            targetData->canWait = false;
+            targetData->eventDispatcher.loadRelaxed()->wakeUp();
+        }
+    }
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -3470,6 +3928,10 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isBatched = type & (Qt::BatchedConnection | Qt::LatestValueOnlyConnection);
+    const bool isLatestValueOnly = type & Qt::LatestValueOnlyConnection;
+    type &= ~(Qt::BatchedConnection | Qt::LatestValueOnlyConnection);
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -3487,6 +3949,8 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    c->isBatched = isBatched;
+    c->isLatestValueOnly = isLatestValueOnly;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3816,6 +4280,17 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
+    if (c->isBatched && !c->isSingleShot) {
+        // copy the arguments while locked, and post an event only if the
+        // previous one has taken the calls already
+        if (!c->batchedCalls)
+            c->batchedCalls = new QBatchedCallBuffer(argumentTypes, c->isLatestValueOnly);
+        c->batchedCalls->append(argv);
+        if (c->batchedCalls->eventPending.testAndSetRelaxed(0, 1))
+            QCoreApplication::postEvent(receiver, new QBatchedMetaCallEvent(c, sender, signal));
+        return;
+    }
+
     SlotObjectGuard slotObjectGuard { c->isSlotObject ? c->slotObj : nullptr };
     locker.unlock();
 
@@ -3834,7 +4309,7 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
             types[n] = QMetaType(argumentTypes[n - 1]);
 
         for (int n = 1; n < nargs; ++n)
-            args[n] = types[n].create(argv[n]);
+            ev->createArgument(n, argv[n]);
     }
 
     if (c->isSingleShot && !QObjectPrivate::removeConnection(c)) {
@@ -5117,6 +5592,10 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isBatched = type & (Qt::BatchedConnection | Qt::LatestValueOnlyConnection);
+    const bool isLatestValueOnly = type & Qt::LatestValueOnlyConnection;
+    type &= ~(Qt::BatchedConnection | Qt::LatestValueOnlyConnection);
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -5135,6 +5614,8 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    c->isBatched = isBatched;
+    c->isLatestValueOnly = isLatestValueOnly;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
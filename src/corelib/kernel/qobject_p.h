@@ -70,6 +70,17 @@ public:
     static void (*setWidgetParent)(QObject *, QObject *); // Used by the QML engine to specify parents for widgets. Set by QtWidgets.
 };
 
+class Q_CORE_EXPORT QObjectAllocationPool
+{
+public:
+    static void setEnabled(bool enable);
+    static bool isEnabled();
+    static void enableFromEnvironment();
+
+    static void *allocate(size_t size);
+    static void deallocate(void *ptr, size_t size) noexcept;
+};
+
 class Q_CORE_EXPORT QObjectPrivate : public QObjectData
 {
 public:
@@ -79,6 +90,10 @@ public:
     {
         ExtraData(QObjectPrivate *ptr) : parent(ptr) { }
 
+        static void *operator new(size_t size) { return QObjectAllocationPool::allocate(size); }
+        static void operator delete(void *ptr, size_t size) noexcept
+        { QObjectAllocationPool::deallocate(ptr, size); }
+
         inline void setObjectNameForwarder(const QString &name)
         {
             parent->q_func()->setObjectName(name);
@@ -131,6 +146,15 @@ public:
 
     QObjectPrivate(int version = QObjectPrivateVersion);
     virtual ~QObjectPrivate();
+
+    // private classes of QObject subclasses inherit these
+    static void *operator new(size_t size) { return QObjectAllocationPool::allocate(size); }
+    static void operator delete(void *ptr, size_t size) noexcept
+    { QObjectAllocationPool::deallocate(ptr, size); }
+    static void *operator new(size_t size, std::align_val_t alignment)
+    { return ::operator new(size, alignment); }
+    static void operator delete(void *ptr, std::align_val_t alignment) noexcept
+    { ::operator delete(ptr, alignment); }
     void deleteChildren();
     // used to clear binding storage early in ~QObject
     void clearBindingStorage();
@@ -394,14 +418,14 @@ public:
         auto metaCallEvent = std::make_unique<QMetaCallEvent>(slotObj, sender,
                                                               signal_index, int(1 + sizeof...(Args)));
 
-        void **args = metaCallEvent->args();
         QMetaType *types = metaCallEvent->types();
         const std::array<void *, sizeof...(Args) + 1> argp{ nullptr, std::addressof(argv)... };
         const std::array metaTypes{ QMetaType::fromType<void>(), QMetaType::fromType<Args>()... };
         for (size_t i = 0; i < sizeof...(Args) + 1; ++i) {
             types[i] = metaTypes[i];
-            args[i] = types[i].create(argp[i]);
-            Q_CHECK_PTR(!i || args[i]);
+            void *arg = metaCallEvent->createArgument(int(i), argp[i]);
+            Q_CHECK_PTR(!i || arg);
+            Q_UNUSED(arg);
         }
 
         return metaCallEvent.release();
@@ -413,10 +437,16 @@ public:
     inline const QMetaType *types() const { return reinterpret_cast<QMetaType *>(d.args_ + d.nargs_); }
     inline QMetaType *types() { return reinterpret_cast<QMetaType *>(d.args_ + d.nargs_); }
 
+    void *createArgument(int n, const void *copy);
+
     virtual void placeMetaCall(QObject *object) override;
 
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size) noexcept;
+
 private:
     inline void allocArgs();
+    inline bool isInlineArgument(const void *arg) const;
 
     struct Data {
         QtPrivate::QSlotObjectBase *slotObj_;
@@ -426,8 +456,11 @@ private:
         ushort method_offset_;
         ushort method_relative_;
     } d;
-    // preallocate enough space for three arguments
-    alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
+    // preallocate enough space for the return value and three arguments
+    alignas(void *) char prealloc_[4 * sizeof(void *) + 4 * sizeof(QMetaType)];
+    // the values of small arguments, see createArgument()
+    alignas(std::max_align_t) char argumentStorage_[8 * sizeof(void *)];
+    ushort argumentStorageUsed_ = 0;
 };
 
 class QBoolBlocker
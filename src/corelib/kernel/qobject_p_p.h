@@ -22,6 +22,7 @@
 
 #include <QtCore/qobject.h>
 #include <QtCore/private/qobject_p.h>
+#include <QtCore/qvarlengtharray.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -66,8 +67,58 @@ struct QObjectPrivate::ConnectionOrSignalVector
 };
 static_assert(std::is_trivial_v<QObjectPrivate::ConnectionOrSignalVector>);
 
+// Holds the arguments of the queued emissions of a Qt::BatchedConnection until
+// the receiver's thread invokes the slot for all of them, from one event. The
+// arguments are stored in place, one call after the other.
+class QBatchedCallBuffer
+{
+    Q_DISABLE_COPY_MOVE(QBatchedCallBuffer)
+public:
+    struct Calls
+    {
+        char *data = nullptr;
+        qsizetype count = 0;
+        qsizetype capacity = 0;
+    };
+
+    QBatchedCallBuffer(const int *argumentTypes, bool latestValueOnly);
+    ~QBatchedCallBuffer();
+
+    // must be called with the receiver's signalSlotLock held
+    void append(void **argv);
+    Calls take();
+    void recycle(Calls &&calls);
+
+    qsizetype argumentCount() const { return types.size(); }
+    void arguments(const Calls &calls, qsizetype i, void **argv) const
+    {
+        char *call = calls.data + i * stride;
+        for (qsizetype n = 0; n < types.size(); ++n)
+            argv[n] = call + offsets[n];
+    }
+
+    // set from the time the first call is appended until an event takes them
+    QAtomicInt eventPending;
+
+private:
+    void reserve(Calls &calls, qsizetype capacity);
+    void destroy(Calls &calls);
+    void deallocate(Calls &calls);
+
+    QVarLengthArray<QMetaType, 4> types;
+    QVarLengthArray<size_t, 4> offsets;
+    size_t stride = 0;
+    size_t alignment = alignof(void *);
+    Calls pending;
+    const bool latestValueOnly;
+};
+
 struct QObjectPrivate::Connection : public ConnectionOrSignalVector
 {
+    static void *operator new(size_t size) { return QObjectAllocationPool::allocate(size); }
+    static void operator delete(void *ptr, size_t size) noexcept
+    { QObjectAllocationPool::deallocate(ptr, size); }
+
     // linked list of connections connected to slots in this object, next is in base class
     Connection **prev;
     // linked list of connections connected to signals in this object
@@ -82,6 +133,9 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
         QtPrivate::QSlotObjectBase *slotObj;
     };
     QAtomicPointer<const int> argumentTypes;
+    // Qt::BatchedConnection: created on the first queued emission, protected by
+    // the receiver's signalSlotLock
+    QBatchedCallBuffer *batchedCalls = nullptr;
     QAtomicInt ref_{
         2
     }; // ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
@@ -93,7 +147,9 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
     ushort isSlotObject : 1;
     ushort ownArgumentTypes : 1;
     ushort isSingleShot : 1;
-    Connection() : ownArgumentTypes(true) { }
+    ushort isBatched : 1;
+    ushort isLatestValueOnly : 1;
+    Connection() : ownArgumentTypes(true), isBatched(false), isLatestValueOnly(false) { }
     ~Connection();
     int method() const
     {
@@ -135,6 +191,10 @@ static_assert(
 
 struct QObjectPrivate::ConnectionData
 {
+    static void *operator new(size_t size) { return QObjectAllocationPool::allocate(size); }
+    static void operator delete(void *ptr, size_t size) noexcept
+    { QObjectAllocationPool::deallocate(ptr, size); }
+
     // the id below is used to avoid activating new connections. When the object gets
     // deleted it's set to 0, so that signal emission stops
     QAtomicInteger<uint> currentConnectionId;
@@ -15,6 +15,8 @@
 #  include <QThread>
 #endif
 
+#include <limits>
+
 #include <sys/times.h>
 
 using namespace std::chrono;
@@ -33,6 +35,32 @@ QTimerInfoList::QTimerInfoList()
     firstTimerInfo = nullptr;
 }
 
+QTimerInfoList::~QTimerInfoList() = default;
+
+/*
+  Moves Qt::CoarseTimer and Qt::VeryCoarseTimer timers that are not due yet
+  into a QTimerWheel, so that registering and unregistering them no longer
+  scans the sorted list. The coarse timeout adjustments are unchanged.
+*/
+void QTimerInfoList::setTimerWheelEnabled(bool enable)
+{
+    if (enable == bool(wheel))
+        return;
+
+    if (enable) {
+        // timers already in the list move over as they get rescheduled
+        wheel.reset(new QTimerWheel);
+        return;
+    }
+
+    const QList<QTimerInfo *> timers = wheel->timers();
+    for (QTimerInfo *t : timers) {
+        wheel->remove(t);
+        timerInsert(t);
+    }
+    wheel.reset();
+}
+
 timespec QTimerInfoList::updateCurrentTime()
 {
     return (currentTime = qt_gettime());
@@ -52,6 +80,175 @@ void QTimerInfoList::timerInsert(QTimerInfo *ti)
     insert(index+1, ti);
 }
 
+/*
+  insert timer info into the wheel if it is a coarse one, else into the list
+*/
+void QTimerInfoList::insertTimer(QTimerInfo *ti)
+{
+    if (wheel && ti->timerType != Qt::PreciseTimer && wheel->insert(ti, currentTime))
+        return;
+    timerInsert(ti);
+}
+
+/*
+ * QTimerWheel: a timer in level L is at most 64^(L+1) ticks away and sits in
+ * the slot of the 64^L-tick block it expires in. When that block is reached,
+ * the slot is cascaded, i.e. its timers are relinked into lower levels; level
+ * 0 slots hold the timers expiring at one exact tick.
+ */
+static constexpr qint64 tickCeil(timespec t)
+{
+    return qint64(t.tv_sec) * 1000 + (t.tv_nsec + 999'999) / 1'000'000;
+}
+
+static constexpr qint64 tickFloor(timespec t)
+{
+    return qint64(t.tv_sec) * 1000 + t.tv_nsec / 1'000'000;
+}
+
+QTimerWheel::QTimerWheel() = default;
+
+QTimerWheel::~QTimerWheel()
+{
+    qDeleteAll(timersById);
+}
+
+/*
+  Inserts the timer, unless it is already due, in which case false is returned.
+*/
+bool QTimerWheel::insert(QTimerInfo *t, timespec now)
+{
+    if (isEmpty())
+        currentTick = qMax(currentTick, tickFloor(now));
+
+    t->wheelTick = tickCeil(t->timeout);
+    if (t->wheelTick <= currentTick)
+        return false;
+
+    timersById.insert(t->id, t);
+    timersByObject.insert(t->obj, t);
+    link(t);
+    return true;
+}
+
+void QTimerWheel::remove(QTimerInfo *t)
+{
+    unlink(t);
+    timersById.remove(t->id);
+    timersByObject.remove(t->obj, t);
+}
+
+void QTimerWheel::link(QTimerInfo *t)
+{
+    constexpr qint64 range = qint64(1) << (SlotBits * LevelCount);
+    const qint64 delta = t->wheelTick - currentTick;
+    Q_ASSERT(delta > 0);
+
+    int level = 0;
+    while (level < LevelCount - 1 && delta >= (qint64(1) << (SlotBits * (level + 1))))
+        ++level;
+
+    // timers beyond the range of the wheel get re-cascaded from the last level
+    const qint64 tick = delta < range ? t->wheelTick : currentTick + range - 1;
+    const int index = int(tick >> (SlotBits * level)) & (SlotCount - 1);
+
+    QTimerInfo **slot = &wheelSlots[level][index];
+    t->wheelSlot = slot;
+    t->wheelPrev = nullptr;
+    t->wheelNext = *slot;
+    if (*slot)
+        (*slot)->wheelPrev = t;
+    *slot = t;
+    occupied[level] |= quint64(1) << index;
+}
+
+void QTimerWheel::unlink(QTimerInfo *t)
+{
+    if (t->wheelPrev)
+        t->wheelPrev->wheelNext = t->wheelNext;
+    else
+        *t->wheelSlot = t->wheelNext;
+    if (t->wheelNext)
+        t->wheelNext->wheelPrev = t->wheelPrev;
+
+    if (!*t->wheelSlot) {
+        const qptrdiff pos = t->wheelSlot - &wheelSlots[0][0];
+        occupied[pos / SlotCount] &= ~(quint64(1) << (pos % SlotCount));
+    }
+}
+
+QTimerInfo *QTimerWheel::takeSlot(int level, int index)
+{
+    QTimerInfo *head = wheelSlots[level][index];
+    wheelSlots[level][index] = nullptr;
+    occupied[level] &= ~(quint64(1) << index);
+    return head;
+}
+
+/*
+  Returns the next tick at which a timer expires or a slot needs to be
+  cascaded. This is a lower bound for the next timeout of the wheel's timers.
+*/
+qint64 QTimerWheel::nextEventTick() const
+{
+    qint64 next = std::numeric_limits<qint64>::max();
+    for (int level = 0; level < LevelCount; ++level) {
+        const quint64 bits = occupied[level];
+        if (!bits)
+            continue;
+
+        // rotate the bitmap so that bit 0 is the block after the current one
+        const int shift = SlotBits * level;
+        const qint64 block = currentTick >> shift;
+        const int start = int(block + 1) & (SlotCount - 1);
+        const quint64 rotated = start ? (bits >> start) | (bits << (SlotCount - start)) : bits;
+        next = qMin(next, (block + 1 + qCountTrailingZeroBits(rotated)) << shift);
+    }
+    return next;
+}
+
+/*
+  Advances the wheel up to and including \a tick, passing every timer that
+  expires to \a expire after removing it from the wheel.
+*/
+template <typename Expire>
+void QTimerWheel::advance(qint64 tick, Expire expire)
+{
+    auto expireTimer = [&](QTimerInfo *t) {
+        timersById.remove(t->id);
+        timersByObject.remove(t->obj, t);
+        expire(t);
+    };
+
+    while (currentTick < tick) {
+        currentTick = isEmpty() ? tick : qMin(tick, nextEventTick());
+
+        for (int level = LevelCount - 1; level > 0; --level) {
+            const int shift = SlotBits * level;
+            if (currentTick & ((qint64(1) << shift) - 1))
+                continue;
+
+            QTimerInfo *t = takeSlot(level, int(currentTick >> shift) & (SlotCount - 1));
+            while (t) {
+                QTimerInfo *next = t->wheelNext;
+                if (t->wheelTick <= currentTick)
+                    expireTimer(t);
+                else
+                    link(t);
+                t = next;
+            }
+        }
+
+        QTimerInfo *t = takeSlot(0, int(currentTick) & (SlotCount - 1));
+        while (t) {
+            QTimerInfo *next = t->wheelNext;
+            Q_ASSERT(t->wheelTick == currentTick);
+            expireTimer(t);
+            t = next;
+        }
+    }
+}
+
 static constexpr timespec roundToMillisecond(timespec val)
 {
     // always round up
@@ -276,12 +473,19 @@ bool QTimerInfoList::timerWait(timespec &tm)
     auto isWaiting = [](QTimerInfo *tinfo) { return !tinfo->activateRef; };
     // Find first waiting timer not already active
     auto it = std::find_if(cbegin(), cend(), isWaiting);
-    if (it == cend())
+    const bool hasWheelTimers = wheel && !wheel->isEmpty();
+    if (it == cend() && !hasWheelTimers)
         return false;
 
-    QTimerInfo *t = *it;
-    if (now < t->timeout) // Time to wait
-        tm = roundToMillisecond(t->timeout - now);
+    timespec timeout = it != cend() ? (*it)->timeout : timespec{};
+    if (hasWheelTimers) {
+        const timespec wheelTimeout = durationToTimespec(milliseconds{wheel->nextEventTick()});
+        if (it == cend() || wheelTimeout < timeout)
+            timeout = wheelTimeout;
+    }
+
+    if (now < timeout) // Time to wait
+        tm = roundToMillisecond(timeout - now);
     else // No time to wait
         tm = {0, 0};
 
@@ -303,14 +507,14 @@ milliseconds QTimerInfoList::remainingDuration(int timerId)
     timespec now = updateCurrentTime();
 
     auto it = findTimerById(timerId);
-    if (it == cend()) {
+    const QTimerInfo *t = it != cend() ? *it : wheel ? wheel->find(timerId) : nullptr;
+    if (!t) {
 #ifndef QT_NO_DEBUG
         qWarning("QTimerInfoList::timerRemainingTime: timer id %i not found", timerId);
 #endif
         return milliseconds{-1};
     }
 
-    const QTimerInfo *t = *it;
     if (now < t->timeout) // time to wait
         return timespecToChronoMs(roundToMillisecond(t->timeout - now));
     else
@@ -370,7 +574,7 @@ void QTimerInfoList::registerTimer(int timerId, milliseconds interval,
             ++t->timeout.tv_sec;
     }
 
-    timerInsert(t);
+    insertTimer(t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -384,25 +588,44 @@ void QTimerInfoList::registerTimer(int timerId, milliseconds interval,
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    auto it = findTimerById(timerId);
-    if (it == cend())
-        return false; // id not found
+    QTimerInfo *t = wheel ? wheel->find(timerId) : nullptr;
+    if (t) {
+        wheel->remove(t);
+    } else {
+        auto it = findTimerById(timerId);
+        if (it == cend())
+            return false; // id not found
+
+        t = *it;
+        erase(it);
+    }
 
     // set timer inactive
-    QTimerInfo *t = *it;
     if (t == firstTimerInfo)
         firstTimerInfo = nullptr;
     if (t->activateRef)
         *(t->activateRef) = nullptr;
     delete t;
-    erase(it);
     return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
-    if (isEmpty())
+    if (isEmpty() && (!wheel || wheel->isEmpty()))
         return false;
+
+    if (wheel) {
+        const QList<QTimerInfo *> timers = wheel->timersForObject(object);
+        for (QTimerInfo *t : timers) {
+            wheel->remove(t);
+            if (t == firstTimerInfo)
+                firstTimerInfo = nullptr;
+            if (t->activateRef)
+                *(t->activateRef) = nullptr;
+            delete t;
+        }
+    }
+
     for (int i = 0; i < size(); ++i) {
         QTimerInfo *t = at(i);
         if (t->obj == object) {
@@ -427,6 +650,11 @@ QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObj
         if (t->obj == object)
             list.emplaceBack(t->id, t->interval.count(), t->timerType);
     }
+    if (wheel) {
+        const QList<QTimerInfo *> timers = wheel->timersForObject(object);
+        for (const QTimerInfo *const t : timers)
+            list.emplaceBack(t->id, t->interval.count(), t->timerType);
+    }
     return list;
 }
 
@@ -435,12 +663,15 @@ QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObj
 */
 int QTimerInfoList::activateTimers()
 {
-    if (qt_disable_lowpriority_timers || isEmpty())
+    if (qt_disable_lowpriority_timers || (isEmpty() && (!wheel || wheel->isEmpty())))
         return 0; // nothing to do
 
     firstTimerInfo = nullptr;
 
     timespec now = updateCurrentTime();
+    // move the coarse timers that are due into the list
+    if (wheel)
+        wheel->advance(tickFloor(now), [this](QTimerInfo *t) { timerInsert(t); });
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << now;
     // Find out how many timer have expired
     auto stillActive = [&now](const QTimerInfo *t) { return now < t->timeout; };
@@ -495,7 +726,7 @@ int QTimerInfoList::activateTimers()
         calculateNextTimeout(currentTimerInfo, now);
 
         // reinsert timer
-        timerInsert(currentTimerInfo);
+        insertTimer(currentTimerInfo);
         if (currentTimerInfo->interval > 0ms)
             n_act++;
 
@@ -22,6 +22,9 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
+
+#include <memory>
 
 #include <sys/time.h> // struct timeval
 
@@ -36,6 +39,12 @@ struct QTimerInfo {
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
 
+    // used while the timer is held by a QTimerWheel
+    qint64 wheelTick; // - timeout in milliseconds, rounded up
+    QTimerInfo **wheelSlot;
+    QTimerInfo *wheelNext;
+    QTimerInfo *wheelPrev;
+
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
     float cumulativeError;
@@ -43,13 +52,62 @@ struct QTimerInfo {
 #endif
 };
 
+// Hierarchical timer wheel with millisecond ticks, holding Qt::CoarseTimer and
+// Qt::VeryCoarseTimer timers until they are due. Four levels of 64 slots cover
+// about 4.6 hours; timers further away are parked in the last level and
+// re-cascaded. Registering and unregistering a timer are O(1).
+class QTimerWheel
+{
+    Q_DISABLE_COPY_MOVE(QTimerWheel)
+public:
+    static constexpr int SlotBits = 6;
+    static constexpr int SlotCount = 1 << SlotBits;
+    static constexpr int LevelCount = 4;
+
+    QTimerWheel();
+    ~QTimerWheel();
+
+    bool isEmpty() const { return timersById.isEmpty(); }
+    qsizetype size() const { return timersById.size(); }
+
+    bool insert(QTimerInfo *t, timespec now);
+    void remove(QTimerInfo *t);
+    QTimerInfo *find(int timerId) const { return timersById.value(timerId); }
+    QList<QTimerInfo *> timers() const { return timersById.values(); }
+    QList<QTimerInfo *> timersForObject(QObject *object) const { return timersByObject.values(object); }
+
+    qint64 nextEventTick() const;
+    template <typename Expire> void advance(qint64 tick, Expire expire);
+
+private:
+    void link(QTimerInfo *t);
+    void unlink(QTimerInfo *t);
+    QTimerInfo *takeSlot(int level, int index);
+
+    qint64 currentTick = 0; // all timers up to and including this tick have expired
+    quint64 occupied[LevelCount] = {};
+    QTimerInfo *wheelSlots[LevelCount][SlotCount] = {};
+    QHash<int, QTimerInfo *> timersById;
+    QMultiHash<QObject *, QTimerInfo *> timersByObject;
+};
+
 class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
 {
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    // coarse timers that are not due yet, if enabled; the list only holds
+    // precise timers and the coarse ones that are about to be activated
+    std::unique_ptr<QTimerWheel> wheel;
+
+    void insertTimer(QTimerInfo *);
+
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
+
+    void setTimerWheelEnabled(bool enable);
+    bool isTimerWheelEnabled() const { return bool(wheel); }
 
     timespec currentTime;
     timespec updateCurrentTime();
@@ -0,0 +1,1146 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcborlazydocument.h"
+
+#include <QtCore/qendian.h>
+#include <QtCore/qfloat16.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qstringconverter_p.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// the same limit as QCborValue::fromCbor()'s
+constexpr int MaximumRecursionDepth = 1024;
+
+// RFC 8949, section 3
+enum MajorType : quint8 {
+    UnsignedIntegerType = 0,
+    NegativeIntegerType = 1,
+    ByteStringType = 2,
+    TextStringType = 3,
+    ArrayType = 4,
+    MapType = 5,
+    TagType = 6,
+    SimpleTypesType = 7
+};
+
+enum AdditionalInformation : quint8 {
+    Value8Bit = 24,
+    Value16Bit = 25,
+    Value32Bit = 26,
+    Value64Bit = 27,
+    IndefiniteLength = 31,
+
+    // for SimpleTypesType
+    HalfPrecisionFloat = Value16Bit,
+    SinglePrecisionFloat = Value32Bit,
+    DoublePrecisionFloat = Value64Bit,
+    Break = IndefiniteLength
+};
+
+} // unnamed namespace
+
+class QCborLazyDocumentPrivate : public QSharedData
+{
+public:
+    // The initial byte of a data item and the argument following it
+    struct Header
+    {
+        qsizetype end;      // of the header: the payload or the next item
+        quint64 value;      // the argument; the bits of floating-point numbers
+        MajorType majorType;
+        quint8 info;
+
+        bool isIndefiniteLength() const noexcept { return info == IndefiniteLength; }
+        bool isBreak() const noexcept
+        { return majorType == SimpleTypesType && info == Break; }
+    };
+
+    QCborError::Code readHeader(qsizetype offset, Header *h) const noexcept;
+    QCborError::Code skipString(const Header &h, qsizetype *offset, bool validateUtf8) const noexcept;
+    qsizetype skip(qsizetype offset, QCborError::Code *error = nullptr,
+                   bool validateUtf8 = false) const noexcept;
+    template <typename Function>
+    bool forEachChunk(qsizetype offset, MajorType majorType, Function f) const;
+    QCborValue::Type type(qsizetype offset) const noexcept;
+
+    const char *data(qsizetype offset) const noexcept { return cbor.constData() + offset; }
+    bool fits(qsizetype offset, quint64 length) const noexcept
+    { return length <= quint64(cbor.size() - offset); }
+
+    QByteArray cbor;
+};
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QCborLazyDocumentPrivate)
+
+using Header = QCborLazyDocumentPrivate::Header;
+
+QCborError::Code QCborLazyDocumentPrivate::readHeader(qsizetype offset, Header *h) const noexcept
+{
+    if (offset >= cbor.size())
+        return QCborError::EndOfFile;
+
+    const uchar initial = uchar(cbor.at(offset));
+    h->majorType = MajorType(initial >> 5);
+    h->info = initial & 0x1f;
+    h->end = offset + 1;
+    h->value = 0;
+
+    if (h->info < Value8Bit) {
+        h->value = h->info;
+    } else if (h->info <= Value64Bit) {
+        const qsizetype n = qsizetype(1) << (h->info - Value8Bit);
+        if (!fits(h->end, n))
+            return QCborError::EndOfFile;
+        const char *p = data(h->end);
+        switch (n) {
+        case 1: h->value = uchar(*p); break;
+        case 2: h->value = qFromBigEndian<quint16>(p); break;
+        case 4: h->value = qFromBigEndian<quint32>(p); break;
+        case 8: h->value = qFromBigEndian<quint64>(p); break;
+        }
+        h->end += n;
+        if (h->majorType == SimpleTypesType && h->info == Value8Bit && h->value < 32)
+            return QCborError::IllegalSimpleType;
+    } else if (h->info == IndefiniteLength) {
+        switch (h->majorType) {
+        case UnsignedIntegerType:
+        case NegativeIntegerType:
+        case TagType:
+            return QCborError::IllegalNumber;
+        default:
+            break;
+        }
+    } else {
+        // 28 to 30 are reserved
+        return QCborError::IllegalNumber;
+    }
+    return QCborError::NoError;
+}
+
+// Advances *offset past the payload of the string whose header is h,
+// including all chunks of an indefinite-length one.
+QCborError::Code QCborLazyDocumentPrivate::skipString(const Header &h, qsizetype *offset,
+                                                      bool validateUtf8) const noexcept
+{
+    const auto skipChunk = [&](const Header &chunk) {
+        if (!fits(chunk.end, chunk.value))
+            return QCborError::EndOfFile;
+        const QByteArrayView bytes(data(chunk.end), qsizetype(chunk.value));
+        if (validateUtf8 && chunk.majorType == TextStringType
+                && !QUtf8::isValidUtf8(bytes).isValidUtf8) {
+            return QCborError::InvalidUtf8String;
+        }
+        *offset = chunk.end + qsizetype(chunk.value);
+        return QCborError::NoError;
+    };
+
+    if (!h.isIndefiniteLength())
+        return skipChunk(h);
+
+    *offset = h.end;
+    while (true) {
+        Header chunk;
+        if (QCborError::Code e = readHeader(*offset, &chunk))
+            return e;
+        if (chunk.isBreak()) {
+            *offset = chunk.end;
+            return QCborError::NoError;
+        }
+        if (chunk.majorType != h.majorType || chunk.isIndefiniteLength())
+            return QCborError::IllegalType;
+        if (QCborError::Code e = skipChunk(chunk))
+            return e;
+    }
+}
+
+// Returns the offset past the data item at offset, or -1 if it is malformed.
+// This only decodes the headers, so it never allocates unless the containers
+// are nested more than 32 deep.
+qsizetype QCborLazyDocumentPrivate::skip(qsizetype offset, QCborError::Code *error,
+                                         bool validateUtf8) const noexcept
+{
+    // The number of items left in each container being skipped. For the
+    // indefinite-length ones, which end at a break, one of:
+    enum : qint64 {
+        IndefiniteArray = -1,
+        IndefiniteMapKey = -2,      // a break may follow
+        IndefiniteMapValue = -3,    // the key of a pair has been read
+    };
+    QVarLengthArray<qint64, 32> enclosing;
+    qint64 left = 1;
+    bool tagged = false;
+
+    QCborError::Code e = QCborError::NoError;
+    while (e == QCborError::NoError) {
+        Header h;
+        if ((e = readHeader(offset, &h)))
+            break;
+        offset = h.end;
+
+        if (h.isBreak()) {
+            if ((left != IndefiniteArray && left != IndefiniteMapKey) || tagged) {
+                e = QCborError::UnexpectedBreak;
+                break;
+            }
+            left = 0;
+        } else if (h.majorType == TagType) {
+            // the tagged item follows and counts as this one
+            tagged = true;
+            continue;
+        } else {
+            if (left > 0)
+                --left;
+            else if (left != IndefiniteArray)
+                left = left == IndefiniteMapKey ? IndefiniteMapValue : IndefiniteMapKey;
+            tagged = false;
+
+            switch (h.majorType) {
+            case ByteStringType:
+            case TextStringType:
+                e = skipString(h, &offset, validateUtf8);
+                break;
+
+            case ArrayType:
+            case MapType:
+                if (enclosing.size() == MaximumRecursionDepth) {
+                    e = QCborError::NestingTooDeep;
+                    break;
+                }
+                // each item takes at least one byte
+                if (!h.isIndefiniteLength() && !fits(offset, h.value)) {
+                    e = QCborError::EndOfFile;
+                    break;
+                }
+                enclosing.append(left);
+                if (h.isIndefiniteLength())
+                    left = h.majorType == MapType ? IndefiniteMapKey : IndefiniteArray;
+                else
+                    left = qint64(h.value) * (h.majorType == MapType ? 2 : 1);
+                break;
+
+            default:
+                break;
+            }
+            if (e != QCborError::NoError)
+                break;
+        }
+
+        while (left == 0) {
+            if (enclosing.isEmpty())
+                return offset;
+            left = enclosing.last();
+            enclosing.removeLast();
+        }
+    }
+
+    if (error)
+        *error = e;
+    return -1;
+}
+
+// Calls f with the contents of the string at offset, once for each chunk.
+// Returns false if it isn't a string of majorType or is malformed.
+template <typename Function>
+bool QCborLazyDocumentPrivate::forEachChunk(qsizetype offset, MajorType majorType,
+                                            Function f) const
+{
+    Header h;
+    if (readHeader(offset, &h) != QCborError::NoError || h.majorType != majorType)
+        return false;
+    if (!h.isIndefiniteLength()) {
+        if (!fits(h.end, h.value))
+            return false;
+        f(QByteArrayView(data(h.end), qsizetype(h.value)));
+        return true;
+    }
+
+    offset = h.end;
+    while (true) {
+        Header chunk;
+        if (readHeader(offset, &chunk) != QCborError::NoError)
+            return false;
+        if (chunk.isBreak())
+            return true;
+        if (chunk.majorType != majorType || chunk.isIndefiniteLength()
+                || !fits(chunk.end, chunk.value)) {
+            return false;
+        }
+        f(QByteArrayView(data(chunk.end), qsizetype(chunk.value)));
+        offset = chunk.end + qsizetype(chunk.value);
+    }
+}
+
+QCborValue::Type QCborLazyDocumentPrivate::type(qsizetype offset) const noexcept
+{
+    Header h;
+    if (readHeader(offset, &h) != QCborError::NoError)
+        return QCborValue::Invalid;
+
+    switch (h.majorType) {
+    case UnsignedIntegerType:
+    case NegativeIntegerType:
+        // as in QCborValue, integers out of the range of qint64 are doubles
+        return qint64(h.value) < 0 ? QCborValue::Double : QCborValue::Integer;
+    case ByteStringType:
+        return QCborValue::ByteArray;
+    case TextStringType:
+        return QCborValue::String;
+    case ArrayType:
+        return QCborValue::Array;
+    case MapType:
+        return QCborValue::Map;
+    case TagType:
+        return QCborValue::Tag;
+    case SimpleTypesType:
+        switch (h.info) {
+        case HalfPrecisionFloat:
+        case SinglePrecisionFloat:
+        case DoublePrecisionFloat:
+            return QCborValue::Double;
+        case Break:
+            return QCborValue::Invalid;
+        }
+        return QCborValue::Type(QCborValue::SimpleType + int(h.value));
+    }
+    Q_UNREACHABLE_RETURN(QCborValue::Invalid);
+}
+
+/*!
+    \class QCborLazyDocument
+    \inmodule QtCore
+    \since 6.7
+    \brief The QCborLazyDocument class reads values from CBOR data in place,
+    without decoding all of it.
+
+    \ingroup cbor
+    \ingroup shared
+    \ingroup qtserialization
+    \reentrant
+
+    QCborValue::fromCbor() decodes a whole CBOR stream up front: it copies
+    every string into the containers it creates and builds the list of
+    elements of every array and map, whether they are read or not.
+    QCborLazyDocument::fromCbor() does no work at all: it keeps a reference to
+    the QByteArray it was given and returns. The values are then read through
+    QCborLazyValue, which decodes them from the data when they are asked for.
+    Strings can be read without copying them, as views into the data.
+
+    Together with QByteArray::fromRawData(), this makes it possible to read a
+    memory-mapped file without copying or decoding any more of it than is
+    needed:
+
+    \snippet code/src_corelib_serialization_qcborlazydocument.cpp 0
+
+    Because nothing is decoded up front, fromCbor() cannot report errors.
+    Malformed data items read as invalid values when they are visited, and
+    iterating over a container stops at the first malformed item in it. Call
+    validate() to check the whole document once, for example when the data
+    comes from an untrusted source.
+
+    A document is read-only. To modify it, convert its values to QCborValue
+    with QCborLazyValue::toCborValue().
+
+    \sa QCborLazyValue, QCborValue, {CBOR Support in Qt}
+*/
+
+/*!
+    Constructs a null document.
+
+    \sa isNull()
+*/
+QCborLazyDocument::QCborLazyDocument() noexcept = default;
+
+/*!
+    Constructs a copy of \a other. Both share the same data.
+*/
+QCborLazyDocument::QCborLazyDocument(const QCborLazyDocument &other) noexcept = default;
+
+/*!
+    \fn QCborLazyDocument::QCborLazyDocument(QCborLazyDocument &&other)
+
+    Move-constructs a document from \a other, which is left null.
+*/
+
+/*!
+    Destroys the document. The QCborLazyValue objects obtained from it must
+    not be used afterwards, unless a copy of the document still exists.
+*/
+QCborLazyDocument::~QCborLazyDocument() = default;
+
+/*!
+    Makes this document a copy of \a other and returns a reference to it.
+*/
+QCborLazyDocument &QCborLazyDocument::operator=(const QCborLazyDocument &other) noexcept = default;
+
+/*!
+    \fn QCborLazyDocument &QCborLazyDocument::operator=(QCborLazyDocument &&other)
+
+    Move-assigns \a other to this document and returns a reference to it.
+*/
+
+/*!
+    \fn void QCborLazyDocument::swap(QCborLazyDocument &other)
+
+    Swaps this document with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Returns a document for reading the first CBOR data item in \a cbor.
+
+    The document refers to \a cbor instead of copying it, and doesn't decode
+    any of it. If \a cbor was created with QByteArray::fromRawData(), its data
+    must outlive the document and all copies of it.
+
+    \sa validate(), QCborValue::fromCbor()
+*/
+QCborLazyDocument QCborLazyDocument::fromCbor(const QByteArray &cbor)
+{
+    QCborLazyDocument result;
+    result.d = new QCborLazyDocumentPrivate;
+    result.d->cbor = cbor;
+    return result;
+}
+
+/*!
+    \fn bool QCborLazyDocument::isNull() const
+
+    Returns \c true if this document is null, that is, if it was
+    default-constructed.
+*/
+
+/*!
+    Decodes the structure of the whole first data item and returns the first
+    error found in it, or QCborError::NoError if it is well-formed. Text
+    strings are checked to be valid UTF-8.
+
+    This walks the entire data item without allocating memory. For a null
+    document, returns QCborError::EndOfFile.
+
+    \sa fromCbor()
+*/
+QCborError QCborLazyDocument::validate() const noexcept
+{
+    QCborError::Code e = QCborError::EndOfFile;
+    if (d && d->skip(0, &e, true) >= 0)
+        e = QCborError::NoError;
+    return { e };
+}
+
+/*!
+    Returns the first data item in the document, or an invalid value if the
+    document is null.
+*/
+QCborLazyValue QCborLazyDocument::root() const noexcept
+{
+    return d ? QCborLazyValue(d.data(), 0) : QCborLazyValue();
+}
+
+/*!
+    \fn QCborLazyValue QCborLazyDocument::operator[](qint64 key) const
+
+    Returns the element at index \a key of the outermost array, or the value
+    for the integer \a key of the outermost map. The same as
+    \c{root()[key]}.
+*/
+
+/*!
+    \fn QCborLazyValue QCborLazyDocument::operator[](QAnyStringView key) const
+
+    Returns the value for the string \a key in the outermost map, the same as
+    \c{root().value(key)}.
+*/
+
+/*!
+    \class QCborLazyValue
+    \inmodule QtCore
+    \since 6.7
+    \brief The QCborLazyValue class refers to a data item in a
+    QCborLazyDocument.
+
+    \ingroup cbor
+    \ingroup qtserialization
+    \reentrant
+
+    A QCborLazyValue is a small handle to a data item in a QCborLazyDocument.
+    Reading it decodes the item from the document's data: type() and the
+    conversion functions decode its header, toStringView() and
+    toByteArrayView() return views into the data, and value(), at() and
+    iteration walk maps and arrays by skipping over the items they don't
+    need. Items that aren't visited are never decoded.
+
+    The functions mirror those of QCborValue, QCborMap and QCborArray and
+    return the same results as they would for the corresponding QCborValue,
+    with these exceptions:
+
+    \list
+    \li Tags are always reported as QCborValue::Tag, including those that
+        QCborValue converts into extended types such as
+        QCborValue::DateTime. toCborValue() does convert them.
+    \li Iterating over a map visits its pairs in the order they appear in the
+        data, including duplicate keys. value() returns the first of
+        duplicates.
+    \li Looking up a missing key or index, or any of them in a value that is
+        not a container, returns an invalid value.
+    \endlist
+
+    Looking up a key or an index walks the map or array from its start. To
+    read many members of a container, iterate over it instead.
+
+    A QCborLazyValue refers to its document without keeping it alive, so it
+    must not be used after the last copy of the QCborLazyDocument it came
+    from is destroyed.
+
+    \sa QCborLazyDocument, QCborValue
+*/
+
+/*!
+    \fn QCborLazyValue::QCborLazyValue()
+
+    Constructs an invalid value.
+*/
+
+/*!
+    Returns the type of this data item, or QCborValue::Invalid if its header
+    is malformed or truncated, or this value doesn't exist.
+
+    Only the header of the item is decoded, so a string or container can be
+    reported even if its contents are malformed.
+
+    \sa QCborValue::type()
+*/
+QCborValue::Type QCborLazyValue::type() const noexcept
+{
+    return d ? d->type(offset) : QCborValue::Invalid;
+}
+
+/*!
+    \fn bool QCborLazyValue::isInteger() const
+
+    Returns \c true if this is an integer in the range of \l qint64.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isByteArray() const
+
+    Returns \c true if this is a byte string.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isString() const
+
+    Returns \c true if this is a text string.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isArray() const
+
+    Returns \c true if this is an array.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isMap() const
+
+    Returns \c true if this is a map.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isTag() const
+
+    Returns \c true if this is a tagged data item.
+
+    \sa tag(), taggedValue()
+*/
+
+/*!
+    \fn bool QCborLazyValue::isFalse() const
+
+    Returns \c true if this is the \c false simple type.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isTrue() const
+
+    Returns \c true if this is the \c true simple type.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isBool() const
+
+    Returns \c true if this is either \c false or \c true.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isNull() const
+
+    Returns \c true if this is the \c null simple type.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isUndefined() const
+
+    Returns \c true if this is the \c undefined simple type.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isDouble() const
+
+    Returns \c true if this is a floating-point number, or an integer out of
+    the range of \l qint64.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isInvalid() const
+
+    Returns \c true if this value doesn't exist or is malformed.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isContainer() const
+
+    Returns \c true if this is an array or a map.
+*/
+
+/*!
+    \fn bool QCborLazyValue::isSimpleType() const
+
+    Returns \c true if this is any simple type, including \c false, \c true,
+    \c null and \c undefined.
+*/
+
+/*!
+    \fn QCborSimpleType QCborLazyValue::toSimpleType(QCborSimpleType defaultValue) const
+
+    Returns the simple type this value is, or \a defaultValue if it isn't a
+    simple type.
+*/
+
+/*!
+    Returns this value as an integer, or \a defaultValue if it isn't a number.
+    Floating-point numbers are truncated.
+
+    \sa QCborValue::toInteger()
+*/
+qint64 QCborLazyValue::toInteger(qint64 defaultValue) const noexcept
+{
+    Header h;
+    if (!d || d->readHeader(offset, &h) != QCborError::NoError)
+        return defaultValue;
+
+    switch (h.majorType) {
+    case UnsignedIntegerType:
+        if (qint64(h.value) >= 0)
+            return qint64(h.value);
+        break;
+    case NegativeIntegerType:
+        if (qint64(h.value) >= 0)
+            return -1 - qint64(h.value);
+        break;
+    case SimpleTypesType:
+        break;
+    default:
+        return defaultValue;
+    }
+
+    // floating-point numbers and integers out of range, as in QCborValue
+    return isDouble() ? qint64(toDouble()) : defaultValue;
+}
+
+/*!
+    Returns \c true if this is \c true, \c false if it is \c false, or
+    \a defaultValue otherwise.
+*/
+bool QCborLazyValue::toBool(bool defaultValue) const noexcept
+{
+    switch (type()) {
+    case QCborValue::False:
+        return false;
+    case QCborValue::True:
+        return true;
+    default:
+        return defaultValue;
+    }
+}
+
+/*!
+    Returns this value as a double, or \a defaultValue if it isn't a number.
+
+    \sa QCborValue::toDouble()
+*/
+double QCborLazyValue::toDouble(double defaultValue) const noexcept
+{
+    Header h;
+    if (!d || d->readHeader(offset, &h) != QCborError::NoError)
+        return defaultValue;
+
+    switch (h.majorType) {
+    case UnsignedIntegerType:
+        return qint64(h.value) < 0 ? double(h.value) : double(qint64(h.value));
+    case NegativeIntegerType:
+        return qint64(h.value) < 0 ? -1 - double(h.value) : double(-1 - qint64(h.value));
+    case SimpleTypesType:
+        switch (h.info) {
+        case HalfPrecisionFloat: {
+            const quint16 bits = quint16(h.value);
+            return double(qFromUnaligned<qfloat16>(&bits));
+        }
+        case SinglePrecisionFloat: {
+            const quint32 bits = quint32(h.value);
+            float f;
+            memcpy(&f, &bits, sizeof(f));
+            return double(f);
+        }
+        case DoublePrecisionFloat: {
+            double f;
+            memcpy(&f, &h.value, sizeof(f));
+            return f;
+        }
+        }
+        break;
+    default:
+        break;
+    }
+    return defaultValue;
+}
+
+/*!
+    Returns the tag number of this tagged item, or \a defaultValue if it
+    isn't tagged.
+
+    \sa taggedValue()
+*/
+QCborTag QCborLazyValue::tag(QCborTag defaultValue) const noexcept
+{
+    Header h;
+    if (!d || d->readHeader(offset, &h) != QCborError::NoError || h.majorType != TagType)
+        return defaultValue;
+    return QCborTag(h.value);
+}
+
+/*!
+    Returns the data item this tag applies to, or an invalid value if this
+    isn't a tagged item.
+
+    \sa tag()
+*/
+QCborLazyValue QCborLazyValue::taggedValue() const noexcept
+{
+    Header h;
+    if (!d || d->readHeader(offset, &h) != QCborError::NoError || h.majorType != TagType)
+        return QCborLazyValue();
+    return QCborLazyValue(d, h.end);
+}
+
+/*!
+    Returns a copy of the contents of this byte string, or \a defaultValue if
+    it isn't a byte string or is malformed. The chunks of an
+    indefinite-length string are joined.
+
+    \sa toByteArrayView()
+*/
+QByteArray QCborLazyValue::toByteArray(const QByteArray &defaultValue) const
+{
+    QByteArray result;
+    if (!d || !d->forEachChunk(offset, ByteStringType,
+                               [&](QByteArrayView chunk) { result.append(chunk); })) {
+        return defaultValue;
+    }
+    if (result.isNull())
+        result = QByteArray("");    // empty, not null
+    return result;
+}
+
+/*!
+    Returns this text string as a QString, or \a defaultValue if it isn't a
+    text string, is malformed or isn't valid UTF-8. The chunks of an
+    indefinite-length string are joined.
+
+    \sa toStringView()
+*/
+QString QCborLazyValue::toString(const QString &defaultValue) const
+{
+    if (!d)
+        return defaultValue;
+
+    // each chunk must be valid UTF-8 by itself, as in QCborValue
+    bool valid = true;
+    QByteArray joined;
+    const auto append = [&](QByteArrayView chunk) {
+        valid = valid && QUtf8::isValidUtf8(chunk).isValidUtf8;
+        joined.append(chunk);
+    };
+
+    // the contents of a definite-length string are converted directly
+    QUtf8StringView view = toStringView();
+    if (!view.isNull())
+        valid = QUtf8::isValidUtf8(QByteArrayView(view.data(), view.size())).isValidUtf8;
+    else if (d->forEachChunk(offset, TextStringType, append))
+        view = QUtf8StringView(joined.constData(), joined.size());
+    else
+        valid = false;
+
+    if (!valid)
+        return defaultValue;
+    QString result = QString::fromUtf8(view);
+    if (result.isNull())
+        result = QString::fromLatin1("");     // empty, not null
+    return result;
+}
+
+/*!
+    Returns a view of the contents of this byte string in the document's data,
+    or a null view if it isn't a definite-length byte string or is truncated.
+
+    Use toByteArray() to read indefinite-length (chunked) strings.
+
+    \sa toByteArray()
+*/
+QByteArrayView QCborLazyValue::toByteArrayView() const noexcept
+{
+    Header h;
+    if (!d || d->readHeader(offset, &h) != QCborError::NoError
+            || h.majorType != ByteStringType || h.isIndefiniteLength()
+            || !d->fits(h.end, h.value)) {
+        return QByteArrayView();
+    }
+    return QByteArrayView(d->data(h.end), qsizetype(h.value));
+}
+
+/*!
+    Returns a view of the contents of this text string in the document's data,
+    or a null view if it isn't a definite-length text string or is truncated.
+
+    The contents are not checked to be valid UTF-8; toString() and
+    QCborLazyDocument::validate() do that. Use toString() to read
+    indefinite-length (chunked) strings.
+
+    \sa toString()
+*/
+QUtf8StringView QCborLazyValue::toStringView() const noexcept
+{
+    Header h;
+    if (!d || d->readHeader(offset, &h) != QCborError::NoError
+            || h.majorType != TextStringType || h.isIndefiniteLength()
+            || !d->fits(h.end, h.value)) {
+        return QUtf8StringView();
+    }
+    return QUtf8StringView(d->data(h.end), qsizetype(h.value));
+}
+
+/*!
+    Decodes this data item completely and returns it as a QCborValue, or an
+    invalid value if it, or any item it contains, is malformed.
+
+    Unlike the other functions of this class, this converts tags to the
+    extended types of QCborValue, such as QCborValue::DateTime.
+
+    \sa QCborValue::fromCbor()
+*/
+QCborValue QCborLazyValue::toCborValue() const
+{
+    const QByteArrayView cbor = rawCbor();
+    if (cbor.isEmpty())
+        return QCborValue(QCborValue::Invalid);
+
+    QCborParserError error;
+    QCborValue result =
+            QCborValue::fromCbor(QByteArray::fromRawData(cbor.data(), cbor.size()), &error);
+    if (error.error != QCborError::NoError)
+        return QCborValue(QCborValue::Invalid);
+    return result;
+}
+
+/*!
+    Returns the encoded bytes of this data item in the document, including
+    the contents of containers and tagged items, or an empty view if it is
+    malformed.
+
+    This walks the whole data item. The view points into the document's data,
+    so it stays valid as long as the document does.
+*/
+QByteArrayView QCborLazyValue::rawCbor() const noexcept
+{
+    const qsizetype end = d ? d->skip(offset) : -1;
+    if (end < 0)
+        return QByteArrayView();
+    return QByteArrayView(d->data(offset), end - offset);
+}
+
+/*!
+    Returns the number of elements of this array or pairs of this map, or 0
+    if this value is neither.
+
+    For definite-length containers, that is read from the header. Containers
+    of indefinite length are walked.
+*/
+qsizetype QCborLazyValue::size() const noexcept
+{
+    Header h;
+    if (!d || d->readHeader(offset, &h) != QCborError::NoError
+            || (h.majorType != ArrayType && h.majorType != MapType)) {
+        return 0;
+    }
+    // each item takes at least one byte, so the count of a valid one fits
+    if (!h.isIndefiniteLength())
+        return d->fits(h.end, h.value) ? qsizetype(h.value) : 0;
+
+    qsizetype n = 0;
+    for (auto it = begin(), e = end(); it != e; ++it)
+        ++n;
+    return n;
+}
+
+template <typename Predicate>
+QCborLazyValue QCborLazyValue::findValue(Predicate keyMatches) const
+{
+    if (!isMap())
+        return QCborLazyValue();
+    for (auto it = begin(), e = end(); it != e; ++it) {
+        if (keyMatches(it.key()))
+            return it.value();
+    }
+    return QCborLazyValue();
+}
+
+/*!
+    Returns \c true if this is a map containing the integer \a key.
+
+    \sa value()
+*/
+bool QCborLazyValue::contains(qint64 key) const noexcept
+{
+    return !value(key).isInvalid();
+}
+
+/*!
+    \overload
+
+    Returns \c true if this is a map containing the string \a key.
+*/
+bool QCborLazyValue::contains(QAnyStringView key) const
+{
+    return !value(key).isInvalid();
+}
+
+/*!
+    Returns the value for the integer \a key in this map, or an invalid value
+    if this isn't a map or doesn't contain \a key.
+
+    \sa operator[](), contains(), QCborMap::value()
+*/
+QCborLazyValue QCborLazyValue::value(qint64 key) const noexcept
+{
+    return findValue([key](QCborLazyValue k) {
+        return k.isInteger() && k.toInteger() == key;
+    });
+}
+
+/*!
+    \overload
+
+    Returns the value for the string \a key in this map, or an invalid value
+    if this isn't a map or doesn't contain \a key.
+
+    Definite-length keys are compared in place, without decoding them.
+*/
+QCborLazyValue QCborLazyValue::value(QAnyStringView key) const
+{
+    return findValue([key](QCborLazyValue k) {
+        if (!k.isString())
+            return false;
+        const QUtf8StringView view = k.toStringView();
+        if (!view.isNull())
+            return QAnyStringView::equal(view, key);
+        const QString decoded = k.toString();
+        return !decoded.isNull() && QAnyStringView::equal(decoded, key);
+    });
+}
+
+/*!
+    Returns the element at index \a i in this array, or an invalid value if
+    this isn't an array or \a i is out of bounds.
+
+    \sa operator[](), QCborArray::at()
+*/
+QCborLazyValue QCborLazyValue::at(qsizetype i) const noexcept
+{
+    if (i < 0 || !isArray())
+        return QCborLazyValue();
+    for (auto it = begin(), e = end(); it != e; ++it) {
+        if (i-- == 0)
+            return it.value();
+    }
+    return QCborLazyValue();
+}
+
+/*!
+    If this is an array, returns the element at index \a key, the same as
+    at(). Otherwise, returns the value for the integer \a key in this map, the
+    same as value().
+*/
+QCborLazyValue QCborLazyValue::operator[](qint64 key) const noexcept
+{
+    return isArray() ? at(key) : value(key);
+}
+
+/*!
+    \fn QCborLazyValue QCborLazyValue::operator[](QAnyStringView key) const
+
+    Returns the value for the string \a key in this map, the same as value().
+*/
+
+/*!
+    Returns an iterator to the first element of this array or pair of this
+    map. If this value is neither, it is equal to end().
+
+    \sa end(), size()
+*/
+QCborLazyValue::const_iterator QCborLazyValue::begin() const noexcept
+{
+    Header h;
+    if (!d || d->readHeader(offset, &h) != QCborError::NoError
+            || (h.majorType != ArrayType && h.majorType != MapType)) {
+        return const_iterator();
+    }
+    return const_iterator(d, h.end, h.isIndefiniteLength() ? -1 : qint64(h.value),
+                          h.majorType == MapType);
+}
+
+/*!
+    Returns an iterator past the last element of this array or pair of this
+    map.
+
+    \sa begin()
+*/
+QCborLazyValue::const_iterator QCborLazyValue::end() const noexcept
+{
+    if (!isContainer())
+        return const_iterator();
+    return const_iterator(d, -1, 0, isMap());
+}
+
+/*!
+    \fn QCborLazyValue::const_iterator QCborLazyValue::constBegin() const
+
+    The same as begin().
+*/
+
+/*!
+    \fn QCborLazyValue::const_iterator QCborLazyValue::constEnd() const
+
+    The same as end().
+*/
+
+/*!
+    \class QCborLazyValue::const_iterator
+    \inmodule QtCore
+    \since 6.7
+    \brief The QCborLazyValue::const_iterator class iterates over the elements
+    of an array or the pairs of a map in a QCborLazyDocument.
+
+    Pairs of maps are visited in the order they appear in the data. Iteration
+    stops at the first malformed element or key.
+*/
+
+/*!
+    \typedef QCborLazyValue::ConstIterator
+
+    Qt-style synonym for QCborLazyValue::const_iterator.
+*/
+
+/*!
+    \fn QCborLazyValue::const_iterator::const_iterator()
+
+    Constructs an invalid iterator.
+*/
+
+QCborLazyValue::const_iterator::const_iterator(const QCborLazyDocumentPrivate *d,
+                                               qsizetype offset, qint64 remaining,
+                                               bool inMap) noexcept
+    : d(d), offset(offset), remaining(remaining), inMap(inMap)
+{
+    if (offset >= 0)
+        settle();
+}
+
+// Ends the iteration if there are no more items, and finds the value of the
+// current pair.
+void QCborLazyValue::const_iterator::settle() noexcept
+{
+    if (remaining == -1) {
+        Header h;
+        if (d->readHeader(offset, &h) != QCborError::NoError || h.isBreak())
+            offset = -1;
+    } else if (remaining == 0) {
+        offset = -1;
+    }
+    if (offset < 0)
+        return;
+
+    valueOffset = inMap ? d->skip(offset) : offset;
+    if (valueOffset < 0)
+        offset = -1;
+}
+
+/*!
+    Returns the current element, or the value of the current pair.
+*/
+QCborLazyValue QCborLazyValue::const_iterator::value() const noexcept
+{
+    return QCborLazyValue(d, valueOffset);
+}
+
+/*!
+    \fn QCborLazyValue QCborLazyValue::const_iterator::operator*() const
+
+    Returns the current element or value, the same as value().
+*/
+
+/*!
+    Returns the key of the current pair when iterating over a map, or an
+    invalid value when iterating over an array.
+*/
+QCborLazyValue QCborLazyValue::const_iterator::key() const noexcept
+{
+    return inMap ? QCborLazyValue(d, offset) : QCborLazyValue();
+}
+
+/*!
+    Advances the iterator to the next element or pair and returns it.
+*/
+QCborLazyValue::const_iterator &QCborLazyValue::const_iterator::operator++() noexcept
+{
+    offset = d->skip(valueOffset);
+    if (remaining > 0)
+        --remaining;
+    if (offset >= 0)
+        settle();
+    return *this;
+}
+
+/*!
+    \fn QCborLazyValue::const_iterator QCborLazyValue::const_iterator::operator++(int)
+
+    Advances the iterator to the next element or pair and returns its previous
+    value.
+*/
+
+/*!
+    \fn bool QCborLazyValue::const_iterator::operator==(const const_iterator &lhs, const const_iterator &rhs)
+
+    Returns \c true if \a lhs and \a rhs point to the same element.
+*/
+
+/*!
+    \fn bool QCborLazyValue::const_iterator::operator!=(const const_iterator &lhs, const const_iterator &rhs)
+
+    Returns \c true if \a lhs and \a rhs point to different elements.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,162 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCBORLAZYDOCUMENT_H
+#define QCBORLAZYDOCUMENT_H
+
+#include <QtCore/qanystringview.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qutf8stringview.h>
+
+#include <iterator>
+
+QT_REQUIRE_CONFIG(cborstreamreader);
+
+QT_BEGIN_NAMESPACE
+
+class QCborLazyDocumentPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QCborLazyDocumentPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QCborLazyValue
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qsizetype;
+        using value_type = QCborLazyValue;
+        using pointer = const QCborLazyValue *;
+        using reference = QCborLazyValue;
+
+        constexpr const_iterator() noexcept = default;
+
+        QCborLazyValue value() const noexcept;
+        QCborLazyValue operator*() const noexcept { return value(); }
+        QCborLazyValue key() const noexcept;
+
+        const_iterator &operator++() noexcept;
+        const_iterator operator++(int) noexcept { const_iterator r = *this; ++*this; return r; }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) noexcept
+        { return lhs.d == rhs.d && lhs.offset == rhs.offset; }
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) noexcept
+        { return !(lhs == rhs); }
+
+    private:
+        friend class QCborLazyValue;
+        const_iterator(const QCborLazyDocumentPrivate *d, qsizetype offset,
+                       qint64 remaining, bool inMap) noexcept;
+        void settle() noexcept;
+
+        const QCborLazyDocumentPrivate *d = nullptr;
+        qsizetype offset = -1;          // of the element or key; -1 at the end
+        qsizetype valueOffset = -1;     // of the element or value
+        qint64 remaining = 0;           // elements left, or -1 if indefinite-length
+        bool inMap = false;
+    };
+    using ConstIterator = const_iterator;
+
+    constexpr QCborLazyValue() noexcept = default;
+
+    QCborValue::Type type() const noexcept;
+    bool isInteger() const noexcept { return type() == QCborValue::Integer; }
+    bool isByteArray() const noexcept { return type() == QCborValue::ByteArray; }
+    bool isString() const noexcept { return type() == QCborValue::String; }
+    bool isArray() const noexcept { return type() == QCborValue::Array; }
+    bool isMap() const noexcept { return type() == QCborValue::Map; }
+    bool isTag() const noexcept { return type() == QCborValue::Tag; }
+    bool isFalse() const noexcept { return type() == QCborValue::False; }
+    bool isTrue() const noexcept { return type() == QCborValue::True; }
+    bool isBool() const noexcept { return isFalse() || isTrue(); }
+    bool isNull() const noexcept { return type() == QCborValue::Null; }
+    bool isUndefined() const noexcept { return type() == QCborValue::Undefined; }
+    bool isDouble() const noexcept { return type() == QCborValue::Double; }
+    bool isInvalid() const noexcept { return type() == QCborValue::Invalid; }
+    bool isContainer() const noexcept { return isMap() || isArray(); }
+    bool isSimpleType() const noexcept
+    {
+        return int(type()) >> 8 == int(QCborValue::SimpleType) >> 8;
+    }
+
+    QCborSimpleType toSimpleType(QCborSimpleType defaultValue = QCborSimpleType::Undefined) const noexcept
+    {
+        return isSimpleType() ? QCborSimpleType(type() & 0xff) : defaultValue;
+    }
+
+    qint64 toInteger(qint64 defaultValue = 0) const noexcept;
+    bool toBool(bool defaultValue = false) const noexcept;
+    double toDouble(double defaultValue = 0) const noexcept;
+
+    QCborTag tag(QCborTag defaultValue = QCborTag(-1)) const noexcept;
+    QCborLazyValue taggedValue() const noexcept;
+
+    QByteArray toByteArray(const QByteArray &defaultValue = {}) const;
+    QString toString(const QString &defaultValue = {}) const;
+    QByteArrayView toByteArrayView() const noexcept;
+    QUtf8StringView toStringView() const noexcept;
+
+    QCborValue toCborValue() const;
+    QByteArrayView rawCbor() const noexcept;
+
+    qsizetype size() const noexcept;
+    bool contains(qint64 key) const noexcept;
+    bool contains(QAnyStringView key) const;
+    QCborLazyValue value(qint64 key) const noexcept;
+    QCborLazyValue value(QAnyStringView key) const;
+    QCborLazyValue at(qsizetype i) const noexcept;
+    QCborLazyValue operator[](qint64 key) const noexcept;
+    QCborLazyValue operator[](QAnyStringView key) const { return value(key); }
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator constBegin() const noexcept { return begin(); }
+    const_iterator constEnd() const noexcept { return end(); }
+
+private:
+    friend class QCborLazyDocument;
+    constexpr QCborLazyValue(const QCborLazyDocumentPrivate *d, qsizetype offset) noexcept
+        : d(d), offset(offset)
+    {}
+
+    template <typename Predicate> QCborLazyValue findValue(Predicate keyMatches) const;
+
+    const QCborLazyDocumentPrivate *d = nullptr;
+    qsizetype offset = 0;
+};
+
+Q_DECLARE_TYPEINFO(QCborLazyValue, Q_RELOCATABLE_TYPE);
+
+class Q_CORE_EXPORT QCborLazyDocument
+{
+public:
+    QCborLazyDocument() noexcept;
+    QCborLazyDocument(const QCborLazyDocument &other) noexcept;
+    QCborLazyDocument(QCborLazyDocument &&other) noexcept = default;
+    ~QCborLazyDocument();
+    QCborLazyDocument &operator=(const QCborLazyDocument &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QCborLazyDocument)
+
+    void swap(QCborLazyDocument &other) noexcept { d.swap(other.d); }
+
+    static QCborLazyDocument fromCbor(const QByteArray &cbor);
+
+    bool isNull() const noexcept { return !d; }
+    QCborError validate() const noexcept;
+
+    QCborLazyValue root() const noexcept;
+    QCborLazyValue operator[](qint64 key) const noexcept { return root()[key]; }
+    QCborLazyValue operator[](QAnyStringView key) const { return root().value(key); }
+
+private:
+    QExplicitlySharedDataPointer<QCborLazyDocumentPrivate> d;
+};
+
+Q_DECLARE_SHARED(QCborLazyDocument)
+
+QT_END_NAMESPACE
+
+#endif // QCBORLAZYDOCUMENT_H
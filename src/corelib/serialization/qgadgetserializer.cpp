@@ -0,0 +1,857 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgadgetserializer.h"
+
+#include <QtCore/qassociativeiterable.h>
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qmetaobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qsequentialiterable.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/private/qmetaobject_p.h>
+#include <QtCore/private/qnumeric_p.h>
+
+#if QT_CONFIG(cborstreamreader)
+#include <QtCore/qcborstreamreader.h>
+#endif
+#if QT_CONFIG(cborstreamwriter)
+#include <QtCore/qcborstreamwriter.h>
+#endif
+
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+struct Codec;
+}
+
+class QGadgetSerializerPrivate
+{
+public:
+    struct Field
+    {
+        QMetaProperty property;
+        QMetaType metaType;
+        QLatin1StringView name;
+        // the function reading and writing the property without a QVariant,
+        // or null if there is none
+        QMetaObject::Data::StaticMetacallFunction metacall = nullptr;
+        int index = 0;          // the property index metacall expects
+        const Codec *codec = nullptr;
+        const QGadgetSerializerPrivate *nested = nullptr;   // for gadget-typed properties
+    };
+
+    QList<Field> fields;
+};
+
+namespace {
+
+using Field = QGadgetSerializerPrivate::Field;
+
+/*
+    The property accessors generated by moc. ReadProperty either copies the
+    value into *argv[0] or, if the READ function returns a reference or a
+    pointer, replaces argv[0] with its address, so the value must be read
+    from the returned pointer.
+*/
+const void *readField(const Field &f, void *object, void *storage)
+{
+    int status = -1;
+    void *argv[] = { storage, nullptr, &status };
+    f.metacall(static_cast<QObject *>(object), QMetaObject::ReadProperty, f.index, argv);
+    return argv[0];
+}
+
+void writeField(const Field &f, void *object, void *value)
+{
+    int status = -1;
+    int flags = 0;
+    void *argv[] = { value, nullptr, &status, &flags };
+    f.metacall(static_cast<QObject *>(object), QMetaObject::WriteProperty, f.index, argv);
+}
+
+// The functions converting one property of an object. There is one set for
+// each of the common property types, which reads and writes the property
+// directly as that type, one for properties whose type is a gadget, and one
+// for all other types, which goes through QVariant.
+struct Codec
+{
+#ifndef QT_NO_DATASTREAM
+    void (*save)(const Field &f, void *object, QDataStream &stream);
+    void (*load)(const Field &f, void *object, QDataStream &stream);
+#endif
+#if QT_CONFIG(cborstreamwriter)
+    void (*toCbor)(const Field &f, void *object, QCborStreamWriter &writer);
+#endif
+#if QT_CONFIG(cborstreamreader)
+    void (*fromCbor)(const Field &f, void *object, QCborStreamReader &reader);
+#endif
+    QJsonValue (*toJson)(const Field &f, void *object);
+    void (*fromJson)(const Field &f, void *object, const QJsonValue &value);
+};
+
+template <typename Impl> constexpr Codec makeCodec()
+{
+    Codec c = {};
+#ifndef QT_NO_DATASTREAM
+    c.save = &Impl::save;
+    c.load = &Impl::load;
+#endif
+#if QT_CONFIG(cborstreamwriter)
+    c.toCbor = &Impl::toCbor;
+#endif
+#if QT_CONFIG(cborstreamreader)
+    c.fromCbor = &Impl::fromCbor;
+#endif
+    c.toJson = &Impl::toJson;
+    c.fromJson = &Impl::fromJson;
+    return c;
+}
+
+template <typename Impl> constexpr Codec codec = makeCodec<Impl>();
+
+#if QT_CONFIG(cborstreamreader)
+// Reads the current item and advances past it. Returns false if it isn't of
+// the requested type, which leaves *value unchanged.
+bool readCborValue(QCborStreamReader &reader, bool *value)
+{
+    if (!reader.isBool()) {
+        reader.next();
+        return false;
+    }
+    *value = reader.toBool();
+    return reader.next();
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, bool> readCborValue(QCborStreamReader &reader, T *value)
+{
+    if (reader.isUnsignedInteger()) {
+        *value = T(reader.toUnsignedInteger());
+    } else if (reader.isNegativeInteger()) {
+        *value = T(reader.toInteger());
+    } else if (!std::is_floating_point_v<T>) {
+        reader.next();
+        return false;
+    } else if (reader.isFloat16()) {
+        *value = T(reader.toFloat16());
+    } else if (reader.isFloat()) {
+        *value = T(reader.toFloat());
+    } else if (reader.isDouble()) {
+        *value = T(reader.toDouble());
+    } else {
+        reader.next();
+        return false;
+    }
+    return reader.next();
+}
+
+template <typename String>
+bool readCborString(QCborStreamReader &reader, String *value,
+                    QCborStreamReader::StringResult<String> (QCborStreamReader::*readChunk)())
+{
+    String result;
+    auto r = (reader.*readChunk)();
+    while (r.status == QCborStreamReader::Ok) {
+        result += r.data;
+        r = (reader.*readChunk)();
+    }
+    if (r.status == QCborStreamReader::Error)
+        return false;
+    *value = std::move(result);
+    return true;
+}
+
+bool readCborValue(QCborStreamReader &reader, QString *value)
+{
+    if (!reader.isString()) {
+        reader.next();
+        return false;
+    }
+    return readCborString(reader, value, &QCborStreamReader::readString);
+}
+
+bool readCborValue(QCborStreamReader &reader, QByteArray *value)
+{
+    if (!reader.isByteArray()) {
+        reader.next();
+        return false;
+    }
+    return readCborString(reader, value, &QCborStreamReader::readByteArray);
+}
+// Reads a text string without converting it from UTF-8
+bool readCborKey(QCborStreamReader &reader, QVarLengthArray<char, 64> &key)
+{
+    key.clear();
+    QCborStreamReader::StringResult<qsizetype> r;
+    do {
+        const qsizetype size = reader.currentStringChunkSize();
+        if (size < 0)
+            return false;
+        const qsizetype oldSize = key.size();
+        key.resize(oldSize + size);
+        r = reader.readStringChunk(key.data() + oldSize, size);
+    } while (r.status == QCborStreamReader::Ok);
+    return r.status == QCborStreamReader::EndOfString;
+}
+#endif // QT_CONFIG(cborstreamreader)
+
+#if QT_CONFIG(cborstreamwriter)
+void appendCbor(QCborStreamWriter &writer, bool value) { writer.append(value); }
+void appendCbor(QCborStreamWriter &writer, int value) { writer.append(qint64(value)); }
+void appendCbor(QCborStreamWriter &writer, uint value) { writer.append(quint64(value)); }
+void appendCbor(QCborStreamWriter &writer, qint64 value) { writer.append(value); }
+void appendCbor(QCborStreamWriter &writer, quint64 value) { writer.append(value); }
+void appendCbor(QCborStreamWriter &writer, float value) { writer.append(double(value)); }
+void appendCbor(QCborStreamWriter &writer, double value) { writer.append(value); }
+void appendCbor(QCborStreamWriter &writer, const QString &value) { writer.append(value); }
+void appendCbor(QCborStreamWriter &writer, const QByteArray &value) { writer.append(value); }
+#endif
+
+// the same conversions as QJsonValue::fromVariant(), except for byte arrays,
+// which are base64url-encoded as in QCborValue::toJsonValue()
+QJsonValue toJsonValue(bool value) { return value; }
+QJsonValue toJsonValue(int value) { return value; }
+QJsonValue toJsonValue(uint value) { return qint64(value); }
+QJsonValue toJsonValue(qint64 value) { return value; }
+QJsonValue toJsonValue(quint64 value)
+{
+    if (qint64(value) >= 0)
+        return qint64(value);
+    return double(value);
+}
+QJsonValue toJsonValue(double value)
+{
+    return qt_is_finite(value) ? QJsonValue(value) : QJsonValue();
+}
+QJsonValue toJsonValue(float value) { return toJsonValue(double(value)); }
+QJsonValue toJsonValue(const QString &value) { return value; }
+QJsonValue toJsonValue(const QByteArray &value)
+{
+    return QString::fromLatin1(value.toBase64(QByteArray::Base64UrlEncoding
+                                              | QByteArray::OmitTrailingEquals));
+}
+
+// Returns false if the value isn't of the requested type, leaving *value
+// unchanged.
+bool fromJsonValue(const QJsonValue &json, bool *value)
+{
+    if (!json.isBool())
+        return false;
+    *value = json.toBool();
+    return true;
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, bool> fromJsonValue(const QJsonValue &json, T *value)
+{
+    if (!json.isDouble())
+        return false;
+    if constexpr (std::is_floating_point_v<T>) {
+        *value = T(json.toDouble());
+    } else {
+        // only integral numbers; toInteger() returns 0 for the others
+        const qint64 i = json.toInteger();
+        if (i == 0 && json.toDouble() != 0)
+            return false;
+        *value = T(i);
+    }
+    return true;
+}
+
+bool fromJsonValue(const QJsonValue &json, QString *value)
+{
+    if (!json.isString())
+        return false;
+    *value = json.toString();
+    return true;
+}
+
+bool fromJsonValue(const QJsonValue &json, QByteArray *value)
+{
+    if (!json.isString())
+        return false;
+    *value = QByteArray::fromBase64(json.toString().toLatin1(), QByteArray::Base64UrlEncoding);
+    return true;
+}
+
+// Properties of the common types, read into and written from a T
+template <typename T> struct TypedCodec
+{
+    static T read(const Field &f, void *object)
+    {
+        T storage{};
+        return *static_cast<const T *>(readField(f, object, &storage));
+    }
+
+#ifndef QT_NO_DATASTREAM
+    static void save(const Field &f, void *object, QDataStream &stream)
+    {
+        stream << read(f, object);
+    }
+    static void load(const Field &f, void *object, QDataStream &stream)
+    {
+        T value{};
+        stream >> value;
+        if (stream.status() == QDataStream::Ok)
+            writeField(f, object, &value);
+    }
+#endif
+#if QT_CONFIG(cborstreamwriter)
+    static void toCbor(const Field &f, void *object, QCborStreamWriter &writer)
+    {
+        appendCbor(writer, read(f, object));
+    }
+#endif
+#if QT_CONFIG(cborstreamreader)
+    static void fromCbor(const Field &f, void *object, QCborStreamReader &reader)
+    {
+        T value{};
+        if (readCborValue(reader, &value))
+            writeField(f, object, &value);
+    }
+#endif
+    static QJsonValue toJson(const Field &f, void *object)
+    {
+        return toJsonValue(read(f, object));
+    }
+    static void fromJson(const Field &f, void *object, const QJsonValue &json)
+    {
+        T value{};
+        if (fromJsonValue(json, &value))
+            writeField(f, object, &value);
+    }
+};
+
+// A value of a type only known at run time, on the stack if it is small
+class FieldStorage
+{
+    Q_DISABLE_COPY_MOVE(FieldStorage)
+public:
+    explicit FieldStorage(QMetaType type)
+        : type(type)
+    {
+        if (type.sizeOf() <= qsizetype(sizeof(buffer))
+                && type.alignOf() <= qsizetype(alignof(std::max_align_t))) {
+            storage = type.construct(buffer);
+        } else {
+            storage = type.create();
+        }
+    }
+    ~FieldStorage()
+    {
+        if (storage == static_cast<void *>(buffer))
+            type.destruct(storage);
+        else
+            type.destroy(storage);
+    }
+
+    // Reads the property into the storage, copying it if the READ function
+    // returned a reference.
+    void *read(const Field &f, void *object)
+    {
+        const void *value = readField(f, object, storage);
+        if (value != storage) {
+            type.destruct(storage);
+            type.construct(storage, value);
+        }
+        return storage;
+    }
+
+private:
+    QMetaType type;
+    void *storage;
+    alignas(std::max_align_t) char buffer[128];
+};
+
+// Properties whose type is a gadget: the gadget is converted field by field
+struct GadgetCodec
+{
+#ifndef QT_NO_DATASTREAM
+    static void save(const Field &f, void *object, QDataStream &stream)
+    {
+        FieldStorage value(f.metaType);
+        void *gadget = value.read(f, object);
+        for (const Field &nested : f.nested->fields) {
+            nested.codec->save(nested, gadget, stream);
+            if (stream.status() != QDataStream::Ok)
+                return;
+        }
+    }
+    static void load(const Field &f, void *object, QDataStream &stream)
+    {
+        FieldStorage value(f.metaType);
+        void *gadget = value.read(f, object);
+        for (const Field &nested : f.nested->fields) {
+            nested.codec->load(nested, gadget, stream);
+            if (stream.status() != QDataStream::Ok)
+                return;
+        }
+        writeField(f, object, gadget);
+    }
+#endif
+#if QT_CONFIG(cborstreamwriter)
+    static void toCbor(const Field &f, void *object, QCborStreamWriter &writer);
+#endif
+#if QT_CONFIG(cborstreamreader)
+    static void fromCbor(const Field &f, void *object, QCborStreamReader &reader);
+#endif
+    static QJsonValue toJson(const Field &f, void *object);
+    static void fromJson(const Field &f, void *object, const QJsonValue &json);
+};
+
+// QCborValue::fromVariant() and QJsonValue::fromVariant() only know about
+// QVariantList and QVariantMap, so other containers are converted to those
+QVariant toGenericContainer(QVariant &&value)
+{
+    if (value.metaType().id() < QMetaType::User)
+        return std::move(value);
+    if (value.canConvert<QVariantList>())
+        return value.toList();
+    if (value.canConvert<QVariantMap>())
+        return value.toMap();
+    return std::move(value);
+}
+
+// the reverse of toGenericContainer(), which QVariant::convert() can't do
+QVariant fromGenericContainer(QVariant &&value, QMetaType type)
+{
+    if (type.id() < QMetaType::User)
+        return std::move(value);
+
+    const QMetaType valueType = value.metaType();
+    if (valueType == QMetaType::fromType<QVariantList>()
+            && QMetaType::canView(type, QMetaType::fromType<QSequentialIterable>())) {
+        QVariant result(type);
+        QSequentialIterable container;
+        QMetaType::view(type, result.data(), QMetaType::fromType<QSequentialIterable>(),
+                        &container);
+        const QVariantList &list = *static_cast<const QVariantList *>(value.constData());
+        for (const QVariant &element : list)
+            container.addValue(element);
+        return result;
+    }
+    if (valueType == QMetaType::fromType<QVariantMap>()
+            && QMetaType::canView(type, QMetaType::fromType<QAssociativeIterable>())) {
+        QVariant result(type);
+        QAssociativeIterable container;
+        QMetaType::view(type, result.data(), QMetaType::fromType<QAssociativeIterable>(),
+                        &container);
+        const QVariantMap &map = *static_cast<const QVariantMap *>(value.constData());
+        for (auto it = map.cbegin(); it != map.cend(); ++it)
+            container.setValue(it.key(), it.value());
+        return result;
+    }
+    return std::move(value);
+}
+
+// All other properties, through QVariant
+struct VariantCodec
+{
+    static QVariant read(const Field &f, void *object)
+    {
+        if (!f.metacall)
+            return f.property.read(static_cast<QObject *>(object));
+        QVariant storage(f.metaType);
+        const void *value = readField(f, object, storage.data());
+        if (value != storage.constData())
+            return QVariant(f.metaType, value);      // a reference or a pointer
+        return storage;
+    }
+    static void write(const Field &f, void *object, QVariant &&value)
+    {
+        value = fromGenericContainer(std::move(value), f.metaType);
+        if (!f.metacall)
+            f.property.write(static_cast<QObject *>(object), std::move(value));
+        else if (value.convert(f.metaType))
+            writeField(f, object, value.data());
+    }
+
+#ifndef QT_NO_DATASTREAM
+    static void save(const Field &f, void *object, QDataStream &stream)
+    {
+        if (!f.metaType.save(stream, read(f, object).constData()))
+            stream.setStatus(QDataStream::WriteFailed);
+    }
+    static void load(const Field &f, void *object, QDataStream &stream)
+    {
+        QVariant value(f.metaType);
+        if (!f.metaType.load(stream, value.data()))
+            stream.setStatus(QDataStream::ReadCorruptData);
+        else if (stream.status() == QDataStream::Ok)
+            write(f, object, std::move(value));
+    }
+#endif
+#if QT_CONFIG(cborstreamwriter)
+    static void toCbor(const Field &f, void *object, QCborStreamWriter &writer)
+    {
+        QCborValue::fromVariant(toGenericContainer(read(f, object))).toCbor(writer);
+    }
+#endif
+#if QT_CONFIG(cborstreamreader)
+    static void fromCbor(const Field &f, void *object, QCborStreamReader &reader)
+    {
+        const QCborValue value = QCborValue::fromCbor(reader);
+        if (reader.lastError() == QCborError::NoError)
+            write(f, object, value.toVariant());
+    }
+#endif
+    static QJsonValue toJson(const Field &f, void *object)
+    {
+        return QJsonValue::fromVariant(toGenericContainer(read(f, object)));
+    }
+    static void fromJson(const Field &f, void *object, const QJsonValue &json)
+    {
+        write(f, object, json.toVariant());
+    }
+};
+
+const Codec *codecFor(const Field &f)
+{
+    if (!f.metacall)
+        return &codec<VariantCodec>;
+
+    switch (f.metaType.id()) {
+    case QMetaType::Bool:
+        return &codec<TypedCodec<bool>>;
+    case QMetaType::Int:
+        return &codec<TypedCodec<int>>;
+    case QMetaType::UInt:
+        return &codec<TypedCodec<uint>>;
+    case QMetaType::LongLong:
+        return &codec<TypedCodec<qint64>>;
+    case QMetaType::ULongLong:
+        return &codec<TypedCodec<quint64>>;
+    case QMetaType::Float:
+        return &codec<TypedCodec<float>>;
+    case QMetaType::Double:
+        return &codec<TypedCodec<double>>;
+    case QMetaType::QString:
+        return &codec<TypedCodec<QString>>;
+    case QMetaType::QByteArray:
+        return &codec<TypedCodec<QByteArray>>;
+    }
+
+    if (f.metaType.flags() & QMetaType::IsGadget && f.metaType.metaObject())
+        return &codec<GadgetCodec>;
+    return &codec<VariantCodec>;
+}
+
+struct PlanRegistry
+{
+    ~PlanRegistry() { qDeleteAll(plans); }
+
+    const QGadgetSerializerPrivate *planFor(const QMetaObject *metaObject);
+
+    QMutex mutex;
+    QHash<const QMetaObject *, QGadgetSerializerPrivate *> plans;
+};
+
+Q_GLOBAL_STATIC(PlanRegistry, planRegistry)
+
+void objectMetacall(QObject *object, QMetaObject::Call call, int index, void **argv)
+{
+    QMetaObject::metacall(object, call, index, argv);
+}
+
+// called with the mutex locked
+const QGadgetSerializerPrivate *PlanRegistry::planFor(const QMetaObject *metaObject)
+{
+    if (QGadgetSerializerPrivate *p = plans.value(metaObject))
+        return p;
+
+    auto *p = new QGadgetSerializerPrivate;
+    plans.insert(metaObject, p);
+
+    // QObject's own objectName is not part of the object's data
+    const bool isQObject = metaObject->inherits(&QObject::staticMetaObject);
+    const int first = isQObject ? QObject::staticMetaObject.propertyCount() : 0;
+    for (int i = first; i < metaObject->propertyCount(); ++i) {
+        const QMetaProperty property = metaObject->property(i);
+        if (!property.isStored() || !property.isReadable() || !property.isWritable())
+            continue;
+
+        Field f;
+        f.property = property;
+        f.metaType = property.metaType();
+        f.name = QLatin1StringView(property.name());
+        const QMetaObject *declaringClass = property.enclosingMetaObject();
+        if (isQObject) {
+            // QObject subclasses may reimplement qt_metacall() to handle
+            // their properties, so go through it
+            f.metacall = &objectMetacall;
+            f.index = property.propertyIndex();
+        } else if (QMetaObjectPrivate::get(declaringClass)->flags & PropertyAccessInStaticMetaCall) {
+            f.metacall = declaringClass->d.static_metacall;
+            f.index = property.relativePropertyIndex();
+        }
+        f.codec = codecFor(f);
+        if (f.codec == &codec<GadgetCodec>)
+            f.nested = planFor(f.metaType.metaObject());
+        p->fields.append(f);
+    }
+    return p;
+}
+
+} // unnamed namespace
+
+#if QT_CONFIG(cborstreamwriter)
+static void writeCborMap(const QGadgetSerializerPrivate *p, QCborStreamWriter &writer,
+                         void *object)
+{
+    writer.startMap(p->fields.size());
+    for (const Field &f : p->fields) {
+        writer.append(f.name);
+        f.codec->toCbor(f, object, writer);
+    }
+    writer.endMap();
+}
+
+void GadgetCodec::toCbor(const Field &f, void *object, QCborStreamWriter &writer)
+{
+    FieldStorage value(f.metaType);
+    writeCborMap(f.nested, writer, value.read(f, object));
+}
+#endif
+
+#if QT_CONFIG(cborstreamreader)
+static bool readCborMap(const QGadgetSerializerPrivate *p, QCborStreamReader &reader,
+                        void *object)
+{
+    if (!reader.isMap()) {
+        reader.next();
+        return false;
+    }
+    if (!reader.enterContainer())
+        return false;
+
+    QVarLengthArray<char, 64> key;
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        if (!reader.isString()) {
+            reader.next();      // the key
+            reader.next();      // the value
+            continue;
+        }
+        if (!readCborKey(reader, key))
+            break;
+
+        // property names are C++ identifiers, so comparing the UTF-8 is enough
+        const QByteArrayView keyView(key.constData(), key.size());
+        auto it = std::find_if(p->fields.cbegin(), p->fields.cend(), [keyView](const Field &f) {
+            return QByteArrayView(f.name.data(), f.name.size()) == keyView;
+        });
+        if (it == p->fields.cend())
+            reader.next();
+        else
+            it->codec->fromCbor(*it, object, reader);
+    }
+
+    return reader.lastError() == QCborError::NoError && reader.leaveContainer();
+}
+
+void GadgetCodec::fromCbor(const Field &f, void *object, QCborStreamReader &reader)
+{
+    // keep the members the data doesn't contain
+    FieldStorage value(f.metaType);
+    void *gadget = value.read(f, object);
+    if (readCborMap(f.nested, reader, gadget))
+        writeField(f, object, gadget);
+}
+#endif
+
+static QJsonObject writeJsonObject(const QGadgetSerializerPrivate *p, void *object)
+{
+    QJsonObject result;
+    for (const Field &f : p->fields)
+        result.insert(f.name, f.codec->toJson(f, object));
+    return result;
+}
+
+static void readJsonObject(const QGadgetSerializerPrivate *p, const QJsonObject &object,
+                          void *target)
+{
+    for (const Field &f : p->fields) {
+        const auto it = object.constFind(f.name);
+        if (it != object.constEnd())
+            f.codec->fromJson(f, target, *it);
+    }
+}
+
+QJsonValue GadgetCodec::toJson(const Field &f, void *object)
+{
+    FieldStorage value(f.metaType);
+    return writeJsonObject(f.nested, value.read(f, object));
+}
+
+void GadgetCodec::fromJson(const Field &f, void *object, const QJsonValue &json)
+{
+    if (!json.isObject())
+        return;
+    FieldStorage value(f.metaType);
+    void *gadget = value.read(f, object);
+    readJsonObject(f.nested, json.toObject(), gadget);
+    writeField(f, object, gadget);
+}
+
+/*!
+    \class QGadgetSerializer
+    \inmodule QtCore
+    \since 6.7
+    \ingroup qtserialization
+    \reentrant
+
+    \brief The QGadgetSerializer class converts Q_GADGET types and QObject
+    subclasses to and from QDataStream, CBOR and JSON, using their properties.
+
+    QGadgetSerializer serializes the values of all the stored, readable and
+    writable properties that moc declared for a type, in declaration order.
+    Unlike iterating over the type's QMetaProperty objects and converting each
+    QVariant that QMetaProperty::readOnGadget() returns, QGadgetSerializer
+    examines the meta-object only once per type, and then reads and writes the
+    properties of the common types (\c bool, the integral and floating-point
+    types, QString and QByteArray) and of nested gadgets directly, without
+    creating a QVariant for each of them:
+
+    \snippet code/src_corelib_serialization_qgadgetserializer.cpp 0
+
+    Properties of other types, such as containers and enumerations, are
+    converted through QVariant, the same way as QMetaType::save(),
+    QCborValue::fromVariant() and QJsonValue::fromVariant() do.
+
+    The QDataStream format is the sequence of the property values, without any
+    header, so saving a gadget with QGadgetSerializer::save() produces the same
+    bytes as streaming each property in turn. In CBOR and JSON, the type is
+    represented as a map or object whose keys are the property names. When
+    reading those, properties that are missing from the data, or whose value
+    has a different type, keep their current value, and keys that match no
+    property are ignored.
+
+    For QObject subclasses, only the properties declared in the class and its
+    bases other than QObject are serialized; in particular, the
+    \l{QObject::objectName}{objectName} is not.
+
+    \sa QMetaProperty, {Qt Serialization}
+*/
+
+/*!
+    \fn template <typename T> void QGadgetSerializer::save(QDataStream &stream, const T &value)
+
+    Writes the properties of \a value to \a stream, in declaration order. If
+    writing fails, the remaining properties are skipped and the status of
+    \a stream indicates the error.
+
+    \sa load()
+*/
+
+/*!
+    \fn template <typename T> void QGadgetSerializer::load(QDataStream &stream, T &value)
+
+    Reads the properties of \a value from \a stream, as written by save(). If
+    reading fails, the properties that had not yet been read keep their value
+    and the status of \a stream indicates the error.
+
+    \sa save()
+*/
+
+/*!
+    \fn template <typename T> void QGadgetSerializer::toCbor(QCborStreamWriter &writer, const T &value)
+
+    Writes \a value to \a writer as a CBOR map from the property names to their
+    values.
+
+    \sa fromCbor()
+*/
+
+/*!
+    \fn template <typename T> bool QGadgetSerializer::fromCbor(QCborStreamReader &reader, T &value)
+
+    Reads the CBOR map at the current position of \a reader into the
+    properties of \a value and advances \a reader past it. Returns \c true on
+    success, or \c false if the current item is not a map or the stream is
+    invalid, in which case \a value may have been partially updated.
+
+    \sa toCbor()
+*/
+
+/*!
+    \fn template <typename T> QJsonObject QGadgetSerializer::toJsonObject(const T &value)
+
+    Returns a JSON object containing the properties of \a value. Byte arrays
+    are encoded as Base64url strings, as in QCborValue::toJsonValue().
+
+    \sa fromJsonObject()
+*/
+
+/*!
+    \fn template <typename T> void QGadgetSerializer::fromJsonObject(const QJsonObject &object, T &value)
+
+    Sets the properties of \a value from the members of \a object.
+
+    \sa toJsonObject()
+*/
+
+const QGadgetSerializerPrivate *QGadgetSerializer::planFor(const QMetaObject *metaObject)
+{
+    PlanRegistry *registry = planRegistry();
+    QMutexLocker locker(&registry->mutex);
+    return registry->planFor(metaObject);
+}
+
+#ifndef QT_NO_DATASTREAM
+void QGadgetSerializer::save_helper(const QGadgetSerializerPrivate *p, QDataStream &stream,
+                                    void *object)
+{
+    for (const Field &f : p->fields) {
+        if (stream.status() != QDataStream::Ok)
+            return;
+        f.codec->save(f, object, stream);
+    }
+}
+
+void QGadgetSerializer::load_helper(const QGadgetSerializerPrivate *p, QDataStream &stream,
+                                    void *object)
+{
+    for (const Field &f : p->fields) {
+        if (stream.status() != QDataStream::Ok)
+            return;
+        f.codec->load(f, object, stream);
+    }
+}
+#endif
+
+#if QT_CONFIG(cborstreamwriter)
+void QGadgetSerializer::toCbor_helper(const QGadgetSerializerPrivate *p,
+                                      QCborStreamWriter &writer, void *object)
+{
+    writeCborMap(p, writer, object);
+}
+#endif
+
+#if QT_CONFIG(cborstreamreader)
+bool QGadgetSerializer::fromCbor_helper(const QGadgetSerializerPrivate *p,
+                                        QCborStreamReader &reader, void *object)
+{
+    return readCborMap(p, reader, object);
+}
+#endif
+
+QJsonObject QGadgetSerializer::toJsonObject_helper(const QGadgetSerializerPrivate *p,
+                                                   void *object)
+{
+    return writeJsonObject(p, object);
+}
+
+void QGadgetSerializer::fromJsonObject_helper(const QGadgetSerializerPrivate *p,
+                                              const QJsonObject &object, void *target)
+{
+    readJsonObject(p, object, target);
+}
+
+QT_END_NAMESPACE
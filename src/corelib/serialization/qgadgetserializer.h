@@ -0,0 +1,81 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGADGETSERIALIZER_H
+#define QGADGETSERIALIZER_H
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qmetatype.h>
+
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+class QCborStreamReader;
+class QCborStreamWriter;
+
+class QGadgetSerializerPrivate;
+class Q_CORE_EXPORT QGadgetSerializer
+{
+public:
+#ifndef QT_NO_DATASTREAM
+    template <typename T> static void save(QDataStream &stream, const T &value)
+    { save_helper(plan<T>(), stream, address(value)); }
+    template <typename T> static void load(QDataStream &stream, T &value)
+    { load_helper(plan<T>(), stream, address(value)); }
+#endif
+#if QT_CONFIG(cborstreamwriter)
+    template <typename T> static void toCbor(QCborStreamWriter &writer, const T &value)
+    { toCbor_helper(plan<T>(), writer, address(value)); }
+#endif
+#if QT_CONFIG(cborstreamreader)
+    template <typename T> static bool fromCbor(QCborStreamReader &reader, T &value)
+    { return fromCbor_helper(plan<T>(), reader, address(value)); }
+#endif
+    template <typename T> static QJsonObject toJsonObject(const T &value)
+    { return toJsonObject_helper(plan<T>(), address(value)); }
+    template <typename T> static void fromJsonObject(const QJsonObject &object, T &value)
+    { fromJsonObject_helper(plan<T>(), object, address(value)); }
+
+private:
+    template <typename T> static const QGadgetSerializerPrivate *plan()
+    {
+        static_assert(QtPrivate::IsGadgetHelper<T>::IsGadgetOrDerivedFrom
+                      || QtPrivate::IsPointerToTypeDerivedFromQObject<T *>::Value,
+                      "QGadgetSerializer requires a Q_GADGET type or a QObject subclass");
+        static const QGadgetSerializerPrivate *p = planFor(&T::staticMetaObject);
+        return p;
+    }
+
+    // moc's static metacall takes a QObject * to the object, or a pointer to
+    // the gadget itself
+    template <typename T> static void *address(const T &value) noexcept
+    {
+        if constexpr (QtPrivate::IsPointerToTypeDerivedFromQObject<T *>::Value)
+            return const_cast<QObject *>(static_cast<const QObject *>(&value));
+        else
+            return const_cast<T *>(&value);
+    }
+
+    static const QGadgetSerializerPrivate *planFor(const QMetaObject *metaObject);
+#ifndef QT_NO_DATASTREAM
+    static void save_helper(const QGadgetSerializerPrivate *p, QDataStream &stream, void *object);
+    static void load_helper(const QGadgetSerializerPrivate *p, QDataStream &stream, void *object);
+#endif
+#if QT_CONFIG(cborstreamwriter)
+    static void toCbor_helper(const QGadgetSerializerPrivate *p, QCborStreamWriter &writer,
+                              void *object);
+#endif
+#if QT_CONFIG(cborstreamreader)
+    static bool fromCbor_helper(const QGadgetSerializerPrivate *p, QCborStreamReader &reader,
+                                void *object);
+#endif
+    static QJsonObject toJsonObject_helper(const QGadgetSerializerPrivate *p, void *object);
+    static void fromJsonObject_helper(const QGadgetSerializerPrivate *p,
+                                      const QJsonObject &object, void *target);
+};
+
+QT_END_NAMESPACE
+
+#endif // QGADGETSERIALIZER_H
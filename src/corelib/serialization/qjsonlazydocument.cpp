@@ -0,0 +1,1048 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonlazydocument.h"
+
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qjsonparser_p.h>
+#include <QtCore/private/qnumeric_p.h>
+#include <QtCore/private/qsimd_p.h>
+#include <QtCore/private/qtools_p.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtMiscUtils;
+
+class QJsonLazyDocumentPrivate : public QSharedData
+{
+public:
+    // A structural character ({}[]:,) outside of a string, the opening quote
+    // of a string or the first character of a number or literal.
+    struct Token
+    {
+        quint32 position;   // in json
+        quint32 next;       // the token after this one and, if it opens a
+                            // container, after the whole container
+    };
+
+    QJsonParseError::ParseError buildIndex(qsizetype *errorOffset);
+
+    char at(quint32 token) const noexcept { return json.constData()[tokens.at(token).position]; }
+    quint32 closingToken(quint32 token) const noexcept { return tokens.at(token).next - 1; }
+    QByteArrayView scalarText(quint32 token) const noexcept;
+    QByteArrayView stringContents(quint32 token) const noexcept;
+    QJsonValue scalarValue(quint32 token) const;
+    bool keyEquals(quint32 token, QAnyStringView key) const;
+
+    QByteArray json;
+    QList<Token> tokens;
+};
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QJsonLazyDocumentPrivate)
+
+namespace {
+
+// the same limit as QJsonPrivate::Parser's
+constexpr int NestingLimit = 1024;
+
+using Token = QJsonLazyDocumentPrivate::Token;
+
+constexpr bool isJsonSpace(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/*
+    Stage 1 of the index: finding the tokens.
+
+    The document is read in blocks of 64 bytes, each turned into bit masks
+    with one bit per byte: the quotes, backslashes, structural characters and
+    whitespace. Bit arithmetic on those masks then finds the quotes that are
+    not escaped, the bytes inside strings and thus the tokens, without
+    branching on the contents of the document. This is the first stage of
+    simdjson (Langdale & Lemire, "Parsing Gigabytes of JSON per Second").
+*/
+struct BlockMasks
+{
+    quint64 quotes = 0;
+    quint64 backslashes = 0;
+    quint64 operators = 0;      // {}[]:,
+    quint64 whitespace = 0;
+};
+
+#ifdef __SSE2__
+static BlockMasks classifyBlock(const uchar *block) noexcept
+{
+    const auto mask = [](__m128i comparison, int shift) {
+        return quint64(uint(_mm_movemask_epi8(comparison))) << shift;
+    };
+
+    BlockMasks masks;
+    for (int i = 0; i < 64; i += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+        const auto equals = [data](char c) { return _mm_cmpeq_epi8(data, _mm_set1_epi8(c)); };
+
+        // '[' and ']' are '{' and '}' without bit 5
+        const __m128i folded = _mm_or_si128(data, _mm_set1_epi8(0x20));
+        const __m128i brackets = _mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')),
+                                              _mm_cmpeq_epi8(folded, _mm_set1_epi8('}')));
+        const __m128i operators = _mm_or_si128(brackets,
+                                               _mm_or_si128(equals(':'), equals(',')));
+        const __m128i whitespace = _mm_or_si128(_mm_or_si128(equals(' '), equals('\t')),
+                                                _mm_or_si128(equals('\n'), equals('\r')));
+
+        masks.quotes |= mask(equals('"'), i);
+        masks.backslashes |= mask(equals('\\'), i);
+        masks.operators |= mask(operators, i);
+        masks.whitespace |= mask(whitespace, i);
+    }
+    return masks;
+}
+#else
+static BlockMasks classifyBlock(const uchar *block) noexcept
+{
+    BlockMasks masks;
+    for (int i = 0; i < 64; ++i) {
+        const quint64 bit = quint64(1) << i;
+        switch (block[i]) {
+        case '"':
+            masks.quotes |= bit;
+            break;
+        case '\\':
+            masks.backslashes |= bit;
+            break;
+        case '{': case '}': case '[': case ']': case ':': case ',':
+            masks.operators |= bit;
+            break;
+        case ' ': case '\t': case '\n': case '\r':
+            masks.whitespace |= bit;
+            break;
+        }
+    }
+    return masks;
+}
+#endif
+
+// Returns the characters following an odd number of backslashes, that is,
+// the escaped ones. *carry is set if the block ends in such a sequence.
+static inline quint64 escapedCharacters(quint64 backslashes, quint64 *carry) noexcept
+{
+    constexpr quint64 EvenBits = Q_UINT64_C(0x5555555555555555);
+    constexpr quint64 OddBits = ~EvenBits;
+
+    // A sequence starting at an even bit escapes the character after it if it
+    // ends at an odd bit and the other way around. Adding the start of each
+    // sequence to the backslashes carries a bit to its end. A sequence carried
+    // over from the previous block flips the parity of the first one.
+    const quint64 starts = backslashes & ~(backslashes << 1);
+    const quint64 evenStartMask = EvenBits ^ *carry;
+    const quint64 evenStarts = starts & evenStartMask;
+    const quint64 oddStarts = starts & ~evenStartMask;
+
+    const quint64 evenCarries = backslashes + evenStarts;
+    quint64 oddCarries;
+    const bool endsOdd = qAddOverflow(backslashes, oddStarts, &oddCarries);
+    oddCarries |= *carry;
+    *carry = endsOdd;
+
+    const quint64 evenStartOddEnd = evenCarries & ~backslashes & OddBits;
+    const quint64 oddStartEvenEnd = oddCarries & ~backslashes & EvenBits;
+    return evenStartOddEnd | oddStartEvenEnd;
+}
+
+// Sets each bit to the parity of the bits up to and including it.
+static inline quint64 prefixXor(quint64 bits) noexcept
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Appends the tokens of json, from begin on, to tokens. Returns false if the
+// last string is unterminated.
+static bool findTokens(const uchar *json, qsizetype begin, qsizetype size, QList<Token> &tokens)
+{
+    quint64 escapeCarry = 0;
+    quint64 inStringCarry = 0;
+    quint64 scalarCarry = 0;
+    qsizetype count = 0;
+
+    for (qsizetype offset = begin; offset < size; offset += 64) {
+        uchar tail[64];
+        const uchar *block = json + offset;
+        if (size - offset < 64) {
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, block, size - offset);
+            block = tail;
+        }
+
+        const BlockMasks masks = classifyBlock(block);
+        const quint64 quotes = masks.quotes & ~escapedCharacters(masks.backslashes, &escapeCarry);
+
+        // from each opening quote to the matching closing one, exclusive
+        const quint64 inString = prefixXor(quotes) ^ inStringCarry;
+        inStringCarry = quint64(qint64(inString) >> 63);
+        const quint64 strings = inString | quotes;
+
+        // numbers, literals and garbage start after anything else
+        const quint64 scalars = ~(masks.operators | masks.whitespace | strings);
+        const quint64 scalarStarts = scalars & ~(scalars << 1 | scalarCarry);
+        scalarCarry = scalars >> 63;
+
+        quint64 found = (masks.operators & ~strings) | (quotes & inString) | scalarStarts;
+        if (!found)
+            continue;
+        const qsizetype n = qPopulationCount(found);
+        tokens.resize(count + n);
+        Token *out = tokens.data() + count;
+        count += n;
+        do {
+            *out++ = { quint32(offset + qCountTrailingZeroBits(found)), 0 };
+            found &= found - 1;
+        } while (found);
+    }
+    return !inStringCarry;
+}
+
+} // unnamed namespace
+
+/*
+    Stage 2 of the index: checking the order of the tokens against the JSON
+    grammar, and linking each opening bracket to the token after the matching
+    closing one so that values can be skipped in constant time. This doesn't
+    look inside strings, numbers or literals; only their first character is
+    checked. The error codes are those QJsonPrivate::Parser reports.
+*/
+QJsonParseError::ParseError QJsonLazyDocumentPrivate::buildIndex(qsizetype *errorOffset)
+{
+    const char *data = json.constData();
+    qsizetype begin = 0;
+    if (json.size() > 3 && json.startsWith("\xef\xbb\xbf"))
+        begin = 3;                  // UTF-8 byte order mark
+    *errorOffset = json.size();
+
+    if (!findTokens(reinterpret_cast<const uchar *>(data), begin, json.size(), tokens))
+        return QJsonParseError::UnterminatedString;
+    if (tokens.isEmpty() || (data[tokens.first().position] != '{'
+                             && data[tokens.first().position] != '[')) {
+        *errorOffset = tokens.isEmpty() ? json.size() : tokens.first().position;
+        return QJsonParseError::IllegalValue;
+    }
+
+    enum Expect { Value, ValueOrEndArray, Key, KeyOrEndObject, NameSeparator,
+                  ValueSeparatorOrEnd, Nothing };
+    Expect expect = Value;
+    QVarLengthArray<quint32, 64> open;
+
+    const quint32 count = quint32(tokens.size());
+    Token *token = tokens.data();
+    for (quint32 i = 0; i < count; ++i) {
+        token[i].next = i + 1;
+        const char c = data[token[i].position];
+        *errorOffset = token[i].position;
+
+        const auto close = [&] {
+            token[open.last()].next = i + 1;
+            open.removeLast();
+            expect = open.isEmpty() ? Nothing : ValueSeparatorOrEnd;
+        };
+
+        switch (expect) {
+        case Value:
+        case ValueOrEndArray:
+            if (c == '{' || c == '[') {
+                if (open.size() >= NestingLimit)
+                    return QJsonParseError::DeepNesting;
+                open.append(i);
+                expect = c == '{' ? KeyOrEndObject : ValueOrEndArray;
+            } else if (c == ']' && expect == ValueOrEndArray) {
+                close();
+            } else if (c == '}' || c == ']') {
+                return QJsonParseError::MissingObject;
+            } else if (c == '"' || c == 't' || c == 'f' || c == 'n' || c == '-'
+                       || isAsciiDigit(c)) {
+                expect = ValueSeparatorOrEnd;
+            } else if (c == ',') {
+                return QJsonParseError::IllegalValue;
+            } else {
+                // the parser tries anything else as a number
+                return QJsonParseError::IllegalNumber;
+            }
+            break;
+
+        case Key:
+        case KeyOrEndObject:
+            if (c == '"')
+                expect = NameSeparator;
+            else if (c == '}' && expect == KeyOrEndObject)
+                close();
+            else if (c == '}')
+                return QJsonParseError::MissingObject;
+            else
+                return QJsonParseError::UnterminatedObject;
+            break;
+
+        case NameSeparator:
+            if (c != ':')
+                return QJsonParseError::MissingNameSeparator;
+            expect = Value;
+            break;
+
+        case ValueSeparatorOrEnd: {
+            const bool inObject = data[token[open.last()].position] == '{';
+            if (c == ',')
+                expect = inObject ? Key : Value;
+            else if (c == (inObject ? '}' : ']'))
+                close();
+            else if (inObject)
+                return QJsonParseError::UnterminatedObject;
+            else if (std::all_of(data + token[i].position + 1, data + json.size(), isJsonSpace))
+                return QJsonParseError::UnterminatedArray;
+            else
+                return QJsonParseError::MissingValueSeparator;
+            break;
+        }
+
+        case Nothing:
+            return QJsonParseError::GarbageAtEnd;
+        }
+    }
+
+    if (!open.isEmpty()) {
+        *errorOffset = json.size();
+        return data[token[open.last()].position] == '{' ? QJsonParseError::UnterminatedObject
+                                                        : QJsonParseError::UnterminatedArray;
+    }
+    *errorOffset = 0;
+    return QJsonParseError::NoError;
+}
+
+// The text of a number or literal. Every value but the outermost is followed by
+// another token, with only whitespace in between.
+QByteArrayView QJsonLazyDocumentPrivate::scalarText(quint32 token) const noexcept
+{
+    const char *begin = json.constData() + tokens.at(token).position;
+    const char *end = json.constData() + tokens.at(token + 1).position;
+    while (end > begin && isJsonSpace(end[-1]))
+        --end;
+    return QByteArrayView(begin, end);
+}
+
+// The characters of a string, between the quotes
+QByteArrayView QJsonLazyDocumentPrivate::stringContents(quint32 token) const noexcept
+{
+    const char *begin = json.constData() + tokens.at(token).position + 1;
+    const char *end = json.constData() + tokens.at(token + 1).position;
+    while (end[-1] != '"')
+        --end;
+    return QByteArrayView(begin, end - 1);
+}
+
+// Parses a number or literal the way QJsonPrivate::Parser does. Returns
+// Undefined for strings, containers and anything malformed.
+QJsonValue QJsonLazyDocumentPrivate::scalarValue(quint32 token) const
+{
+    const QByteArrayView text = scalarText(token);
+    switch (text.front()) {
+    case '{':
+    case '[':
+    case '"':
+        return QJsonValue(QJsonValue::Undefined);
+    case 't':
+        return text == "true" ? QJsonValue(true) : QJsonValue(QJsonValue::Undefined);
+    case 'f':
+        return text == "false" ? QJsonValue(false) : QJsonValue(QJsonValue::Undefined);
+    case 'n':
+        return text == "null" ? QJsonValue(QJsonValue::Null) : QJsonValue(QJsonValue::Undefined);
+    }
+
+    const char *p = text.begin();
+    const char *const end = text.end();
+    bool isInt = true;
+    if (p < end && *p == '-')
+        ++p;
+    if (p < end && *p == '0') {
+        ++p;
+    } else {
+        while (p < end && isAsciiDigit(*p))
+            ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && isAsciiDigit(*p)) {
+            isInt = isInt && *p == '0';
+            ++p;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        isInt = false;
+        ++p;
+        if (p < end && (*p == '-' || *p == '+'))
+            ++p;
+        while (p < end && isAsciiDigit(*p))
+            ++p;
+    }
+    if (p != end)
+        return QJsonValue(QJsonValue::Undefined);
+
+    bool ok;
+    if (isInt) {
+        const qlonglong n = text.toLongLong(&ok);
+        if (ok)
+            return QJsonValue(qint64(n));
+    }
+    const double d = text.toDouble(&ok);
+    if (!ok)
+        return QJsonValue(QJsonValue::Undefined);
+    qint64 n;
+    if (convertDoubleTo(d, &n))
+        return QJsonValue(n);
+    return QJsonValue(d);
+}
+
+bool QJsonLazyDocumentPrivate::keyEquals(quint32 token, QAnyStringView key) const
+{
+    const QByteArrayView contents = stringContents(token);
+    if (!contents.contains('\\'))
+        return QAnyStringView::equal(QUtf8StringView(contents.data(), contents.size()), key);
+
+    QString decoded;
+    return QJsonPrivate::decodeString(contents.begin(), contents.end(), &decoded)
+                   == QJsonParseError::NoError
+            && QAnyStringView::equal(decoded, key);
+}
+
+/*!
+    \class QJsonLazyDocument
+    \inmodule QtCore
+    \since 6.7
+    \brief The QJsonLazyDocument class reads values from a JSON document
+    without parsing all of it.
+
+    \ingroup json
+    \ingroup shared
+    \ingroup qtserialization
+    \reentrant
+
+    QJsonDocument::fromJson() converts a whole document into QJsonObject and
+    QJsonArray values, copying every string and converting every number on
+    the way. When only a few values of a large document are needed, most of
+    that work is wasted. QJsonLazyDocument::fromJson() instead only builds an
+    index of the document's structure, in one fast pass over its bytes, and
+    keeps a reference to the QByteArray it was given. The values are then
+    read through QJsonLazyValue, which looks them up in the document when they
+    are asked for:
+
+    \snippet code/src_corelib_serialization_qjsonlazydocument.cpp 0
+
+    fromJson() reports the same errors as QJsonDocument::fromJson() for
+    malformed structure: unbalanced brackets, missing separators,
+    unterminated strings, too deeply nested containers or data after the end
+    of the document. Strings, numbers and literals, however, are only parsed
+    when they are read. A malformed one reads as an undefined value, and
+    QJsonLazyValue::toJsonValue() returns an undefined value for any container
+    that contains one.
+
+    The index takes up to eight bytes for each bracket, comma, colon and
+    value in the document. A document is read-only; to modify it, convert it
+    to a QJsonDocument or its values to QJsonValue.
+
+    \sa QJsonLazyValue, QJsonDocument, {JSON Support in Qt}
+*/
+
+/*!
+    Constructs a null document.
+
+    \sa isNull()
+*/
+QJsonLazyDocument::QJsonLazyDocument() noexcept = default;
+
+/*!
+    Constructs a copy of \a other. Both share the same document and index.
+*/
+QJsonLazyDocument::QJsonLazyDocument(const QJsonLazyDocument &other) noexcept = default;
+
+/*!
+    \fn QJsonLazyDocument::QJsonLazyDocument(QJsonLazyDocument &&other)
+
+    Move-constructs a document from \a other, which is left null.
+*/
+
+/*!
+    Destroys the document. The QJsonLazyValue objects obtained from it must
+    not be used afterwards, unless a copy of the document still exists.
+*/
+QJsonLazyDocument::~QJsonLazyDocument() = default;
+
+/*!
+    Makes this document a copy of \a other and returns a reference to it.
+*/
+QJsonLazyDocument &QJsonLazyDocument::operator=(const QJsonLazyDocument &other) noexcept = default;
+
+/*!
+    \fn QJsonLazyDocument &QJsonLazyDocument::operator=(QJsonLazyDocument &&other)
+
+    Move-assigns \a other to this document and returns a reference to it.
+*/
+
+/*!
+    \fn void QJsonLazyDocument::swap(QJsonLazyDocument &other)
+
+    Swaps this document with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Indexes \a json as a UTF-8 encoded JSON document and returns a document
+    for reading it.
+
+    The document refers to \a json instead of copying it. If \a json was
+    created with QByteArray::fromRawData(), its data must outlive the document
+    and all copies of it.
+
+    If the structure of \a json is malformed, returns a null document and, if
+    \a error isn't \nullptr, fills it in with the type and offset of the first
+    error.
+
+    \sa isNull(), QJsonDocument::fromJson()
+*/
+QJsonLazyDocument QJsonLazyDocument::fromJson(const QByteArray &json, QJsonParseError *error)
+{
+    QJsonLazyDocument result;
+    QJsonParseError::ParseError e = QJsonParseError::DocumentTooLarge;
+    qsizetype offset = 0;
+    if (size_t(json.size()) < std::numeric_limits<quint32>::max()) {
+        result.d = new QJsonLazyDocumentPrivate;
+        result.d->json = json;
+        e = result.d->buildIndex(&offset);
+        if (e != QJsonParseError::NoError)
+            result.d.reset();
+    }
+    if (error) {
+        error->offset = int(offset);
+        error->error = e;
+    }
+    return result;
+}
+
+/*!
+    \fn bool QJsonLazyDocument::isNull() const
+
+    Returns \c true if this document is null, that is, if it was
+    default-constructed or fromJson() failed.
+*/
+
+/*!
+    Returns \c true if the document's outermost value is an array.
+
+    \sa isObject(), root()
+*/
+bool QJsonLazyDocument::isArray() const noexcept
+{
+    return d && d->at(0) == '[';
+}
+
+/*!
+    Returns \c true if the document's outermost value is an object.
+
+    \sa isArray(), root()
+*/
+bool QJsonLazyDocument::isObject() const noexcept
+{
+    return d && d->at(0) == '{';
+}
+
+/*!
+    Returns the document's outermost value, an object or an array, or an
+    undefined value if the document is null.
+*/
+QJsonLazyValue QJsonLazyDocument::root() const noexcept
+{
+    return d ? QJsonLazyValue(d.data(), 0) : QJsonLazyValue();
+}
+
+/*!
+    \fn QJsonLazyValue QJsonLazyDocument::operator[](QAnyStringView key) const
+
+    Returns the value for \a key in the document's outermost object, the same
+    as \c{root().value(key)}.
+*/
+
+/*!
+    \fn QJsonLazyValue QJsonLazyDocument::operator[](qsizetype i) const
+
+    Returns the value at index \a i in the document's outermost array, the
+    same as \c{root().at(i)}.
+*/
+
+/*!
+    \class QJsonLazyValue
+    \inmodule QtCore
+    \since 6.7
+    \brief The QJsonLazyValue class refers to a value in a QJsonLazyDocument.
+
+    \ingroup json
+    \ingroup qtserialization
+    \reentrant
+
+    A QJsonLazyValue is a small handle to a value in a QJsonLazyDocument.
+    Reading it parses the value's text in the document: type() and the
+    conversion functions parse numbers and literals, toString() decodes
+    strings, and value(), at() and iteration walk objects and arrays by
+    skipping over the values they don't need. Values that aren't read are
+    never parsed.
+
+    The functions mirror those of QJsonValue, QJsonObject and QJsonArray and
+    return the same results as they would for the corresponding QJsonValue,
+    with two exceptions: iterating over an object visits its members in the
+    order they appear in the document, including duplicate keys, and keys()
+    returns the keys in that order. value() returns the last of duplicate
+    members, as QJsonObject does.
+
+    Looking up a key or an index walks the object or array from its start.
+    To read many members of a container, iterate over it instead.
+
+    A QJsonLazyValue refers to its document without keeping it alive, so it
+    must not be used after the last copy of the QJsonLazyDocument it came
+    from is destroyed.
+
+    \sa QJsonLazyDocument, QJsonValue
+*/
+
+/*!
+    \fn QJsonLazyValue::QJsonLazyValue()
+
+    Constructs an undefined value.
+*/
+
+/*!
+    Returns the type of this value, or QJsonValue::Undefined if it is a
+    malformed number or literal or this value doesn't exist.
+
+    Strings are reported as QJsonValue::String without checking their
+    contents; toString() returns a null string if they are malformed.
+*/
+QJsonValue::Type QJsonLazyValue::type() const
+{
+    if (!d)
+        return QJsonValue::Undefined;
+    switch (d->at(token)) {
+    case '{':
+        return QJsonValue::Object;
+    case '[':
+        return QJsonValue::Array;
+    case '"':
+        return QJsonValue::String;
+    }
+    return d->scalarValue(token).type();
+}
+
+/*!
+    \fn bool QJsonLazyValue::isNull() const
+
+    Returns \c true if this value is null.
+*/
+
+/*!
+    \fn bool QJsonLazyValue::isBool() const
+
+    Returns \c true if this value is a boolean.
+
+    \sa toBool()
+*/
+
+/*!
+    \fn bool QJsonLazyValue::isDouble() const
+
+    Returns \c true if this value is a number.
+
+    \sa toDouble(), toInteger()
+*/
+
+/*!
+    \fn bool QJsonLazyValue::isString() const
+
+    Returns \c true if this value is a string.
+
+    \sa toString()
+*/
+
+/*!
+    \fn bool QJsonLazyValue::isArray() const
+
+    Returns \c true if this value is an array.
+
+    \sa at(), size(), begin()
+*/
+
+/*!
+    \fn bool QJsonLazyValue::isObject() const
+
+    Returns \c true if this value is an object.
+
+    \sa value(), size(), begin()
+*/
+
+/*!
+    \fn bool QJsonLazyValue::isUndefined() const
+
+    Returns \c true if this value is undefined, that is, if it doesn't exist
+    or is malformed.
+*/
+
+/*!
+    Returns this value as a boolean, or \a defaultValue if it isn't one.
+
+    \sa QJsonValue::toBool()
+*/
+bool QJsonLazyValue::toBool(bool defaultValue) const
+{
+    return d ? d->scalarValue(token).toBool(defaultValue) : defaultValue;
+}
+
+/*!
+    Returns this value as an int if it is a number with an integral value
+    that fits, or \a defaultValue otherwise.
+
+    \sa QJsonValue::toInt()
+*/
+int QJsonLazyValue::toInt(int defaultValue) const
+{
+    return d ? d->scalarValue(token).toInt(defaultValue) : defaultValue;
+}
+
+/*!
+    Returns this value as a qint64 if it is a number with an integral value
+    that fits, or \a defaultValue otherwise.
+
+    \sa QJsonValue::toInteger()
+*/
+qint64 QJsonLazyValue::toInteger(qint64 defaultValue) const
+{
+    return d ? d->scalarValue(token).toInteger(defaultValue) : defaultValue;
+}
+
+/*!
+    Returns this value as a double, or \a defaultValue if it isn't a number.
+
+    \sa QJsonValue::toDouble()
+*/
+double QJsonLazyValue::toDouble(double defaultValue) const
+{
+    return d ? d->scalarValue(token).toDouble(defaultValue) : defaultValue;
+}
+
+/*!
+    Returns this value as a string, or a null string if it isn't a string or
+    contains invalid escape sequences or UTF-8.
+
+    \sa QJsonValue::toString()
+*/
+QString QJsonLazyValue::toString() const
+{
+    return toString(QString());
+}
+
+/*!
+    \overload
+
+    Returns this value as a string, or \a defaultValue if it isn't a string
+    or contains invalid escape sequences or UTF-8.
+*/
+QString QJsonLazyValue::toString(const QString &defaultValue) const
+{
+    if (!d || d->at(token) != '"')
+        return defaultValue;
+    const QByteArrayView contents = d->stringContents(token);
+    QString result;
+    if (QJsonPrivate::decodeString(contents.begin(), contents.end(), &result)
+            != QJsonParseError::NoError) {
+        return defaultValue;
+    }
+    return result;
+}
+
+/*!
+    Parses this value completely and returns it as a QJsonValue, or an
+    undefined value if it, or any value it contains, is malformed.
+*/
+QJsonValue QJsonLazyValue::toJsonValue() const
+{
+    if (!d)
+        return QJsonValue(QJsonValue::Undefined);
+
+    switch (d->at(token)) {
+    case '{':
+    case '[': {
+        const QByteArrayView json = rawJson();
+        const QJsonDocument document =
+                QJsonDocument::fromJson(QByteArray::fromRawData(json.data(), json.size()));
+        if (document.isObject())
+            return document.object();
+        if (document.isArray())
+            return document.array();
+        return QJsonValue(QJsonValue::Undefined);
+    }
+    case '"': {
+        const QString string = toString();
+        return string.isNull() ? QJsonValue(QJsonValue::Undefined) : QJsonValue(string);
+    }
+    }
+    return d->scalarValue(token);
+}
+
+/*!
+    Returns the text of this value in the document, without surrounding
+    whitespace, or an empty view if this value doesn't exist.
+
+    The view points into the document's data, so it stays valid as long as
+    the document does.
+*/
+QByteArrayView QJsonLazyValue::rawJson() const noexcept
+{
+    if (!d)
+        return QByteArrayView();
+
+    const char *begin = d->json.constData() + d->tokens.at(token).position;
+    switch (*begin) {
+    case '{':
+    case '[':
+        return QByteArrayView(begin, d->json.constData()
+                                     + d->tokens.at(d->closingToken(token)).position + 1);
+    case '"': {
+        const QByteArrayView contents = d->stringContents(token);
+        return QByteArrayView(begin, contents.end() + 1);
+    }
+    }
+    return d->scalarText(token);
+}
+
+/*!
+    Returns the number of elements of this array or members of this object,
+    or 0 if this value is neither.
+
+    This walks the whole container.
+*/
+qsizetype QJsonLazyValue::size() const noexcept
+{
+    qsizetype n = 0;
+    for (auto it = begin(), e = end(); it != e; ++it)
+        ++n;
+    return n;
+}
+
+/*!
+    Returns the keys of this object in the order they appear in the document,
+    or an empty list if this value isn't an object.
+
+    \sa QJsonObject::keys()
+*/
+QStringList QJsonLazyValue::keys() const
+{
+    QStringList result;
+    if (!isObject())
+        return result;
+    for (auto it = begin(), e = end(); it != e; ++it)
+        result.append(it.key());
+    return result;
+}
+
+quint32 QJsonLazyValue::findMember(QAnyStringView key) const
+{
+    quint32 found = 0;          // 0 is the outermost value, never a member
+    if (!d || d->at(token) != '{')
+        return found;
+
+    // the last duplicate wins, as in QJsonObject
+    const quint32 end = d->closingToken(token);
+    for (quint32 t = token + 1; t != end; ) {
+        // the key, the colon, then the value
+        if (d->keyEquals(t, key))
+            found = t + 2;
+        t = d->tokens.at(t + 2).next;
+        if (t != end)
+            ++t;                // the comma
+    }
+    return found;
+}
+
+/*!
+    Returns \c true if this is an object containing \a key.
+
+    \sa value()
+*/
+bool QJsonLazyValue::contains(QAnyStringView key) const
+{
+    return findMember(key) != 0;
+}
+
+/*!
+    Returns the value for \a key in this object, or an undefined value if this
+    isn't an object or doesn't contain \a key.
+
+    \sa operator[](), contains(), QJsonObject::value()
+*/
+QJsonLazyValue QJsonLazyValue::value(QAnyStringView key) const
+{
+    const quint32 member = findMember(key);
+    return member ? QJsonLazyValue(d, member) : QJsonLazyValue();
+}
+
+/*!
+    Returns the value at index \a i in this array, or an undefined value if
+    this isn't an array or \a i is out of bounds.
+
+    \sa operator[](), QJsonArray::at()
+*/
+QJsonLazyValue QJsonLazyValue::at(qsizetype i) const noexcept
+{
+    if (!d || d->at(token) != '[' || i < 0)
+        return QJsonLazyValue();
+    for (auto it = begin(), e = end(); it != e; ++it) {
+        if (i-- == 0)
+            return it.value();
+    }
+    return QJsonLazyValue();
+}
+
+/*!
+    \fn QJsonLazyValue QJsonLazyValue::operator[](QAnyStringView key) const
+
+    Returns the value for \a key in this object, the same as value().
+*/
+
+/*!
+    \fn QJsonLazyValue QJsonLazyValue::operator[](qsizetype i) const
+
+    Returns the value at index \a i in this array, the same as at().
+*/
+
+/*!
+    Returns an iterator to the first element of this array or member of this
+    object. If this value is neither, it is equal to end().
+
+    \sa end(), size()
+*/
+QJsonLazyValue::const_iterator QJsonLazyValue::begin() const noexcept
+{
+    if (!d)
+        return const_iterator();
+    const char c = d->at(token);
+    if (c != '{' && c != '[')
+        return const_iterator();
+    // for empty containers, that's the closing bracket, as for end()
+    return const_iterator(d, token + 1, c == '{');
+}
+
+/*!
+    Returns an iterator past the last element of this array or member of this
+    object.
+
+    \sa begin()
+*/
+QJsonLazyValue::const_iterator QJsonLazyValue::end() const noexcept
+{
+    if (!d)
+        return const_iterator();
+    const char c = d->at(token);
+    if (c != '{' && c != '[')
+        return const_iterator();
+    return const_iterator(d, d->closingToken(token), c == '{');
+}
+
+/*!
+    \fn QJsonLazyValue::const_iterator QJsonLazyValue::constBegin() const
+
+    The same as begin().
+*/
+
+/*!
+    \fn QJsonLazyValue::const_iterator QJsonLazyValue::constEnd() const
+
+    The same as end().
+*/
+
+/*!
+    \class QJsonLazyValue::const_iterator
+    \inmodule QtCore
+    \since 6.7
+    \brief The QJsonLazyValue::const_iterator class iterates over the elements
+    of an array or the members of an object in a QJsonLazyDocument.
+
+    Members of objects are visited in the order they appear in the document.
+*/
+
+/*!
+    \typedef QJsonLazyValue::ConstIterator
+
+    Qt-style synonym for QJsonLazyValue::const_iterator.
+*/
+
+/*!
+    \fn QJsonLazyValue::const_iterator::const_iterator()
+
+    Constructs an invalid iterator.
+*/
+
+/*!
+    Returns the current element or member value.
+*/
+QJsonLazyValue QJsonLazyValue::const_iterator::value() const noexcept
+{
+    return QJsonLazyValue(d, inObject ? token + 2 : token);
+}
+
+/*!
+    \fn QJsonLazyValue QJsonLazyValue::const_iterator::operator*() const
+
+    Returns the current element or member value, the same as value().
+*/
+
+/*!
+    Returns the key of the current member when iterating over an object, or a
+    null string when iterating over an array.
+*/
+QString QJsonLazyValue::const_iterator::key() const
+{
+    return inObject ? QJsonLazyValue(d, token).toString() : QString();
+}
+
+/*!
+    Advances the iterator to the next element or member and returns it.
+*/
+QJsonLazyValue::const_iterator &QJsonLazyValue::const_iterator::operator++() noexcept
+{
+    const quint32 after = d->tokens.at(inObject ? token + 2 : token).next;
+    token = d->at(after) == ',' ? after + 1 : after;
+    return *this;
+}
+
+/*!
+    \fn QJsonLazyValue::const_iterator QJsonLazyValue::const_iterator::operator++(int)
+
+    Advances the iterator to the next element or member and returns its
+    previous value.
+*/
+
+/*!
+    \fn bool QJsonLazyValue::const_iterator::operator==(const const_iterator &lhs, const const_iterator &rhs)
+
+    Returns \c true if \a lhs and \a rhs point to the same element.
+*/
+
+/*!
+    \fn bool QJsonLazyValue::const_iterator::operator!=(const const_iterator &lhs, const const_iterator &rhs)
+
+    Returns \c true if \a lhs and \a rhs point to different elements.
+*/
+
+QT_END_NAMESPACE
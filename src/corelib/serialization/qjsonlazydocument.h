@@ -0,0 +1,137 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QJSONLAZYDOCUMENT_H
+#define QJSONLAZYDOCUMENT_H
+
+#include <QtCore/qanystringview.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstringlist.h>
+
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+class QJsonLazyDocumentPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QJsonLazyDocumentPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QJsonLazyValue
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qsizetype;
+        using value_type = QJsonLazyValue;
+        using pointer = const QJsonLazyValue *;
+        using reference = QJsonLazyValue;
+
+        constexpr const_iterator() noexcept = default;
+
+        QJsonLazyValue value() const noexcept;
+        QJsonLazyValue operator*() const noexcept { return value(); }
+        QString key() const;
+
+        const_iterator &operator++() noexcept;
+        const_iterator operator++(int) noexcept { const_iterator r = *this; ++*this; return r; }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) noexcept
+        { return lhs.d == rhs.d && lhs.token == rhs.token; }
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) noexcept
+        { return !(lhs == rhs); }
+
+    private:
+        friend class QJsonLazyValue;
+        constexpr const_iterator(const QJsonLazyDocumentPrivate *d, quint32 token,
+                                 bool inObject) noexcept
+            : d(d), token(token), inObject(inObject)
+        {}
+
+        const QJsonLazyDocumentPrivate *d = nullptr;
+        quint32 token = 0;
+        bool inObject = false;
+    };
+    using ConstIterator = const_iterator;
+
+    constexpr QJsonLazyValue() noexcept = default;
+
+    QJsonValue::Type type() const;
+    bool isNull() const { return type() == QJsonValue::Null; }
+    bool isBool() const { return type() == QJsonValue::Bool; }
+    bool isDouble() const { return type() == QJsonValue::Double; }
+    bool isString() const { return type() == QJsonValue::String; }
+    bool isArray() const { return type() == QJsonValue::Array; }
+    bool isObject() const { return type() == QJsonValue::Object; }
+    bool isUndefined() const { return type() == QJsonValue::Undefined; }
+
+    bool toBool(bool defaultValue = false) const;
+    int toInt(int defaultValue = 0) const;
+    qint64 toInteger(qint64 defaultValue = 0) const;
+    double toDouble(double defaultValue = 0) const;
+    QString toString() const;
+    QString toString(const QString &defaultValue) const;
+    QJsonValue toJsonValue() const;
+    QByteArrayView rawJson() const noexcept;
+
+    qsizetype size() const noexcept;
+    QStringList keys() const;
+    bool contains(QAnyStringView key) const;
+    QJsonLazyValue value(QAnyStringView key) const;
+    QJsonLazyValue at(qsizetype i) const noexcept;
+    QJsonLazyValue operator[](QAnyStringView key) const { return value(key); }
+    QJsonLazyValue operator[](qsizetype i) const noexcept { return at(i); }
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator constBegin() const noexcept { return begin(); }
+    const_iterator constEnd() const noexcept { return end(); }
+
+private:
+    friend class QJsonLazyDocument;
+    constexpr QJsonLazyValue(const QJsonLazyDocumentPrivate *d, quint32 token) noexcept
+        : d(d), token(token)
+    {}
+
+    quint32 findMember(QAnyStringView key) const;
+
+    const QJsonLazyDocumentPrivate *d = nullptr;
+    quint32 token = 0;
+};
+
+Q_DECLARE_TYPEINFO(QJsonLazyValue, Q_RELOCATABLE_TYPE);
+
+class Q_CORE_EXPORT QJsonLazyDocument
+{
+public:
+    QJsonLazyDocument() noexcept;
+    QJsonLazyDocument(const QJsonLazyDocument &other) noexcept;
+    QJsonLazyDocument(QJsonLazyDocument &&other) noexcept = default;
+    ~QJsonLazyDocument();
+    QJsonLazyDocument &operator=(const QJsonLazyDocument &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QJsonLazyDocument)
+
+    void swap(QJsonLazyDocument &other) noexcept { d.swap(other.d); }
+
+    static QJsonLazyDocument fromJson(const QByteArray &json, QJsonParseError *error = nullptr);
+
+    bool isNull() const noexcept { return !d; }
+    bool isArray() const noexcept;
+    bool isObject() const noexcept;
+
+    QJsonLazyValue root() const noexcept;
+    QJsonLazyValue operator[](QAnyStringView key) const { return root().value(key); }
+    QJsonLazyValue operator[](qsizetype i) const noexcept { return root().at(i); }
+
+private:
+    QExplicitlySharedDataPointer<QJsonLazyDocumentPrivate> d;
+};
+
+Q_DECLARE_SHARED(QJsonLazyDocument)
+
+QT_END_NAMESPACE
+
+#endif // QJSONLAZYDOCUMENT_H
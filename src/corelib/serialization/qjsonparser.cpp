@@ -47,6 +47,7 @@ using namespace QtMiscUtils;
 #define JSONERR_DEEP_NEST   QT_TRANSLATE_NOOP("QJsonParseError", "too deeply nested document")
 #define JSONERR_DOC_LARGE   QT_TRANSLATE_NOOP("QJsonParseError", "too large document")
 #define JSONERR_GARBAGEEND  QT_TRANSLATE_NOOP("QJsonParseError", "garbage at the end of the document")
+#define JSONERR_PREMATURE   QT_TRANSLATE_NOOP("QJsonParseError", "premature end of document")
 
 /*!
     \class QJsonParseError
@@ -82,6 +83,9 @@ using namespace QtMiscUtils;
     \value DeepNesting              The JSON document is too deeply nested for the parser to parse it
     \value DocumentTooLarge         The JSON document is too large for the parser to parse it
     \value GarbageAtEnd             The parsed document contains additional garbage characters at the end
+    \value PrematureEndOfDocument   The input ended before the end of the current value. Only
+                                    QJsonStreamReader reports this error, and can resume once more
+                                    data is available (since 6.7)
 
 */
 
@@ -157,6 +161,9 @@ QString QJsonParseError::errorString() const
     case GarbageAtEnd:
         sz = JSONERR_GARBAGEEND;
         break;
+    case PrematureEndOfDocument:
+        sz = JSONERR_PREMATURE;
+        break;
     }
 #ifndef QT_BOOTSTRAPPED
     return QCoreApplication::translate("QJsonParseError", sz);
@@ -928,4 +935,30 @@ bool Parser::parseString()
     return true;
 }
 
+QJsonParseError::ParseError QJsonPrivate::decodeString(const char *json, const char *end,
+                                                       QString *result)
+{
+    result->clear();
+    if (!memchr(json, '\\', end - json)) {
+        const QByteArrayView utf8(json, end - json);
+        if (!QUtf8::isValidUtf8(utf8).isValidUtf8)
+            return QJsonParseError::IllegalUTF8String;
+        *result = QString::fromUtf8(utf8);
+        return QJsonParseError::NoError;
+    }
+
+    result->reserve(end - json);
+    while (json < end) {
+        char32_t ch = 0;
+        if (*json == '\\') {
+            if (!scanEscapeSequence(json, end, &ch))
+                return QJsonParseError::IllegalEscapeSequence;
+        } else if (!scanUtf8Char(json, end, &ch)) {
+            return QJsonParseError::IllegalUTF8String;
+        }
+        result->append(QChar::fromUcs4(ch));
+    }
+    return QJsonParseError::NoError;
+}
+
 QT_END_NAMESPACE
@@ -50,6 +50,10 @@ private:
     QExplicitlySharedDataPointer<QCborContainerPrivate> container;
 };
 
+// Decodes the characters of a JSON string, given without its quotes, into
+// *result the way Parser does. Returns the error found, if any.
+QJsonParseError::ParseError decodeString(const char *begin, const char *end, QString *result);
+
 }
 
 QT_END_NAMESPACE
@@ -0,0 +1,1011 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamreader.h"
+#include <QtCore/qiodevice.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qjsonparser_p.h>
+#include <QtCore/private/qnumeric_p.h>
+#include <QtCore/private/qtools_p.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtMiscUtils;
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \since 6.7
+    \brief The QJsonStreamReader class is a pull parser for JSON, operating on
+    either a QByteArray or a QIODevice.
+
+    \ingroup json
+    \ingroup qtserialization
+    \reentrant
+
+    QJsonDocument::fromJson() needs the whole document in memory and converts
+    all of it at once. QJsonStreamReader instead decodes a JSON document one
+    element at a time, directly from a QIODevice or from data passed in
+    chunks to addData(). It only keeps the part of the input that it has not
+    finished reading, so its memory use does not depend on the size of the
+    document, only on the size of the largest string or number in it.
+
+    Like \l QCborStreamReader, on which its API is modeled, QJsonStreamReader
+    is positioned on one element at a time, whose type() is available
+    without any further parsing:
+
+    \table
+      \header \li Kind       \li Types       \li Behavior
+      \row   \li Literals    \li Null, Bool, Double
+             \li The value is pre-parsed, so the accessor functions are \c
+                 const. Must call next() to advance.
+      \row   \li Strings     \li String
+             \li readString() returns the string and advances to the next
+                 element.
+      \row   \li Containers  \li Array, Object
+             \li To access the elements, you must call enterContainer(),
+                 read all elements, then call leaveContainer(). That function
+                 advances to the next element.
+    \endtable
+
+    Inside an object, the keys are reported as String elements, each followed
+    by the element of its value. readValue() reads the current element,
+    including all elements of a container, as a QJsonValue and advances past
+    it. This is convenient to process a large array of records one at a time:
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 0
+
+    \section1 Incremental parsing
+
+    When the input ends before the end of an element, QJsonStreamReader
+    reports the QJsonParseError::PrematureEndOfDocument error, which is not
+    fatal: once more data is available, call addData() or, when reading from a
+    QIODevice, reparse(), and parsing resumes where it stopped. Any other
+    error is fatal: the reader stops parsing and the functions that advance
+    return \c false.
+
+    Only one top-level value is read: hasNext() returns \c false when it has
+    been read. As with QJsonDocument::fromJson(), only whitespace may follow
+    it; any other data is reported as the QJsonParseError::GarbageAtEnd
+    error. A number at the top level of a QByteArray ends with the data, and
+    addData() extends it until the reader advances past it. When reading from
+    a sequential QIODevice, such a number must be followed by whitespace, as
+    only that shows that the number is complete.
+
+    \sa QJsonStreamWriter, QJsonDocument, QCborStreamReader, {JSON Support in Qt}
+*/
+
+/*!
+    \enum QJsonStreamReader::Type
+
+    This enumeration contains the types of element that QJsonStreamReader
+    reports.
+
+    \value Invalid      No element, because of an error or because the end of
+                        the current container or of the document was reached
+    \value Null         The \c null literal
+    \value Bool         The \c true or \c false literal
+    \value Double       A number, see toDouble() and toInteger()
+    \value String       A string or the key of an object member
+    \value Array        An array
+    \value Object       An object
+
+    \sa type()
+*/
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum {
+        // the same limit as QJsonPrivate::Parser's
+        NestingLimit = 1024,
+        IdealIoBufferSize = 16384
+    };
+
+    struct Level
+    {
+        QJsonStreamReader::Type type;
+        qint64 count;           // elements read so far, keys included
+    };
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qint64 bufferOffset = 0;    // offset in the stream of buffer[0]
+    qsizetype cursor = 0;       // end of the last element read
+
+    QVarLengthArray<Level, 16> containerStack;
+    bool rootRead = false;
+    bool atEnd = false;         // of the current container or of the document
+    int pendingSkipDepth = -1;  // next() skipping a container didn't finish
+
+    // the current element
+    qsizetype elementStart = 0;
+    qsizetype elementEnd = 0;
+    bool boolean = false;
+    bool isInteger = false;
+    qint64 integer = 0;
+    double number = 0;
+    QString string;
+
+    QJsonParseError lastError = {};
+    bool corrupt = false;
+
+    QJsonStreamReaderPrivate(const QByteArray &data)
+        : buffer(data)
+    {
+    }
+
+    QJsonStreamReaderPrivate(QIODevice *device)
+    {
+        setDevice(device);
+    }
+
+    void setDevice(QIODevice *dev)
+    {
+        buffer.clear();
+        bufferOffset = 0;
+        device = dev;
+        initDecoder();
+    }
+
+    void initDecoder()
+    {
+        containerStack.clear();
+        cursor = elementStart = elementEnd = 0;
+        rootRead = atEnd = false;
+        pendingSkipDepth = -1;
+        lastError = {};
+        corrupt = false;
+    }
+
+    void handleError(QJsonParseError::ParseError err) noexcept
+    {
+        Q_ASSERT(err != QJsonParseError::NoError);
+
+        // is the error fatal?
+        if (err != QJsonParseError::PrematureEndOfDocument)
+            corrupt = true;
+
+        const qint64 offset = bufferOffset + elementStart;
+        lastError.offset = int(qMin(offset, qint64(std::numeric_limits<int>::max())));
+        lastError.error = err;
+    }
+
+    bool atEndOfInput() const
+    {
+        // only then can we tell that a number at the end of the buffer is complete
+        return device && !device->isSequential() && device->atEnd();
+    }
+
+    void compact();
+    void append(const char *data, qsizetype len);
+    bool fill();
+    void advance();
+
+    QJsonParseError::ParseError parseElement(QJsonStreamReader::Type *type);
+    QJsonParseError::ParseError parseValue(const char *p, QJsonStreamReader::Type *type);
+    QJsonParseError::ParseError parseNumber(const char *p);
+    bool findContainerEnd(qsizetype *containerEnd) const;
+};
+
+static constexpr bool isJsonSpace(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static const char *skipWhitespace(const char *p, const char *end) noexcept
+{
+    while (p < end && isJsonSpace(*p))
+        ++p;
+    return p;
+}
+
+// Drops the data that has been read, unless there is little of it.
+void QJsonStreamReaderPrivate::compact()
+{
+    const qsizetype discard = cursor;
+    if (discard == 0 || (discard < IdealIoBufferSize && discard < buffer.size() / 2))
+        return;
+
+    buffer.remove(0, discard);
+    bufferOffset += discard;
+    cursor -= discard;
+    elementStart -= discard;
+    elementEnd -= discard;
+}
+
+void QJsonStreamReaderPrivate::append(const char *data, qsizetype len)
+{
+    compact();
+    buffer.append(data, len);
+}
+
+// Reads more data from the device. Returns false if there was none.
+bool QJsonStreamReaderPrivate::fill()
+{
+    if (!device)
+        return false;
+
+    compact();
+
+    // read at least as much as is pending, so that we don't rescan a long
+    // string or number more than a few times
+    const qsizetype oldSize = buffer.size();
+    const qsizetype chunk = qMax(qsizetype(IdealIoBufferSize), oldSize - cursor);
+    buffer.resize(oldSize + chunk);
+    const qint64 read = device->read(buffer.data() + oldSize, chunk);
+    buffer.resize(oldSize + qMax(read, qint64(0)));
+    return read > 0;
+}
+
+// Moves past the current element, which has been read.
+void QJsonStreamReaderPrivate::advance()
+{
+    cursor = elementEnd;
+    if (containerStack.isEmpty())
+        rootRead = true;
+    else
+        ++containerStack.last().count;
+}
+
+/*
+    Finds the element at cursor and the separators before it. This does not
+    change the state of the reader other than the current element, so it can
+    be repeated once more data is available.
+*/
+QJsonParseError::ParseError QJsonStreamReaderPrivate::parseElement(QJsonStreamReader::Type *type)
+{
+    const char *const begin = buffer.constData();
+    const char *const end = begin + buffer.size();
+    const char *p = begin + cursor;
+
+    *type = QJsonStreamReader::Invalid;
+    atEnd = false;
+
+    if (containerStack.isEmpty()) {
+        if (rootRead) {
+            // like QJsonDocument::fromJson(), allow only whitespace after it
+            p = skipWhitespace(p, end);
+            elementStart = p - begin;
+            if (p != end)
+                return QJsonParseError::GarbageAtEnd;
+            cursor = elementStart;  // so that fill() can drop the whitespace
+            atEnd = true;
+            return QJsonParseError::NoError;
+        }
+        if (bufferOffset == 0 && cursor == 0) {
+            // skip a UTF-8 byte order mark
+            constexpr char bom[] = "\xef\xbb\xbf";
+            const qsizetype n = qMin(end - p, qsizetype(sizeof(bom) - 1));
+            if (memcmp(p, bom, n) == 0) {
+                if (n < qsizetype(sizeof(bom) - 1))
+                    return QJsonParseError::PrematureEndOfDocument;
+                p += n;
+            }
+        }
+        p = skipWhitespace(p, end);
+        elementStart = p - begin;
+        if (p == end)
+            return QJsonParseError::PrematureEndOfDocument;
+        return parseValue(p, type);
+    }
+
+    const Level &level = containerStack.last();
+    const bool inObject = level.type == QJsonStreamReader::Object;
+    p = skipWhitespace(p, end);
+    elementStart = p - begin;
+    if (p == end)
+        return QJsonParseError::PrematureEndOfDocument;
+
+    if (inObject && level.count % 2) {
+        // the value of a member
+        if (*p != ':')
+            return QJsonParseError::MissingNameSeparator;
+        p = skipWhitespace(p + 1, end);
+        elementStart = p - begin;
+        if (p == end)
+            return QJsonParseError::PrematureEndOfDocument;
+        return parseValue(p, type);
+    }
+
+    const char close = inObject ? '}' : ']';
+    if (*p == close) {
+        atEnd = true;
+        elementEnd = elementStart + 1;
+        return QJsonParseError::NoError;
+    }
+    if (level.count) {
+        // the same errors as QJsonPrivate::Parser's
+        if (*p != ',' && inObject)
+            return QJsonParseError::UnterminatedObject;
+        if (*p != ',')
+            return *p == '}' ? QJsonParseError::UnterminatedArray
+                             : QJsonParseError::MissingValueSeparator;
+        p = skipWhitespace(p + 1, end);
+        elementStart = p - begin;
+        if (p == end)
+            return QJsonParseError::PrematureEndOfDocument;
+        if (inObject && *p != '"')
+            return QJsonParseError::MissingObject;
+    } else if (inObject && *p != '"') {
+        return QJsonParseError::UnterminatedObject;
+    }
+    return parseValue(p, type);
+}
+
+QJsonParseError::ParseError
+QJsonStreamReaderPrivate::parseValue(const char *p, QJsonStreamReader::Type *type)
+{
+    const char *const begin = buffer.constData();
+    const char *const end = begin + buffer.size();
+    Q_ASSERT(p < end);
+
+    const auto literal = [&](QByteArrayView text, QJsonStreamReader::Type t) {
+        const qsizetype n = qMin(end - p, text.size());
+        if (QByteArrayView(p, n) != text.first(n))
+            return QJsonParseError::IllegalValue;
+        if (n < text.size())
+            return QJsonParseError::PrematureEndOfDocument;
+        *type = t;
+        elementEnd = elementStart + n;
+        return QJsonParseError::NoError;
+    };
+
+    switch (*p) {
+    case '[':
+    case '{':
+        if (containerStack.size() >= NestingLimit)
+            return QJsonParseError::DeepNesting;
+        *type = *p == '[' ? QJsonStreamReader::Array : QJsonStreamReader::Object;
+        elementEnd = elementStart + 1;
+        return QJsonParseError::NoError;
+
+    case '"': {
+        const char *q = p + 1;
+        while (true) {
+            q = static_cast<const char *>(memchr(q, '"', end - q));
+            if (!q)
+                return QJsonParseError::PrematureEndOfDocument;
+
+            // an odd number of backslashes before the quote escapes it
+            const char *b = q;
+            while (b[-1] == '\\')
+                --b;
+            if ((q - b) % 2 == 0)
+                break;
+            ++q;
+        }
+        if (const auto err = QJsonPrivate::decodeString(p + 1, q, &string))
+            return err;
+        *type = QJsonStreamReader::String;
+        elementEnd = q + 1 - begin;
+        return QJsonParseError::NoError;
+    }
+
+    case 't':
+        boolean = true;
+        return literal("true", QJsonStreamReader::Bool);
+    case 'f':
+        boolean = false;
+        return literal("false", QJsonStreamReader::Bool);
+    case 'n':
+        return literal("null", QJsonStreamReader::Null);
+
+    case ']':
+    case '}':
+        return QJsonParseError::MissingObject;
+    case ',':
+        return QJsonParseError::IllegalValue;
+    }
+
+    if (*p != '-' && !isAsciiDigit(*p))
+        return QJsonParseError::IllegalNumber;
+    if (const auto err = parseNumber(p))
+        return err;
+    *type = QJsonStreamReader::Double;
+    return QJsonParseError::NoError;
+}
+
+QJsonParseError::ParseError QJsonStreamReaderPrivate::parseNumber(const char *p)
+{
+    const char *const begin = buffer.constData();
+    const char *const end = begin + buffer.size();
+
+    const auto isNumberChar = [](char c) {
+        return isAsciiDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    };
+    const char *numberEnd = p;
+    while (numberEnd < end && isNumberChar(*numberEnd))
+        ++numberEnd;
+    // A number at the top level of a QByteArray ends with the data; if more
+    // is added before advancing past it, addData() parses it again.
+    if (numberEnd == end && !atEndOfInput() && (device || !containerStack.isEmpty()))
+        return QJsonParseError::PrematureEndOfDocument;
+
+    // the same grammar as QJsonPrivate::Parser's
+    bool isInt = true;
+    const char *q = p;
+    if (*q == '-')
+        ++q;
+    if (q < numberEnd && *q == '0') {
+        ++q;
+    } else {
+        while (q < numberEnd && isAsciiDigit(*q))
+            ++q;
+    }
+    if (q < numberEnd && *q == '.') {
+        ++q;
+        while (q < numberEnd && isAsciiDigit(*q)) {
+            isInt = isInt && *q == '0';
+            ++q;
+        }
+    }
+    if (q < numberEnd && (*q == 'e' || *q == 'E')) {
+        isInt = false;
+        ++q;
+        if (q < numberEnd && (*q == '-' || *q == '+'))
+            ++q;
+        while (q < numberEnd && isAsciiDigit(*q))
+            ++q;
+    }
+    if (q != numberEnd)
+        return QJsonParseError::IllegalNumber;
+
+    const QByteArrayView text(p, numberEnd);
+    bool ok = false;
+    if (isInt) {
+        integer = text.toLongLong(&ok);
+        if (ok)
+            number = double(integer);
+    }
+    if (!ok) {
+        number = text.toDouble(&ok);
+        if (!ok)
+            return QJsonParseError::IllegalNumber;
+        ok = convertDoubleTo(number, &integer);
+    }
+    isInteger = ok;
+    elementEnd = numberEnd - begin;
+    return QJsonParseError::NoError;
+}
+
+// Finds the end of the array or object at elementStart, without validating it.
+bool QJsonStreamReaderPrivate::findContainerEnd(qsizetype *containerEnd) const
+{
+    const char *const begin = buffer.constData();
+    const char *const end = begin + buffer.size();
+    qsizetype depth = 0;
+    for (const char *p = begin + elementStart; p < end; ++p) {
+        switch (*p) {
+        case '[':
+        case '{':
+            ++depth;
+            break;
+        case ']':
+        case '}':
+            if (--depth == 0) {
+                *containerEnd = p + 1 - begin;
+                return true;
+            }
+            break;
+        case '"':
+            for (++p; p < end && *p != '"'; ++p) {
+                if (*p == '\\')
+                    ++p;
+            }
+            if (p >= end)
+                return false;
+            break;
+        }
+    }
+    return false;
+}
+
+/*!
+    Creates a QJsonStreamReader object with no source data. After
+    construction, QJsonStreamReader reports the
+    QJsonParseError::PrematureEndOfDocument error.
+
+    You can add more data by calling addData() or by setting a different
+    source device using setDevice().
+
+    \sa addData(), isValid()
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : QJsonStreamReader(QByteArray())
+{
+}
+
+/*!
+    \overload
+
+    Creates a QJsonStreamReader object with \a len bytes of data starting at
+    \a data. The pointer must remain valid until QJsonStreamReader is
+    destroyed.
+*/
+QJsonStreamReader::QJsonStreamReader(const char *data, qsizetype len)
+    : QJsonStreamReader(QByteArray::fromRawData(data, len))
+{
+}
+
+/*!
+    \overload
+
+    Creates a QJsonStreamReader object that will parse the JSON document found
+    in \a data.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d(new QJsonStreamReaderPrivate(data))
+{
+    preparse();
+}
+
+/*!
+    \overload
+
+    Creates a QJsonStreamReader object that will parse the JSON document read
+    from \a device. QJsonStreamReader does not take ownership of \a device, so
+    it must remain valid until this object is destroyed.
+
+    QJsonStreamReader reads from the device in blocks of several kilobytes,
+    so the position of the device is usually past the element being read.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d(new QJsonStreamReaderPrivate(device))
+{
+    preparse();
+}
+
+/*!
+    Destroys this QJsonStreamReader object and frees any associated
+    resources.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the source of data to \a device, resetting the decoder to its initial
+    state.
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->setDevice(device);
+    preparse();
+}
+
+/*!
+    Returns the QIODevice that was set with either setDevice() or the
+    QJsonStreamReader constructor. If this object was reading from a
+    QByteArray, this function returns nullptr instead.
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Adds \a data to the JSON stream and reparses the current element. This
+    function is useful if the end of the data was previously reached while
+    processing the stream, but now more data is available.
+
+    QJsonStreamReader drops the data that it has finished reading when more is
+    added, so that its memory use does not grow with the size of the
+    document.
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+/*!
+    \overload
+
+    Adds \a len bytes of data starting at \a data to the JSON stream and
+    reparses the current element.
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    if (!d->device) {
+        if (len > 0)
+            d->append(data, len);
+        reparse();
+    } else {
+        qWarning("QJsonStreamReader: addData() with device()");
+    }
+}
+
+/*!
+    Reparses the current element. This function must be called when more data
+    becomes available in the source QIODevice after parsing failed due to
+    reaching the end of the input data before the end of the JSON document.
+
+    When reading from a QByteArray, the addData() function automatically calls
+    this function. Calling it when the reading had not failed is a no-op.
+*/
+void QJsonStreamReader::reparse()
+{
+    d->lastError = {};
+    d->corrupt = false;
+    preparse();
+    skipToPendingDepth();
+}
+
+/*!
+    Clears the decoder state and resets the input source data to an empty byte
+    array. After this function is called, QJsonStreamReader will be
+    indicating the QJsonParseError::PrematureEndOfDocument error.
+
+    Call addData() to add more data to be parsed.
+
+    \sa reset(), setDevice()
+*/
+void QJsonStreamReader::clear()
+{
+    setDevice(nullptr);
+}
+
+/*!
+    Resets the source back to the beginning and clears the decoder state.
+
+    If the source data is a QIODevice, this function will call
+    QIODevice::reset(), which will seek to byte position 0. If the JSON
+    document is not found at the beginning of the device, position the
+    QIODevice to the right offset and call setDevice() instead.
+
+    If the source data is a QByteArray, QJsonStreamReader restarts from the
+    oldest data that it holds. That is the beginning of the QByteArray unless
+    addData() has since dropped data that had been read.
+
+    \sa clear(), setDevice()
+*/
+void QJsonStreamReader::reset()
+{
+    if (d->device) {
+        d->device->reset();
+        d->buffer.clear();
+        d->bufferOffset = 0;
+    }
+    d->initDecoder();
+    preparse();
+}
+
+/*!
+    Returns the last error in decoding the stream, if any. If no error was
+    encountered, this returns a QJsonParseError whose \l{QJsonParseError::}{error}
+    is QJsonParseError::NoError.
+
+    \sa isValid()
+*/
+QJsonParseError QJsonStreamReader::lastError() const
+{
+    return d->lastError;
+}
+
+/*!
+    Returns the offset in the input stream of the element currently being
+    decoded, or of where the decoding stopped with an error. The offset counts
+    from the first byte given to the constructor, addData() or read from the
+    device after setDevice().
+
+    \sa lastError()
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    return d->bufferOffset + d->elementStart;
+}
+
+/*!
+    \fn bool QJsonStreamReader::isValid() const
+
+    Returns true if the current element is valid, false otherwise. It is
+    invalid if there was an error decoding it or if the end of the current
+    container or of the document was reached.
+
+    \sa type(), lastError(), hasNext()
+*/
+
+/*!
+    Returns the number of containers that this stream has entered with
+    enterContainer() but not yet left.
+
+    \sa enterContainer(), leaveContainer()
+*/
+int QJsonStreamReader::containerDepth() const
+{
+    return int(d->containerStack.size());
+}
+
+/*!
+    Returns either QJsonStreamReader::Array or QJsonStreamReader::Object,
+    indicating whether the container that contains the current element was an
+    array or an object, respectively. If we're currently parsing the root
+    element, this function returns QJsonStreamReader::Invalid.
+
+    \sa containerDepth(), enterContainer()
+*/
+QJsonStreamReader::Type QJsonStreamReader::parentContainerType() const
+{
+    if (d->containerStack.isEmpty())
+        return Invalid;
+    return d->containerStack.last().type;
+}
+
+/*!
+    Returns true if there are more elements to be decoded in the current
+    container or false if we've reached its end. If we're parsing the root
+    element, hasNext() returning false indicates the parsing is complete;
+    otherwise, if the container depth is non-zero, then the outer code needs
+    to call leaveContainer().
+
+    \sa parentContainerType(), containerDepth(), leaveContainer()
+*/
+bool QJsonStreamReader::hasNext() const noexcept
+{
+    return !d->atEnd && !d->corrupt;
+}
+
+/*!
+    Advances the JSON stream decoding one element. You should usually call
+    this function when the current element is a literal (null, a boolean or a
+    number). If the current element is an array or an object, this function
+    skips over that entire element, including all contained elements.
+
+    This function returns true if advancing was successful, false otherwise.
+    It may fail if the stream is corrupt or incomplete, or if hasNext() has
+    returned false. If this function returns false, lastError() will return
+    the error code detailing what the failure was. If the stream was
+    incomplete, reparse() or addData() continue skipping a container.
+
+    \sa lastError(), isValid(), hasNext()
+*/
+bool QJsonStreamReader::next()
+{
+    if (d->lastError.error != QJsonParseError::NoError)
+        return false;
+    if (!hasNext()) {
+        qWarning("QJsonStreamReader::next: no element to advance past");
+        return false;
+    }
+
+    if (isContainer()) {
+        d->pendingSkipDepth = containerDepth();
+        enterContainer();
+        skipToPendingDepth();
+    } else {
+        d->advance();
+        preparse();
+    }
+    return d->lastError.error == QJsonParseError::NoError;
+}
+
+// Skips elements until we're back at the depth where next() was called on a
+// container.
+void QJsonStreamReader::skipToPendingDepth()
+{
+    while (d->pendingSkipDepth >= 0 && d->lastError.error == QJsonParseError::NoError) {
+        if (containerDepth() == d->pendingSkipDepth) {
+            d->pendingSkipDepth = -1;
+        } else if (!hasNext()) {
+            leaveContainer();
+        } else if (isContainer()) {
+            enterContainer();
+        } else {
+            d->advance();
+            preparse();
+        }
+    }
+}
+
+/*!
+    \fn bool QJsonStreamReader::enterContainer()
+
+    Enters the array or object that is the current element and prepares for
+    iterating the elements contained in the container. Returns true if
+    entering the container succeeded, false otherwise (usually, a parsing
+    error). Each call to enterContainer() must be paired with a call to
+    leaveContainer().
+
+    This function may only be called if the current element is an array or an
+    object (that is, if isArray(), isObject() or isContainer() is true).
+    Calling it in any other condition is an error.
+
+    \sa leaveContainer(), isContainer(), isArray(), isObject()
+*/
+bool QJsonStreamReader::_enterContainer_helper()
+{
+    if (d->lastError.error != QJsonParseError::NoError)
+        return false;
+    d->containerStack.append({ type_, 0 });
+    d->cursor = d->elementEnd;
+    preparse();
+    return true;
+}
+
+/*!
+    Leaves the array or object whose elements were being processed and
+    positions the decoder at the next element after the end of the container.
+    Returns true if leaving the container succeeded, false otherwise (usually,
+    a parsing error). Each call to enterContainer() must be paired with a call
+    to leaveContainer().
+
+    This function may only be called if hasNext() has returned false and
+    containerDepth() is not zero. Calling it in any other condition is an
+    error.
+
+    \sa enterContainer(), parentContainerType(), containerDepth()
+*/
+bool QJsonStreamReader::leaveContainer()
+{
+    if (d->containerStack.isEmpty()) {
+        qWarning("QJsonStreamReader::leaveContainer: trying to leave top-level element");
+        return false;
+    }
+    if (d->lastError.error != QJsonParseError::NoError)
+        return false;
+    if (!d->atEnd) {
+        qWarning("QJsonStreamReader::leaveContainer: the container has more elements");
+        return false;
+    }
+
+    d->containerStack.removeLast();
+    d->advance();
+    preparse();
+    return true;
+}
+
+/*!
+    Returns the boolean value of the current element. This function may only
+    be called if the current element is a boolean (isBool() is true).
+
+    \sa type(), next()
+*/
+bool QJsonStreamReader::toBool() const noexcept
+{
+    Q_ASSERT(isBool());
+    return d->boolean;
+}
+
+/*!
+    Returns the value of the current element, which must be a number (that
+    is, isDouble() must be true).
+
+    \sa toInteger(), type(), next()
+*/
+double QJsonStreamReader::toDouble() const noexcept
+{
+    Q_ASSERT(isDouble());
+    return d->number;
+}
+
+/*!
+    Returns the value of the current element if it's a number whose value is
+    an integer that fits in a qint64. Otherwise returns \a defaultValue.
+
+    Unlike toDouble(), this function returns integers beyond 2\sup{53}
+    exactly.
+
+    \sa toDouble(), QJsonValue::toInteger()
+*/
+qint64 QJsonStreamReader::toInteger(qint64 defaultValue) const noexcept
+{
+    return isDouble() && d->isInteger ? d->integer : defaultValue;
+}
+
+/*!
+    Returns the current string or object key and advances to the next
+    element. This function may only be called if the current element is a
+    string (isString() is true) and there was no error.
+
+    \sa type(), readValue()
+*/
+QString QJsonStreamReader::readString()
+{
+    if (!isString() || d->lastError.error != QJsonParseError::NoError) {
+        qWarning("QJsonStreamReader::readString: the current element is not a string");
+        return QString();
+    }
+
+    QString result = std::move(d->string);
+    d->advance();
+    preparse();
+    return result;
+}
+
+/*!
+    Reads the current element, including all elements of a container, as a
+    QJsonValue and advances to the next element. Returns an undefined value
+    in case of error.
+
+    If the input ends before the end of the element, this function returns an
+    undefined value and leaves the reader positioned on the element, with the
+    QJsonParseError::PrematureEndOfDocument error: once more data is
+    available, call reparse() or addData() and readValue() again.
+
+    Reading a container with this function needs all of its data in memory at
+    once, like QJsonDocument::fromJson() does, and reports the same errors.
+    Use enterContainer() to read a large container one element at a time.
+
+    \sa readString(), QJsonDocument::fromJson()
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    if (d->lastError.error != QJsonParseError::NoError)
+        return QJsonValue(QJsonValue::Undefined);
+
+    QJsonValue result;
+    switch (type_) {
+    case Invalid:
+        return QJsonValue(QJsonValue::Undefined);
+    case Null:
+        break;
+    case Bool:
+        result = d->boolean;
+        break;
+    case Double:
+        result = d->isInteger ? QJsonValue(d->integer) : QJsonValue(d->number);
+        break;
+    case String:
+        return readString();
+
+    case Array:
+    case Object: {
+        // QJsonPrivate::Parser is much faster at building the value than
+        // going through the elements is, so only find where it ends
+        qsizetype end;
+        bool found;
+        while (!(found = d->findContainerEnd(&end)) && d->fill()) {
+        }
+        if (!found) {
+            d->handleError(QJsonParseError::PrematureEndOfDocument);
+            return QJsonValue(QJsonValue::Undefined);
+        }
+
+        QJsonParseError error;
+        const QByteArray json = QByteArray::fromRawData(d->buffer.constData() + d->elementStart,
+                                                        end - d->elementStart);
+        const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        if (error.error != QJsonParseError::NoError) {
+            d->elementStart += error.offset;
+            d->handleError(error.error);
+            return QJsonValue(QJsonValue::Undefined);
+        }
+        result = doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+        d->elementEnd = end;
+        break;
+    }
+    }
+
+    d->advance();
+    preparse();
+    return result;
+}
+
+void QJsonStreamReader::preparse()
+{
+    type_ = Invalid;
+    if (d->lastError.error != QJsonParseError::NoError)
+        return;
+
+    Type type;
+    QJsonParseError::ParseError err;
+    for (;;) {
+        err = d->parseElement(&type);
+        // after the top-level value, read the rest of the device to find
+        // any data that follows it
+        const bool needsMoreData = err == QJsonParseError::PrematureEndOfDocument
+                || (err == QJsonParseError::NoError && d->rootRead && d->device);
+        if (!needsMoreData || !d->fill())
+            break;
+    }
+    if (err == QJsonParseError::NoError)
+        type_ = type;
+    else
+        d->handleError(err);
+}
+
+QT_END_NAMESPACE
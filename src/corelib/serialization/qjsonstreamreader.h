@@ -0,0 +1,87 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QJSONSTREAMREADER_H
+#define QJSONSTREAMREADER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qstring.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QJsonStreamReaderPrivate;
+class Q_CORE_EXPORT QJsonStreamReader
+{
+public:
+    enum Type : quint8 {
+        Invalid,
+        Null,
+        Bool,
+        Double,
+        String,
+        Array,
+        Object
+    };
+
+    QJsonStreamReader();
+    QJsonStreamReader(const char *data, qsizetype len);
+    explicit QJsonStreamReader(const QByteArray &data);
+    explicit QJsonStreamReader(QIODevice *device);
+    ~QJsonStreamReader();
+    Q_DISABLE_COPY(QJsonStreamReader)
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+    void addData(const QByteArray &data);
+    void addData(const char *data, qsizetype len);
+    void reparse();
+    void clear();
+    void reset();
+
+    QJsonParseError lastError() const;
+    qint64 currentOffset() const;
+
+    bool isValid() const noexcept { return !isInvalid(); }
+
+    int containerDepth() const;
+    Type parentContainerType() const;
+    bool hasNext() const noexcept;
+    bool next();
+
+    Type type() const noexcept { return type_; }
+    bool isNull() const noexcept { return type() == Null; }
+    bool isBool() const noexcept { return type() == Bool; }
+    bool isDouble() const noexcept { return type() == Double; }
+    bool isString() const noexcept { return type() == String; }
+    bool isArray() const noexcept { return type() == Array; }
+    bool isObject() const noexcept { return type() == Object; }
+    bool isContainer() const noexcept { return isArray() || isObject(); }
+    bool isInvalid() const noexcept { return type() == Invalid; }
+
+    bool enterContainer() { Q_ASSERT(isContainer()); return _enterContainer_helper(); }
+    bool leaveContainer();
+
+    bool toBool() const noexcept;
+    double toDouble() const noexcept;
+    qint64 toInteger(qint64 defaultValue = 0) const noexcept;
+    QString readString();
+    QJsonValue readValue();
+
+private:
+    void preparse();
+    void skipToPendingDepth();
+    bool _enterContainer_helper();
+
+    std::unique_ptr<QJsonStreamReaderPrivate> d;
+    Type type_ = Invalid;
+};
+
+QT_END_NAMESPACE
+
+#endif // QJSONSTREAMREADER_H
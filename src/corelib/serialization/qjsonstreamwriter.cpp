@@ -0,0 +1,502 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamwriter.h"
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qlocale.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qjsonwriter_p.h>
+#include <QtCore/private/qnumeric_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \since 6.7
+    \brief The QJsonStreamWriter class is a simple JSON writer operating on a
+    one-way stream.
+
+    \ingroup json
+    \ingroup qtserialization
+    \reentrant
+
+    QJsonDocument::toJson() needs the whole document in memory, as QJsonObject
+    and QJsonArray values, and returns all of its text at once.
+    QJsonStreamWriter instead writes the text of a document as its elements are
+    appended, to a QIODevice or to a QByteArray. When writing to a device, it
+    writes the text in blocks of several kilobytes, so that its memory use does
+    not depend on the size of the document.
+
+    Like \l QCborStreamWriter, on which its API is modeled, QJsonStreamWriter
+    is used by appending elements with the append() overloads and by starting
+    and ending containers with startArray(), endArray(), startObject() and
+    endObject(). Inside an object, the elements are the keys, which must be
+    strings, each followed by its value:
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 1
+
+    The output is the same as QJsonDocument::toJson() in the format() that is
+    set. In the QJsonDocument::Compact format, QJsonStreamWriter writes a
+    newline between top-level values, if more than one is written, so that
+    the output is a sequence of JSON texts, one per line.
+
+    QJsonStreamWriter does not check that the containers are balanced or that
+    the document ends: endArray() and endObject() return \c false if they
+    don't match the container being written.
+
+    \sa QJsonStreamReader, QJsonDocument, QCborStreamWriter, {JSON Support in Qt}
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    enum { FlushThreshold = 16384 };
+
+    struct Level
+    {
+        bool isObject;
+        qint64 count;           // elements written so far, keys included
+    };
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<Level, 16> containerStack;
+    bool compact = false;
+    bool rootWritten = false;
+
+    QJsonStreamWriterPrivate(QIODevice *device)
+        : device(device)
+    {
+    }
+
+    QJsonStreamWriterPrivate(QByteArray *data)
+        : data(data)
+    {
+    }
+
+    QByteArray &output()
+    {
+        return data ? *data : buffer;
+    }
+
+    void flush()
+    {
+        if (device && !buffer.isEmpty())
+            device->write(buffer);
+        buffer.resize(0);
+    }
+
+    bool beginElement(bool isString);
+    void endElement();
+    void appendString(QByteArrayView text, QStringView (*toString)(QByteArrayView, QString *));
+};
+
+// Writes the separators and indentation before an element. Returns false if
+// the element can't be written here.
+bool QJsonStreamWriterPrivate::beginElement(bool isString)
+{
+    QByteArray &json = output();
+    if (containerStack.isEmpty()) {
+        if (rootWritten && compact)
+            json += '\n';
+        return true;
+    }
+
+    Level &level = containerStack.last();
+    if (level.isObject && level.count % 2) {
+        // the value of a member, after its key
+        ++level.count;
+        return true;
+    }
+    if (level.isObject && !isString) {
+        qWarning("QJsonStreamWriter: the keys of an object must be strings");
+        return false;
+    }
+
+    if (level.count)
+        json += compact ? "," : ",\n";
+    if (!compact)
+        json.append(4 * containerStack.size(), ' ');
+    ++level.count;
+    return true;
+}
+
+void QJsonStreamWriterPrivate::endElement()
+{
+    if (containerStack.isEmpty()) {
+        rootWritten = true;
+        if (!compact)
+            output() += '\n';
+        flush();
+        return;
+    }
+
+    const Level &level = containerStack.last();
+    if (level.isObject && level.count % 2)
+        output() += compact ? ":" : ": ";
+    else if (buffer.size() >= FlushThreshold)
+        flush();
+}
+
+// Writes text, in Latin-1 or UTF-8, directly if it needs no escaping and
+// through toString() otherwise.
+void QJsonStreamWriterPrivate::appendString(QByteArrayView text,
+                                            QStringView (*toString)(QByteArrayView, QString *))
+{
+    if (!beginElement(true))
+        return;
+
+    QByteArray &json = output();
+    json += '"';
+    const auto needsEscaping = [](char c) {
+        return uchar(c) < 0x20 || uchar(c) >= 0x80 || c == '"' || c == '\\';
+    };
+    if (std::none_of(text.begin(), text.end(), needsEscaping)) {
+        json += text;
+    } else {
+        QString storage;
+        QJsonPrivate::Writer::stringToJson(toString(text, &storage), json);
+    }
+    json += '"';
+    endElement();
+}
+
+/*!
+    Creates a QJsonStreamWriter object that will write the stream to
+    \a device. The device must be opened before the first append() call is
+    made. This constructor can be used with any class that derives from
+    QIODevice, such as QFile, QProcess or QTcpSocket.
+
+    QJsonStreamWriter does not take ownership of \a device, so it must remain
+    valid until this object is destroyed or another device is set.
+
+    \sa setDevice()
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d(new QJsonStreamWriterPrivate(device))
+{
+}
+
+/*!
+    Creates a QJsonStreamWriter object that will append the stream to
+    \a data. All streaming is done immediately to the byte array, without the
+    need for flushing any buffers.
+
+    \sa setDevice()
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : d(new QJsonStreamWriterPrivate(data))
+{
+}
+
+/*!
+    Destroys this QJsonStreamWriter object, writing any buffered data to the
+    device.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Replaces the device or byte array that this QJsonStreamWriter object is
+    writing to with \a device, after writing any buffered data to the previous
+    device.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+    Returns the QIODevice that this QJsonStreamWriter object is writing to,
+    or nullptr if it is writing to a QByteArray.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Sets the format of the text that is written next to \a format. The default
+    is QJsonDocument::Indented.
+
+    \sa format(), QJsonDocument::toJson()
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    d->compact = format == QJsonDocument::Compact;
+}
+
+/*!
+    Returns the format of the text that is written.
+
+    \sa setFormat()
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    return d->compact ? QJsonDocument::Compact : QJsonDocument::Indented;
+}
+
+/*!
+    \overload
+
+    Appends the integer \a i to the stream.
+*/
+void QJsonStreamWriter::append(qint64 i)
+{
+    if (!d->beginElement(false))
+        return;
+    d->output() += QByteArray::number(i);
+    d->endElement();
+}
+
+/*!
+    \overload
+
+    Appends the unsigned integer \a u to the stream.
+*/
+void QJsonStreamWriter::append(quint64 u)
+{
+    if (!d->beginElement(false))
+        return;
+    d->output() += QByteArray::number(u);
+    d->endElement();
+}
+
+/*!
+    \overload
+
+    Appends the number \a d to the stream, in the shortest form that reads
+    back as the same value. JSON has no representation for infinities and NaN,
+    so they are written as \c null.
+*/
+void QJsonStreamWriter::append(double d)
+{
+    if (!this->d->beginElement(false))
+        return;
+    if (qIsFinite(d))
+        this->d->output() += QByteArray::number(d, 'g', QLocale::FloatingPointShortest);
+    else
+        this->d->output() += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
+    this->d->endElement();
+}
+
+/*!
+    \overload
+
+    Appends the boolean value \a b to the stream.
+*/
+void QJsonStreamWriter::append(bool b)
+{
+    if (!d->beginElement(false))
+        return;
+    d->output() += b ? "true" : "false";
+    d->endElement();
+}
+
+/*!
+    \overload
+
+    Appends the Latin-1 string \a str to the stream, as a string or as the key
+    of an object member.
+*/
+void QJsonStreamWriter::append(QLatin1StringView str)
+{
+    d->appendString(QByteArrayView(str.data(), str.size()), [](QByteArrayView text, QString *s) {
+        *s = QLatin1StringView(text.data(), text.size());
+        return QStringView(*s);
+    });
+}
+
+/*!
+    \overload
+
+    Appends the string \a str to the stream, as a string or as the key of an
+    object member.
+*/
+void QJsonStreamWriter::append(QStringView str)
+{
+    if (!d->beginElement(true))
+        return;
+    QByteArray &json = d->output();
+    json += '"';
+    QJsonPrivate::Writer::stringToJson(str, json);
+    json += '"';
+    d->endElement();
+}
+
+/*!
+    \fn void QJsonStreamWriter::append(const QString &str)
+    \overload
+
+    Appends the string \a str to the stream, as a string or as the key of an
+    object member.
+*/
+
+/*!
+    \fn void QJsonStreamWriter::append(const char *str, qsizetype size)
+    \overload
+
+    Appends \a size bytes of UTF-8 text starting at \a str to the stream, as a
+    string or as the key of an object member. If \a size is -1, \a str must be
+    null-terminated.
+
+    \sa appendTextString()
+*/
+
+/*!
+    Appends \a len bytes of UTF-8 text starting at \a utf8 to the stream, as a
+    string or as the key of an object member.
+*/
+void QJsonStreamWriter::appendTextString(const char *utf8, qsizetype len)
+{
+    d->appendString(QByteArrayView(utf8, len), [](QByteArrayView text, QString *s) {
+        *s = QString::fromUtf8(text);
+        return QStringView(*s);
+    });
+}
+
+/*!
+    \overload
+
+    Appends \a value, including all elements of an array or object, to the
+    stream. An undefined value is written as \c null.
+*/
+void QJsonStreamWriter::append(const QJsonValue &value)
+{
+    if (!d->beginElement(value.isString()))
+        return;
+    const int indent = d->compact ? 0 : int(d->containerStack.size());
+    QJsonPrivate::Writer::valueToJson(QCborValue::fromJsonValue(value), d->output(), indent,
+                                      d->compact);
+    d->endElement();
+}
+
+/*!
+    \fn void QJsonStreamWriter::append(std::nullptr_t)
+    \overload
+
+    Appends \c null to the stream.
+
+    \sa appendNull()
+*/
+
+/*!
+    Appends \c null to the stream.
+*/
+void QJsonStreamWriter::appendNull()
+{
+    if (!d->beginElement(false))
+        return;
+    d->output() += "null";
+    d->endElement();
+}
+
+/*!
+    Starts an array in the stream. The elements appended after this call are
+    the elements of the array, until the matching endArray() call.
+
+    \sa endArray(), startObject()
+*/
+void QJsonStreamWriter::startArray()
+{
+    if (!d->beginElement(false))
+        return;
+    d->output() += d->compact ? "[" : "[\n";
+    d->containerStack.append({ false, 0 });
+}
+
+/*!
+    Ends the array started by the matching startArray() call. Returns false if
+    the container being written is not an array, true otherwise.
+
+    \sa startArray()
+*/
+bool QJsonStreamWriter::endArray()
+{
+    if (d->containerStack.isEmpty() || d->containerStack.last().isObject) {
+        qWarning("QJsonStreamWriter::endArray: no array to end");
+        return false;
+    }
+
+    const qint64 count = d->containerStack.last().count;
+    d->containerStack.removeLast();
+    QByteArray &json = d->output();
+    if (count && !d->compact)
+        json += '\n';
+    if (!d->compact)
+        json.append(4 * d->containerStack.size(), ' ');
+    json += ']';
+    d->endElement();
+    return true;
+}
+
+/*!
+    Starts an object in the stream. The elements appended after this call are
+    the keys of the object's members, each followed by its value, until the
+    matching endObject() call.
+
+    \sa endObject(), startArray()
+*/
+void QJsonStreamWriter::startObject()
+{
+    if (!d->beginElement(false))
+        return;
+    d->output() += d->compact ? "{" : "{\n";
+    d->containerStack.append({ true, 0 });
+}
+
+/*!
+    Ends the object started by the matching startObject() call. Returns false
+    if the container being written is not an object or if the value of its
+    last key is missing, true otherwise.
+
+    \sa startObject()
+*/
+bool QJsonStreamWriter::endObject()
+{
+    if (d->containerStack.isEmpty() || !d->containerStack.last().isObject) {
+        qWarning("QJsonStreamWriter::endObject: no object to end");
+        return false;
+    }
+    const qint64 count = d->containerStack.last().count;
+    if (count % 2) {
+        qWarning("QJsonStreamWriter::endObject: the last key has no value");
+        return false;
+    }
+
+    d->containerStack.removeLast();
+    QByteArray &json = d->output();
+    if (count && !d->compact)
+        json += '\n';
+    if (!d->compact)
+        json.append(4 * d->containerStack.size(), ' ');
+    json += '}';
+    d->endElement();
+    return true;
+}
+
+/*!
+    Writes the buffered text to the device. QJsonStreamWriter does this on its
+    own when a top-level value ends, when enough text has been buffered and
+    when it is destroyed, so calling this function is only needed for the
+    receiver to see the text of an unfinished value.
+*/
+void QJsonStreamWriter::flush()
+{
+    d->flush();
+}
+
+QT_END_NAMESPACE
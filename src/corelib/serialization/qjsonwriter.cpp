@@ -22,26 +22,28 @@ static inline uchar hexdig(uint u)
     return (u < 0xa ? '0' + u : 'a' + u - 0xa);
 }
 
-static QByteArray escapedString(QStringView s)
+void Writer::stringToJson(QStringView s, QByteArray &json)
 {
     // give it a minimum size to ensure the resize() below always adds enough space
-    QByteArray ba(qMax(s.size(), 16), Qt::Uninitialized);
+    const qsizetype start = json.size();
+    json.resize(start + qMax(s.size(), 16));
 
-    auto ba_const_start = [&]() { return reinterpret_cast<const uchar *>(ba.constData()); };
-    uchar *cursor = reinterpret_cast<uchar *>(const_cast<char *>(ba.constData()));
-    const uchar *ba_end = cursor + ba.size();
+    auto json_const_start = [&]() { return reinterpret_cast<const uchar *>(json.constData()); };
+    uchar *cursor = reinterpret_cast<uchar *>(json.data()) + start;
+    const uchar *json_end = json_const_start() + json.size();
     const char16_t *src = s.utf16();
     const char16_t *const end = s.utf16() + s.size();
 
     while (src != end) {
-        if (cursor >= ba_end - 6) {
-            // ensure we have enough space
-            qptrdiff pos = cursor - ba_const_start();
-            ba.resize(ba.size()*2);
-            cursor = reinterpret_cast<uchar *>(ba.data()) + pos;
-            ba_end = ba_const_start() + ba.size();
+        if (cursor >= json_end - 6) {
+            // ensure we have enough space: grow by what the rest of the string
+            // needs unless it's mostly escaped, not by the size of the document
+            // the string is appended to
+            qptrdiff pos = cursor - json_const_start();
+            json.resize(json.size() + (end - src) * 3 + 6);
+            cursor = reinterpret_cast<uchar *>(json.data()) + pos;
+            json_end = json_const_start() + json.size();
         }
-
         char16_t u = *src++;
         if (u < 0x80) {
             if (u < 0x20 || u == 0x22 || u == 0x5c) {
@@ -89,11 +91,10 @@ static QByteArray escapedString(QStringView s)
         }
     }
 
-    ba.resize(cursor - ba_const_start());
-    return ba;
+    json.resize(cursor - json_const_start());
 }
 
-static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact)
+void Writer::valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact)
 {
     QCborValue::Type type = v.type();
     switch (type) {
@@ -116,7 +117,7 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
     }
     case QCborValue::String:
         json += '"';
-        json += escapedString(v.toString());
+        stringToJson(v.toString(), json);
         json += '"';
         break;
     case QCborValue::Array:
@@ -149,7 +150,7 @@ static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json,
     qsizetype i = 0;
     while (true) {
         json += indentString;
-        valueToJson(a->valueAt(i), json, indent, compact);
+        Writer::valueToJson(a->valueAt(i), json, indent, compact);
 
         if (++i == a->elements.size()) {
             if (!compact)
@@ -174,9 +175,9 @@ static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json
         QCborValue e = o->valueAt(i);
         json += indentString;
         json += '"';
-        json += escapedString(o->valueAt(i).toString());
+        Writer::stringToJson(o->valueAt(i).toString(), json);
         json += compact ? "\":" : "\": ";
-        valueToJson(o->valueAt(i + 1), json, indent, compact);
+        Writer::valueToJson(o->valueAt(i + 1), json, indent, compact);
 
         if ((i += 2) == o->elements.size()) {
             if (!compact)
@@ -0,0 +1,318 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qfloatconversion_p.h"
+#include "qfloatconversion_data_p.h"
+
+#include <QtCore/qalgorithms.h>
+
+#include <cfloat>
+#include <cstring>
+#include <limits>
+
+#if defined(Q_CC_MSVC) && (defined(Q_PROCESSOR_X86_64) || defined(Q_PROCESSOR_ARM_64))
+#  include <intrin.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Conversions between double and decimal that do not need arbitrary
+    precision arithmetic, for the C locale paths of QLocale. Both use the
+    128 leading bits of the powers of ten in qfloatconversion_data_p.h.
+
+    shortestDecimal() is Raffaello Giulietti's Schubfach algorithm ("The
+    Schubfach way to render doubles", 2020), as in Java's Double.toString()
+    but without Java's requirement of at least two digits: it finds the
+    shortest decimal in the rounding interval of a double with three
+    128-bit multiplications, and no loop.
+
+    decimalToDouble() is Daniel Lemire's algorithm ("Number Parsing at a
+    Gigabyte per Second", 2021), with Clinger's fast path for small
+    exponents. It rounds correctly for every 64-bit significand ("Fast
+    Number Parsing Without Fallback", Mushtak and Lemire, 2023).
+*/
+
+namespace QFloatConversion {
+
+namespace {
+
+struct UInt128
+{
+    quint64 high;
+    quint64 low;
+};
+
+inline UInt128 multiply(quint64 a, quint64 b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const quint128 r = quint128(a) * b;
+    return { quint64(r >> 64), quint64(r) };
+#elif defined(Q_CC_MSVC) && (defined(Q_PROCESSOR_X86_64) || defined(Q_PROCESSOR_ARM_64))
+    return { __umulh(a, b), a * b };
+#else
+    const quint64 aLow = a & 0xffffffffU, aHigh = a >> 32;
+    const quint64 bLow = b & 0xffffffffU, bHigh = b >> 32;
+    const quint64 low = aLow * bLow;
+    const quint64 middle1 = aHigh * bLow + (low >> 32);
+    const quint64 middle2 = aLow * bHigh + (middle1 & 0xffffffffU);
+    return { aHigh * bHigh + (middle1 >> 32) + (middle2 >> 32), a * b };
+#endif
+}
+
+inline UInt128 powerOfTen(int q) noexcept
+{
+    Q_ASSERT(q >= MinPowerOfTen && q <= MaxPowerOfTen);
+    const quint64 *p = powersOfTen + 2 * (q - MinPowerOfTen);
+    return { p[0], p[1] };
+}
+
+constexpr int SignificandBits = std::numeric_limits<double>::digits - 1;    // 52
+constexpr int ExponentBias = std::numeric_limits<double>::max_exponent - 1; // 1023
+constexpr int MinBinaryExponent = 1 - ExponentBias - SignificandBits;       // -1074
+constexpr quint64 HiddenBit = Q_UINT64_C(1) << SignificandBits;
+constexpr quint64 SignificandMask = HiddenBit - 1;
+constexpr int InfiniteExponent = 2 * ExponentBias + 1;                      // 0x7ff
+
+inline quint64 toBits(double d) noexcept
+{
+    quint64 bits;
+    memcpy(&bits, &d, sizeof bits);
+    return bits;
+}
+
+inline double fromBits(quint64 bits) noexcept
+{
+    double d;
+    memcpy(&d, &bits, sizeof d);
+    return d;
+}
+
+// floor(e * log10(2)), floor(e * log10(3/4 * 2)) and floor(e * log2(10)), exact
+// for the exponents of doubles
+constexpr int floorLog10Pow2(int e) noexcept
+{
+    return int((qint64(e) * Q_INT64_C(661971961083)) >> 41);
+}
+
+constexpr int floorLog10ThreeQuartersPow2(int e) noexcept
+{
+    return int((qint64(e) * Q_INT64_C(661971961083) - Q_INT64_C(274743187321)) >> 41);
+}
+
+constexpr int floorLog2Pow10(int e) noexcept
+{
+    return int((qint64(e) * Q_INT64_C(913124641741)) >> 38);
+}
+
+static_assert(floorLog10Pow2(1) == 0 && floorLog10Pow2(4) == 1 && floorLog10Pow2(-1) == -1);
+static_assert(floorLog2Pow10(1) == 3 && floorLog2Pow10(-1) == -4);
+
+// Returns the product of cp and g = g1 * 2^63 + g0, divided by 2^127 and
+// rounded to odd: the lowest bit tells whether the division was inexact.
+inline quint64 roundToOdd(quint64 g1, quint64 g0, quint64 cp) noexcept
+{
+    constexpr quint64 Mask63 = (Q_UINT64_C(1) << 63) - 1;
+    const quint64 x1 = multiply(g0, cp).high;
+    const UInt128 y = multiply(g1, cp);
+    const quint64 z = (y.low >> 1) + x1;
+    const quint64 vbp = y.high + (z >> 63);
+    return vbp | (((z & Mask63) + Mask63) >> 63);
+}
+
+inline Decimal withoutTrailingZeros(quint64 significand, int exponent) noexcept
+{
+    Q_ASSERT(significand != 0);
+    while (significand % 10 == 0) {
+        significand /= 10;
+        ++exponent;
+    }
+    return { significand, exponent };
+}
+
+// The names follow the paper: v = c 2^q is the double, and the decimals
+// are scaled by 4 so that the bounds of its rounding interval are integers.
+Decimal schubfach(int q, quint64 c) noexcept
+{
+    const bool closedInterval = (c & 1) == 0;   // round to even includes the bounds
+    const quint64 cb = c << 2;
+    const quint64 cbr = cb + 2;
+    quint64 cbl;
+    int k;
+    if (c != HiddenBit || q == MinBinaryExponent) {
+        cbl = cb - 2;
+        k = floorLog10Pow2(q);
+    } else {
+        // The next lower double is closer than the next higher one
+        cbl = cb - 1;
+        k = floorLog10ThreeQuartersPow2(q);
+    }
+    const int h = q + floorLog2Pow10(-k) + 2;
+
+    // g = floor(10^-k 2^-r) + 1, where r is such that 2^125 <= g < 2^126
+    const UInt128 p = powerOfTen(-k);
+    quint64 gHigh = p.high >> 2;
+    quint64 gLow = ((p.low >> 2) | (p.high << 62)) + 1;
+    gHigh += gLow == 0;
+    const quint64 g1 = (gHigh << 1) | (gLow >> 63);
+    const quint64 g0 = gLow & ((Q_UINT64_C(1) << 63) - 1);
+
+    const quint64 vb = roundToOdd(g1, g0, cb << h);
+    const quint64 vbl = roundToOdd(g1, g0, cbl << h) + !closedInterval;
+    const quint64 vbr = roundToOdd(g1, g0, cbr << h) - !closedInterval;
+
+    // One digit less than s: exactly one of the two multiples of ten
+    // around s can be in the interval, as it is narrower than 10 * 10^k
+    const quint64 s = vb >> 2;
+    if (s >= 10) {
+        const quint64 sp10 = 10 * (s / 10);
+        const quint64 tp10 = sp10 + 10;
+        const bool upin = vbl <= sp10 << 2;
+        const bool wpin = (tp10 << 2) <= vbr;
+        if (upin != wpin)
+            return withoutTrailingZeros(upin ? sp10 : tp10, k);
+    }
+
+    // Otherwise, s or s + 1, whichever is in the interval, or closer to v
+    const quint64 t = s + 1;
+    const bool uin = vbl <= s << 2;
+    const bool win = (t << 2) <= vbr;
+    if (uin != win)
+        return withoutTrailingZeros(uin ? s : t, k);
+    const qint64 cmp = qint64(vb - ((s + t) << 1));
+    return withoutTrailingZeros(cmp < 0 || (cmp == 0 && (s & 1) == 0) ? s : t, k);
+}
+
+} // unnamed namespace
+
+Decimal shortestDecimal(double d) noexcept
+{
+    const quint64 bits = toBits(d);
+    const quint64 t = bits & SignificandMask;
+    const int biasedExponent = int(bits >> SignificandBits) & InfiniteExponent;
+    Q_ASSERT(biasedExponent != InfiniteExponent);
+    Q_ASSERT(biasedExponent != 0 || t != 0);
+
+    if (biasedExponent == 0)    // subnormal
+        return schubfach(MinBinaryExponent, t);
+
+    const int q = MinBinaryExponent - 1 + biasedExponent;
+    const quint64 c = HiddenBit | t;
+    if (q < 0 && q > -std::numeric_limits<double>::digits) {
+        // Integers below 2^53 are their own shortest representation
+        const quint64 f = c >> -q;
+        if (f << -q == c)
+            return withoutTrailingZeros(f, 0);
+    }
+    return schubfach(q, c);
+}
+
+double decimalToDouble(quint64 significand, int exponent) noexcept
+{
+    if (significand == 0 || exponent < MinPowerOfTen)
+        return 0.0;
+    if (exponent > std::numeric_limits<double>::max_exponent10)
+        return std::numeric_limits<double>::infinity();
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    // Clinger's fast path: both operands are exact, so is the rounded result
+    static constexpr double exactPowersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    constexpr int MaxExactPowerOfTen = int(std::size(exactPowersOfTen)) - 1;
+    if (significand <= HiddenBit << 1 && exponent >= -MaxExactPowerOfTen
+            && exponent <= MaxExactPowerOfTen) {
+        const double d = double(significand);
+        return exponent < 0 ? d / exactPowersOfTen[-exponent] : d * exactPowersOfTen[exponent];
+    }
+#endif
+
+    // Eisel-Lemire: multiply the normalized significand by the 128 leading
+    // bits of 10^exponent; the 55 leading bits of the product are enough to
+    // round, unless all of the bits below them are ones.
+    const int leadingZeros = qCountLeadingZeroBits(significand);
+    const quint64 w = significand << leadingZeros;
+    UInt128 power = powerOfTen(exponent);
+    if (exponent < 0 && exponent >= -27) {
+        // 5^-exponent fits in 64 bits, and the algorithm needs the table
+        // entries of these exact reciprocals rounded up
+        ++power.low;
+        power.high += power.low == 0;
+    }
+    constexpr int Precision = SignificandBits + 3;
+    constexpr quint64 PrecisionMask = ~quint64(0) >> Precision;
+    UInt128 product = multiply(w, power.high);
+    if ((product.high & PrecisionMask) == PrecisionMask) {
+        const quint64 correction = multiply(w, power.low).high;
+        product.low += correction;
+        product.high += correction > product.low;
+    }
+
+    const int upperBit = int(product.high >> 63);
+    const int shift = upperBit + 64 - Precision;
+    quint64 mantissa = product.high >> shift;
+    // floor(exponent * log2(10)) + 63, the binary exponent of the product
+    const int power2Exponent = (((152170 + 65536) * exponent) >> 16) + 63;
+    int biasedExponent = power2Exponent + upperBit - leadingZeros + ExponentBias;
+
+    if (biasedExponent <= 0) {
+        // Subnormal, or zero
+        if (-biasedExponent + 1 >= 64)
+            return 0.0;
+        mantissa >>= -biasedExponent + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        // Rounding up can make the smallest normal double
+        biasedExponent = mantissa < HiddenBit ? 0 : 1;
+        return fromBits(mantissa | (quint64(biasedExponent) << SignificandBits));
+    }
+
+    // Ties can only happen when the product is exact, which requires small
+    // exponents; round them to even, and all the others up
+    if (product.low <= 1 && exponent >= -4 && exponent <= 23 && (mantissa & 3) == 1
+            && (mantissa << shift) == product.high) {
+        mantissa &= ~quint64(1);
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (HiddenBit << 1)) {
+        mantissa = HiddenBit;
+        ++biasedExponent;
+    }
+    mantissa &= SignificandMask;
+    if (biasedExponent >= InfiniteExponent)
+        return std::numeric_limits<double>::infinity();
+    return fromBits(mantissa | (quint64(biasedExponent) << SignificandBits));
+}
+
+qsizetype writeDigits(quint64 value, char *out) noexcept
+{
+    static constexpr char digitPairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+    qsizetype length = 1;
+    for (quint64 v = value; v >= 10; v /= 10)
+        ++length;
+
+    char *p = out + length;
+    while (value >= 100) {
+        const quint64 pair = value % 100;
+        value /= 100;
+        *--p = digitPairs[2 * pair + 1];
+        *--p = digitPairs[2 * pair];
+    }
+    if (value >= 10) {
+        *--p = digitPairs[2 * value + 1];
+        *--p = digitPairs[2 * value];
+    } else {
+        *--p = char('0' + value);
+    }
+    return length;
+}
+
+} // namespace QFloatConversion
+
+QT_END_NAMESPACE
@@ -0,0 +1,51 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFLOATCONVERSION_P_H
+#define QFLOATCONVERSION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of internal files.  This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFloatConversion {
+
+// significand * 10^exponent
+struct Decimal
+{
+    quint64 significand;
+    int exponent;
+};
+
+// The longest significand shortestDecimal() can return
+constexpr int MaxShortestDigits = 17;
+
+// Returns the shortest decimal that reads back as d, the closest to d if
+// there are several, without trailing zeros in the significand (Schubfach).
+// d must be finite and non-zero; its sign is ignored.
+Decimal shortestDecimal(double d) noexcept;
+
+// Returns significand * 10^exponent rounded to the nearest double, ties to
+// even (Eisel-Lemire). Underflows to 0 and overflows to infinity.
+double decimalToDouble(quint64 significand, int exponent) noexcept;
+
+// Writes the decimal digits of value to out, which must have room for all
+// of them, and returns their count.
+qsizetype writeDigits(quint64 value, char *out) noexcept;
+
+} // namespace QFloatConversion
+
+QT_END_NAMESPACE
+
+#endif // QFLOATCONVERSION_P_H
@@ -7,6 +7,10 @@
 #include "qlocale_p.h"
 #include "qstring.h"
 
+#if !defined(QT_BOOTSTRAPPED)
+#include "qfloatconversion_p.h"
+#endif
+
 #include <private/qtools_p.h>
 #include <private/qnumeric_p.h>
 
@@ -20,6 +24,7 @@
 
 #include <limits>
 #include <charconv>
+#include <optional>
 
 #if defined(Q_OS_LINUX) && !defined(__UCLIBC__)
 #    include <fenv.h>
@@ -84,6 +89,20 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+#if !defined(QT_BOOTSTRAPPED)
+    // The shortest representation does not depend on the form. Finding it
+    // directly is much faster than libdouble-conversion, and than snprintf,
+    // which has no such mode.
+    if (precision == QLocale::FloatingPointShortest && d != 0
+            && bufSize >= QFloatConversion::MaxShortestDigits) {
+        sign = d < 0;
+        const QFloatConversion::Decimal decimal = QFloatConversion::shortestDecimal(d);
+        length = int(QFloatConversion::writeDigits(decimal.significand, buf));
+        decpt = length + decimal.exponent;
+        return;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
@@ -250,6 +269,83 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
         --length;
 }
 
+#if !defined(QT_BOOTSTRAPPED)
+// Parses num if it is a plain decimal number, [+-]digits[.digits][(e|E)[+-]digits]
+// with at least one digit before the exponent, and nothing else. Returns
+// nullopt for any other text, and for numbers whose rounding depends on
+// digits after the 19th significant one; qt_asciiToDouble() then uses the
+// general parser.
+static std::optional<QSimpleParsedNumber<double>> fastAsciiToDouble(const char *num,
+                                                                     qsizetype numLen)
+{
+    // At most 19 digits fit in a quint64
+    constexpr int MaxSignificantDigits = std::numeric_limits<quint64>::digits10;
+
+    const char *p = num;
+    const char *const end = num + numLen;
+    const bool negative = *p == '-';
+    if (negative || *p == '+')
+        ++p;
+
+    quint64 significand = 0;
+    int significantDigits = 0;
+    qint64 exponent = 0;
+    bool nonZeroDigitDropped = false;
+    qsizetype digitCount = 0;
+    auto parseDigits = [&](bool fraction) {
+        const char *begin = p;
+        for (; p != end && isAsciiDigit(*p); ++p) {
+            if (significantDigits < MaxSignificantDigits) {
+                significand = significand * 10 + (*p - '0');
+                significantDigits += significand != 0; // leading zeros are not significant
+                exponent -= fraction;
+            } else {
+                exponent += !fraction;
+                nonZeroDigitDropped = nonZeroDigitDropped || *p != '0';
+            }
+        }
+        digitCount += p - begin;
+    };
+
+    parseDigits(false);
+    if (p != end && *p == '.') {
+        ++p;
+        parseDigits(true);
+    }
+    if (digitCount == 0)
+        return std::nullopt;
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        const bool negativeExponent = p != end && *p == '-';
+        if (p != end && (*p == '-' || *p == '+'))
+            ++p;
+        if (p == end)
+            return std::nullopt;
+        int value = 0;
+        for (; p != end && isAsciiDigit(*p); ++p) {
+            if (value < 100000) // anything larger over- or underflows anyway
+                value = value * 10 + (*p - '0');
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (p != end)
+        return std::nullopt;
+
+    double d = 0;
+    if (significand != 0) {
+        const int q = int(qBound(qint64(-1000000), exponent, qint64(1000000)));
+        d = QFloatConversion::decimalToDouble(significand, q);
+        // The dropped digits make the number larger, but by less than one
+        // unit of the last kept digit: both bounds must round the same.
+        if (nonZeroDigitDropped && QFloatConversion::decimalToDouble(significand + 1, q) != d)
+            return std::nullopt;
+    }
+    const bool outOfRange = !qt_is_finite(d) || (d == 0 && significand != 0);
+    return QSimpleParsedNumber<double>{ negative ? -d : d, outOfRange ? -numLen : numLen };
+}
+#endif // !QT_BOOTSTRAPPED
+
 QSimpleParsedNumber<double> qt_asciiToDouble(const char *num, qsizetype numLen,
                                              StrayCharacterMode strayCharMode)
 {
@@ -292,6 +388,11 @@ QSimpleParsedNumber<double> qt_asciiToDouble(const char *num, qsizetype numLen,
         }
     }
 
+#if !defined(QT_BOOTSTRAPPED)
+    if (const auto r = fastAsciiToDouble(num, numLen))
+        return *r;
+#endif
+
     double d = 0.0;
     int processed;
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
@@ -790,6 +891,67 @@ QString qdtoBasicLatin(double d, QLocaleData::DoubleForm form, int precision, bo
     return dtoString<QString>(d, form, precision, uppercase);
 }
 
+qsizetype qdtoShortestBasicLatin(double d, char16_t *out) noexcept
+{
+    constexpr int BufferSize = 1 + std::numeric_limits<double>::max_digits10;
+    char buffer[BufferSize];
+    bool negative = false;
+    int length = 0;
+    int decpt = 0;
+    qt_doubleToAscii(d, QLocaleData::DFSignificantDigits, QLocale::FloatingPointShortest,
+                     buffer, BufferSize, negative, length, decpt);
+
+    // Same output as dtoString(), without the precision padding it never
+    // does in the F.P.Shortest case
+    char16_t *p = out;
+    const auto appendDigits = [&p](const char *digits, qsizetype count) {
+        for (qsizetype i = 0; i < count; ++i)
+            *p++ = char16_t(digits[i]);
+    };
+    if (negative && !isZero(d))
+        *p++ = u'-';
+    if (!qIsFinite(d)) {
+        appendDigits(buffer, length);
+        return p - out;
+    }
+
+    if (resolveFormat(QLocale::FloatingPointShortest, decpt, length) == QLocaleData::DFExponent) {
+        *p++ = char16_t(buffer[0]);
+        if (length > 1) {
+            *p++ = u'.';
+            appendDigits(buffer + 1, length - 1);
+        }
+        int exponent = decpt - 1;
+        *p++ = u'e';
+        *p++ = exponent < 0 ? u'-' : u'+';
+        exponent = std::abs(exponent);
+        if (exponent < 10)
+            *p++ = u'0';
+        p += digits(exponent);
+        char16_t *location = p;
+        qulltoString_helper<char16_t>(exponent, 10, location);
+    } else if (decpt < 0) {
+        *p++ = u'0';
+        *p++ = u'.';
+        for (; decpt < 0; ++decpt)
+            *p++ = u'0';
+        appendDigits(buffer, length);
+    } else if (decpt >= length) {
+        appendDigits(buffer, length);
+        for (int i = length; i < decpt; ++i)
+            *p++ = u'0';
+    } else {
+        if (decpt)
+            appendDigits(buffer, decpt);
+        else
+            *p++ = u'0';
+        *p++ = u'.';
+        appendDigits(buffer + decpt, length - decpt);
+    }
+    Q_ASSERT(p - out <= MaxShortestDoubleLength);
+    return p - out;
+}
+
 QByteArray qdtoAscii(double d, QLocaleData::DoubleForm form, int precision, bool uppercase)
 {
     return dtoString<QByteArray>(d, form, precision, uppercase);
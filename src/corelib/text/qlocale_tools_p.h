@@ -49,6 +49,11 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
                                      int precision, bool uppercase);
 [[nodiscard]] QByteArray qdtoAscii(double d, QLocaleData::DoubleForm form,
                                    int precision, bool uppercase);
+// Longest result of qdtoShortestBasicLatin(), e.g. "-2.2250738585072014e-308"
+constexpr qsizetype MaxShortestDoubleLength = 24;
+// Writes qdtoBasicLatin(d, DFSignificantDigits, FloatingPointShortest, false)
+// to out, without allocating; returns the number of characters written
+qsizetype qdtoShortestBasicLatin(double d, char16_t *out) noexcept;
 
 [[nodiscard]] constexpr inline bool isZero(double d)
 {
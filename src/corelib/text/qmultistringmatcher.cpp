@@ -0,0 +1,707 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmultistringmatcher.h"
+
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qsimd_p.h>
+#include <QtCore/private/qtools_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+static inline char16_t foldCase(char16_t ch, Qt::CaseSensitivity cs) noexcept
+{
+    return cs == Qt::CaseSensitive ? ch : char16_t(QChar::toCaseFolded(char32_t(ch)));
+}
+
+static inline uchar foldCase(uchar ch, Qt::CaseSensitivity cs) noexcept
+{
+    return cs == Qt::CaseSensitive ? ch : uchar(QtMiscUtils::toAsciiLower(char(ch)));
+}
+
+// Finds all occurrences of a set of patterns in text made of Char code units
+// (char16_t for UTF-16, uchar for UTF-8) in one pass.
+//
+// The patterns are compiled into an Aho-Corasick automaton, turned into a DFA
+// over classes of code units, so that the scan does one table lookup per code
+// unit. If the patterns' first two code units take few distinct values, a
+// SIMD prefilter in the style of Teddy looks for those pairs instead, and only
+// the candidate positions are compared with the patterns.
+template <typename Char>
+class MultiStringSearcher
+{
+public:
+    void compile(const QList<QList<Char>> &patterns, Qt::CaseSensitivity cs);
+
+    // Calls report(offset, patternIndex) for each match, in order of offset,
+    // and for the same offset in order of pattern index. Stops early if report
+    // returns false.
+    template <typename Report>
+    void search(const Char *text, qsizetype size, qsizetype from, Report report) const;
+
+    qsizetype patternLength(qsizetype index) const { return lengths.at(index); }
+
+private:
+    enum : quint32 { Reports = 0x80000000u };
+    enum { MaxFilterPairs = 8, AnyUnit = 0x10000 };
+
+    uint classOf(Char ch) const noexcept;
+    bool matchesAt(const Char *text, qsizetype size, qsizetype pos, qsizetype index) const noexcept;
+    template <typename Report>
+    bool verifyCandidate(const Char *text, qsizetype size, qsizetype pos, Report &report) const;
+    template <typename Report>
+    void searchAutomaton(const Char *text, qsizetype size, qsizetype from, Report &report) const;
+    template <typename Report>
+    void searchFiltered(const Char *text, qsizetype size, qsizetype from, Report &report) const;
+    void buildFilter(Qt::CaseSensitivity cs);
+
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+    qsizetype maxLength = 0;
+    QList<qsizetype> lengths;           // per pattern
+    QList<Char> foldedUnits;            // the folded patterns, one after the other
+    QList<qsizetype> unitOffsets;       // per pattern, into foldedUnits
+
+    // The DFA: each entry of transitions is the offset of the row of the next
+    // state (state * classCount), with Reports set if that state ends patterns.
+    quint16 lowClasses[256] = {};
+    QList<std::pair<char16_t, quint16>> highClasses;    // sorted, char16_t only
+    uint classCount = 1;                // class 0 is for units in no pattern
+    QList<quint32> transitions;
+    QList<qsizetype> firstPattern;      // per state, or -1
+    QList<quint32> outputLink;          // per state, the next suffix with patterns
+    QList<qsizetype> nextPattern;       // per pattern, the next one ending in its state
+
+    // The prefilter: pairs of first and second code units (AnyUnit for
+    // patterns of one unit), and the patterns starting with each folded pair.
+    struct Bucket
+    {
+        uint first;
+        uint second;
+        QList<qsizetype> patterns;      // sorted
+    };
+    QList<Bucket> buckets;
+    uint filterCount = 0;               // 0 if the filter isn't used
+    Char filterFirst[MaxFilterPairs] = {};
+    Char filterSecond[MaxFilterPairs] = {};
+    bool filterAnySecond[MaxFilterPairs] = {};
+};
+
+template <typename Char>
+uint MultiStringSearcher<Char>::classOf(Char ch) const noexcept
+{
+    if (ch < 256)
+        return lowClasses[ch];
+    // only char16_t gets here
+    const char16_t folded = foldCase(char16_t(ch), cs);
+    if (folded < 256)
+        return lowClasses[folded];
+    const auto it = std::lower_bound(highClasses.cbegin(), highClasses.cend(), folded,
+                                     [](const auto &entry, char16_t u) { return entry.first < u; });
+    return it != highClasses.cend() && it->first == folded ? it->second : 0;
+}
+
+template <typename Char>
+void MultiStringSearcher<Char>::compile(const QList<QList<Char>> &patterns,
+                                        Qt::CaseSensitivity caseSensitivity)
+{
+    cs = caseSensitivity;
+    const qsizetype patternCount = patterns.size();
+    lengths.resize(patternCount);
+    unitOffsets.resize(patternCount);
+    nextPattern.fill(-1, patternCount);
+
+    // the alphabet: one class per distinct folded unit
+    QList<Char> alphabet;
+    for (qsizetype i = 0; i < patternCount; ++i) {
+        lengths[i] = patterns.at(i).size();
+        unitOffsets[i] = foldedUnits.size();
+        maxLength = qMax(maxLength, lengths[i]);
+        for (Char ch : patterns.at(i)) {
+            foldedUnits.append(foldCase(ch, cs));
+            alphabet.append(foldedUnits.constLast());
+        }
+    }
+    std::sort(alphabet.begin(), alphabet.end());
+    alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+    classCount = uint(alphabet.size()) + 1;
+    const auto classOfFolded = [&alphabet](Char folded) {
+        const auto it = std::lower_bound(alphabet.cbegin(), alphabet.cend(), folded);
+        return it != alphabet.cend() && *it == folded ? uint(it - alphabet.cbegin()) + 1 : 0u;
+    };
+    for (uint ch = 0; ch < 256; ++ch)
+        lowClasses[ch] = quint16(classOfFolded(foldCase(Char(ch), cs)));
+    for (Char ch : std::as_const(alphabet)) {
+        if (ch >= 256)
+            highClasses.append({ char16_t(ch), quint16(classOfFolded(ch)) });
+    }
+
+    // the trie, with rows of classCount next states
+    constexpr quint32 Missing = ~0u;
+    QList<quint32> next(classCount, Missing);
+    firstPattern.fill(-1, 1);
+    for (qsizetype i = patternCount - 1; i >= 0; --i) {
+        if (!lengths.at(i))
+            continue;   // empty patterns never match
+        quint32 state = 0;
+        for (qsizetype j = 0; j < lengths.at(i); ++j) {
+            const uint c = classOfFolded(foldedUnits.at(unitOffsets.at(i) + j));
+            if (next.at(state * classCount + c) == Missing) {
+                next[state * classCount + c] = quint32(firstPattern.size());
+                next.resize(next.size() + classCount, Missing);
+                firstPattern.append(-1);
+            }
+            state = next.at(state * classCount + c);
+        }
+        // going backwards keeps the patterns of a state in order
+        nextPattern[i] = firstPattern.at(state);
+        firstPattern[state] = i;
+    }
+
+    // Aho-Corasick: complete the transitions with those of the longest proper
+    // suffix that is also a prefix (the failure state), breadth first
+    const qsizetype stateCount = firstPattern.size();
+    QList<quint32> failure(stateCount, 0);
+    outputLink.fill(0, stateCount);
+    QList<quint32> queue;
+    queue.reserve(stateCount);
+    for (uint c = 0; c < classCount; ++c) {
+        if (next.at(c) == Missing)
+            next[c] = 0;
+        else
+            queue.append(next.at(c));
+    }
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const quint32 state = queue.at(head);
+        const quint32 fail = failure.at(state);
+        for (uint c = 0; c < classCount; ++c) {
+            const quint32 child = next.at(state * classCount + c);
+            if (child == Missing) {
+                next[state * classCount + c] = next.at(fail * classCount + c);
+                continue;
+            }
+            const quint32 childFail = next.at(fail * classCount + c);
+            failure[child] = childFail;
+            outputLink[child] = firstPattern.at(childFail) >= 0 ? childFail : outputLink.at(childFail);
+            queue.append(child);
+        }
+    }
+
+    Q_ASSERT(quint64(next.size()) < Reports);
+    transitions.resize(next.size());
+    for (qsizetype i = 0; i < next.size(); ++i) {
+        const quint32 target = next.at(i);
+        const bool reports = firstPattern.at(target) >= 0 || outputLink.at(target);
+        transitions[i] = target * classCount | (reports ? quint32(Reports) : 0u);
+    }
+
+    buildFilter(cs);
+}
+
+template <typename Char>
+void MultiStringSearcher<Char>::buildFilter(Qt::CaseSensitivity cs)
+{
+    // Folding would have to be done on the text too, and Unicode case folding
+    // maps several code units to the same one, so only ASCII folding is
+    // supported by the filter.
+    constexpr bool AsciiFolding = std::is_same_v<Char, uchar>;
+    if (cs == Qt::CaseInsensitive && !AsciiFolding)
+        return;
+
+    for (qsizetype i = 0; i < lengths.size(); ++i) {
+        if (!lengths.at(i))
+            continue;
+        const Char *units = foldedUnits.constData() + unitOffsets.at(i);
+        const uint first = units[0];
+        const uint second = lengths.at(i) > 1 ? uint(units[1]) : uint(AnyUnit);
+        auto it = std::find_if(buckets.begin(), buckets.end(), [&](const Bucket &bucket) {
+            return bucket.first == first && bucket.second == second;
+        });
+        if (it == buckets.end()) {
+            if (buckets.size() == MaxFilterPairs)
+                return;
+            buckets.append({ first, second, {} });
+            it = buckets.end() - 1;
+        }
+        it->patterns.append(i);
+    }
+
+    // the raw pairs that fold to the buckets' pairs
+    const auto variants = [cs](uint folded) {
+        QVarLengthArray<uint, 2> result = { folded };
+        if (cs == Qt::CaseInsensitive && folded >= 'a' && folded <= 'z')
+            result.append(folded - 'a' + 'A');
+        return result;
+    };
+    uint count = 0;
+    for (const Bucket &bucket : std::as_const(buckets)) {
+        for (uint first : variants(bucket.first)) {
+            const auto seconds = bucket.second == AnyUnit ? QVarLengthArray<uint, 2>{ 0 }
+                                                          : variants(bucket.second);
+            for (uint second : seconds) {
+                if (count == MaxFilterPairs)
+                    return;
+                filterFirst[count] = Char(first);
+                filterSecond[count] = Char(second);
+                filterAnySecond[count] = bucket.second == AnyUnit;
+                ++count;
+            }
+        }
+    }
+    filterCount = count;
+}
+
+template <typename Char>
+bool MultiStringSearcher<Char>::matchesAt(const Char *text, qsizetype size, qsizetype pos,
+                                          qsizetype index) const noexcept
+{
+    const qsizetype length = lengths.at(index);
+    if (size - pos < length)
+        return false;
+    const Char *units = foldedUnits.constData() + unitOffsets.at(index);
+    for (qsizetype i = 0; i < length; ++i) {
+        if (foldCase(text[pos + i], cs) != units[i])
+            return false;
+    }
+    return true;
+}
+
+template <typename Char> template <typename Report>
+bool MultiStringSearcher<Char>::verifyCandidate(const Char *text, qsizetype size, qsizetype pos,
+                                                Report &report) const
+{
+    const uint first = foldCase(text[pos], cs);
+    const uint second = pos + 1 < size ? uint(foldCase(text[pos + 1], cs)) : uint(AnyUnit);
+    QVarLengthArray<qsizetype, 16> found;
+    for (const Bucket &bucket : buckets) {
+        if (bucket.first != first || (bucket.second != AnyUnit && bucket.second != second))
+            continue;
+        for (qsizetype index : bucket.patterns) {
+            if (matchesAt(text, size, pos, index))
+                found.append(index);
+        }
+    }
+    // at most two buckets match: one with a second unit, one without
+    if (found.size() > 1)
+        std::sort(found.begin(), found.end());
+    for (qsizetype index : std::as_const(found)) {
+        if (!report(pos, index))
+            return false;
+    }
+    return true;
+}
+
+template <typename Char> template <typename Report>
+void MultiStringSearcher<Char>::searchFiltered(const Char *text, qsizetype size, qsizetype from,
+                                               Report &report) const
+{
+    qsizetype pos = from;
+#ifdef __SSE2__
+    // compare Step units at a time, and the units that follow them
+    constexpr qsizetype Step = 16 / sizeof(Char);
+    const auto set1 = [](Char ch) {
+        return sizeof(Char) == 1 ? _mm_set1_epi8(char(ch)) : _mm_set1_epi16(short(ch));
+    };
+    const auto equal = [](__m128i a, __m128i b) {
+        return sizeof(Char) == 1 ? _mm_cmpeq_epi8(a, b) : _mm_cmpeq_epi16(a, b);
+    };
+    __m128i firsts[MaxFilterPairs];
+    __m128i seconds[MaxFilterPairs];
+    __m128i anySeconds[MaxFilterPairs];
+    for (uint i = 0; i < filterCount; ++i) {
+        firsts[i] = set1(filterFirst[i]);
+        seconds[i] = set1(filterSecond[i]);
+        anySeconds[i] = filterAnySecond[i] ? _mm_set1_epi8(-1) : _mm_setzero_si128();
+    }
+    for ( ; size - pos > Step; pos += Step) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + pos));
+        const __m128i following = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + pos + 1));
+        __m128i candidates = _mm_setzero_si128();
+        for (uint i = 0; i < filterCount; ++i) {
+            const __m128i secondMatches = _mm_or_si128(equal(following, seconds[i]),
+                                                       anySeconds[i]);
+            candidates = _mm_or_si128(candidates,
+                                      _mm_and_si128(equal(data, firsts[i]), secondMatches));
+        }
+        uint mask = _mm_movemask_epi8(candidates);
+        if (sizeof(Char) == 2)
+            mask &= 0x5555;     // one bit per code unit
+        for ( ; mask; mask &= mask - 1) {
+            const qsizetype candidate = pos + qCountTrailingZeroBits(mask) / sizeof(Char);
+            if (!verifyCandidate(text, size, candidate, report))
+                return;
+        }
+    }
+#endif
+    for ( ; pos < size; ++pos) {
+        for (uint i = 0; i < filterCount; ++i) {
+            if (text[pos] == filterFirst[i]
+                    && (filterAnySecond[i] || (pos + 1 < size && text[pos + 1] == filterSecond[i]))) {
+                if (!verifyCandidate(text, size, pos, report))
+                    return;
+                break;
+            }
+        }
+    }
+}
+
+template <typename Char> template <typename Report>
+void MultiStringSearcher<Char>::searchAutomaton(const Char *text, qsizetype size, qsizetype from,
+                                                Report &report) const
+{
+    const quint32 *table = transitions.constData();
+    quint32 row = 0;
+    for (qsizetype pos = from; pos < size; ++pos) {
+        row = table[row + classOf(text[pos])];
+        if (Q_LIKELY(!(row & Reports)))
+            continue;
+        row &= ~Reports;
+        const quint32 state = row / classCount;
+        for (quint32 s = firstPattern.at(state) >= 0 ? state : outputLink.at(state); s;
+             s = outputLink.at(s)) {
+            for (qsizetype index = firstPattern.at(s); index >= 0; index = nextPattern.at(index)) {
+                if (!report(pos + 1 - lengths.at(index), index))
+                    return;
+            }
+        }
+    }
+}
+
+template <typename Char> template <typename Report>
+void MultiStringSearcher<Char>::search(const Char *text, qsizetype size, qsizetype from,
+                                       Report report) const
+{
+    if (from >= size || !maxLength)
+        return;
+    if (filterCount) {
+        searchFiltered(text, size, from, report);
+        return;
+    }
+
+    // The automaton finds the matches in order of their end, so they have to
+    // be put in order first. No match is longer than maxLength, so the ones
+    // starting maxLength units before the end of the last one are final.
+    QVarLengthArray<QMultiStringMatcher::Match, 16> pending;    // sorted
+    const auto byOffset = [](const QMultiStringMatcher::Match &lhs,
+                             const QMultiStringMatcher::Match &rhs) {
+        return lhs.offset < rhs.offset
+                || (lhs.offset == rhs.offset && lhs.patternIndex < rhs.patternIndex);
+    };
+    bool stopped = false;
+    const auto flush = [&](qsizetype before) {
+        qsizetype done = 0;
+        while (done < pending.size() && pending.at(done).offset < before) {
+            if (!report(pending.at(done).offset, pending.at(done).patternIndex)) {
+                stopped = true;
+                return;
+            }
+            ++done;
+        }
+        pending.erase(pending.begin(), pending.begin() + done);
+    };
+    auto collect = [&](qsizetype offset, qsizetype index) {
+        const QMultiStringMatcher::Match match = { offset, lengths.at(index), index };
+        flush(offset + match.length - maxLength);
+        pending.insert(std::upper_bound(pending.begin(), pending.end(), match, byOffset), match);
+        return !stopped;
+    };
+    searchAutomaton(text, size, from, collect);
+    if (!stopped)
+        flush(size);
+}
+
+} // unnamed namespace
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    QMultiStringMatcherPrivate(const QStringList &patterns, Qt::CaseSensitivity cs);
+
+    template <typename Char>
+    QMultiStringMatcher::Match indexIn(const MultiStringSearcher<Char> &searcher,
+                                       const Char *text, qsizetype size, qsizetype from) const
+    {
+        QMultiStringMatcher::Match result;
+        searcher.search(text, size, qMax(from, qsizetype(0)), [&](qsizetype offset, qsizetype index) {
+            result = { offset, searcher.patternLength(index), index };
+            return false;
+        });
+        return result;
+    }
+
+    template <typename Char>
+    QList<QMultiStringMatcher::Match> matchAll(const MultiStringSearcher<Char> &searcher,
+                                               const Char *text, qsizetype size,
+                                               qsizetype from) const
+    {
+        QList<QMultiStringMatcher::Match> result;
+        searcher.search(text, size, qMax(from, qsizetype(0)), [&](qsizetype offset, qsizetype index) {
+            result.append({ offset, searcher.patternLength(index), index });
+            return true;
+        });
+        return result;
+    }
+
+    QStringList patterns;
+    Qt::CaseSensitivity cs;
+    MultiStringSearcher<char16_t> utf16;
+    MultiStringSearcher<uchar> utf8;
+};
+
+QMultiStringMatcherPrivate::QMultiStringMatcherPrivate(const QStringList &patterns,
+                                                       Qt::CaseSensitivity cs)
+    : patterns(patterns), cs(cs)
+{
+    QList<QList<char16_t>> utf16Patterns;
+    QList<QList<uchar>> utf8Patterns;
+    utf16Patterns.reserve(patterns.size());
+    utf8Patterns.reserve(patterns.size());
+    for (const QString &pattern : patterns) {
+        utf16Patterns.append(QList<char16_t>(pattern.utf16(), pattern.utf16() + pattern.size()));
+        const QByteArray utf8 = pattern.toUtf8();
+        utf8Patterns.append(QList<uchar>(utf8.cbegin(), utf8.cend()));
+    }
+    utf16.compile(utf16Patterns, cs);
+    utf8.compile(utf8Patterns, cs);
+}
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiStringMatcherPrivate)
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.7
+    \brief The QMultiStringMatcher class searches for several strings in one
+    pass over a text.
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+    \reentrant
+
+    QMultiStringMatcher is useful when you have a set of strings, for instance
+    keywords, and want to know which of them occur in a text, and where.
+    Calling QStringView::indexOf() or QStringMatcher::indexIn() once per
+    pattern reads the text once per pattern; a QMultiStringMatcher is
+    constructed once with all the patterns, and then reads each text only
+    once, however many patterns there are.
+
+    Create a QMultiStringMatcher with the list of patterns and the case
+    sensitivity, then call indexIn() to find the first match in a text, or
+    matchAll() to find all of them. Each match is reported as a Match, with
+    its offset and length in the text and the index of the pattern in the
+    list. Matches can overlap, and several patterns can match at the same
+    offset.
+
+    \snippet code/src_corelib_text_qmultistringmatcher.cpp 0
+
+    The text can be UTF-16, as a QStringView, or UTF-8, as a QByteArrayView.
+    In the latter case, the UTF-8 forms of the patterns are searched for,
+    and the offsets and lengths of the matches are in bytes.
+
+    The patterns are compiled into an automaton that looks at each character
+    of the text once. If their first two characters take only a few distinct
+    values, the text is searched for those with SIMD instructions instead,
+    and only where they are found are the patterns compared. The matches
+    found are the same either way.
+
+    Case-insensitive matching of UTF-16 text folds the case of each UTF-16
+    code unit, like QStringMatcher. In UTF-8 text, only the ASCII letters are
+    folded.
+
+    \sa QStringMatcher, QByteArrayMatcher, QLatin1StringMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.7
+    \brief The Match struct describes a match found by QMultiStringMatcher.
+
+    \sa QMultiStringMatcher::indexIn(), QMultiStringMatcher::matchAll()
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::offset
+
+    The position of the match in the text, or -1 if there is no match.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::length
+
+    The length of the match, that is of the pattern, in the code units of
+    the text.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::patternIndex
+
+    The index of the pattern in the list passed to the constructor, or -1
+    if there is no match.
+*/
+
+/*!
+    \fn bool QMultiStringMatcher::Match::isValid() const
+
+    Returns \c true if this describes a match, or \c false if nothing was
+    found.
+*/
+
+/*!
+    \fn bool QMultiStringMatcher::Match::operator==(const Match &lhs, const Match &rhs)
+
+    Returns \c true if \a lhs and \a rhs have the same offset, length and
+    pattern index; otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QMultiStringMatcher::Match::operator!=(const Match &lhs, const Match &rhs)
+
+    Returns \c true if \a lhs and \a rhs differ in offset, length or pattern
+    index; otherwise returns \c false.
+*/
+
+/*!
+    Constructs a matcher without patterns, which never finds anything.
+*/
+QMultiStringMatcher::QMultiStringMatcher() = default;
+
+/*!
+    Constructs a matcher that searches for \a patterns, with case sensitivity
+    \a cs. Empty patterns are never found.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher and returns a reference to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher and returns a reference to this
+    matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Returns the patterns this matcher searches for.
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d ? d->patterns : QStringList();
+}
+
+/*!
+    Returns the case sensitivity of this matcher.
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d ? d->cs : Qt::CaseSensitive;
+}
+
+/*!
+    Searches \a text for the patterns, starting at position \a from, and
+    returns the match with the lowest offset. If several patterns match
+    there, the one that comes first in the list of patterns is returned. If
+    nothing is found, an invalid Match is returned.
+
+    \sa matchAll(), containsAny()
+*/
+QMultiStringMatcher::Match QMultiStringMatcher::indexIn(QStringView text, qsizetype from) const
+{
+    if (!d)
+        return {};
+    return d->indexIn(d->utf16, text.utf16(), text.size(), from);
+}
+
+/*!
+    \overload
+
+    Searches the UTF-8 \a text for the patterns. The offset and length of
+    the match are in bytes.
+*/
+QMultiStringMatcher::Match QMultiStringMatcher::indexIn(QByteArrayView text, qsizetype from) const
+{
+    if (!d)
+        return {};
+    return d->indexIn(d->utf8, reinterpret_cast<const uchar *>(text.data()), text.size(), from);
+}
+
+/*!
+    \fn bool QMultiStringMatcher::containsAny(QStringView text) const
+
+    Returns \c true if any of the patterns occurs in \a text; otherwise
+    returns \c false.
+
+    \sa indexIn()
+*/
+
+/*!
+    \fn bool QMultiStringMatcher::containsAny(QByteArrayView text) const
+    \overload
+
+    Returns \c true if any of the patterns occurs in the UTF-8 \a text;
+    otherwise returns \c false.
+*/
+
+/*!
+    Returns all the matches of the patterns in \a text, starting at position
+    \a from, in order of offset, and matches at the same offset in the order
+    of the patterns. Overlapping matches are all reported.
+
+    \sa indexIn()
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::matchAll(QStringView text,
+                                                                qsizetype from) const
+{
+    if (!d)
+        return {};
+    return d->matchAll(d->utf16, text.utf16(), text.size(), from);
+}
+
+/*!
+    \overload
+
+    Returns all the matches of the patterns in the UTF-8 \a text. Their
+    offsets and lengths are in bytes.
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::matchAll(QByteArrayView text,
+                                                                qsizetype from) const
+{
+    if (!d)
+        return {};
+    return d->matchAll(d->utf8, reinterpret_cast<const uchar *>(text.data()), text.size(), from);
+}
+
+QT_END_NAMESPACE
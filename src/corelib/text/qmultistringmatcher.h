@@ -0,0 +1,70 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMULTISTRINGMATCHER_H
+#define QMULTISTRINGMATCHER_H
+
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMultiStringMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiStringMatcherPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QMultiStringMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype offset = -1;
+        qsizetype length = 0;
+        qsizetype patternIndex = -1;
+
+        constexpr bool isValid() const noexcept { return offset >= 0; }
+
+        friend constexpr bool operator==(const Match &lhs, const Match &rhs) noexcept
+        {
+            return lhs.offset == rhs.offset && lhs.length == rhs.length
+                    && lhs.patternIndex == rhs.patternIndex;
+        }
+        friend constexpr bool operator!=(const Match &lhs, const Match &rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    QMultiStringMatcher();
+    explicit QMultiStringMatcher(const QStringList &patterns,
+                                 Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiStringMatcher(const QMultiStringMatcher &other) noexcept;
+    QMultiStringMatcher(QMultiStringMatcher &&other) noexcept = default;
+    ~QMultiStringMatcher();
+    QMultiStringMatcher &operator=(const QMultiStringMatcher &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QMultiStringMatcher)
+
+    void swap(QMultiStringMatcher &other) noexcept { d.swap(other.d); }
+
+    QStringList patterns() const;
+    Qt::CaseSensitivity caseSensitivity() const;
+
+    Match indexIn(QStringView text, qsizetype from = 0) const;
+    Match indexIn(QByteArrayView text, qsizetype from = 0) const;
+    bool containsAny(QStringView text) const { return indexIn(text).isValid(); }
+    bool containsAny(QByteArrayView text) const { return indexIn(text).isValid(); }
+
+    QList<Match> matchAll(QStringView text, qsizetype from = 0) const;
+    QList<Match> matchAll(QByteArrayView text, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiStringMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiStringMatcher)
+Q_DECLARE_TYPEINFO(QMultiStringMatcher::Match, Q_PRIMITIVE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QMULTISTRINGMATCHER_H
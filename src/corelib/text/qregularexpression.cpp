@@ -5,6 +5,7 @@
 
 #include "qregularexpression.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -23,6 +24,10 @@
 
 #include <pcre2.h>
 
+#include <cstddef>
+#include <stdlib.h>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -246,6 +251,17 @@ using namespace Qt::StringLiterals;
     It is possible to pass a starting offset and one or more match options to
     the globalMatch() function, exactly like normal matching with match().
 
+    \target matching many subjects
+    \section2 Matching many subjects
+
+    To match the same regular expression against many subject strings, for
+    instance the lines of a file, use matchEach(). It calls a function with
+    the result of the match for each subject in turn, reusing the same
+    resources (and, unless the function keeps a copy of it, the same
+    QRegularExpressionMatch object) for all the subjects:
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 37
+
     \target partial matching
     \section1 Partial Matching
 
@@ -430,6 +446,15 @@ using namespace Qt::StringLiterals;
     \c{QT_ENABLE_REGEXP_JIT} environment variable to a non-zero or zero value
     respectively.
 
+    \section1 Compiled Patterns
+
+    Compiling a pattern, and optimizing it with the JIT, is expensive compared
+    to matching it against a short subject. QRegularExpression therefore keeps
+    a process-wide cache of the most recently compiled patterns, shared by all
+    threads. Creating a QRegularExpression object with the same pattern and
+    pattern options as a recently used one, for instance in a function that is
+    called repeatedly, does not compile the pattern again.
+
     \sa QRegularExpressionMatch, QRegularExpressionMatchIterator
 */
 
@@ -700,6 +725,24 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+struct QRegularExpressionCompiledPattern : QSharedData
+{
+    QRegularExpressionCompiledPattern(const QString &pattern,
+                                      QRegularExpression::PatternOptions patternOptions);
+    ~QRegularExpressionCompiledPattern();
+    Q_DISABLE_COPY_MOVE(QRegularExpressionCompiledPattern)
+
+    void getPatternInfo();
+    void optimizePattern();
+
+    pcre2_code_16 *code = nullptr;
+    int errorCode = 0;
+    qsizetype errorOffset = -1;
+    int capturingCount = 0;
+    bool usingCrLfNewlines = false;
+    bool usingJOption = false;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -708,8 +751,6 @@ struct QRegularExpressionPrivate : QSharedData
 
     void cleanCompiledPattern();
     void compilePattern();
-    void getPatternInfo();
-    void optimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -732,9 +773,12 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The compiled pattern is shared with the other QRegularExpressionPrivate
+    // objects using the same pattern and options, through the compiled pattern
+    // cache; when the private is copied (i.e. a detach happened) it is reset,
+    // and compiledPattern is set to nullptr. compiledPattern and the following
+    // members are copies of the ones in compiledData.
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> compiledData;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -752,14 +796,16 @@ struct QRegularExpressionMatchPrivate : QSharedData
                                    QRegularExpression::MatchOptions matchOptions);
 
     QRegularExpressionMatch nextMatch() const;
+    void reset(const QString &newSubject);
 
     const QRegularExpression regularExpression;
 
     // subject is what we match upon. If we've been asked to match over
     // a QString, then subjectStorage is a copy of that string
-    // (so that it's kept alive by us)
-    const QString subjectStorage;
-    const QStringView subject;
+    // (so that it's kept alive by us). They are only ever changed by
+    // reset(), when QRegularExpression::matchEach() reuses this object.
+    QString subjectStorage;
+    QStringView subject;
 
     const QRegularExpression::MatchType matchType;
     const QRegularExpression::MatchOptions matchOptions;
@@ -868,7 +914,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiledData.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -878,29 +924,26 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
 
 /*!
     \internal
+
+    Compiles \a pattern with the given \a patternOptions and, if that
+    succeeds, optimizes it and gathers the information about it that
+    QRegularExpressionPrivate needs.
 */
-void QRegularExpressionPrivate::compilePattern()
+QRegularExpressionCompiledPattern::QRegularExpressionCompiledPattern(const QString &pattern,
+                                                                     QRegularExpression::PatternOptions patternOptions)
 {
-    const QMutexLocker lock(&mutex);
-
-    if (!isDirty)
-        return;
-
-    isDirty = false;
-    cleanCompiledPattern();
-
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
     PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
-                                       pattern.size(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       nullptr);
-
-    if (!compiledPattern) {
+    code = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
+                            pattern.size(),
+                            options,
+                            &errorCode,
+                            &patternErrorOffset,
+                            nullptr);
+
+    if (!code) {
         errorOffset = qsizetype(patternErrorOffset);
         return;
     } else {
@@ -915,15 +958,23 @@ void QRegularExpressionPrivate::compilePattern()
 /*!
     \internal
 */
-void QRegularExpressionPrivate::getPatternInfo()
+QRegularExpressionCompiledPattern::~QRegularExpressionCompiledPattern()
 {
-    Q_ASSERT(compiledPattern);
+    pcre2_code_free_16(code);
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionCompiledPattern::getPatternInfo()
+{
+    Q_ASSERT(code);
 
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
+    pcre2_pattern_info_16(code, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
 
     // detect the settings for the newline
     unsigned int patternNewlineSetting;
-    if (pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
+    if (pcre2_pattern_info_16(code, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
         // no option was specified in the regexp, grab PCRE build defaults
         pcre2_config_16(PCRE2_CONFIG_NEWLINE, &patternNewlineSetting);
     }
@@ -933,8 +984,105 @@ void QRegularExpressionPrivate::getPatternInfo()
             (patternNewlineSetting == PCRE2_NEWLINE_ANYCRLF);
 
     unsigned int hasJOptionChanged;
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
-    if (Q_UNLIKELY(hasJOptionChanged)) {
+    pcre2_pattern_info_16(code, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
+    usingJOption = hasJOptionChanged;
+}
+
+namespace {
+/*
+    The process-wide cache of compiled patterns. A pcre2_code_16 is never
+    modified once it has been compiled and JIT-compiled, so it can be used
+    concurrently by any number of threads; the cache itself is protected by
+    a mutex. The entries are reference-counted, so a pattern evicted from the
+    cache stays alive for as long as a QRegularExpression uses it.
+*/
+struct CompiledPatternKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+
+    friend bool operator==(const CompiledPatternKey &lhs, const CompiledPatternKey &rhs) noexcept
+    {
+        return lhs.patternOptions == rhs.patternOptions && lhs.pattern == rhs.pattern;
+    }
+    friend size_t qHash(const CompiledPatternKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.pattern, key.patternOptions.toInt());
+    }
+};
+
+struct CompiledPatternCacheEntry
+{
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> compiled;
+};
+
+struct CompiledPatternCache
+{
+    // Number of patterns kept alive by the cache. Compiled patterns are
+    // usually a few KB (more with the JIT), so this bounds the memory used
+    // to a few MB at most.
+    enum { MaxEntries = 256 };
+
+    QBasicMutex mutex;
+    QCache<CompiledPatternKey, CompiledPatternCacheEntry> cache{MaxEntries};
+};
+}
+
+Q_GLOBAL_STATIC(CompiledPatternCache, compiledPatternCache)
+
+/*!
+    \internal
+
+    Returns the compiled form of \a pattern with \a patternOptions, from the
+    compiled pattern cache if possible. Compilation happens without holding
+    the cache's mutex; if two threads compile the same pattern at the same
+    time, the first one to finish wins and the other result is discarded.
+*/
+static QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern>
+compiledPatternFor(const QString &pattern, QRegularExpression::PatternOptions patternOptions)
+{
+    CompiledPatternCache *cache = compiledPatternCache();
+    CompiledPatternKey key{pattern, patternOptions};
+    if (cache) {
+        const QMutexLocker lock(&cache->mutex);
+        if (const CompiledPatternCacheEntry *entry = cache->cache.object(key))
+            return entry->compiled;
+    }
+
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> compiled(
+                new QRegularExpressionCompiledPattern(pattern, patternOptions));
+
+    if (cache) {
+        const QMutexLocker lock(&cache->mutex);
+        if (const CompiledPatternCacheEntry *entry = cache->cache.object(key))
+            return entry->compiled;
+        cache->cache.insert(std::move(key), new CompiledPatternCacheEntry{compiled});
+    }
+    return compiled;
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionPrivate::compilePattern()
+{
+    const QMutexLocker lock(&mutex);
+
+    if (!isDirty)
+        return;
+
+    isDirty = false;
+    cleanCompiledPattern();
+
+    compiledData = compiledPatternFor(pattern, patternOptions);
+    compiledPattern = compiledData->code;
+    errorCode = compiledData->errorCode;
+    errorOffset = compiledData->errorOffset;
+    capturingCount = compiledData->capturingCount;
+    usingCrLfNewlines = compiledData->usingCrLfNewlines;
+
+    // Warn for every QRegularExpression, not only the first one compiling the pattern
+    if (Q_UNLIKELY(compiledData->usingJOption)) {
         qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
                  qUtf16Printable(pattern));
     }
@@ -942,8 +1090,9 @@ void QRegularExpressionPrivate::getPatternInfo()
 
 
 /*
-    Simple "smartpointer" wrapper around a pcre2_jit_stack_16, to be used with
-    QThreadStorage.
+    Simple "smartpointer" wrappers around a pcre2_jit_stack_16, a
+    pcre2_match_context_16 and a pcre2_match_data_16, to be used as
+    thread-local variables.
 */
 namespace {
 struct PcreJitStackFree
@@ -955,6 +1104,79 @@ struct PcreJitStackFree
     }
 };
 Q_CONSTINIT static thread_local std::unique_ptr<pcre2_jit_stack_16, PcreJitStackFree> jitStacks;
+
+struct PcreMatchContextFree
+{
+    void operator()(pcre2_match_context_16 *context)
+    {
+        pcre2_match_context_free_16(context);
+    }
+};
+Q_CONSTINIT static thread_local std::unique_ptr<pcre2_match_context_16, PcreMatchContextFree> matchContexts;
+
+/*
+    Since PCRE2 10.41, the match data also holds the heap frames that a match
+    not done by the JIT needs for backtracking, up to the heap limit, and
+    frees them only together with it. So the match data is allocated through
+    functions that count the bytes it holds, and release() drops it when a
+    match made it larger than MaxRetainedSize, which also bounds what a
+    pattern with many capturing groups leaves behind.
+*/
+struct PcreMatchData
+{
+    static constexpr size_t MaxRetainedSize = 64 * 1024;
+
+    pcre2_match_data_16 *data = nullptr;
+    size_t allocated = 0;
+
+    ~PcreMatchData() { reset(); }
+
+    pcre2_match_data_16 *get(int capturingCount)
+    {
+        if (data && pcre2_get_ovector_count_16(data) <= uint(capturingCount))
+            reset();
+        if (!data) {
+            // the match data keeps the allocation functions of the context
+            pcre2_general_context_16 *context =
+                    pcre2_general_context_create_16(&allocate, &deallocate, this);
+            data = pcre2_match_data_create_16(qMax(capturingCount + 1, 16), context);
+            pcre2_general_context_free_16(context);
+        }
+        return data;
+    }
+
+    void release()
+    {
+        if (allocated > MaxRetainedSize)
+            reset();
+    }
+
+    void reset()
+    {
+        if (data)
+            pcre2_match_data_free_16(std::exchange(data, nullptr));
+    }
+
+    static void *allocate(PCRE2_SIZE size, void *self)
+    {
+        auto *block = static_cast<std::max_align_t *>(malloc(sizeof(std::max_align_t) + size));
+        if (!block)
+            return nullptr;
+        *reinterpret_cast<PCRE2_SIZE *>(block) = size;
+        static_cast<PcreMatchData *>(self)->allocated += size;
+        return block + 1;
+    }
+
+    static void deallocate(void *ptr, void *self)
+    {
+        if (!ptr)
+            return;
+        auto *block = static_cast<std::max_align_t *>(ptr) - 1;
+        static_cast<PcreMatchData *>(self)->allocated -= *reinterpret_cast<PCRE2_SIZE *>(block);
+        free(block);
+    }
+};
+Q_CONSTINIT static thread_local PcreMatchData matchDatas;
 }
 
 /*!
@@ -992,19 +1214,19 @@ static bool isJitEnabled()
     The purpose of the function is to call pcre2_jit_compile_16, which
     JIT-compiles the pattern.
 
-    It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    It gets called when a pattern is compiled by us (when it is not found in
+    the compiled pattern cache), before the compiled pattern is shared.
 */
-void QRegularExpressionPrivate::optimizePattern()
+void QRegularExpressionCompiledPattern::optimizePattern()
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
     static const bool enableJit = isJitEnabled();
 
     if (!enableJit)
         return;
 
-    pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
 }
 
 /*!
@@ -1141,9 +1363,16 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         previousMatchWasEmpty = true;
     }
 
-    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
-    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
-    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(compiledPattern, nullptr);
+    // The match context and the match data are reused by all the matches
+    // done by a thread; the match data is replaced when a pattern has more
+    // capturing groups than it can hold, and dropped after the match if it
+    // grew too large to keep (see PcreMatchData).
+    if (!matchContexts) {
+        matchContexts.reset(pcre2_match_context_create_16(nullptr));
+        pcre2_jit_stack_assign_16(matchContexts.get(), &qtPcreCallback, nullptr);
+    }
+    pcre2_match_context_16 *matchContext = matchContexts.get();
+    pcre2_match_data_16 *matchData = matchDatas.get(capturingCount);
 
     // PCRE does not accept a null pointer as subject string, even if
     // its length is zero. We however allow it in input: a QStringView
@@ -1257,8 +1486,7 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         }
     }
 
-    pcre2_match_data_free_16(matchData);
-    pcre2_match_context_free_16(matchContext);
+    matchDatas.release();
 }
 
 /*!
@@ -1277,6 +1505,25 @@ QRegularExpressionMatchPrivate::QRegularExpressionMatchPrivate(const QRegularExp
 {
 }
 
+/*!
+    \internal
+
+    Prepares this object, which must not be shared, for matching the same
+    regular expression again against \a newSubject. The capturedOffsets list
+    keeps its capacity.
+*/
+void QRegularExpressionMatchPrivate::reset(const QString &newSubject)
+{
+    Q_ASSERT(ref.loadRelaxed() == 1);
+    subjectStorage = newSubject;
+    subject = QStringView(subjectStorage);
+    capturedOffsets.clear();
+    capturedCount = 0;
+    hasMatch = false;
+    hasPartialMatch = false;
+    isValid = false;
+}
+
 /*!
     \internal
 */
@@ -1720,6 +1967,48 @@ QRegularExpressionMatchIterator QRegularExpression::globalMatchView(QStringView
     return QRegularExpressionMatchIterator(*priv);
 }
 
+/*!
+    \since 6.7
+
+    Matches the regular expression against each string in \a subjects, in
+    order, using a match of type \a matchType and honoring the given
+    \a matchOptions. For each subject, \a callback is called with the index
+    of the subject in \a subjects and the result of the match.
+
+    This is equivalent to calling match() on each subject, but faster: the
+    pattern is compiled only once, the resources needed for matching are
+    reused for all subjects, and the QRegularExpressionMatch object passed to
+    \a callback is reused for the next subject, unless \a callback keeps a
+    copy of it.
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 37
+
+    \sa match(), {matching many subjects}
+*/
+void QRegularExpression::matchEach(const QStringList &subjects,
+                                   qxp::function_ref<void(qsizetype, const QRegularExpressionMatch &)> callback,
+                                   MatchType matchType,
+                                   MatchOptions matchOptions) const
+{
+    d.data()->compilePattern();
+
+    const auto newPrivate = [&] {
+        return new QRegularExpressionMatchPrivate(*this, QString(), QStringView(),
+                                                  matchType, matchOptions);
+    };
+
+    QRegularExpressionMatch match(*newPrivate());
+    for (qsizetype i = 0; i < subjects.size(); ++i) {
+        // Reuse the private of the previous match, unless the callback has
+        // kept a copy of it
+        if (match.d->ref.loadRelaxed() != 1)
+            match = QRegularExpressionMatch(*newPrivate());
+        match.d->reset(subjects.at(i));
+        d->doMatch(match.d.data(), 0);
+        callback(i, std::as_const(match));
+    }
+}
+
 /*!
     \since 5.4
 
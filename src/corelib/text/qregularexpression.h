@@ -11,6 +11,7 @@
 #include <QtCore/qstringview.h>
 #include <QtCore/qshareddata.h>
 #include <QtCore/qvariant.h>
+#include <QtCore/qxpfunctional.h>
 
 #include <iterator>
 
@@ -127,6 +128,11 @@ public:
                                                     MatchType matchType       = NormalMatch,
                                                     MatchOptions matchOptions = NoMatchOption) const;
 
+    void matchEach(const QStringList &subjects,
+                   qxp::function_ref<void(qsizetype, const QRegularExpressionMatch &)> callback,
+                   MatchType matchType       = NormalMatch,
+                   MatchOptions matchOptions = NoMatchOption) const;
+
     void optimize() const;
 
     enum WildcardConversionOption {
@@ -463,6 +463,407 @@ static void simdCompareAscii(const qchar8_t *&, const qchar8_t *, const char16_t
 }
 #endif
 
+#if defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(QT_BOOTSTRAPPED)
+// Multi-byte UTF-8 in blocks of 16: the ASCII functions above stop at the
+// first non-ASCII character, these go on through the characters of up to
+// three bytes (all of the BMP except the surrogates) and leave only invalid
+// sequences and non-BMP characters to the per-character loops. They are
+// selected at runtime: the AVX2 code packs the characters together with
+// shuffles looked up in tables, the AVX512 VBMI2 code with compress
+// instructions.
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512VBMI2)
+#    define QT_FUNCTION_TARGET_STRING_ARCH_SKYLAKE_AVX512_VBMI2 \
+        QT_FUNCTION_TARGET_STRING_ARCH_SKYLAKE_AVX512 "," QT_FUNCTION_TARGET_STRING_AVX512VBMI2
+#  endif
+
+namespace {
+struct Utf8Block
+{
+    uint errors;    // one bit per byte that is or starts an invalid sequence
+    uint starts;    // one bit per byte that starts a character
+    uint pending;   // the continuation bytes at the start of the next block
+    uint tail;      // number of bytes of the character continued in the next block
+    bool ascii;     // whether all 16 bytes are ASCII
+    __m256i utf16;  // the character starting at each byte
+};
+
+enum : qsizetype {
+    Utf8BlockSize = 16,
+    // The decoders read two bytes past the block. The encoders store 16 or 32
+    // bytes at a time and may write up to 56 bytes for a block, which the
+    // three bytes per character reserved by the callers cover as long as there
+    // are 19 characters left.
+    Utf8DecodeBlockMinimum = Utf8BlockSize + 2,
+    Utf8EncodeBlockMinimum = Utf8BlockSize + 3,
+};
+} // unnamed namespace
+
+// Decodes the 16 bytes at src, the first of which are continuation bytes of a
+// character of the previous block if pending says so. Characters of up to
+// three bytes are decoded, even if they continue past the block; anything else
+// is left for the per-character code to deal with, by flagging it as an error.
+static QT_FUNCTION_TARGET(ARCH_HASWELL) Q_ALWAYS_INLINE
+Utf8Block decodeUtf8Block(const uchar *src, uint pending) noexcept
+{
+    const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 1));
+    const __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2));
+    const auto inRange = [](__m128i v, uchar lo, uchar hi) {
+        // all bytes of interest are >= 0x80, so signed comparisons do
+        return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(char(lo - 1))),
+                             _mm_cmplt_epi8(v, _mm_set1_epi8(char(hi + 1))));
+    };
+    const auto bits = [](__m128i v) { return uint(_mm_movemask_epi8(v)); };
+    const auto continuations = [&](__m128i v) {
+        return bits(_mm_cmplt_epi8(v, _mm_set1_epi8(char(0xc0))));
+    };
+
+    const __m128i lead2 = inRange(b0, 0xc2, 0xdf);
+    const __m128i lead3 = inRange(b0, 0xe0, 0xef);
+    const uint lead2Bits = bits(lead2);
+    const uint lead3Bits = bits(lead3);
+    const uint leadBits = lead2Bits | lead3Bits;
+    const uint continuation = continuations(b0);
+
+    // four-byte and invalid leading bytes
+    const uint nonAscii = bits(b0);
+    uint errors = nonAscii & ~continuation & ~leadBits;
+    // the continuation bytes must be exactly where the leading bytes say
+    const uint expected = (leadBits << 1 | lead3Bits << 2 | pending) & 0xffff;
+    errors |= continuation & ~expected;
+    errors |= leadBits & ~continuations(b1);
+    errors |= lead3Bits & ~continuations(b2);
+    // overlong (E0 80-9F) and surrogate (ED A0-BF) three-byte sequences
+    const uint upperContinuation = bits(inRange(b1, 0xa0, 0xbf));
+    errors |= bits(_mm_cmpeq_epi8(b0, _mm_set1_epi8(char(0xe0)))) & ~upperContinuation;
+    errors |= bits(_mm_cmpeq_epi8(b0, _mm_set1_epi8(char(0xed)))) & upperContinuation;
+
+    Utf8Block block;
+    block.errors = errors;
+    block.starts = ~continuation & 0xffff;
+    block.pending = (leadBits >> 15) | (lead3Bits >> 14);
+    block.tail = (lead3Bits & 0x4000) ? 2 : (leadBits >> 15);
+    block.ascii = !nonAscii;
+
+    const __m256i w0 = _mm256_cvtepu8_epi16(b0);
+    const __m256i w1 = _mm256_and_si256(_mm256_cvtepu8_epi16(b1), _mm256_set1_epi16(0x3f));
+    const __m256i w2 = _mm256_and_si256(_mm256_cvtepu8_epi16(b2), _mm256_set1_epi16(0x3f));
+    // 110y'yyyy 10xx'xxxx -> 0000'0yyy'yyxx'xxxx
+    const __m256i two = _mm256_or_si256(
+            _mm256_slli_epi16(_mm256_and_si256(w0, _mm256_set1_epi16(0x1f)), 6), w1);
+    // 1110'zzzz 10yy'yyyy 10xx'xxxx -> zzzz'yyyy'yyxx'xxxx
+    const __m256i three = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(w0, 12),
+                                                          _mm256_slli_epi16(w1, 6)), w2);
+    __m256i utf16 = _mm256_blendv_epi8(w0, two, _mm256_cvtepi8_epi16(lead2));
+    block.utf16 = _mm256_blendv_epi8(utf16, three, _mm256_cvtepi8_epi16(lead3));
+    return block;
+}
+
+// For each 8-bit mask, the _mm_shuffle_epi8() argument that moves the 16-bit
+// elements selected by the mask to the front
+static constexpr struct Utf16CompressShuffles {
+    alignas(16) uchar masks[256][16];
+} utf16CompressShuffles = [] {
+    Utf16CompressShuffles table = {};
+    for (uint mask = 0; mask < 256; ++mask) {
+        uint n = 0;
+        for (uint i = 0; i < 8; ++i) {
+            if (mask & (1u << i)) {
+                table.masks[mask][2 * n] = uchar(2 * i);
+                table.masks[mask][2 * n + 1] = uchar(2 * i + 1);
+                ++n;
+            }
+        }
+    }
+    return table;
+}();
+
+// The decoders below go through the input in steps of 16 bytes, until an
+// error or the end of the input. If the last character of the last block
+// continues past it, they take it back, so that src stays at the start of a
+// character.
+
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+void simdDecodeUtf8_avx2(char16_t *&dst, const uchar *&src, const uchar *end) noexcept
+{
+    uint pending = 0;
+    uint tail = 0;
+    while (end - src >= Utf8DecodeBlockMinimum) {
+        const Utf8Block block = decodeUtf8Block(src, pending);
+        const uint length = qCountTrailingZeroBits(block.errors | 0x10000);
+        const uint starts = block.starts & ((1u << length) - 1);
+        // compress each half with a shuffle: there is room for 8 characters,
+        // even if fewer are stored
+        for (uint half = 0; half < 2; ++half) {
+            const uint selected = (starts >> (8 * half)) & 0xff;
+            const __m128i utf16 = half ? _mm256_extracti128_si256(block.utf16, 1)
+                                       : _mm256_castsi256_si128(block.utf16);
+            const __m128i shuffle = _mm_load_si128(
+                    reinterpret_cast<const __m128i *>(utf16CompressShuffles.masks[selected]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(utf16, shuffle));
+            dst += qPopulationCount(selected);
+        }
+        if (block.errors) {
+            src += length;
+            tail = 0;
+            break;
+        }
+        pending = block.pending;
+        tail = block.tail;
+        src += Utf8BlockSize;
+        if (block.ascii)
+            break;      // the ASCII code is faster
+    }
+    if (tail) {
+        src -= tail;
+        --dst;
+    }
+    _mm256_zeroupper();
+}
+
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+const uchar *simdValidateUtf8_avx2(const uchar *src, const uchar *end) noexcept
+{
+    uint pending = 0;
+    uint tail = 0;
+    while (end - src >= Utf8DecodeBlockMinimum) {
+        const Utf8Block block = decodeUtf8Block(src, pending);
+        if (block.errors) {
+            src += qCountTrailingZeroBits(block.errors);
+            tail = 0;
+            break;
+        }
+        pending = block.pending;
+        tail = block.tail;
+        src += Utf8BlockSize;
+        if (block.ascii)
+            break;      // the ASCII code is faster
+    }
+    _mm256_zeroupper();
+    return src - tail;
+}
+
+// Returns the UTF-8 form of each of the eight UTF-16 code units in utf16
+// (which must not be surrogates) in the lowest bytes of a 32-bit lane, and
+// sets the lanes of twoOrMore and three for the code units that need at least
+// two bytes (U+0080 and up) and three bytes (U+0800 and up).
+static QT_FUNCTION_TARGET(ARCH_HASWELL) Q_ALWAYS_INLINE
+__m256i encodeUtf8Lanes(__m128i utf16, __m256i &twoOrMore, __m256i &three) noexcept
+{
+    const __m256i u = _mm256_cvtepu16_epi32(utf16);
+    const __m256i low6 = _mm256_set1_epi32(0x3f);
+    const __m256i cont = _mm256_set1_epi32(0x80);
+    twoOrMore = _mm256_cmpgt_epi32(u, _mm256_set1_epi32(0x7f));
+    three = _mm256_cmpgt_epi32(u, _mm256_set1_epi32(0x7ff));
+
+    const __m256i last = _mm256_or_si256(cont, _mm256_and_si256(u, low6));
+    const __m256i middle = _mm256_or_si256(cont, _mm256_and_si256(_mm256_srli_epi32(u, 6), low6));
+    // 0000'0yyy'yyxx'xxxx -> 110y'yyyy 10xx'xxxx
+    const __m256i two = _mm256_or_si256(
+            _mm256_or_si256(_mm256_set1_epi32(0xc0), _mm256_srli_epi32(u, 6)),
+            _mm256_slli_epi32(last, 8));
+    // zzzz'yyyy'yyxx'xxxx -> 1110'zzzz 10yy'yyyy 10xx'xxxx
+    const __m256i threeBytes = _mm256_or_si256(
+            _mm256_or_si256(_mm256_set1_epi32(0xe0), _mm256_srli_epi32(u, 12)),
+            _mm256_or_si256(_mm256_slli_epi32(middle, 8), _mm256_slli_epi32(last, 16)));
+    return _mm256_blendv_epi8(_mm256_blendv_epi8(u, two, twoOrMore), threeBytes, three);
+}
+
+// Returns the number of code units at src before the first surrogate
+static QT_FUNCTION_TARGET(ARCH_HASWELL) Q_ALWAYS_INLINE
+uint nonSurrogatePrefix(__m256i data) noexcept
+{
+    const __m256i surrogates = _mm256_cmpeq_epi16(
+            _mm256_and_si256(data, _mm256_set1_epi16(short(0xf800))),
+            _mm256_set1_epi16(short(0xd800)));
+    const quint64 mask = uint(_mm256_movemask_epi8(surrogates));
+    return qCountTrailingZeroBits(mask | quint64(1) << 32) / 2;
+}
+
+// For each combination of lengths of four characters, the _mm_shuffle_epi8()
+// argument that moves their UTF-8 bytes out of the 32-bit lanes to the front,
+// and the total number of bytes. Bit i of the index says that character i has
+// two or more bytes, bit 4 + i that it has three.
+static constexpr struct Utf8CompressShuffles {
+    alignas(16) uchar masks[256][16];
+    uchar lengths[256];
+} utf8CompressShuffles = [] {
+    Utf8CompressShuffles table = {};
+    for (uint index = 0; index < 256; ++index) {
+        uint n = 0;
+        for (uint i = 0; i < 4; ++i) {
+            const uint length = 1 + ((index >> i) & 1) + ((index >> (4 + i)) & 1);
+            for (uint j = 0; j < length; ++j)
+                table.masks[index][n++] = uchar(4 * i + j);
+        }
+        table.lengths[index] = uchar(n);
+    }
+    return table;
+}();
+
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+void simdEncodeUtf8_avx2(uchar *&dst, const char16_t *&src, const char16_t *end) noexcept
+{
+    while (end - src >= Utf8EncodeBlockMinimum) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+        const uint count = nonSurrogatePrefix(data);
+        if (!count)
+            break;
+
+        const uint used = (1u << count) - 1;
+        uint multiByte = 0;
+        for (uint half = 0; half < 2; ++half) {
+            __m256i twoOrMore, three;
+            const __m128i part = half ? _mm256_extracti128_si256(data, 1)
+                                      : _mm256_castsi256_si128(data);
+            const __m256i lanes = encodeUtf8Lanes(part, twoOrMore, three);
+            const uint halfUsed = (used >> (8 * half)) & 0xff;
+            const uint twoOrMoreBits = _mm256_movemask_ps(_mm256_castsi256_ps(twoOrMore)) & halfUsed;
+            const uint threeBits = _mm256_movemask_ps(_mm256_castsi256_ps(three)) & halfUsed;
+            multiByte |= twoOrMoreBits;
+            for (uint quarter = 0; quarter < 2; ++quarter) {
+                const uint index = ((twoOrMoreBits >> (4 * quarter)) & 0xf)
+                        | ((threeBits >> (4 * quarter)) & 0xf) << 4;
+                const __m128i bytes = quarter ? _mm256_extracti128_si256(lanes, 1)
+                                              : _mm256_castsi256_si128(lanes);
+                const __m128i shuffle = _mm_load_si128(
+                        reinterpret_cast<const __m128i *>(utf8CompressShuffles.masks[index]));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(bytes, shuffle));
+                // the characters past count were taken as one byte each
+                const uint unused = 4 - qPopulationCount((halfUsed >> (4 * quarter)) & 0xf);
+                dst += utf8CompressShuffles.lengths[index] - unused;
+            }
+        }
+        src += count;
+        if (!multiByte && count == Utf8BlockSize)
+            break;      // the ASCII code is faster
+    }
+    _mm256_zeroupper();
+}
+
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512VBMI2)
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512_VBMI2)
+void simdDecodeUtf8_avx512(char16_t *&dst, const uchar *&src, const uchar *end) noexcept
+{
+    uint pending = 0;
+    uint tail = 0;
+    while (end - src >= Utf8DecodeBlockMinimum) {
+        const Utf8Block block = decodeUtf8Block(src, pending);
+        const uint length = qCountTrailingZeroBits(block.errors | 0x10000);
+        const __mmask16 starts = __mmask16(block.starts & ((1u << length) - 1));
+        // there is room for 16 characters, even if fewer are stored
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst),
+                            _mm256_maskz_compress_epi16(starts, block.utf16));
+        dst += qPopulationCount(uint(starts));
+        if (block.errors) {
+            src += length;
+            tail = 0;
+            break;
+        }
+        pending = block.pending;
+        tail = block.tail;
+        src += Utf8BlockSize;
+        if (block.ascii)
+            break;      // the ASCII code is faster
+    }
+    if (tail) {
+        src -= tail;
+        --dst;
+    }
+    _mm256_zeroupper();
+}
+
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512_VBMI2)
+void simdEncodeUtf8_avx512(uchar *&dst, const char16_t *&src, const char16_t *end) noexcept
+{
+    while (end - src >= Utf8EncodeBlockMinimum) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+        const uint count = nonSurrogatePrefix(data);
+        if (!count)
+            break;
+
+        uint multiByte = 0;
+        for (uint half = 0; half < 2; ++half) {
+            __m256i twoOrMore, three;
+            const __m128i part = half ? _mm256_extracti128_si256(data, 1)
+                                      : _mm256_castsi256_si128(data);
+            const __m256i lanes = encodeUtf8Lanes(part, twoOrMore, three);
+            // keep the first one, two or three bytes of the lanes up to count
+            const __mmask8 used = __mmask8((1u << qBound(0, int(count) - 8 * int(half), 8)) - 1);
+            const __m256i keep = _mm256_maskz_or_epi32(used, _mm256_set1_epi32(0xff),
+                    _mm256_or_si256(_mm256_and_si256(twoOrMore, _mm256_set1_epi32(0xff00)),
+                                    _mm256_and_si256(three, _mm256_set1_epi32(0xff0000))));
+            const __mmask32 bytes = _mm256_test_epi8_mask(keep, keep);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst),
+                                _mm256_maskz_compress_epi8(bytes, lanes));
+            dst += qPopulationCount(quint32(bytes));
+            multiByte |= _mm256_movemask_ps(_mm256_castsi256_ps(twoOrMore));
+        }
+        src += count;
+        if (!multiByte && count == Utf8BlockSize)
+            break;      // the ASCII code is faster
+    }
+    _mm256_zeroupper();
+}
+#  endif // AVX512VBMI2
+
+// Decodes as many complete blocks as possible, leaving src at the sequence
+// that stopped it. Unless nothing was decoded, nextAscii is updated so the
+// caller's per-character loop handles just that sequence (or the remaining
+// bytes, if they are too few for another block) before trying again.
+static void simdDecodeUtf8(char16_t *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end)
+{
+    const uchar *const start = src;
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512VBMI2)
+    if (qCpuHasFeature(ArchSkylakeAvx512) && qCpuHasFeature(AVX512VBMI2))
+        simdDecodeUtf8_avx512(dst, src, end);
+    else
+#  endif
+    if (qCpuHasFeature(ArchHaswell))
+        simdDecodeUtf8_avx2(dst, src, end);
+    if (src != start)
+        nextAscii = end - src < Utf8DecodeBlockMinimum ? end : src + 1;
+}
+
+static const uchar *simdValidateUtf8(const uchar *src, const uchar *end, const uchar *&nextAscii)
+{
+    if (!qCpuHasFeature(ArchHaswell))
+        return src;
+    const uchar *const start = src;
+    src = simdValidateUtf8_avx2(src, end);
+    if (src != start)
+        nextAscii = end - src < Utf8DecodeBlockMinimum ? end : src + 1;
+    return src;
+}
+
+static void simdEncodeUtf8(uchar *&dst, const char16_t *&nextAscii, const char16_t *&src, const char16_t *end)
+{
+    const char16_t *const start = src;
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512VBMI2)
+    if (qCpuHasFeature(ArchSkylakeAvx512) && qCpuHasFeature(AVX512VBMI2))
+        simdEncodeUtf8_avx512(dst, src, end);
+    else
+#  endif
+    if (qCpuHasFeature(ArchHaswell))
+        simdEncodeUtf8_avx2(dst, src, end);
+    if (src != start)
+        nextAscii = end - src < Utf8EncodeBlockMinimum ? end : src + 1;
+}
+#else
+static void simdDecodeUtf8(char16_t *&, const uchar *&, const uchar *&, const uchar *)
+{
+}
+
+static const uchar *simdValidateUtf8(const uchar *src, const uchar *, const uchar *&)
+{
+    return src;
+}
+
+static void simdEncodeUtf8(uchar *&, const char16_t *&, const char16_t *&, const char16_t *)
+{
+}
+#endif
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(QStringView in)
@@ -479,6 +880,7 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
+        simdEncodeUtf8(dst, nextAscii, src, end);
 
         do {
             char16_t u = *src++;
@@ -545,6 +947,7 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
+        simdEncodeUtf8(cursor, nextAscii, src, end);
 
         do {
             char16_t uc = *src++;
@@ -648,6 +1051,7 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in) noexcept
             nextAscii = end;
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
+            simdDecodeUtf8(dst, nextAscii, src, end);
 
             do {
                 uchar b = *src++;
@@ -749,8 +1153,11 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in, QStringConve
     res = 0;
     const uchar *nextAscii = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
-            break;
+        if (src >= nextAscii) {
+            if (simdDecodeAscii(dst, nextAscii, src, end))
+                break;
+            simdDecodeUtf8(dst, nextAscii, src, end);
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -798,8 +1205,13 @@ QUtf8::ValidUtf8Result QUtf8::isValidUtf8(QByteArrayView in)
     bool isValidAscii = true;
 
     while (src < end) {
-        if (src >= nextAscii)
+        if (src >= nextAscii) {
             src = simdFindNonAscii(src, end, nextAscii);
+            if (src != end && *src >= 0x80) {
+                isValidAscii = false;
+                src = simdValidateUtf8(src, end, nextAscii);
+            }
+        }
         if (src == end)
             break;
 
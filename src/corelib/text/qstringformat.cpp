@@ -0,0 +1,228 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qstringformat.h"
+
+#include "qlocale.h"
+#include "private/qlocale_tools_p.h"
+#include "private/qstringconverter_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \macro QT_FORMAT_STRING(str)
+    \relates QFormattedString
+    \since 6.7
+
+    Wraps the UTF-16 string literal \a str, for instance \c{u"%1 of %2"},
+    so that qFormat() and qFormatTo() can parse it at compile time.
+
+    The format string contains placeholders that are replaced by the
+    arguments passed to qFormat(). It can use either of two styles:
+
+    \list
+    \li \c{%1} to \c{%99}, as with QString::arg(): \c{%1} is replaced by the
+        first argument, \c{%2} by the second one, and so on. With this style,
+        braces are not special.
+    \li \c{{}} and \c{{n}}, as with \c{std::format()}: \c{{}} is replaced by
+        the next argument, and \c{{0}}, \c{{1}}, ... by the first, second, ...
+        argument. \c{{{} and \c{}}} are written as single braces. A format
+        string cannot use both \c{{}} and \c{{n}}.
+    \endlist
+
+    The style is chosen automatically: if the format string contains a
+    \c{%n} placeholder, it uses the first style.
+
+    Numbers are written as in the C locale, unless the placeholder is
+    \c{%L1} (or \c{{:L}}, \c{{1:L}}), in which case they are formatted by
+    the default QLocale, like QLocale::toString() does.
+
+    Errors in the format string, and format strings that use more arguments
+    than are passed to qFormat(), are reported at compile time.
+
+    \sa qFormat()
+*/
+
+/*!
+    \class QFormattedString
+    \inmodule QtCore
+    \since 6.7
+    \ingroup string-processing
+
+    \brief The QFormattedString class is the result of qFormat(), a format
+    string with its arguments, which has not been written out yet.
+
+    QFormattedString is to qFormat() what QStringBuilder is to the \c{%}
+    operator: a lightweight object that knows the size of the text it
+    represents, and writes it to its destination in one go when it is
+    converted to a QString, or concatenated with other strings by
+    QStringBuilder.
+
+    \snippet code/src_corelib_text_qstringformat.cpp 0
+
+    Like QStringBuilder, a QFormattedString refers to its arguments without
+    copying them, and it should therefore not be stored (for instance with
+    \c{auto}) but converted to a QString in the same expression that created
+    it. It can be neither copied nor moved.
+
+    \sa qFormat(), qFormatTo(), QT_FORMAT_STRING()
+*/
+
+/*!
+    \fn template <typename Format, qsizetype ArgumentCount> qsizetype QFormattedString<Format, ArgumentCount>::size() const
+
+    Returns the size of the formatted text, in UTF-16 code units. If some
+    arguments are UTF-8 strings, this is an upper bound of the actual size.
+*/
+
+/*!
+    \fn template <typename Format, qsizetype ArgumentCount> void QFormattedString<Format, ArgumentCount>::appendTo(QChar *&out) const
+
+    Writes the formatted text to \a out, which must have room for at least
+    size() characters, and advances \a out past it.
+*/
+
+/*!
+    \fn template <typename Format, qsizetype ArgumentCount> QString QFormattedString<Format, ArgumentCount>::toString() const
+    \fn template <typename Format, qsizetype ArgumentCount> QFormattedString<Format, ArgumentCount>::operator QString() const
+
+    Returns the formatted text as a QString. The QString is allocated only
+    once.
+*/
+
+/*!
+    \fn template <typename Format, typename... Args> QFormattedString<Format, sizeof...(Args)> qFormat(Format format, const Args &...args)
+    \relates QFormattedString
+    \since 6.7
+
+    Returns the text of the \a format string, created with
+    QT_FORMAT_STRING(), with its placeholders replaced by \a args.
+
+    Unlike QString::arg(), qFormat() parses the format string at compile
+    time, formats all the arguments in one pass, and does not allocate
+    memory until the result is converted to a QString; then it allocates
+    it once. It does not allocate at all when used with qFormatTo() and a
+    buffer that is large enough, except when numbers are formatted
+    according to the locale.
+
+    The arguments can be:
+    \list
+    \li strings, that is anything that converts to QAnyStringView, for
+        instance QString, QStringView, QLatin1StringView or QUtf8StringView;
+        they are written as is;
+    \li characters (QChar, \c char16_t, QLatin1Char or \c char, which is
+        taken as Latin-1);
+    \li integers, written in base 10;
+    \li floating-point numbers, written in the shortest form that reads
+        back as the same \c double, like QString::number(\c{value}, 'g',
+        QLocale::FloatingPointShortest).
+    \endlist
+
+    \snippet code/src_corelib_text_qstringformat.cpp 0
+
+    \sa qFormatTo(), QT_FORMAT_STRING(), QString::arg()
+*/
+
+/*!
+    \fn template <typename Format, typename... Args> QStringView qFormatTo(QString &out, Format format, const Args &...args)
+    \relates QFormattedString
+    \since 6.7
+
+    Appends the text of the \a format string, with its placeholders replaced
+    by \a args, to \a out, and returns a view of the appended text. \a out
+    is reallocated only if its capacity is too small.
+
+    This is useful to build text in a reused buffer:
+
+    \snippet code/src_corelib_text_qstringformat.cpp 1
+
+    \sa qFormat()
+*/
+
+/*!
+    \fn template <qsizetype Prealloc, typename Format, typename... Args> QStringView qFormatTo(QVarLengthArray<char16_t, Prealloc> &out, Format format, const Args &...args)
+    \relates QFormattedString
+    \since 6.7
+    \overload
+
+    Appends the formatted text to \a out, and returns a view of the
+    appended text. No memory is allocated if the text fits in the
+    preallocated part of \a out.
+*/
+
+namespace QtPrivate {
+
+static_assert(QFormatArgument::BufferSize >= MaxShortestDoubleLength);
+
+template <typename T>
+static qsizetype integerToBasicLatin(T value, bool negative, char16_t *out) noexcept
+{
+    char16_t digits[QFormatArgument::BufferSize];
+    char16_t *p = std::end(digits);
+    do {
+        *--p = char16_t(u'0' + value % 10);
+        value /= 10;
+    } while (value);
+    if (negative)
+        *--p = u'-';
+    const qsizetype length = std::end(digits) - p;
+    memcpy(out, p, length * sizeof(char16_t));
+    return length;
+}
+
+void QFormatArgument::setNumber(qlonglong value, int usage)
+{
+    if (usage & Plain) {
+        // Negating std::numeric_limits<qlonglong>::min() is undefined behavior
+        const bool negative = value < 0;
+        const qulonglong magnitude = negative ? 1u + qulonglong(-(value + 1)) : qulonglong(value);
+        m_text = QStringView(m_buffer, integerToBasicLatin(magnitude, negative, m_buffer));
+    }
+    if (usage & Localized) {
+        m_localizedStorage = QLocale().toString(value);
+        m_localizedText = m_localizedStorage;
+        m_hasLocalizedText = true;
+    }
+}
+
+void QFormatArgument::setNumber(qulonglong value, int usage)
+{
+    if (usage & Plain)
+        m_text = QStringView(m_buffer, integerToBasicLatin(value, false, m_buffer));
+    if (usage & Localized) {
+        m_localizedStorage = QLocale().toString(value);
+        m_localizedText = m_localizedStorage;
+        m_hasLocalizedText = true;
+    }
+}
+
+void QFormatArgument::setNumber(double value, int usage)
+{
+    if (usage & Plain)
+        m_text = QStringView(m_buffer, qdtoShortestBasicLatin(value, m_buffer));
+    if (usage & Localized) {
+        m_localizedStorage = QLocale().toString(value, 'g', QLocale::FloatingPointShortest);
+        m_localizedText = m_localizedStorage;
+        m_hasLocalizedText = true;
+    }
+}
+
+void QFormatArgument::appendTo(QAnyStringView text, QChar *&out) noexcept
+{
+    text.visit([&out](auto text) {
+        using View = decltype(text);
+        if constexpr (std::is_same_v<View, QStringView>) {
+            if (const qsizetype n = text.size())
+                memcpy(out, text.data(), n * sizeof(QChar));
+            out += text.size();
+        } else if constexpr (std::is_same_v<View, QLatin1StringView>) {
+            out = QLatin1::convertToUnicode(out, text);
+        } else {
+            out = QUtf8::convertToUnicode(out, QByteArrayView(text.data(), text.size()));
+        }
+    });
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
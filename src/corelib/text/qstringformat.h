@@ -0,0 +1,418 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSTRINGFORMAT_H
+#define QSTRINGFORMAT_H
+
+#if 0
+#pragma qt_class(QStringFormat)
+#pragma qt_class(QFormattedString)
+#pragma qt_sync_stop_processing
+#endif
+
+#include <QtCore/qanystringview.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringbuilder.h>
+#include <QtCore/qstringview.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <type_traits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+struct QFormatStringBase {};
+
+enum class QFormatStringError {
+    NoError,
+    UnmatchedBrace,
+    InvalidPlaceholder,
+    MixedNumbering,
+    ZeroPlaceholder,
+};
+
+struct QFormatPlaceholder
+{
+    qsizetype position = 0;     // in the format string
+    qsizetype length = 0;       // of the placeholder text
+    int argument = -1;          // -1 for an escaped brace, written once
+    bool localized = false;
+};
+
+template <qsizetype Capacity>
+struct QParsedFormatString
+{
+    QFormatPlaceholder placeholders[Capacity] = {};
+    qsizetype count = 0;
+    int argumentCount = 0;      // highest argument used, plus one
+    QFormatStringError error = QFormatStringError::NoError;
+
+    constexpr bool uses(int argument, bool localized) const noexcept
+    {
+        for (qsizetype i = 0; i < count; ++i) {
+            if (placeholders[i].argument == argument && placeholders[i].localized == localized)
+                return true;
+        }
+        return false;
+    }
+
+    constexpr void add(qsizetype position, qsizetype length, int argument, bool localized) noexcept
+    {
+        placeholders[count++] = { position, length, argument, localized };
+        if (argument >= argumentCount)
+            argumentCount = argument + 1;
+    }
+};
+
+constexpr int formatDigitValue(char16_t c) noexcept
+{
+    return c >= u'0' && c <= u'9' ? int(c - u'0') : -1;
+}
+
+// Parses a %n placeholder (%1 to %99, optionally %L1 to %L99) at \a i;
+// returns its length, or 0 if there is no placeholder there.
+constexpr qsizetype parsePercentPlaceholder(QStringView format, qsizetype i,
+                                            int *argument, bool *localized) noexcept
+{
+    qsizetype j = i + 1;
+    *localized = j < format.size() && format[j] == u'L';
+    if (*localized)
+        ++j;
+    if (j >= format.size() || formatDigitValue(format[j].unicode()) < 0)
+        return 0;
+    int number = formatDigitValue(format[j++].unicode());
+    if (j < format.size() && formatDigitValue(format[j].unicode()) >= 0)
+        number = number * 10 + formatDigitValue(format[j++].unicode());
+    *argument = number;
+    return j - i;
+}
+
+template <qsizetype Capacity>
+constexpr QParsedFormatString<Capacity> parseFormatString(QStringView format) noexcept
+{
+    QParsedFormatString<Capacity> result;
+
+    // A format string using %1 to %99 placeholders takes braces literally;
+    // otherwise, {} and {n} are placeholders, and {{ and }} escape braces.
+    bool percentStyle = false;
+    for (qsizetype i = 0; i < format.size(); ++i) {
+        int argument = 0;
+        bool localized = false;
+        if (format[i] == u'%' && parsePercentPlaceholder(format, i, &argument, &localized)) {
+            percentStyle = true;
+            break;
+        }
+    }
+
+    if (percentStyle) {
+        for (qsizetype i = 0; i < format.size(); ++i) {
+            if (format[i] != u'%')
+                continue;
+            int argument = 0;
+            bool localized = false;
+            if (const qsizetype length = parsePercentPlaceholder(format, i, &argument, &localized)) {
+                if (argument == 0) {
+                    result.error = QFormatStringError::ZeroPlaceholder;
+                    return result;
+                }
+                result.add(i, length, argument - 1, localized);
+                i += length - 1;
+            }
+        }
+        return result;
+    }
+
+    int nextArgument = 0;
+    bool automaticNumbering = false;
+    bool manualNumbering = false;
+    for (qsizetype i = 0; i < format.size(); ++i) {
+        const char16_t c = format[i].unicode();
+        if (c == u'}') {
+            if (i + 1 < format.size() && format[i + 1] == u'}') {
+                result.add(i, 2, -1, false);
+                ++i;
+                continue;
+            }
+            result.error = QFormatStringError::UnmatchedBrace;
+            return result;
+        }
+        if (c != u'{')
+            continue;
+        if (i + 1 < format.size() && format[i + 1] == u'{') {
+            result.add(i, 2, -1, false);
+            ++i;
+            continue;
+        }
+
+        qsizetype j = i + 1;
+        int argument = -1;
+        while (j < format.size() && formatDigitValue(format[j].unicode()) >= 0) {
+            argument = (argument < 0 ? 0 : argument * 10) + formatDigitValue(format[j].unicode());
+            if (argument > 99) {
+                result.error = QFormatStringError::InvalidPlaceholder;
+                return result;
+            }
+            ++j;
+        }
+        bool localized = false;
+        if (j + 1 < format.size() && format[j] == u':' && format[j + 1] == u'L') {
+            localized = true;
+            j += 2;
+        }
+        if (j >= format.size()) {
+            result.error = QFormatStringError::UnmatchedBrace;
+            return result;
+        }
+        if (format[j] != u'}') {
+            result.error = QFormatStringError::InvalidPlaceholder;
+            return result;
+        }
+
+        if (argument < 0) {
+            automaticNumbering = true;
+            argument = nextArgument++;
+        } else {
+            manualNumbering = true;
+        }
+        if (automaticNumbering && manualNumbering) {
+            result.error = QFormatStringError::MixedNumbering;
+            return result;
+        }
+        result.add(i, j + 1 - i, argument, localized);
+        i = j;
+    }
+    return result;
+}
+
+template <typename Format>
+struct QFormatStringTraits
+{
+    static_assert(std::is_base_of_v<QFormatStringBase, Format>,
+                  "The format string must be wrapped in QT_FORMAT_STRING()");
+
+    static constexpr QStringView format = Format::view();
+    static constexpr qsizetype Capacity = format.size() / 2 + 1;
+    static constexpr QParsedFormatString<Capacity> parsed = parseFormatString<Capacity>(format);
+
+    static_assert(parsed.error != QFormatStringError::UnmatchedBrace,
+                  "QT_FORMAT_STRING: unmatched brace; write {{ and }} for literal braces");
+    static_assert(parsed.error != QFormatStringError::InvalidPlaceholder,
+                  "QT_FORMAT_STRING: invalid placeholder; use {}, {n}, {:L} or {n:L}");
+    static_assert(parsed.error != QFormatStringError::MixedNumbering,
+                  "QT_FORMAT_STRING: cannot mix automatic {} and manual {n} numbering");
+    static_assert(parsed.error != QFormatStringError::ZeroPlaceholder,
+                  "QT_FORMAT_STRING: %-style placeholders are numbered from %1");
+};
+
+class QFormatArgument
+{
+public:
+    enum Usage : quint8 {
+        Unused = 0x0,
+        Plain = 0x1,
+        Localized = 0x2,
+    };
+
+    // Room for any integer, and the shortest form of any double, in the C locale
+    static constexpr qsizetype BufferSize = 32;
+
+    QFormatArgument() = default;
+    Q_DISABLE_COPY_MOVE(QFormatArgument)
+
+    QAnyStringView text(bool localized) const noexcept
+    { return localized && m_hasLocalizedText ? QAnyStringView(m_localizedText) : m_text; }
+
+    void setText(QAnyStringView text) noexcept { m_text = text; }
+
+    void setCharacter(char16_t c) noexcept
+    {
+        m_buffer[0] = c;
+        m_text = QStringView(m_buffer, 1);
+    }
+
+    Q_CORE_EXPORT void setNumber(qlonglong value, int usage);
+    Q_CORE_EXPORT void setNumber(qulonglong value, int usage);
+    Q_CORE_EXPORT void setNumber(double value, int usage);
+
+    Q_CORE_EXPORT static void appendTo(QAnyStringView text, QChar *&out) noexcept;
+
+private:
+    // m_text and m_localizedText can point into m_buffer and
+    // m_localizedStorage, so objects of this class cannot be copied or moved
+    QAnyStringView m_text;
+    QStringView m_localizedText;
+    bool m_hasLocalizedText = false;
+    char16_t m_buffer[BufferSize];
+    QString m_localizedStorage;
+};
+
+template <typename T>
+constexpr bool IsFormatCharacter = std::is_same_v<T, QChar> || std::is_same_v<T, char16_t>
+        || std::is_same_v<T, QLatin1Char> || std::is_same_v<T, char>
+        || std::is_same_v<T, QChar::SpecialCharacter>;
+
+template <typename T>
+void setFormatArgument(QFormatArgument &argument, const T &value, int usage)
+{
+    if constexpr (IsFormatCharacter<T>) {
+        Q_UNUSED(usage);
+        if constexpr (std::is_same_v<T, char>)
+            argument.setCharacter(char16_t(uchar(value)));
+        else if constexpr (std::is_same_v<T, QLatin1Char>)
+            argument.setCharacter(char16_t(value.unicode()));
+        else
+            argument.setCharacter(QChar(value).unicode());
+    } else if constexpr (std::is_same_v<T, bool>) {
+        static_assert(!std::is_same_v<T, bool>,
+                      "qFormat() does not format bool; pass a string or an integer instead");
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        argument.setNumber(qlonglong(value), usage);
+    } else if constexpr (std::is_integral_v<T>) {
+        argument.setNumber(qulonglong(value), usage);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        argument.setNumber(double(value), usage);
+    } else {
+        static_assert(std::is_convertible_v<const T &, QAnyStringView>,
+                      "qFormat() arguments must be strings, characters or numbers");
+        Q_UNUSED(usage);
+        argument.setText(QAnyStringView(value));
+    }
+}
+
+} // namespace QtPrivate
+
+template <typename Format, qsizetype ArgumentCount>
+class QFormattedString
+{
+    using Traits = QtPrivate::QFormatStringTraits<Format>;
+    static_assert(Traits::parsed.argumentCount <= ArgumentCount,
+                  "QT_FORMAT_STRING: the format string uses more arguments than were passed");
+
+public:
+    Q_DISABLE_COPY_MOVE(QFormattedString)
+
+    qsizetype size() const noexcept
+    {
+        qsizetype result = Traits::format.size();
+        for (qsizetype i = 0; i < Traits::parsed.count; ++i) {
+            const QtPrivate::QFormatPlaceholder &p = Traits::parsed.placeholders[i];
+            result -= p.length;
+            result += p.argument < 0 ? 1 : m_arguments[p.argument].text(p.localized).size();
+        }
+        return result;
+    }
+
+    void appendTo(QChar *&out) const noexcept
+    {
+        qsizetype position = 0;
+        for (qsizetype i = 0; i < Traits::parsed.count; ++i) {
+            const QtPrivate::QFormatPlaceholder &p = Traits::parsed.placeholders[i];
+            out = copyFormat(out, position, p.position - position);
+            if (p.argument < 0)
+                *out++ = Traits::format[p.position];
+            else
+                QtPrivate::QFormatArgument::appendTo(m_arguments[p.argument].text(p.localized), out);
+            position = p.position + p.length;
+        }
+        out = copyFormat(out, position, Traits::format.size() - position);
+    }
+
+    QString toString() const
+    {
+        QString result(size(), Qt::Uninitialized);
+        QChar *out = result.data();
+        appendTo(out);
+        result.resize(out - result.constData());
+        return result;
+    }
+    operator QString() const { return toString(); }
+
+private:
+    template <typename F, typename... Args>
+    friend QFormattedString<F, sizeof...(Args)> qFormat(F, const Args &...);
+
+    template <typename... Args>
+    explicit QFormattedString(const Args &...args)
+    {
+        init(std::index_sequence_for<Args...>{}, args...);
+    }
+
+    template <std::size_t... Is, typename... Args>
+    void init(std::index_sequence<Is...>, const Args &...args)
+    {
+        (QtPrivate::setFormatArgument(m_arguments[Is], args, usage(int(Is))), ...);
+    }
+
+    static constexpr int usage(int argument) noexcept
+    {
+        return (Traits::parsed.uses(argument, false) ? QtPrivate::QFormatArgument::Plain : 0)
+             | (Traits::parsed.uses(argument, true) ? QtPrivate::QFormatArgument::Localized : 0);
+    }
+
+    static QChar *copyFormat(QChar *out, qsizetype position, qsizetype length) noexcept
+    {
+        if (length > 0)
+            memcpy(out, Traits::format.data() + position, length * sizeof(QChar));
+        return out + (length > 0 ? length : 0);
+    }
+
+    QtPrivate::QFormatArgument m_arguments[ArgumentCount ? ArgumentCount : 1];
+};
+
+#define QT_FORMAT_STRING(str) \
+    ([] { \
+        struct QtFormatString : QT_PREPEND_NAMESPACE(QtPrivate)::QFormatStringBase { \
+            static constexpr QT_PREPEND_NAMESPACE(QStringView) view() noexcept \
+            { return QT_PREPEND_NAMESPACE(QStringView)(str); } \
+        }; \
+        return QtFormatString{}; \
+    }())
+
+template <typename Format, typename... Args>
+[[nodiscard]] QFormattedString<Format, sizeof...(Args)> qFormat(Format, const Args &...args)
+{
+    return QFormattedString<Format, sizeof...(Args)>(args...);
+}
+
+template <typename Format, typename... Args>
+QStringView qFormatTo(QString &out, Format format, const Args &...args)
+{
+    const auto formatted = qFormat(format, args...);
+    const qsizetype start = out.size();
+    out.resize(start + formatted.size());
+    QChar *end = out.data() + start;
+    formatted.appendTo(end);
+    out.resize(end - out.constData());
+    return QStringView(out).sliced(start);
+}
+
+template <qsizetype Prealloc, typename Format, typename... Args>
+QStringView qFormatTo(QVarLengthArray<char16_t, Prealloc> &out, Format format, const Args &...args)
+{
+    const auto formatted = qFormat(format, args...);
+    const qsizetype start = out.size();
+    out.resize(start + formatted.size());
+    QChar *end = reinterpret_cast<QChar *>(out.data() + start);
+    formatted.appendTo(end);
+    out.resize(reinterpret_cast<char16_t *>(end) - out.data());
+    return QStringView(out.data() + start, out.size() - start);
+}
+
+template <typename Format, qsizetype ArgumentCount>
+struct QConcatenable<QFormattedString<Format, ArgumentCount>>
+{
+    typedef QFormattedString<Format, ArgumentCount> type;
+    typedef QString ConvertTo;
+    enum { ExactSize = false };
+    static qsizetype size(const type &formatted) noexcept { return formatted.size(); }
+    static inline void appendTo(const type &formatted, QChar *&out) noexcept
+    {
+        formatted.appendTo(out);
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTRINGFORMAT_H
@@ -324,10 +324,10 @@ bool QtPrivate::QStringList_contains(const QStringList *that, QLatin1StringView
 QStringList QtPrivate::QStringList_filter(const QStringList *that, const QRegularExpression &re)
 {
     QStringList res;
-    for (qsizetype i = 0; i < that->size(); ++i) {
-        if (that->at(i).contains(re))
+    re.matchEach(*that, [&](qsizetype i, const QRegularExpressionMatch &match) {
+        if (match.hasMatch())
             res << that->at(i);
-    }
+    });
     return res;
 }
 #endif // QT_CONFIG(regularexpression)
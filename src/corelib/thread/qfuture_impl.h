@@ -539,24 +539,20 @@ void Continuation<Function, ResultType, ParentResultType>::create(F &&func,
     auto continuation = [func = std::forward<F>(func), fi, promise = QPromise(fi), pool,
                          launchAsync](const QFutureInterfaceBase &parentData) mutable {
         const auto parent = QFutureInterface<ParentResultType>(parentData).future();
-        Continuation<Function, ResultType, ParentResultType> *continuationJob = nullptr;
         if (launchAsync) {
             auto asyncJob = new AsyncContinuation<Function, ResultType, ParentResultType>(
                     std::forward<Function>(func), parent, std::move(promise), pool);
             fi.setRunnable(asyncJob);
-            continuationJob = asyncJob;
+            // If continuation is successfully launched, AsyncContinuation will be deleted
+            // by the QThreadPool which has started it.
+            if (!asyncJob->execute())
+                delete asyncJob;
         } else {
-            continuationJob = new SyncContinuation<Function, ResultType, ParentResultType>(
+            // Synchronous continuations run inline, on the thread finishing the
+            // parent, so they need no allocation of their own.
+            SyncContinuation<Function, ResultType, ParentResultType> syncJob(
                     std::forward<Function>(func), parent, std::move(promise));
-        }
-
-        bool isLaunched = continuationJob->execute();
-        // If continuation is successfully launched, AsyncContinuation will be deleted
-        // by the QThreadPool which has started it. Synchronous continuation will be
-        // executed immediately, so it's safe to always delete it here.
-        if (!(launchAsync && isLaunched)) {
-            delete continuationJob;
-            continuationJob = nullptr;
+            syncJob.execute();
         }
     };
     f->d.setContinuation(ContinuationWrapper(std::move(continuation)), fi.d);
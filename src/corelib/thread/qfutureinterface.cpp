@@ -622,6 +622,12 @@ void QFutureInterfaceBase::reset()
     d->setState(QFutureInterfaceBase::NoState);
     d->progressTime.invalidate();
     d->isValid = false;
+
+    // A kept continuation runs again when the future finishes again.
+    QMutexLocker lock(&d->continuationMutex);
+    d->continuationHandoff.store(d->continuation ? QFutureInterfaceBasePrivate::Installed
+                                                 : QFutureInterfaceBasePrivate::NoContinuation,
+                                 std::memory_order_relaxed);
 }
 
 void QFutureInterfaceBase::rethrowPossibleException()
@@ -830,23 +836,38 @@ void QFutureInterfaceBase::setContinuation(std::function<void(const QFutureInter
 {
     QMutexLocker lock(&d->continuationMutex);
 
-    // If the state is ready, run continuation immediately,
-    // otherwise save it for later.
-    if (isFinished()) {
+    // If the continuation has been cleaned, only run it if the future is
+    // already finished; there's nothing to keep alive.
+    if (d->continuationState == QFutureInterfaceBasePrivate::Cleaned) {
         lock.unlock();
-        func(*this);
-        lock.relock();
+        if (isFinished())
+            func(*this);
+        return;
     }
-    // Unless the continuation has been cleaned earlier, we have to
-    // store the move-only continuation, to guarantee that the associated
-    // future's data stays alive.
-    if (d->continuationState != QFutureInterfaceBasePrivate::Cleaned) {
-        if (d->continuation) {
-            qWarning() << "Adding a continuation to a future which already has a continuation. "
-                          "The existing continuation is overwritten.";
-        }
-        d->continuation = std::move(func);
-        d->continuationData = continuationFutureData;
+
+    // Store the move-only continuation even if it runs immediately, to
+    // guarantee that the associated future's data stays alive.
+    if (d->continuation) {
+        qWarning() << "Adding a continuation to a future which already has a continuation. "
+                      "The existing continuation is overwritten.";
+    }
+    d->continuation = std::move(func);
+    d->continuationData = continuationFutureData;
+    // Publish the continuation before checking the state; pairs with the
+    // fence in runContinuation(), so that at least one of the two threads
+    // sees the other's write, and the exchange picks exactly one of them.
+    // This happens under the lock, so that cleanContinuation() can't drop
+    // the continuation before it is published.
+    d->continuationHandoff.store(QFutureInterfaceBasePrivate::Installed, std::memory_order_relaxed);
+    lock.unlock();
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!isFinished())
+        return;
+    if (d->continuationHandoff.exchange(QFutureInterfaceBasePrivate::Claimed,
+                                        std::memory_order_acq_rel)
+            == QFutureInterfaceBasePrivate::Installed) {
+        d->runInstalledContinuation(*this);
     }
 }
 
@@ -855,6 +876,11 @@ void QFutureInterfaceBase::cleanContinuation()
     if (!d)
         return;
 
+    // A continuation set while the future finished may not have been
+    // claimed yet; it must run before it is dropped.
+    if (isFinished())
+        runContinuation();
+
     QMutexLocker lock(&d->continuationMutex);
     d->continuation = nullptr;
     d->continuationState = QFutureInterfaceBasePrivate::Cleaned;
@@ -863,21 +889,32 @@ void QFutureInterfaceBase::cleanContinuation()
 
 void QFutureInterfaceBase::runContinuation() const
 {
-    QMutexLocker lock(&d->continuationMutex);
-    if (d->continuation) {
+    // Futures without a continuation finish without taking the lock.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (d->continuationHandoff.exchange(QFutureInterfaceBasePrivate::Claimed,
+                                        std::memory_order_acq_rel)
+            == QFutureInterfaceBasePrivate::Installed) {
+        d->runInstalledContinuation(*this);
+    }
+}
+
+void QFutureInterfaceBasePrivate::runInstalledContinuation(const QFutureInterfaceBase &future)
+{
+    QMutexLocker lock(&continuationMutex);
+    if (continuation) {
         // Save the continuation in a local function, to avoid calling
         // a null std::function below, in case cleanContinuation() is
         // called from some other thread right after unlock() below.
-        auto fn = std::move(d->continuation);
+        auto fn = std::move(continuation);
         lock.unlock();
-        fn(*this);
+        fn(future);
 
         lock.relock();
         // Unless the continuation has been cleaned earlier, we have to
         // store the move-only continuation, to guarantee that the associated
         // future's data stays alive.
-        if (d->continuationState != QFutureInterfaceBasePrivate::Cleaned)
-            d->continuation = std::move(fn);
+        if (continuationState != QFutureInterfaceBasePrivate::Cleaned)
+            continuation = std::move(fn);
     }
 }
 
@@ -163,6 +163,14 @@ public:
     enum ContinuationState : quint8 { Default, Canceled, Cleaned };
     std::atomic<ContinuationState> continuationState { Default };
 
+    // Decides, without locking, whether setContinuation() or the thread
+    // finishing the future runs the continuation: whichever of them moves
+    // the handoff from Installed to Claimed, once both the continuation is
+    // installed and the future is finished.
+    enum ContinuationHandoff : quint8 { NoContinuation, Installed, Claimed };
+    std::atomic<ContinuationHandoff> continuationHandoff { NoContinuation };
+    void runInstalledContinuation(const QFutureInterfaceBase &future);
+
     inline QThreadPool *pool() const
     { return m_pool ? m_pool : QThreadPool::globalInstance(); }
 
@@ -434,6 +434,134 @@ void QRecursiveMutex::unlock() noexcept
 }
 
 
+/*!
+    \class QAdaptiveMutex
+    \inmodule QtCore
+    \since 6.7
+    \brief The QAdaptiveMutex class is a QMutex that spins for a while
+    before putting a thread to sleep.
+
+    \threadsafe
+
+    \ingroup thread
+
+    When a QMutex is already locked, lock() puts the calling thread to sleep
+    until the mutex is unlocked. If the mutex is held for very short periods
+    of time, as in producer/consumer handoffs, the cost of going to sleep and
+    being woken up again dominates. QAdaptiveMutex instead first spins,
+    repeatedly checking whether the mutex has become available, and only puts
+    the thread to sleep if that doesn't happen within its spin budget.
+
+    The number of iterations actually spun adapts to how long previous lock()
+    calls had to spin to obtain this mutex, so that a mutex that is held for
+    long stops wasting CPU time. The upper limit can be changed per instance
+    with setSpinCount(). By default, it is chosen from the number of CPUs,
+    and is zero on single-CPU systems, where spinning can never succeed.
+
+    QAdaptiveMutex derives from QMutex, so it can be used with QWaitCondition
+    and wherever a QMutex pointer is expected; however, only the functions
+    called on a QAdaptiveMutex spin.
+
+    \sa QMutex, QAdaptiveSemaphore
+*/
+
+/*!
+    \fn QAdaptiveMutex::QAdaptiveMutex()
+
+    Constructs a new mutex with the default spin budget. The mutex is created
+    in an unlocked state.
+*/
+
+/*!
+    \fn QAdaptiveMutex::QAdaptiveMutex(int spinCount)
+
+    Constructs a new mutex that spins at most \a spinCount times before
+    putting a thread to sleep. The mutex is created in an unlocked state.
+
+    \sa setSpinCount()
+*/
+
+/*!
+    \fn void QAdaptiveMutex::setSpinCount(int spinCount)
+
+    Sets the maximum number of times lock() and tryLock() spin before putting
+    the calling thread to sleep to \a spinCount. Zero disables spinning, a
+    negative value restores the default.
+
+    \sa spinCount()
+*/
+
+/*!
+    Returns the maximum number of times lock() and tryLock() spin before
+    putting the calling thread to sleep.
+
+    \sa setSpinCount()
+*/
+int QAdaptiveMutex::spinCount() const noexcept
+{
+    const int spinCount = spinBudget.loadRelaxed();
+    return spinCount < 0 ? QtPrivate::defaultSpinCount() : spinCount;
+}
+
+/*!
+    \fn void QAdaptiveMutex::lock()
+
+    Locks the mutex. If another thread has locked the mutex, this call spins
+    until the mutex becomes available or the spin budget is exhausted, and
+    then blocks until that thread has unlocked it.
+
+    \sa QMutex::lock(), setSpinCount()
+*/
+
+/*!
+    \fn bool QAdaptiveMutex::tryLock(QDeadlineTimer timeout)
+
+    Attempts to lock the mutex, spinning and then waiting until \a timeout
+    expires for the mutex to become available. Returns \c true if the lock was
+    obtained; otherwise returns \c false.
+
+    \sa QMutex::tryLock(QDeadlineTimer)
+*/
+
+/*!
+    \fn bool QAdaptiveMutex::tryLock(int timeout)
+    \overload
+
+    Attempts to lock the mutex, spinning and then waiting for at most
+    \a timeout milliseconds for the mutex to become available.
+*/
+
+/*!
+    \fn template <class Rep, class Period> bool QAdaptiveMutex::try_lock_for(std::chrono::duration<Rep, Period> duration)
+
+    Same as tryLock(QDeadlineTimer(\a duration)).
+*/
+
+/*!
+    \fn template<class Clock, class Duration> bool QAdaptiveMutex::try_lock_until(std::chrono::time_point<Clock, Duration> timePoint)
+
+    Same as tryLock(QDeadlineTimer(\a timePoint)).
+*/
+
+bool QAdaptiveMutex::spinLock() noexcept
+{
+    return QtPrivate::adaptiveSpin([this] { return QMutex::tryLock(); },
+                                   spinBudget.loadRelaxed(), averageSpins);
+}
+
+/*!
+    \internal
+
+    Returns the spin budget used by QAdaptiveMutex and QAdaptiveSemaphore
+    unless set explicitly: spinning only makes sense if another CPU can
+    release the lock in the meantime.
+*/
+int QtPrivate::defaultSpinCount() noexcept
+{
+    static const int spinCount = QThread::idealThreadCount() > 1 ? 100 : 0;
+    return spinCount;
+}
+
 /*!
     \class QMutexLocker
     \inmodule QtCore
@@ -215,6 +215,59 @@ bool QRecursiveMutex::tryLock(int timeout) QT_MUTEX_LOCK_NOEXCEPT
 }
 #endif
 
+class Q_CORE_EXPORT QAdaptiveMutex : public QMutex
+{
+public:
+    constexpr QAdaptiveMutex() noexcept = default;
+    constexpr explicit QAdaptiveMutex(int spinCount) noexcept
+        : spinBudget(spinCount)
+    {}
+
+    void setSpinCount(int spinCount) noexcept { spinBudget.storeRelaxed(spinCount); }
+    int spinCount() const noexcept;
+
+    // BasicLockable concept
+    void lock() QT_MUTEX_LOCK_NOEXCEPT
+    {
+        if (!tryLock() && !spinLock())
+            QMutex::lock();
+    }
+
+    using QMutex::tryLock;
+    bool tryLock(int timeout) QT_MUTEX_LOCK_NOEXCEPT
+    {
+        return tryLock(QDeadlineTimer(timeout));
+    }
+    bool tryLock(QDeadlineTimer timeout) QT_MUTEX_LOCK_NOEXCEPT
+    {
+        if (tryLock())
+            return true;
+        if (!timeout.hasExpired() && spinLock())
+            return true;
+        return QMutex::tryLock(timeout);
+    }
+
+    // TimedLockable concept
+    template <class Rep, class Period>
+    bool try_lock_for(std::chrono::duration<Rep, Period> duration)
+    {
+        return tryLock(QDeadlineTimer(duration));
+    }
+
+    // TimedLockable concept
+    template<class Clock, class Duration>
+    bool try_lock_until(std::chrono::time_point<Clock, Duration> timePoint)
+    {
+        return tryLock(QDeadlineTimer(timePoint));
+    }
+
+private:
+    bool spinLock() noexcept;
+
+    QAtomicInt spinBudget = -1; // -1: use the default
+    QAtomicInt averageSpins = 0;
+};
+
 template <typename Mutex>
 class [[nodiscard]] QMutexLocker
 {
@@ -312,6 +365,16 @@ private:
 
 class QRecursiveMutex : public QMutex {};
 
+class QAdaptiveMutex : public QMutex
+{
+public:
+    constexpr QAdaptiveMutex() noexcept { }
+    constexpr explicit QAdaptiveMutex(int) noexcept { }
+
+    void setSpinCount(int) noexcept {}
+    int spinCount() const noexcept { return 0; }
+};
+
 template <typename Mutex>
 class [[nodiscard]] QMutexLocker
 {
@@ -22,6 +22,7 @@
 #include <QtCore/qmutex.h>
 #include <QtCore/qatomic.h>
 #include <QtCore/qdeadlinetimer.h>
+#include <QtCore/private/qsimd_p.h>
 
 #include "qplatformdefs.h" // _POSIX_VERSION
 
@@ -89,6 +90,45 @@ public:
 #endif
 };
 
+namespace QtPrivate {
+int defaultSpinCount() noexcept;
+
+/*!
+    \internal
+
+    Spins calling \a tryAcquire until it succeeds or the spin budget runs
+    out, and returns whether it succeeded. The budget is \a maxSpins
+    iterations (the default budget if negative), further limited by the
+    running average of the spins that previous calls needed, which is kept
+    in \a averageSpins. A lock that is usually released quickly is
+    therefore spun on for a while, while one that is held for long falls
+    back to parking the thread almost immediately.
+*/
+template <typename TryAcquire>
+bool adaptiveSpin(TryAcquire tryAcquire, int maxSpins, QAtomicInt &averageSpins) noexcept
+{
+    if (maxSpins < 0)
+        maxSpins = defaultSpinCount();
+    if (maxSpins == 0)
+        return false;
+
+    const int average = averageSpins.loadRelaxed();
+    const int limit = qMin(maxSpins, 2 * average + 16);
+    int spins = 0;
+    bool acquired = false;
+    while (spins < limit) {
+        ++spins;
+        qYieldCpu();
+        if (tryAcquire()) {
+            acquired = true;
+            break;
+        }
+    }
+    averageSpins.storeRelaxed(average + (spins - average) / 8);
+    return acquired;
+}
+} // namespace QtPrivate
+
 QT_END_NAMESPACE
 
 #endif // QMUTEX_P_H
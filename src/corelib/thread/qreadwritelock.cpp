@@ -9,6 +9,7 @@
 #include "qthread.h"
 #include "qreadwritelock_p.h"
 #include "qelapsedtimer.h"
+#include "qmath.h"
 #include "private/qfreelist_p.h"
 #include "private/qlocking_p.h"
 
@@ -577,6 +578,245 @@ void QReadWriteLockPrivate::release()
     qrwl_freelist->release(id);
 }
 
+/*!
+    \class QShardedReadWriteLock
+    \inmodule QtCore
+    \since 6.7
+    \brief The QShardedReadWriteLock class provides read-write locking
+    optimized for resources that are read far more often than written.
+
+    \threadsafe
+
+    \ingroup thread
+
+    QShardedReadWriteLock has the same locking semantics as a non-recursive
+    QReadWriteLock, but distributes the reader count over several counters,
+    one per group of threads. Taking a read lock only modifies the counter
+    belonging to the calling thread, so readers running in parallel on
+    different CPUs do not contend on a shared cache line. The price is paid
+    by writers: lockForWrite() has to inspect every counter and wait until
+    all of them drop to zero. Use this class when writing is rare and many
+    threads read concurrently; otherwise prefer QReadWriteLock, which is
+    smaller and cheaper to lock for writing.
+
+    Waiting writers have priority: once a thread has started to lock for
+    writing, new readers block until the writer has unlocked.
+
+    A lock obtained with lockForRead() or tryLockForRead() must be unlocked
+    by the thread that obtained it.
+
+    The class also provides the \c lock_shared(), \c try_lock_shared(),
+    \c unlock_shared(), \c lock() and \c try_lock() member functions, so it
+    can be used with \c std::shared_lock and \c std::unique_lock.
+
+    \sa QReadWriteLock
+*/
+
+namespace {
+Q_CONSTINIT std::atomic<int> nextReaderShard = 0;
+Q_CONSTINIT thread_local int currentReaderShard = -1;
+}
+
+inline QShardedReadWriteLockPrivate::Shard &
+QShardedReadWriteLockPrivate::shardForCurrentThread() noexcept
+{
+    // Threads are assigned to shards round-robin the first time they take a
+    // read lock. A thread always uses the same shard, so that unlock()
+    // decrements the counter that lockForRead() incremented.
+    int index = currentReaderShard;
+    if (Q_UNLIKELY(index < 0))
+        index = currentReaderShard = nextReaderShard.fetch_add(1, std::memory_order_relaxed) & (MaxShards - 1);
+    return shards[index & (shardCount - 1)];
+}
+
+bool QShardedReadWriteLockPrivate::hasReaders() const noexcept
+{
+    for (int i = 0; i < shardCount; ++i) {
+        if (shards[i].readers.load() != 0)
+            return true;
+    }
+    return false;
+}
+
+void QShardedReadWriteLockPrivate::releaseReader(Shard &shard)
+{
+    // The decrement and the load of writerActive are sequentially consistent,
+    // pairing with the store in lockForWrite(): either the writer sees our
+    // decrement, or we see that it is waiting and wake it up.
+    if (shard.readers.fetch_sub(1) == 1 && writerActive.load()) {
+        const auto lock = qt_scoped_lock(mutex);
+        cond.notify_all();
+    }
+}
+
+bool QShardedReadWriteLockPrivate::contendedLockForRead(Shard &shard, QDeadlineTimer timeout)
+{
+    // A writer is active or waiting: back off, so that it is not starved.
+    releaseReader(shard);
+
+    auto lock = qt_unique_lock(mutex);
+    while (true) {
+        while (writerActive.load()) {
+            if (timeout.hasExpired())
+                return false;
+            if (timeout.isForever())
+                cond.wait(lock);
+            else
+                cond.wait_until(lock, timeout.deadline<std::chrono::steady_clock>());
+        }
+        shard.readers.fetch_add(1);
+        if (!writerActive.load())
+            return true;
+        // Another writer came in between; it needs to be told that we left.
+        shard.readers.fetch_sub(1);
+        cond.notify_all();
+    }
+}
+
+bool QShardedReadWriteLockPrivate::lockForWrite(QDeadlineTimer timeout)
+{
+    auto lock = qt_unique_lock(mutex);
+    while (writerActive.load()) {
+        if (timeout.hasExpired())
+            return false;
+        if (timeout.isForever())
+            cond.wait(lock);
+        else
+            cond.wait_until(lock, timeout.deadline<std::chrono::steady_clock>());
+    }
+
+    // From now on, new readers back off in contendedLockForRead().
+    writerActive.store(true);
+    while (hasReaders()) {
+        if (timeout.hasExpired()) {
+            writerActive.store(false);
+            cond.notify_all();
+            return false;
+        }
+        if (timeout.isForever())
+            cond.wait(lock);
+        else
+            cond.wait_until(lock, timeout.deadline<std::chrono::steady_clock>());
+    }
+    writer.store(QThread::currentThreadId(), std::memory_order_relaxed);
+    return true;
+}
+
+void QShardedReadWriteLockPrivate::unlockForWrite()
+{
+    writer.store(nullptr, std::memory_order_relaxed);
+    const auto lock = qt_scoped_lock(mutex);
+    writerActive.store(false);
+    cond.notify_all();
+}
+
+/*!
+    Constructs a QShardedReadWriteLock object in the unlocked state.
+
+    The number of reader counters is derived from
+    QThread::idealThreadCount().
+*/
+QShardedReadWriteLock::QShardedReadWriteLock()
+{
+    const int threads = qMax(1, QThread::idealThreadCount());
+    const int shardCount = qMin(int(qNextPowerOfTwo(quint32(threads - 1))),
+                                int(QShardedReadWriteLockPrivate::MaxShards));
+    d = new QShardedReadWriteLockPrivate(shardCount);
+}
+
+/*!
+    Destroys the QShardedReadWriteLock object.
+
+    \warning Destroying a read-write lock that is in use may result
+    in undefined behavior.
+*/
+QShardedReadWriteLock::~QShardedReadWriteLock()
+{
+    if (d->writerActive.load() || d->hasReaders())
+        qWarning("QShardedReadWriteLock: destroying locked QShardedReadWriteLock");
+    delete d;
+}
+
+/*!
+    \fn void QShardedReadWriteLock::lockForRead()
+
+    Locks the lock for reading. This function will block the current
+    thread if another thread has locked, or is waiting to lock, for writing.
+
+    It is not possible to lock for read if the thread already has
+    locked for write.
+
+    \sa unlock(), lockForWrite(), tryLockForRead()
+*/
+
+/*!
+    Attempts to lock for reading. This function returns \c true if the lock was
+    obtained; otherwise it returns \c false. If another thread has locked for
+    writing, this function will wait until \a timeout expires for the lock to
+    become available.
+
+    In the uncontended case, this only increments the reader counter of
+    the calling thread.
+
+    \sa unlock(), lockForRead()
+*/
+bool QShardedReadWriteLock::tryLockForRead(QDeadlineTimer timeout)
+{
+    auto &shard = d->shardForCurrentThread();
+    shard.readers.fetch_add(1);
+    if (Q_LIKELY(!d->writerActive.load()))
+        return true;
+    return d->contendedLockForRead(shard, timeout);
+}
+
+/*!
+    \fn void QShardedReadWriteLock::lockForWrite()
+
+    Locks the lock for writing. This function will block the current
+    thread if another thread has locked for reading or writing.
+
+    It is not possible to lock for write if the thread already has
+    locked for read.
+
+    \sa unlock(), lockForRead(), tryLockForWrite()
+*/
+
+/*!
+    Attempts to lock for writing. This function returns \c true if the lock was
+    obtained; otherwise it returns \c false. If another thread has locked for
+    reading or writing, this function will wait until \a timeout expires for
+    the lock to become available.
+
+    Locking for writing has to inspect the reader counters of all threads,
+    which makes it more expensive than QReadWriteLock::tryLockForWrite().
+
+    \sa unlock(), lockForWrite()
+*/
+bool QShardedReadWriteLock::tryLockForWrite(QDeadlineTimer timeout)
+{
+    return d->lockForWrite(timeout);
+}
+
+/*!
+    Unlocks the lock.
+
+    Attempting to unlock a lock that is not locked is an error, and will result
+    in program termination.
+
+    \sa lockForRead(), lockForWrite(), tryLockForRead(), tryLockForWrite()
+*/
+void QShardedReadWriteLock::unlock()
+{
+    if (d->writer.load(std::memory_order_relaxed) == QThread::currentThreadId()) {
+        d->unlockForWrite();
+    } else {
+        auto &shard = d->shardForCurrentThread();
+        Q_ASSERT_X(shard.readers.load(std::memory_order_relaxed) > 0,
+                   "QShardedReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
+        d->releaseReader(shard);
+    }
+}
+
 /*!
     \class QReadLocker
     \inmodule QtCore
@@ -84,6 +84,34 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
 }
 #endif // inline since 6.6
 
+class QShardedReadWriteLockPrivate;
+
+class Q_CORE_EXPORT QShardedReadWriteLock
+{
+public:
+    QShardedReadWriteLock();
+    ~QShardedReadWriteLock();
+
+    void lockForRead() { tryLockForRead(QDeadlineTimer(QDeadlineTimer::Forever)); }
+    bool tryLockForRead(QDeadlineTimer timeout = {});
+
+    void lockForWrite() { tryLockForWrite(QDeadlineTimer(QDeadlineTimer::Forever)); }
+    bool tryLockForWrite(QDeadlineTimer timeout = {});
+
+    void unlock();
+
+    // std::shared_mutex compatibility
+    void lock_shared() { lockForRead(); }
+    bool try_lock_shared() { return tryLockForRead(); }
+    void unlock_shared() { unlock(); }
+    void lock() { lockForWrite(); }
+    bool try_lock() { return tryLockForWrite(); }
+
+private:
+    Q_DISABLE_COPY(QShardedReadWriteLock)
+    QShardedReadWriteLockPrivate *d;
+};
+
 #if defined(Q_CC_MSVC)
 #pragma warning( push )
 #pragma warning( disable : 4312 ) // ignoring the warning from /Wp64
@@ -207,6 +235,30 @@ private:
     Q_DISABLE_COPY(QReadWriteLock)
 };
 
+class QShardedReadWriteLock
+{
+public:
+    inline QShardedReadWriteLock() noexcept { }
+    inline ~QShardedReadWriteLock() { }
+
+    void lockForRead() noexcept { }
+    bool tryLockForRead(QDeadlineTimer = {}) noexcept { return true; }
+
+    void lockForWrite() noexcept { }
+    bool tryLockForWrite(QDeadlineTimer = {}) noexcept { return true; }
+
+    void unlock() noexcept { }
+
+    void lock_shared() noexcept { }
+    bool try_lock_shared() noexcept { return true; }
+    void unlock_shared() noexcept { }
+    void lock() noexcept { }
+    bool try_lock() noexcept { return true; }
+
+private:
+    Q_DISABLE_COPY(QShardedReadWriteLock)
+};
+
 class QT6_ONLY(Q_CORE_EXPORT) QReadLocker
 {
 public:
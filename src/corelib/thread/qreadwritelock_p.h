@@ -21,6 +21,9 @@
 #include <QtCore/qreadwritelock.h>
 #include <QtCore/qvarlengtharray.h>
 
+#include <atomic>
+#include <memory>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -84,6 +87,37 @@ public:
 };
 Q_DECLARE_TYPEINFO(QReadWriteLockPrivate::Reader, Q_PRIMITIVE_TYPE);\
 
+class QShardedReadWriteLockPrivate
+{
+public:
+    enum { MaxShards = 64 };
+
+    // One reader count per cache line, so that readers running on different
+    // threads do not write to the same memory.
+    struct alignas(64) Shard {
+        std::atomic<int> readers = 0;
+    };
+
+    explicit QShardedReadWriteLockPrivate(int shardCount)
+        : shardCount(shardCount), shards(new Shard[shardCount]) {}
+
+    Shard &shardForCurrentThread() noexcept;
+    bool hasReaders() const noexcept;
+
+    void releaseReader(Shard &shard);
+    bool contendedLockForRead(Shard &shard, QDeadlineTimer timeout);
+    bool lockForWrite(QDeadlineTimer timeout);
+    void unlockForWrite();
+
+    std::atomic<bool> writerActive = false;
+    std::atomic<Qt::HANDLE> writer = nullptr;
+
+    QtPrivate::mutex mutex;
+    QtPrivate::condition_variable cond;
+    const int shardCount;
+    const std::unique_ptr<Shard[]> shards;
+};
+
 /*! \internal  Helper for QWaitCondition::wait */
 inline QReadWriteLockStates::StateForWaitCondition
 QReadWriteLockPrivate::stateForWaitCondition(const QReadWriteLock *q)
@@ -8,6 +8,7 @@
 #include "qdatetime.h"
 #include "qdebug.h"
 #include "qlocking_p.h"
+#include "qmutex_p.h"
 #include "qwaitcondition_p.h"
 
 #include <chrono>
@@ -535,6 +536,92 @@ bool QSemaphore::tryAcquire(int n, QDeadlineTimer timer)
     \sa tryAcquire(), try_acquire(), try_acquire_for()
 */
 
+/*!
+    \class QAdaptiveSemaphore
+    \inmodule QtCore
+    \since 6.7
+    \brief The QAdaptiveSemaphore class is a QSemaphore that spins for a
+    while before putting a thread to sleep.
+
+    \threadsafe
+
+    \ingroup thread
+
+    When acquire() cannot obtain the requested resources immediately,
+    QAdaptiveSemaphore first spins, repeatedly checking whether enough
+    resources have been released, and only puts the calling thread to sleep
+    if that doesn't happen within its spin budget. This avoids the cost of
+    sleeping and being woken up again in handoffs between threads that
+    release resources within microseconds.
+
+    As with QAdaptiveMutex, the number of iterations actually spun adapts
+    to how long previous calls had to spin, and the upper limit can be
+    changed per instance with setSpinCount().
+
+    \sa QSemaphore, QAdaptiveMutex
+*/
+
+/*!
+    \fn QAdaptiveSemaphore::QAdaptiveSemaphore(int n)
+
+    Creates a new semaphore and initializes the number of resources it
+    guards to \a n (by default, 0). The default spin budget is used.
+*/
+
+/*!
+    \fn QAdaptiveSemaphore::QAdaptiveSemaphore(int n, int spinCount)
+
+    Creates a new semaphore guarding \a n resources that spins at most
+    \a spinCount times before putting a thread to sleep.
+*/
+
+/*!
+    \fn void QAdaptiveSemaphore::setSpinCount(int spinCount)
+
+    Sets the maximum number of times acquire() and tryAcquire() spin before
+    putting the calling thread to sleep to \a spinCount. Zero disables
+    spinning, a negative value restores the default.
+
+    \sa spinCount()
+*/
+
+/*!
+    Returns the maximum number of times acquire() and tryAcquire() spin before
+    putting the calling thread to sleep.
+
+    \sa setSpinCount()
+*/
+int QAdaptiveSemaphore::spinCount() const noexcept
+{
+    const int spinCount = spinBudget.loadRelaxed();
+    return spinCount < 0 ? QtPrivate::defaultSpinCount() : spinCount;
+}
+
+/*!
+    \fn void QAdaptiveSemaphore::acquire(int n)
+
+    Tries to acquire \a n resources guarded by the semaphore, spinning and
+    then blocking until they become available.
+
+    \sa QSemaphore::acquire()
+*/
+
+/*!
+    \fn bool QAdaptiveSemaphore::tryAcquire(int n, QDeadlineTimer timeout)
+
+    Tries to acquire \a n resources guarded by the semaphore, spinning and
+    then waiting until \a timeout expires for them to become available.
+    Returns \c true on success.
+
+    \sa QSemaphore::tryAcquire()
+*/
+
+bool QAdaptiveSemaphore::spinAcquire(int n)
+{
+    return QtPrivate::adaptiveSpin([this, n] { return available() >= n && QSemaphore::tryAcquire(n); },
+                                   spinBudget.loadRelaxed(), averageSpins);
+}
+
 /*!
     \class QSemaphoreReleaser
     \brief The QSemaphoreReleaser class provides exception-safe deferral of a QSemaphore::release() call.
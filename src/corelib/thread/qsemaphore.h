@@ -5,6 +5,7 @@
 #define QSEMAPHORE_H
 
 #include <QtCore/qglobal.h>
+#include <QtCore/qatomic.h>
 #include <QtCore/qdeadlinetimer.h>
 
 QT_REQUIRE_CONFIG(thread);
@@ -61,6 +62,52 @@ bool QSemaphore::tryAcquire(int n, int timeout)
 }
 #endif
 
+class Q_CORE_EXPORT QAdaptiveSemaphore : public QSemaphore
+{
+public:
+    explicit QAdaptiveSemaphore(int n = 0) : QSemaphore(n) {}
+    QAdaptiveSemaphore(int n, int spinCount) : QSemaphore(n), spinBudget(spinCount) {}
+
+    void setSpinCount(int spinCount) noexcept { spinBudget.storeRelaxed(spinCount); }
+    int spinCount() const noexcept;
+
+    void acquire(int n = 1)
+    {
+        if (!QSemaphore::tryAcquire(n) && !spinAcquire(n))
+            QSemaphore::acquire(n);
+    }
+    bool tryAcquire(int n = 1) { return QSemaphore::tryAcquire(n); }
+    bool tryAcquire(int n, int timeout) { return tryAcquire(n, QDeadlineTimer(timeout)); }
+    bool tryAcquire(int n, QDeadlineTimer timeout)
+    {
+        if (QSemaphore::tryAcquire(n))
+            return true;
+        if (!timeout.hasExpired() && spinAcquire(n))
+            return true;
+        return QSemaphore::tryAcquire(n, timeout);
+    }
+    template <typename Rep, typename Period>
+    bool tryAcquire(int n, std::chrono::duration<Rep, Period> timeout)
+    { return tryAcquire(n, QDeadlineTimer(timeout)); }
+
+    // std::counting_semaphore compatibility:
+    bool try_acquire() noexcept { return QSemaphore::tryAcquire(); }
+    template <typename Rep, typename Period>
+    bool try_acquire_for(const std::chrono::duration<Rep, Period> &timeout)
+    { return tryAcquire(1, timeout); }
+    template <typename Clock, typename Duration>
+    bool try_acquire_until(const std::chrono::time_point<Clock, Duration> &tp)
+    {
+        return try_acquire_for(tp - Clock::now());
+    }
+
+private:
+    bool spinAcquire(int n);
+
+    QAtomicInt spinBudget = -1; // -1: use the default
+    QAtomicInt averageSpins = 0;
+};
+
 class QSemaphoreReleaser
 {
 public:
@@ -40,6 +40,63 @@ void QPostEventList::addEvent(const QPostEvent &ev)
     }
 }
 
+QPostEventList::~QPostEventList()
+{
+    // ~QThreadData() has taken care of the events that were pending then
+    PendingEvent *pending = pendingEvents.loadRelaxed();
+    while (pending) {
+        delete pending->event.event;
+        delete std::exchange(pending, pending->next);
+    }
+}
+
+/*!
+    \internal
+    Pushes \a pending to the stack of events that have been posted without
+    locking the mutex. This is safe to call from any thread.
+*/
+void QPostEventList::pushPendingEvent(PendingEvent *pending) noexcept
+{
+    // pending must not be written to once it is published, another thread
+    // may have taken and deleted it already
+    pendingEventCount.fetchAndAddRelaxed(1);
+    PendingEvent *top = pendingEvents.loadRelaxed();
+    do {
+        pending->next = top;
+    } while (!pendingEvents.testAndSetOrdered(top, pending, top));
+}
+
+/*!
+    \internal
+    Adds the events that have been posted without locking the mutex to the
+    list, in the order they were posted. Returns \c true if there were any.
+    Must be called with the mutex locked.
+*/
+bool QPostEventList::addPendingEvents()
+{
+    PendingEvent *pending = pendingEvents.fetchAndStoreOrdered(nullptr);
+    if (!pending)
+        return false;
+
+    // the stack has the most recently posted event on top
+    PendingEvent *first = nullptr;
+    qsizetype count = 0;
+    while (pending) {
+        PendingEvent *next = pending->next;
+        pending->next = first;
+        first = pending;
+        pending = next;
+        ++count;
+    }
+    pendingEventCount.fetchAndSubRelaxed(count);
+
+    while (first) {
+        addEvent(first->event);
+        delete std::exchange(first, first->next);
+    }
+    return true;
+}
+
 
 /*
   QThreadData
@@ -81,6 +138,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    postEventList.addPendingEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
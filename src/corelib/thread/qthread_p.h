@@ -72,9 +72,26 @@ public:
 
     QMutex mutex;
 
+    // Events posted without locking the mutex (see QCoreApplication::postEvent()).
+    // They form a lock-free stack, which addPendingEvents() moves to the list in
+    // the order they were posted, and which any code reading the list must
+    // therefore call first.
+    struct PendingEvent
+    {
+        QPostEvent event;
+        PendingEvent *next;
+    };
+    QAtomicPointer<PendingEvent> pendingEvents;
+    // the number of events on that stack, so that it can be counted without locking
+    QAtomicInteger<qsizetype> pendingEventCount;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
+    ~QPostEventList();
 
     void addEvent(const QPostEvent &ev);
+    void pushPendingEvent(PendingEvent *pending) noexcept;
+    bool addPendingEvents();
+    bool hasPendingEvents() const noexcept { return pendingEvents.loadAcquire() != nullptr; }
 
 private:
     //hides because they do not keep that list sorted. addEvent must be used
@@ -307,6 +324,8 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
+        if (postEventList.addPendingEvents())
+            canWait = false;
         return canWait;
     }
 
@@ -325,7 +344,8 @@ public:
     QList<void *> tls;
 
     bool quitNow;
-    bool canWait;
+    // written without the postEventList mutex when events are posted without locking
+    std::atomic<bool> canWait;
     bool isAdopted;
     bool requiresCoreApplication;
 };
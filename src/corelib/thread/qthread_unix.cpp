@@ -303,6 +303,7 @@ void *QThreadPrivate::start(void *arg)
 
         data->ensureEventDispatcher();
         data->eventDispatcher.loadRelaxed()->startingUp();
+        QObjectAllocationPool::enableFromEnvironment();
 
 #if (defined(Q_OS_LINUX) || defined(Q_OS_DARWIN) || defined(Q_OS_QNX))
         {
@@ -277,6 +277,7 @@ unsigned int __stdcall QT_ENSURE_STACK_ALIGNED_FOR_SSE QThreadPrivate::start(voi
 
     data->ensureEventDispatcher();
     data->eventDispatcher.loadRelaxed()->startingUp();
+    QObjectAllocationPool::enableFromEnvironment();
 
 #if !defined(QT_NO_DEBUG) && defined(Q_CC_MSVC)
     // sets the name of the current thread.
@@ -5,6 +5,7 @@
 #include "qthreadpool_p.h"
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
+#include "qrandom.h"
 
 #include <algorithm>
 #include <memory>
@@ -23,12 +24,20 @@ public:
     QThreadPoolThread(QThreadPoolPrivate *manager);
     void run() override;
     void registerThreadInactive();
+    QRunnable *takeLocalRunnable(bool newest);
 
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // work-stealing mode: the runnables started from this thread
+    QMutex localMutex;
+    QList<QRunnable *> localQueue;
 };
 
+// the pool thread that the current thread is, if any
+Q_CONSTINIT static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -48,6 +57,7 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -56,39 +66,57 @@ void QThreadPoolThread::run()
         do {
             if (r) {
                 // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
+                bool del = r->autoDelete();
 
                 // run the task
                 locker.unlock();
+                for (;;) {
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // in work-stealing mode, go on with the runnables started from this
+                    // thread, newest first, unless the queue holds higher priority ones
+                    if (manager->prioritizedTasks.loadRelaxed() || !(r = takeLocalRunnable(true)))
+                        break;
+                    del = r->autoDelete();
+                }
                 locker.relock();
             }
 
-            // if too many threads are active, stop working in this one
-            if (manager->tooManyThreadsActive())
+            // if too many threads are active, stop working in this one,
+            // but not before running the runnables that were started from it
+            if (manager->tooManyThreadsActive()) {
+                if ((r = takeLocalRunnable(true)))
+                    continue;
                 break;
+            }
 
-            // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
+            // all work is done, look for runnables started from other threads
+            // in work-stealing mode, or wait for more
+            if (manager->queue.isEmpty()) {
+                if ((r = manager->stealRunnable(this)))
+                    continue;
                 break;
+            }
 
             QueuePage *page = manager->queue.first();
             r = page->pop();
+            if (page->priority() > 0)
+                manager->prioritizedTasks.deref();
 
             if (page->isFinished()) {
                 manager->queue.removeFirst();
@@ -105,13 +133,31 @@ void QThreadPoolThread::run()
         // if too many threads are active, expire this thread
         if (manager->tooManyThreadsActive()) {
             manager->expiredThreads.enqueue(this);
+            manager->updateSpareThreadsHint();
             registerThreadInactive();
             return;
         }
+
+        // In work-stealing mode, announce that this thread is about to wait and
+        // then look once more. Either this finds a runnable that was started
+        // from another thread in the meantime, or that thread sees the hint and
+        // goes through the queue instead (see QThreadPoolPrivate::startLocally()).
+        const bool workStealing = manager->workStealing.loadRelaxed();
+        if (workStealing) {
+            manager->idleThreadsHint.ref();
+            if ((runnable = manager->stealRunnable(this))) {
+                manager->idleThreadsHint.deref();
+                continue;
+            }
+        }
+
         manager->waitingThreads.enqueue(this);
+        manager->updateSpareThreadsHint();
         registerThreadInactive();
         // wait for work, exiting after the expiry timeout is reached
         runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
+        if (workStealing)
+            manager->idleThreadsHint.deref();
         // this thread is about to be deleted, do not work or expire
         if (!manager->allThreads.contains(this)) {
             Q_ASSERT(manager->queue.isEmpty());
@@ -131,6 +177,22 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+/*
+    \internal
+    Takes the newest or the oldest runnable started from this thread in
+    work-stealing mode.
+*/
+QRunnable *QThreadPoolThread::takeLocalRunnable(bool newest)
+{
+    if (!manager->workStealing.loadRelaxed())
+        return nullptr;
+
+    QMutexLocker locker(&localMutex);
+    if (localQueue.isEmpty())
+        return nullptr;
+    return newest ? localQueue.takeLast() : localQueue.takeFirst();
+}
+
 
 /*
     \internal
@@ -188,6 +250,9 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
+    if (priority > 0)
+        prioritizedTasks.ref();
+
     for (QueuePage *page : std::as_const(queue)) {
         if (page->priority() == priority && !page->isFull()) {
             page->push(runnable);
@@ -215,12 +280,15 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             break;
 
         page->pop();
+        if (page->priority() > 0)
+            prioritizedTasks.deref();
 
         if (page->isFinished()) {
             queue.removeFirst();
             delete page;
         }
     }
+    updateSpareThreadsHint();
 }
 
 bool QThreadPoolPrivate::areAllThreadsActive() const
@@ -313,6 +381,8 @@ void QThreadPoolPrivate::clear()
         auto *page = queue.takeLast();
         while (!page->isFinished()) {
             QRunnable *r = page->pop();
+            if (page->priority() > 0)
+                prioritizedTasks.deref();
             if (r && r->autoDelete()) {
                 locker.unlock();
                 delete r;
@@ -321,6 +391,107 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+
+    if (!workStealing.loadRelaxed())
+        return;
+
+    QList<QRunnable *> localRunnables;
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        localRunnables += std::exchange(thread->localQueue, {});
+    }
+    locker.unlock();
+    for (QRunnable *r : std::as_const(localRunnables)) {
+        if (r->autoDelete())
+            delete r;
+    }
+}
+
+/*!
+    \internal
+    Starts \a runnable, which was started from the pool's own \a thread, by
+    pushing it to that thread's queue in work-stealing mode, without taking
+    the pool's mutex. Returns \c false if work stealing is disabled.
+*/
+bool QThreadPoolPrivate::startLocally(QThreadPoolThread *thread, QRunnable *runnable)
+{
+    {
+        QMutexLocker localLocker(&thread->localMutex);
+        if (!workStealing.loadRelaxed())
+            return false;
+        thread->localQueue.append(runnable);
+    }
+
+    // If threads are waiting for work, or more can be started, let one of
+    // them run the newest runnable. The ordered read pairs with the one in
+    // QThreadPoolThread::run(), so that a thread that is about to wait either
+    // finds the runnable or makes us see it.
+    if (idleThreadsHint.fetchAndAddOrdered(0) == 0 && !spareThreadsHint.loadRelaxed())
+        return true;
+
+    if (QRunnable *r = thread->takeLocalRunnable(true)) {
+        QMutexLocker locker(&mutex);
+        if (!tryStart(r))
+            enqueueTask(r);
+        updateSpareThreadsHint();
+    }
+    return true;
+}
+
+/*!
+    \internal
+    Takes a runnable from \a thief's own queue in work-stealing mode, or else
+    the oldest one of another thread, starting at a random thread.
+    Must be called with the mutex locked.
+*/
+QRunnable *QThreadPoolPrivate::stealRunnable(QThreadPoolThread *thief)
+{
+    if (!workStealing.loadRelaxed())
+        return nullptr;
+
+    if (QRunnable *r = thief->takeLocalRunnable(true))
+        return r;
+
+    const qsizetype count = allThreads.size();
+    if (count < 2)
+        return nullptr;
+
+    auto it = allThreads.cbegin();
+    std::advance(it, QRandomGenerator::global()->bounded(int(count)));
+    for (qsizetype i = 0; i < count; ++i) {
+        if (it == allThreads.cend())
+            it = allThreads.cbegin();
+        QThreadPoolThread *victim = *it++;
+        if (victim == thief)
+            continue;
+        if (QRunnable *r = victim->takeLocalRunnable(false))
+            return r;
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+    Must be called with the mutex locked.
+*/
+void QThreadPoolPrivate::setWorkStealingEnabled(bool enable)
+{
+    if (workStealing.loadRelaxed() == int(enable))
+        return;
+
+    workStealing.storeRelaxed(enable);
+    if (enable)
+        return;
+
+    // hand the runnables of the threads' queues over to the shared one;
+    // startLocally() checks the flag with the thread's mutex held
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        for (QRunnable *r : std::as_const(thread->localQueue))
+            enqueueTask(r);
+        thread->localQueue.clear();
+    }
+    tryToStartMoreThreads();
 }
 
 /*!
@@ -350,6 +521,8 @@ bool QThreadPool::tryTake(QRunnable *runnable)
     QMutexLocker locker(&d->mutex);
     for (QueuePage *page : std::as_const(d->queue)) {
         if (page->tryTake(runnable)) {
+            if (page->priority() > 0)
+                d->prioritizedTasks.deref();
             if (page->isFinished()) {
                 d->queue.removeOne(page);
                 delete page;
@@ -358,6 +531,14 @@ bool QThreadPool::tryTake(QRunnable *runnable)
         }
     }
 
+    // in work-stealing mode, the runnable may still be in a thread's queue
+    if (d->workStealing.loadRelaxed()) {
+        for (QThreadPoolThread *thread : std::as_const(d->allThreads)) {
+            QMutexLocker localLocker(&thread->localMutex);
+            if (thread->localQueue.removeOne(runnable))
+                return true;
+        }
+    }
     return false;
 }
 
@@ -510,10 +691,16 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->workStealing.loadRelaxed() && currentPoolThread
+            && currentPoolThread->manager == d && d->startLocally(currentPoolThread, runnable)) {
+        return;
+    }
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
         d->enqueueTask(runnable, priority);
+    d->updateSpareThreadsHint();
 }
 
 /*!
@@ -556,10 +743,9 @@ bool QThreadPool::tryStart(QRunnable *runnable)
 
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
-    if (d->tryStart(runnable))
-        return true;
-
-    return false;
+    const bool started = d->tryStart(runnable);
+    d->updateSpareThreadsHint();
+    return started;
 }
 
 /*!
@@ -678,6 +864,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateSpareThreadsHint();
 }
 
 /*! \property QThreadPool::stackSize
@@ -832,6 +1019,40 @@ void QThreadPool::clear()
     d->clear();
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \brief whether runnables started from the pool's own threads are queued
+    per thread
+    \since 6.7
+
+    By default, runnables that cannot be run right away are put in one queue
+    shared by all threads of the pool. If this property is \c true, runnables
+    that one of the pool's threads starts with the default priority are
+    instead pushed to that thread's own queue. Once its current runnable
+    returns, the thread runs them newest first, without taking the pool's
+    lock. Threads that run out of work take the oldest runnables from the
+    queues of other threads, starting at a random one.
+
+    This reduces contention on the shared queue for fine-grained tasks that
+    start further tasks, for instance when recursively splitting work.
+    Runnables started from other threads, or with a non-zero priority, still
+    go through the shared queue, and runnables with a higher priority are run
+    before the ones in the per-thread queues.
+
+    The default value is \c false.
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->setWorkStealingEnabled(enabled);
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.loadRelaxed();
+}
+
 /*!
     \since 6.0
 
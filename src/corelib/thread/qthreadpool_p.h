@@ -134,6 +134,12 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    bool startLocally(QThreadPoolThread *thread, QRunnable *runnable);
+    QRunnable *stealRunnable(QThreadPoolThread *thief);
+    void setWorkStealingEnabled(bool enable);
+    void updateSpareThreadsHint()
+    { spareThreadsHint.storeRelaxed(!areAllThreadsActive()); }
+
     static QThreadPool *qtGuiInstance();
 
     mutable QMutex mutex;
@@ -150,6 +156,14 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+
+    // Work-stealing mode: runnables started from a worker thread go to that
+    // thread's own deque, which is accessed without taking the pool's mutex.
+    // The hints below are read without holding the mutex.
+    QAtomicInt workStealing = 0;
+    QAtomicInt idleThreadsHint = 0;     // threads about to wait for work, or waiting
+    QAtomicInt spareThreadsHint = 1;    // !areAllThreadsActive()
+    QAtomicInt prioritizedTasks = 0;    // queued runnables with priority > 0
 };
 
 QT_END_NAMESPACE
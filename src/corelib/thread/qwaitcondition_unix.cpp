@@ -14,6 +14,7 @@
 
 #include "private/qcore_unix_p.h"
 #include "qreadwritelock_p.h"
+#include "qfutex_p.h"
 
 #include <errno.h>
 #include <sys/time.h>
@@ -21,6 +22,133 @@
 
 QT_BEGIN_NAMESPACE
 
+#if defined(QT_ALWAYS_USE_FUTEX)
+/*
+ * Futex-based implementation (Linux):
+ *
+ * Each waiting thread queues a Waiter on its own stack and sleeps on that
+ * Waiter's futex word. wakeOne() dequeues the oldest waiter, flags it and
+ * wakes exactly that thread; wakeAll() does so for all of them. Only threads
+ * that were waiting when wakeOne() or wakeAll() was called can be woken, and
+ * a wakeup is never lost to, or stolen by, a thread that starts waiting
+ * later. The queue is protected by a QBasicMutex that is only held for a few
+ * pointer operations; the woken thread does not need to acquire it again.
+ */
+class QWaitConditionPrivate
+{
+public:
+    struct Waiter {
+        Waiter *prev = nullptr;
+        Waiter *next = nullptr;
+        QBasicAtomicInt woken = Q_BASIC_ATOMIC_INITIALIZER(0);
+    };
+
+    QBasicMutex queueLock;
+    Waiter *head = nullptr;
+    Waiter *tail = nullptr;
+
+    // Must be called before the user's lock is released, so that a thread
+    // waking us up after acquiring that lock is guaranteed to see us.
+    void registerWaiter(Waiter &waiter)
+    {
+        const auto locker = qt_scoped_lock(queueLock);
+        waiter.prev = tail;
+        if (tail)
+            tail->next = &waiter;
+        else
+            head = &waiter;
+        tail = &waiter;
+    }
+
+    void unlink(Waiter *waiter)
+    {
+        if (waiter->prev)
+            waiter->prev->next = waiter->next;
+        else
+            head = waiter->next;
+        if (waiter->next)
+            waiter->next->prev = waiter->prev;
+        else
+            tail = waiter->prev;
+    }
+
+    bool wait(Waiter &waiter, QDeadlineTimer deadline)
+    {
+        while (!waiter.woken.loadAcquire()) {
+            if (deadline.isForever()) {
+                QtFutex::futexWait(waiter.woken, 0);
+            } else {
+                const qint64 remaining = deadline.remainingTimeNSecs();
+                if (remaining <= 0)
+                    break;
+                QtFutex::futexWait(waiter.woken, 0, remaining);
+            }
+        }
+        if (waiter.woken.loadAcquire())
+            return true;
+
+        // Timed out, unless we were dequeued by a wakeup in the meantime.
+        const auto locker = qt_scoped_lock(queueLock);
+        if (waiter.woken.loadRelaxed())
+            return true;
+        unlink(&waiter);
+        return false;
+    }
+
+    void wakeOne()
+    {
+        Waiter *waiter;
+        {
+            const auto locker = qt_scoped_lock(queueLock);
+            waiter = head;
+            if (!waiter)
+                return;
+            unlink(waiter);
+            // The waiter may return and go out of scope as soon as it sees
+            // this store, so it must not be accessed anymore. Waking up the
+            // futex at a dead address is harmless: futex waits can wake up
+            // spuriously anyway.
+            waiter->woken.storeRelease(1);
+        }
+        QtFutex::futexWakeOne(waiter->woken);
+    }
+
+    void wakeAll()
+    {
+        const auto locker = qt_scoped_lock(queueLock);
+        Waiter *waiter = std::exchange(head, nullptr);
+        tail = nullptr;
+        while (waiter) {
+            Waiter *next = waiter->next;
+            waiter->woken.storeRelease(1);
+            QtFutex::futexWakeOne(waiter->woken);
+            waiter = next;
+        }
+    }
+};
+
+QWaitCondition::QWaitCondition()
+    : d(new QWaitConditionPrivate)
+{
+}
+
+QWaitCondition::~QWaitCondition()
+{
+    delete d;
+}
+
+void QWaitCondition::wakeOne()
+{
+    d->wakeOne();
+}
+
+void QWaitCondition::wakeAll()
+{
+    d->wakeAll();
+}
+
+#else // !QT_ALWAYS_USE_FUTEX
+
 static constexpr clockid_t SteadyClockClockId =
 #if !defined(CLOCK_MONOTONIC)
         // we don't know how to set the monotonic clock
@@ -81,11 +209,20 @@ static void qt_abstime_for_timeout(timespec *ts, QDeadlineTimer deadline)
 class QWaitConditionPrivate
 {
 public:
+    struct Waiter {};
+
     pthread_mutex_t mutex;
     pthread_cond_t cond;
     int waiters;
     int wakeups;
 
+    void registerWaiter(Waiter &)
+    {
+        qt_report_pthread_error(pthread_mutex_lock(&mutex), "QWaitCondition::wait()",
+                                "mutex lock");
+        ++waiters;
+    }
+
     int wait_relative(QDeadlineTimer deadline)
     {
         timespec ti;
@@ -93,7 +230,7 @@ public:
         return pthread_cond_timedwait(&cond, &mutex, &ti);
     }
 
-    bool wait(QDeadlineTimer deadline)
+    bool wait(Waiter &, QDeadlineTimer deadline)
     {
         int code;
         forever {
@@ -162,6 +299,8 @@ void QWaitCondition::wakeAll()
                             "mutex unlock");
 }
 
+#endif // !QT_ALWAYS_USE_FUTEX
+
 bool QWaitCondition::wait(QMutex *mutex, unsigned long time)
 {
     if (time == std::numeric_limits<unsigned long>::max())
@@ -174,11 +313,11 @@ bool QWaitCondition::wait(QMutex *mutex, QDeadlineTimer deadline)
     if (!mutex)
         return false;
 
-    qt_report_pthread_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wait()", "mutex lock");
-    ++d->waiters;
+    QWaitConditionPrivate::Waiter waiter;
+    d->registerWaiter(waiter);
     mutex->unlock();
 
-    bool returnValue = d->wait(deadline);
+    bool returnValue = d->wait(waiter, deadline);
 
     mutex->lock();
 
@@ -206,12 +345,12 @@ bool QWaitCondition::wait(QReadWriteLock *readWriteLock, QDeadlineTimer deadline
         return false;
     }
 
-    qt_report_pthread_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wait()", "mutex lock");
-    ++d->waiters;
+    QWaitConditionPrivate::Waiter waiter;
+    d->registerWaiter(waiter);
 
     readWriteLock->unlock();
 
-    bool returnValue = d->wait(deadline);
+    bool returnValue = d->wait(waiter, deadline);
 
     if (previousState == LockedForWrite)
         readWriteLock->lockForWrite();
@@ -0,0 +1,223 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCONCURRENTHASH_H
+#define QCONCURRENTHASH_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qreadwritelock.h>
+
+#include <limits>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+template <typename Key, typename T>
+class QConcurrentHash
+{
+    using Node = QHashPrivate::Node<Key, T>;
+    using Data = QHashPrivate::Data<Node>;
+
+    // Each shard is a QHash guarded by its own lock, on a cache line of its
+    // own so that threads working on different shards don't contend
+    struct alignas(64) Shard
+    {
+        mutable QReadWriteLock lock;
+        QHash<Key, T> hash;
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+
+    static constexpr qsizetype DefaultShardCount = 64;
+    static constexpr qsizetype MaxShardCount = 256;
+
+    explicit QConcurrentHash(qsizetype shardCount = DefaultShardCount)
+        : seed(QHashSeed::globalSeed())
+    {
+        shardCount = qBound(qsizetype(1), shardCount, MaxShardCount);
+        // round up to a power of two
+        const size_t count = qNextPowerOfTwo(quint32(shardCount - 1));
+        shards.reset(new Shard[count]);
+        shardMask = count - 1;
+    }
+
+    qsizetype shardCount() const noexcept { return qsizetype(shardMask + 1); }
+
+    qsizetype size() const
+    {
+        qsizetype n = 0;
+        for (size_t i = 0; i <= shardMask; ++i) {
+            QReadLocker locker(&shards[i].lock);
+            n += shards[i].hash.size();
+        }
+        return n;
+    }
+    bool isEmpty() const { return size() == 0; }
+
+    void clear()
+    {
+        for (size_t i = 0; i <= shardMask; ++i) {
+            QHash<Key, T> old; // destroy the items outside the lock
+            QWriteLocker locker(&shards[i].lock);
+            old.swap(shards[i].hash);
+        }
+    }
+
+    bool contains(const Key &key) const
+    {
+        const size_t hash = hashOf(key);
+        const Shard &s = shardFor(hash);
+        QReadLocker locker(&s.lock);
+        return findNode(s, key, hash) != nullptr;
+    }
+
+    T value(const Key &key) const
+    {
+        return value(key, T());
+    }
+
+    T value(const Key &key, const T &defaultValue) const
+    {
+        const size_t hash = hashOf(key);
+        const Shard &s = shardFor(hash);
+        QReadLocker locker(&s.lock);
+        if (Node *n = findNode(s, key, hash))
+            return n->value;
+        return defaultValue;
+    }
+
+    bool insertOrAssign(const Key &key, const T &value)
+    {
+        const size_t hash = hashOf(key);
+        Shard &s = shardFor(hash);
+        QWriteLocker locker(&s.lock);
+        auto result = findOrInsert(s, key, hash);
+        if (result.initialized) {
+            result.it.node()->emplaceValue(value);
+            return false;
+        }
+        Node::createInPlace(result.it.node(), Key(key), value);
+        return true;
+    }
+
+    template <typename Factory>
+    T computeIfAbsent(const Key &key, Factory &&factory)
+    {
+        const size_t hash = hashOf(key);
+        Shard &s = shardFor(hash);
+        {
+            QReadLocker locker(&s.lock);
+            if (Node *n = findNode(s, key, hash))
+                return n->value;
+        }
+        QWriteLocker locker(&s.lock);
+        // another thread may have inserted the key while the lock was released
+        if (Node *n = findNode(s, key, hash))
+            return n->value;
+        T value = std::forward<Factory>(factory)();
+        auto result = findOrInsert(s, key, hash);
+        Node::createInPlace(result.it.node(), Key(key), value);
+        return value;
+    }
+
+    bool remove(const Key &key)
+    {
+        const size_t hash = hashOf(key);
+        Shard &s = shardFor(hash);
+        QWriteLocker locker(&s.lock);
+        if (s.hash.isEmpty())
+            return false;
+        s.hash.detach();
+        Data *d = s.hash.d;
+        auto bucket = d->seed == seed ? d->findBucket(key, hash) : d->findBucket(key);
+        if (bucket.isUnused())
+            return false;
+        d->erase(bucket);
+        return true;
+    }
+
+    QHash<Key, T> snapshot() const
+    {
+        const std::unique_ptr<QHash<Key, T>[]> copies = shardSnapshots();
+        qsizetype total = 0;
+        for (size_t i = 0; i <= shardMask; ++i)
+            total += copies[i].size();
+        QHash<Key, T> result;
+        result.reserve(total);
+        for (size_t i = 0; i <= shardMask; ++i) {
+            for (auto it = copies[i].cbegin(), end = copies[i].cend(); it != end; ++it)
+                result.insert(it.key(), it.value());
+        }
+        return result;
+    }
+
+    template <typename Function>
+    void forEach(Function function) const
+    {
+        const std::unique_ptr<QHash<Key, T>[]> copies = shardSnapshots();
+        for (size_t i = 0; i <= shardMask; ++i) {
+            for (auto it = copies[i].cbegin(), end = copies[i].cend(); it != end; ++it)
+                function(it.key(), it.value());
+        }
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QConcurrentHash)
+
+    size_t hashOf(const Key &key) const
+        noexcept(noexcept(QHashPrivate::calculateHash(key, size_t())))
+    {
+        return QHashPrivate::calculateHash(key, seed);
+    }
+
+    // The low bits of the hash select the bucket inside a shard's QHash, so
+    // pick the shard from the top bits of a Fibonacci-scrambled hash
+    Shard &shardFor(size_t hash) const noexcept
+    {
+        constexpr size_t Multiplier = sizeof(size_t) == 8 ? size_t(0x9e3779b97f4a7c15ULL)
+                                                          : size_t(0x9e3779b9U);
+        constexpr int Shift = std::numeric_limits<size_t>::digits - 8;
+        static_assert(MaxShardCount == 1 << 8);
+        return shards[((hash * Multiplier) >> Shift) & shardMask];
+    }
+
+    // The shards' QHashes hash with the global seed too, unless it was
+    // changed since this object was constructed
+    Node *findNode(const Shard &s, const Key &key, size_t hash) const noexcept
+    {
+        const Data *d = s.hash.d;
+        if (!d)
+            return nullptr;
+        return d->seed == seed ? d->findNode(key, hash) : d->findNode(key);
+    }
+
+    typename Data::InsertionResult findOrInsert(Shard &s, const Key &key, size_t hash)
+    {
+        s.hash.detach();
+        Data *d = s.hash.d;
+        return d->seed == seed ? d->findOrInsert(key, hash) : d->findOrInsert(key);
+    }
+
+    // Copying a QHash only shares its data, so each shard is locked only
+    // briefly, and a writer to the shard detaches from the snapshot later
+    std::unique_ptr<QHash<Key, T>[]> shardSnapshots() const
+    {
+        std::unique_ptr<QHash<Key, T>[]> copies(new QHash<Key, T>[shardMask + 1]);
+        for (size_t i = 0; i <= shardMask; ++i) {
+            QReadLocker locker(&shards[i].lock);
+            copies[i] = shards[i].hash;
+        }
+        return copies;
+    }
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shardMask = 0;
+    size_t seed;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTHASH_H
@@ -680,6 +680,9 @@ aeshash256_lt32_avx256(__m256i state0, const uchar *p, size_t len)
             hash16bytes(state0_128, data0);
         }
     }
+    // leave the upper halves of the registers clean, or the legacy-SSE code
+    // the caller runs next (like QHash's bucket probing) pays for the transition
+    _mm256_zeroupper();
     return mm_cvtsi128_sz(state0_128);
 }
 
@@ -730,7 +733,9 @@ aeshash256_ge32(__m256i state0, const uchar *p, size_t len)
     // XOR the two halves and extract
     __m128i low = _mm256_extracti128_si256(state0, 0);
     __m128i high = _mm256_extracti128_si256(state0, 1);
-    return mm_cvtsi128_sz(_mm_xor_si128(low, high));
+    __m128i state0_128 = _mm_xor_si128(low, high);
+    _mm256_zeroupper();
+    return mm_cvtsi128_sz(state0_128);
 }
 
 static size_t QT_FUNCTION_TARGET(VAES)
@@ -3865,7 +3870,7 @@ static_assert(sizeof(Span<Node1>) == sizeof(Span<Node<char, void *>>));
 static_assert(sizeof(Span<Node1>) == sizeof(Span<Node<qsizetype, QHashDummyValue>>));
 static_assert(sizeof(Span<Node1>) == sizeof(Span<Node<QString, QVariant>>));
 static_assert(sizeof(Span<Node1>) > SpanConstants::NEntries);
-static_assert(qNextPowerOfTwo(sizeof(Span<Node1>)) == SpanConstants::NEntries * 2);
+static_assert(qNextPowerOfTwo(sizeof(Span<Node1>)) == SpanConstants::NEntries * 4);
 
 // ensure allocations are always a power of two, at a minimum NEntries,
 // obeying the fomula
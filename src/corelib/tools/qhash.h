@@ -225,6 +225,18 @@ struct SpanConstants {
     static constexpr size_t UnusedEntry = 0xff;
 
     static_assert ((NEntries & LocalBucketMask) == 0, "NEntries must be a power of two.");
+
+    // The tag of a bucket holds the top 7 bits of its key's hash, while the
+    // low bits select the bucket. EmptyTag, having the top bit set, can't
+    // collide with any of them.
+    static constexpr size_t GroupSize = 8;
+    static constexpr unsigned char EmptyTag = 0x80;
+    static constexpr unsigned char tagForHash(size_t hash) noexcept
+    {
+        return static_cast<unsigned char>(hash >> (std::numeric_limits<size_t>::digits - 7));
+    }
+
+    static_assert ((NEntries % GroupSize) == 0, "Spans must hold whole groups.");
 };
 
 // Regular hash tables consist of a list of buckets that can store Nodes. But simply allocating one large array of buckets
@@ -235,6 +247,10 @@ struct SpanConstants {
 // actual storage space for the Nodes (the 'entries' member) or 0xff (UnusedEntry) to flag that the bucket is empty.
 // As we have only 128 entries per Span, the offset array can be represented using an unsigned char. This trick makes the hash
 // table have a very small memory overhead compared to many other implementations.
+//
+// Each Span also stores a tag per bucket: a few bits of the hash of the key stored in it, or EmptyTag. Lookups compare the
+// tags of a group of 8 buckets at once in a 64-bit word, and only compare the keys of the buckets whose tag matches. That
+// saves most key comparisons for keys that are expensive to compare, like long strings with a common prefix.
 template<typename Node>
 struct Span {
     // Entry is a slot available for storing a Node. The Span holds a pointer to
@@ -250,12 +266,14 @@ struct Span {
         Node &node() { return *reinterpret_cast<Node *>(&storage); }
     };
 
+    unsigned char tags[SpanConstants::NEntries];
     unsigned char offsets[SpanConstants::NEntries];
     Entry *entries = nullptr;
     unsigned char allocated = 0;
     unsigned char nextFree = 0;
     Span() noexcept
     {
+        memset(tags, SpanConstants::EmptyTag, sizeof(tags));
         memset(offsets, SpanConstants::UnusedEntry, sizeof(offsets));
     }
     ~Span()
@@ -275,7 +293,7 @@ struct Span {
             entries = nullptr;
         }
     }
-    Node *insert(size_t i)
+    Node *insert(size_t i, unsigned char tag)
     {
         Q_ASSERT(i < SpanConstants::NEntries);
         Q_ASSERT(offsets[i] == SpanConstants::UnusedEntry);
@@ -285,6 +303,7 @@ struct Span {
         Q_ASSERT(entry < allocated);
         nextFree = entries[entry].nextFree();
         offsets[i] = entry;
+        tags[i] = tag;
         return &entries[entry].node();
     }
     void erase(size_t bucket) noexcept(std::is_nothrow_destructible<Node>::value)
@@ -294,6 +313,7 @@ struct Span {
 
         unsigned char entry = offsets[bucket];
         offsets[bucket] = SpanConstants::UnusedEntry;
+        tags[bucket] = SpanConstants::EmptyTag;
 
         entries[entry].node().~Node();
         entries[entry].nextFree() = nextFree;
@@ -307,6 +327,10 @@ struct Span {
     {
         return (offsets[i] != SpanConstants::UnusedEntry);
     }
+    unsigned char tag(size_t i) const noexcept
+    {
+        return tags[i];
+    }
     Node &at(size_t i) noexcept
     {
         Q_ASSERT(i < SpanConstants::NEntries);
@@ -339,6 +363,8 @@ struct Span {
         Q_ASSERT(offsets[to] == SpanConstants::UnusedEntry);
         offsets[to] = offsets[from];
         offsets[from] = SpanConstants::UnusedEntry;
+        tags[to] = tags[from];
+        tags[from] = SpanConstants::EmptyTag;
     }
     void moveFromSpan(Span &fromSpan, size_t fromIndex, size_t to) noexcept(std::is_nothrow_move_constructible_v<Node>)
     {
@@ -355,6 +381,8 @@ struct Span {
 
         size_t fromOffset = fromSpan.offsets[fromIndex];
         fromSpan.offsets[fromIndex] = SpanConstants::UnusedEntry;
+        tags[to] = fromSpan.tags[fromIndex];
+        fromSpan.tags[fromIndex] = SpanConstants::EmptyTag;
         Entry &fromEntry = fromSpan.entries[fromOffset];
 
         if constexpr (isRelocatable<Node>()) {
@@ -367,6 +395,28 @@ struct Span {
         fromSpan.nextFree = static_cast<unsigned char>(fromOffset);
     }
 
+    struct GroupMatch {
+        quint64 matching;   // buckets whose tag is the one searched for
+        quint64 empty;      // unused buckets
+    };
+    // Returns the masks of the GroupSize buckets starting at index group, in
+    // the top bit of one byte per bucket.
+    GroupMatch matchGroup(size_t group, unsigned char tag) const noexcept
+    {
+        Q_ASSERT(group % SpanConstants::GroupSize == 0);
+        constexpr quint64 Ones = 0x0101010101010101;
+        constexpr quint64 Low7 = Ones * 0x7f;
+        constexpr quint64 High = Ones * 0x80;
+        // compilers turn this into a single load
+        quint64 control = 0;
+        for (size_t i = 0; i < SpanConstants::GroupSize; ++i)
+            control |= quint64(tags[group + i]) << (i * 8);
+        // set the top bit of the bytes that are zero, without carries between bytes
+        const quint64 x = control ^ (Ones * tag);
+        const quint64 matching = ~(((x & Low7) + Low7) | x | Low7);
+        return { matching, control & High };
+    }
+
     void addStorage()
     {
         Q_ASSERT(allocated < SpanConstants::NEntries);
@@ -506,9 +556,9 @@ struct Data
         {
             return &span->at(index);
         }
-        Node *insert() const
+        Node *insert(unsigned char tag) const
         {
-            return span->insert(index);
+            return span->insert(index, tag);
         }
 
     private:
@@ -565,9 +615,15 @@ struct Data
                 if (!span.hasNode(index))
                     continue;
                 const Node &n = span.at(index);
-                auto it = resized ? findBucket(n.key) : Bucket { spans + s, index };
+                unsigned char tag = span.tag(index);
+                Bucket it { spans + s, index };
+                if (resized) {
+                    const size_t hash = QHashPrivate::calculateHash(n.key, seed);
+                    it = findBucket(n.key, hash);
+                    tag = SpanConstants::tagForHash(hash);
+                }
                 Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                Node *newNode = it.insert(tag);
                 new (newNode) Node(n);
             }
         }
@@ -650,9 +706,10 @@ struct Data
                 if (!span.hasNode(index))
                     continue;
                 Node &n = span.at(index);
-                auto it = findBucket(n.key);
+                const size_t hash = QHashPrivate::calculateHash(n.key, seed);
+                auto it = findBucket(n.key, hash);
                 Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                Node *newNode = it.insert(SpanConstants::tagForHash(hash));
                 new (newNode) Node(std::move(n));
             }
             span.freeData();
@@ -678,28 +735,49 @@ struct Data
     }
 
     Bucket findBucket(const Key &key) const noexcept
+    {
+        return findBucket(key, QHashPrivate::calculateHash(key, seed));
+    }
+
+    Bucket findBucket(const Key &key, size_t hash) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
         Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
-        // loop over the buckets until we find the entry we search for
-        // or an empty slot, in which case we know the entry doesn't exist
+        // Test a group of buckets at a time: only the keys of the buckets whose
+        // tag matches need to be compared, and the first empty bucket ends the
+        // search, in which case we know the entry doesn't exist
+        const unsigned char tag = SpanConstants::tagForHash(hash);
         while (true) {
-            size_t offset = bucket.offset();
-            if (offset == SpanConstants::UnusedEntry) {
-                return bucket;
-            } else {
-                Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
-                    return bucket;
+            const size_t group = bucket.index & ~(SpanConstants::GroupSize - 1);
+            auto [matching, empty] = bucket.span->matchGroup(group, tag);
+            // ignore the buckets before the start of the search...
+            const quint64 start = ~quint64(0) << ((bucket.index - group) * 8);
+            matching &= start;
+            empty &= start;
+            // ... and those after the first empty one
+            if (empty)
+                matching &= (empty & (~empty + 1)) - 1;
+            while (matching) {
+                const size_t index = group + size_t(qCountTrailingZeroBits(matching)) / 8;
+                if (qHashEquals(bucket.span->at(index).key, key))
+                    return Bucket(bucket.span, index);
+                matching &= matching - 1;
             }
+            if (empty)
+                return Bucket(bucket.span, group + size_t(qCountTrailingZeroBits(empty)) / 8);
+            bucket.index = group + SpanConstants::GroupSize - 1;
             bucket.advanceWrapped(this);
         }
     }
 
     Node *findNode(const Key &key) const noexcept
     {
-        auto bucket = findBucket(key);
+        return findNode(key, QHashPrivate::calculateHash(key, seed));
+    }
+
+    Node *findNode(const Key &key, size_t hash) const noexcept
+    {
+        auto bucket = findBucket(key, hash);
         if (bucket.isUnused())
             return nullptr;
         return bucket.node();
@@ -712,20 +790,25 @@ struct Data
     };
 
     InsertionResult findOrInsert(const Key &key) noexcept
+    {
+        return findOrInsert(key, QHashPrivate::calculateHash(key, seed));
+    }
+
+    InsertionResult findOrInsert(const Key &key, size_t hash) noexcept
     {
         Bucket it(static_cast<Span *>(nullptr), 0);
         if (numBuckets > 0) {
-            it = findBucket(key);
+            it = findBucket(key, hash);
             if (!it.isUnused())
                 return { it.toIterator(this), true };
         }
         if (shouldGrow()) {
             rehash(size + 1);
-            it = findBucket(key); // need to get a new iterator after rehashing
+            it = findBucket(key, hash); // need to get a new iterator after rehashing
         }
         Q_ASSERT(it.span != nullptr);
         Q_ASSERT(it.isUnused());
-        it.insert();
+        it.insert(SpanConstants::tagForHash(hash));
         ++size;
         return { it.toIterator(this), false };
     }
@@ -820,6 +903,7 @@ class QHash
     using Data = QHashPrivate::Data<Node>;
     friend class QSet<Key>;
     friend class QMultiHash<Key, T>;
+    template <typename, typename> friend class QConcurrentHash;
     friend tst_QHash;
 
     Data *d = nullptr;
@@ -759,11 +759,25 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+    qint64 written;
+    if (socketType == QAbstractSocket::TcpSocket && writeBuffer.size() > writeBuffer.nextDataBlockSize()) {
+        // The buffer holds several blocks, for instance byte arrays that
+        // were appended without copying. Send as many as we can at once.
+        QVarLengthArray<QByteArrayView, 16> blocks;
+        for (qint64 offset = 0; offset < writeBuffer.size() && blocks.size() < blocks.capacity(); ) {
+            qint64 blockSize;
+            const char *block = writeBuffer.readPointerAtPosition(offset, blockSize);
+            blocks.append(QByteArrayView(block, blockSize));
+            offset += blockSize;
+        }
+        written = socketEngine->writeVector(blocks.constData(), blocks.size());
+    } else {
+        qint64 nextSize = writeBuffer.nextDataBlockSize();
+        const char *ptr = writeBuffer.readPointer();
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+        // Attempt to write it all in one chunk.
+        written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    }
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -796,6 +810,50 @@ bool QAbstractSocketPrivate::writeToSocket()
     return written > 0;
 }
 
+/*! \internal
+
+    Writes the byte arrays in \a data to an unbuffered TCP socket with a
+    single call to the socket engine, buffering what it could not write
+    without copying large byte arrays. Other sockets write them one at a
+    time.
+*/
+qint64 QAbstractSocketPrivate::writeVector(const QByteArrayList &data)
+{
+    if (isBuffered || socketType != QAbstractSocket::TcpSocket || !socketEngine
+        || state == QAbstractSocket::UnconnectedState || !writeBuffer.isEmpty()) {
+        return QIODevicePrivate::writeVector(data);
+    }
+
+    QVarLengthArray<QByteArrayView, 16> chunks;
+    qint64 size = 0;
+    for (const QByteArray &chunk : data) {
+        chunks.append(chunk);
+        size += chunk.size();
+    }
+
+    qint64 written = size ? socketEngine->writeVector(chunks.constData(), chunks.size())
+                          : Q_INT64_C(0);
+    if (written < 0) {
+        setError(socketEngine->error(), socketEngine->errorString());
+        return written;
+    }
+
+    // Buffer what was not written yet
+    for (const QByteArray &chunk : data) {
+        if (written >= chunk.size()) {
+            written -= chunk.size();
+        } else if (written == 0 && chunk.size() >= QRINGBUFFER_CHUNKSIZE) {
+            writeBuffer.append(chunk);
+        } else {
+            writeBuffer.append(chunk.constData() + written, chunk.size() - written);
+            written = 0;
+        }
+    }
+    if (!writeBuffer.isEmpty())
+        socketEngine->setWriteNotificationEnabled(true);
+    return size;    // actually written + what has been buffered
+}
+
 /*! \internal
 
     Writes pending data in the write buffers to the socket. The function
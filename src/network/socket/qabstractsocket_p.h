@@ -101,6 +101,7 @@ public:
     void fetchConnectionParameters();
     bool readFromSocket();
     virtual bool writeToSocket();
+    qint64 writeVector(const QByteArrayList &data) override;
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
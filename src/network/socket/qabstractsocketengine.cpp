@@ -92,6 +92,29 @@ QAbstractSocketEngine *QAbstractSocketEngine::createSocketEngine(qintptr socketD
     return new QNativeSocketEngine(parent);
 }
 
+/*!
+    Writes the \a count buffers in \a chunks, one after the other, and returns
+    the number of bytes written, or -1 if an error occurred before anything
+    was written. The default implementation calls write() for each buffer,
+    stopping after a short write; engines that can send several buffers with
+    one system call reimplement it.
+*/
+qint64 QAbstractSocketEngine::writeVector(const QByteArrayView *chunks, qsizetype count)
+{
+    qint64 writtenSoFar = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (chunks[i].isEmpty())
+            continue;
+        const qint64 written = write(chunks[i].data(), chunks[i].size());
+        if (written < 0)
+            return writtenSoFar ? writtenSoFar : written;
+        writtenSoFar += written;
+        if (written < chunks[i].size())
+            break;
+    }
+    return writtenSoFar;
+}
+
 QAbstractSocket::SocketError QAbstractSocketEngine::error() const
 {
     return d_func()->socketError;
@@ -105,6 +105,7 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 writeVector(const QByteArrayView *chunks, qsizetype count);
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -75,6 +75,11 @@ public:
     {
         return QTcpSocket::writeData(data, maxSize);
     }
+
+    inline qint64 writeVector(const QByteArrayList &data)
+    {
+        return static_cast<QIODevicePrivate *>(d_ptr.data())->writeVector(data);
+    }
 };
 #endif //#if !defined(Q_OS_WIN) || defined(QT_LOCALSOCKET_TCP)
 
@@ -85,6 +90,9 @@ public:
 
     QLocalSocketPrivate();
     void init();
+#if !defined(Q_OS_WIN) || defined(QT_LOCALSOCKET_TCP)
+    qint64 writeVector(const QByteArrayList &data) override;
+#endif
 
 #if defined(QT_LOCALSOCKET_TCP)
     QLocalUnixSocket* tcpSocket;
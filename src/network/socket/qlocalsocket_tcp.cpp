@@ -285,6 +285,11 @@ qint64 QLocalSocket::writeData(const char *data, qint64 c)
     return d->tcpSocket->writeData(data, c);
 }
 
+qint64 QLocalSocketPrivate::writeVector(const QByteArrayList &data)
+{
+    return tcpSocket->writeVector(data);
+}
+
 void QLocalSocket::abort()
 {
     Q_D(QLocalSocket);
@@ -468,6 +468,11 @@ qint64 QLocalSocket::writeData(const char *data, qint64 c)
     return d->unixSocket.writeData(data, c);
 }
 
+qint64 QLocalSocketPrivate::writeVector(const QByteArrayList &data)
+{
+    return unixSocket.writeVector(data);
+}
+
 void QLocalSocket::abort()
 {
     Q_D(QLocalSocket);
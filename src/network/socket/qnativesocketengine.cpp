@@ -882,6 +882,23 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes the \a count buffers in \a chunks to the socket with one system
+    call where the platform supports it. Returns the number of bytes written,
+    which may be less than their total size, or -1 if an error occurred.
+*/
+qint64 QNativeSocketEngine::writeVector(const QByteArrayView *chunks, qsizetype count)
+{
+#ifdef Q_OS_UNIX
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeVector(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeVector(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteVector(chunks, count);
+#else
+    return QAbstractSocketEngine::writeVector(chunks, count);
+#endif
+}
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -123,6 +123,7 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 writeVector(const QByteArrayView *chunks, qsizetype count) override;
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
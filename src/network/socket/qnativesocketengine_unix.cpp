@@ -1303,6 +1303,52 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+/*
+    Like nativeWrite(), but sends the buffers with a single writev(). Only
+    the first IOV_MAX of them are sent.
+*/
+qint64 QNativeSocketEnginePrivate::nativeWriteVector(const QByteArrayView *chunks, qsizetype count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    QVarLengthArray<iovec, 16> vector;
+    for (qsizetype i = 0; i < count && vector.size() < QT_IOV_MAX; ++i) {
+        if (!chunks[i].isEmpty())
+            vector.append({ const_cast<char *>(chunks[i].data()), size_t(chunks[i].size()) });
+    }
+    if (vector.isEmpty())
+        return 0;
+
+    qint64 writtenBytes = qt_safe_writev_nosignal(socketDescriptor, vector.constData(),
+                                                   int(vector.size()));
+
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        case EMSGSIZE:
+            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteVector(%p, %lld) == %lld", chunks,
+           qint64(count), writtenBytes);
+#endif
+
+    return writtenBytes;
+}
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
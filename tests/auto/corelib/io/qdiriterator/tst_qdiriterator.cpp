@@ -11,6 +11,9 @@
 #include <qstringlist.h>
 #include <QSet>
 #include <QString>
+#include <QTemporaryDir>
+
+#include <functional>
 
 #include <QtCore/private/qfsfileengine_p.h>
 
@@ -27,6 +30,8 @@
 Q_DECLARE_METATYPE(QDirIterator::IteratorFlags)
 Q_DECLARE_METATYPE(QDir::Filters)
 
+using namespace Qt::StringLiterals;
+
 class tst_QDirIterator : public QObject
 {
     Q_OBJECT
@@ -88,6 +93,11 @@ private slots:
 #endif
 #ifndef Q_OS_WIN
     void hiddenDirs_hiddenFiles();
+#endif
+    void parallelTraversal_data();
+    void parallelTraversal();
+#ifndef Q_OS_WIN
+    void parallelTraversalFollowSymlinks();
 #endif
 #ifdef BUILTIN_TESTDATA
 private:
@@ -307,6 +317,39 @@ void tst_QDirIterator::iterateRelativeDirectory_data()
                    "entrylist/directory/dummy,"
                    "entrylist/writable").split(',');
 
+    QTest::newRow("QDir::Subdirectories | QDir::ParallelTraversal / QDir::Files")
+        << QString("entrylist")
+        << QDirIterator::IteratorFlags(QDirIterator::Subdirectories | QDirIterator::ParallelTraversal)
+        << QDir::Filters(QDir::Files) << QStringList("*")
+        << QString("entrylist/directory/dummy,"
+                   "entrylist/file,"
+#ifndef Q_NO_SYMLINKS
+                   "entrylist/linktofile.lnk,"
+#endif
+                   "entrylist/writable").split(',');
+
+    QTest::newRow("QDir::Subdirectories | QDir::FollowSymlinks | QDir::ParallelTraversal | QDir::UnorderedResults")
+        << QString("entrylist")
+        << QDirIterator::IteratorFlags(QDirIterator::Subdirectories | QDirIterator::FollowSymlinks
+                                       | QDirIterator::ParallelTraversal
+                                       | QDirIterator::UnorderedResults)
+        << QDir::Filters(QDir::NoFilter) << QStringList("*")
+        << QString(
+                   "entrylist/.,"
+                   "entrylist/..,"
+                   "entrylist/directory/.,"
+                   "entrylist/directory/..,"
+                   "entrylist/file,"
+#ifndef Q_NO_SYMLINKS
+                   "entrylist/linktofile.lnk,"
+#endif
+                   "entrylist/directory,"
+                   "entrylist/directory/dummy,"
+#if !defined(Q_NO_SYMLINKS) && !defined(Q_NO_SYMLINKS_TO_DIRS)
+                   "entrylist/linktodirectory.lnk,"
+#endif
+                   "entrylist/writable").split(',');
+
     QTest::newRow("empty, default")
         << QString("empty") << QDirIterator::IteratorFlags{}
         << QDir::Filters(QDir::NoFilter) << QStringList("*")
@@ -614,6 +657,114 @@ void tst_QDirIterator::hiddenDirs_hiddenFiles()
 }
 #endif // Q_OS_WIN
 
+void tst_QDirIterator::parallelTraversal_data()
+{
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QStringList>("nameFilters");
+
+    QTest::newRow("all") << QDir::Filters(QDir::NoFilter) << QStringList();
+    QTest::newRow("files") << QDir::Filters(QDir::Files) << QStringList();
+    QTest::newRow("dirs") << QDir::Filters(QDir::Dirs | QDir::NoDotAndDotDot) << QStringList();
+    QTest::newRow("name filter") << QDir::Filters(QDir::AllEntries | QDir::NoDotAndDotDot)
+                                 << QStringList("*1*");
+    QTest::newRow("hidden") << QDir::Filters(QDir::AllEntries | QDir::Hidden) << QStringList();
+}
+
+void tst_QDirIterator::parallelTraversal()
+{
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    QDir root(tempDir.path());
+
+    // a tree wide and deep enough for the workers to run ahead of the iteration
+    const std::function<void(const QString &, int)> populate = [&](const QString &path, int depth) {
+        QVERIFY(root.mkpath(path));
+        for (int i = 0; i < 5; ++i) {
+            QFile file(root.filePath(path + "/file"_L1 + QString::number(i)));
+            QVERIFY(file.open(QIODevice::WriteOnly));
+        }
+        QFile hidden(root.filePath(path + "/.hidden"_L1));
+        QVERIFY(hidden.open(QIODevice::WriteOnly));
+        if (depth < 3) {
+            for (int i = 0; i < 4; ++i)
+                populate(path + "/dir"_L1 + QString::number(i), depth + 1);
+        }
+    };
+    populate("tree"_L1, 0);
+    const QString path = root.filePath("tree"_L1);
+
+    auto iterate = [&](QDirIterator::IteratorFlags flags, qsizetype limit = -1) {
+        QStringList result;
+        QDirIterator it(path, nameFilters, filters, QDirIterator::Subdirectories | flags);
+        while (it.hasNext() && result.size() != limit)
+            result << it.nextFileInfo().filePath();
+        return result;
+    };
+
+    const QStringList sequential = iterate({});
+    QVERIFY(!sequential.isEmpty());
+
+    // the same entries in the same order
+    QCOMPARE(iterate(QDirIterator::ParallelTraversal), sequential);
+
+    // the same entries
+    QStringList unordered = iterate(QDirIterator::ParallelTraversal
+                                    | QDirIterator::UnorderedResults);
+    QStringList sorted = sequential;
+    unordered.sort();
+    sorted.sort();
+    QCOMPARE(unordered, sorted);
+
+    // stopping early cancels the listing
+    QCOMPARE(iterate(QDirIterator::ParallelTraversal, 3), sequential.first(3));
+    QCOMPARE(iterate(QDirIterator::ParallelTraversal | QDirIterator::UnorderedResults, 3).size(),
+             3);
+}
+
+#ifndef Q_OS_WIN
+void tst_QDirIterator::parallelTraversalFollowSymlinks()
+{
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    QDir root(tempDir.path());
+
+    // several links to the same directory, and loops: which of the paths is
+    // returned depends on the order in which the directories are entered
+    for (int i = 0; i < 8; ++i) {
+        const QString dir = "tree/d"_L1 + QString::number(i);
+        QVERIFY(root.mkpath(dir + "/sub"_L1));
+        QFile file(root.filePath(dir + "/sub/file"_L1));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QVERIFY(QFile::link("../target"_L1, root.filePath(dir + "/link"_L1)));
+        QVERIFY(QFile::link(".."_L1, root.filePath(dir + "/sub/loop"_L1)));
+    }
+    QVERIFY(root.mkpath("tree/target/sub"_L1));
+    QFile file(root.filePath("tree/target/sub/file"_L1));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    const QString path = root.filePath("tree"_L1);
+
+    auto iterate = [&](QDirIterator::IteratorFlags flags) {
+        QStringList result;
+        QDirIterator it(path, QDir::AllEntries | QDir::NoDotAndDotDot,
+                        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks | flags);
+        while (it.hasNext())
+            result << it.nextFileInfo().filePath();
+        return result;
+    };
+
+    const QStringList sequential = iterate({});
+    QVERIFY(sequential.contains(path + "/target"_L1));
+    QCOMPARE(sequential.filter("/sub/file"_L1).size(), 9);
+
+    // the same directories are skipped as loops or duplicates
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(iterate(QDirIterator::ParallelTraversal), sequential);
+}
+#endif
+
 QTEST_MAIN(tst_QDirIterator)
 
 #include "tst_qdiriterator.moc"
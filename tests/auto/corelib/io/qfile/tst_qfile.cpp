@@ -270,6 +270,8 @@ private slots:
 
     void openDirectory();
     void writeNothing();
+    void writeVector_data();
+    void writeVector();
 
     void invalidFile_data();
     void invalidFile();
@@ -3570,6 +3572,58 @@ void tst_QFile::writeNothing()
     }
 }
 
+void tst_QFile::writeVector_data()
+{
+    QTest::addColumn<int>("filetype");
+    QTest::addColumn<bool>("unbuffered");
+
+    QTest::newRow("native") << int(OpenQFile) << false;
+    QTest::newRow("native-unbuffered") << int(OpenQFile) << true;
+    QTest::newRow("fileno") << int(OpenFd) << false;
+    QTest::newRow("fileno-unbuffered") << int(OpenFd) << true;
+    QTest::newRow("stream") << int(OpenStream) << false;
+}
+
+void tst_QFile::writeVector()
+{
+    QFETCH(int, filetype);
+    QFETCH(bool, unbuffered);
+
+    QFile file("file.txt");
+    QIODevice::OpenMode mode = QIODevice::ReadWrite | QIODevice::Truncate;
+    if (unbuffered)
+        mode |= QIODevice::Unbuffered;
+    QVERIFY(openFile(file, mode, FileType(filetype)));
+
+    const QByteArray large(20000, 'x');
+    QByteArray expected;
+
+    // small enough to be buffered
+    QCOMPARE(file.write("head"), qint64(4));
+    QCOMPARE(file.write(QByteArrayList{ "ab", QByteArray(), "cd" }), qint64(4));
+    expected += "headabcd";
+    QCOMPARE(file.pos(), qint64(expected.size()));
+
+    // written with what is buffered
+    QCOMPARE(file.write(QByteArrayList{ "<", large, ">" }), qint64(large.size() + 2));
+    expected += '<' + large + '>';
+    QCOMPARE(file.pos(), qint64(expected.size()));
+
+    // overwriting after a seek
+    QVERIFY(file.seek(2));
+    QCOMPARE(file.write(QByteArrayList{ "AB", "CD" }), qint64(4));
+    expected.replace(2, 4, "ABCD");
+    QCOMPARE(file.pos(), qint64(6));
+    QCOMPARE(file.size(), qint64(expected.size()));
+    QCOMPARE(file.error(), QFile::NoError);
+    closeFile(file);
+
+    // the file descriptor opened by openFd() is write-only
+    QFile reader("file.txt");
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+    QCOMPARE(reader.readAll(), expected);
+}
+
 void tst_QFile::resize_data()
 {
     QTest::addColumn<int>("filetype");
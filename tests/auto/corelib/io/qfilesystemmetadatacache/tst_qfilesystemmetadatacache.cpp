@@ -0,0 +1,277 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QScopeGuard>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+// Changes made with the POSIX functions are invisible to Qt and are only seen
+// through inotify, so they need QTRY_*; changes made through QFile and QDir must
+// be visible immediately.
+class tst_QFileSystemMetaDataCache : public QObject
+{
+    Q_OBJECT
+public:
+    static void initMain();
+
+private slots:
+    void initTestCase();
+    void changesThroughQt();
+    void externalChanges();
+    void replacedFile();
+    void movedParentDirectory();
+    void symlinkedDirectory();
+    void relativePaths();
+    void concurrentLookups();
+
+private:
+    QString path(const QString &name) const { return root + u'/' + name; }
+
+    QTemporaryDir tempDir;
+    QString root;
+};
+
+void tst_QFileSystemMetaDataCache::initMain()
+{
+    qputenv("QT_FILESYSTEM_METADATA_CACHE", "1");
+}
+
+static bool writeFile(const QString &fileName, const char *data, int flags = O_TRUNC)
+{
+    const int fd = ::open(QFile::encodeName(fileName).constData(), O_WRONLY | O_CREAT | flags, 0644);
+    if (fd == -1)
+        return false;
+    const ssize_t size = ssize_t(qstrlen(data));
+    const bool ok = ::write(fd, data, size) == size;
+    ::close(fd);
+    return ok;
+}
+
+void tst_QFileSystemMetaDataCache::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    // only canonical paths are cached
+    root = QFileInfo(tempDir.path()).canonicalFilePath();
+    QVERIFY(!root.isEmpty());
+    // keeps QDir::rmpath() from removing the directory itself
+    QVERIFY(writeFile(path(u"keep"_s), ""));
+}
+
+void tst_QFileSystemMetaDataCache::changesThroughQt()
+{
+    const QString fileName = path(u"qt.txt"_s);
+    QVERIFY(!QFileInfo::exists(fileName));
+    QVERIFY(!QFileInfo::exists(fileName));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QVERIFY(QFileInfo::exists(fileName));
+    QCOMPARE(QFileInfo(fileName).size(), 0);
+    QCOMPARE(file.write("hello"), 5);
+    QVERIFY(file.flush());
+    QCOMPARE(QFileInfo(fileName).size(), 5);
+    QCOMPARE(file.write(" world"), 6);
+    file.close();
+    QCOMPARE(QFileInfo(fileName).size(), 11);
+
+    QVERIFY(file.setPermissions(QFile::ReadOwner | QFile::WriteOwner));
+    QCOMPARE(QFileInfo(fileName).permissions() & QFile::ReadOther, QFile::Permissions());
+
+    const QString renamed = path(u"qt-renamed.txt"_s);
+    QVERIFY(QFileInfo::exists(fileName));
+    QVERIFY(!QFileInfo::exists(renamed));
+    QVERIFY(file.rename(renamed));
+    QVERIFY(!QFileInfo::exists(fileName));
+    QVERIFY(QFileInfo::exists(renamed));
+
+    QVERIFY(QFile::remove(renamed));
+    QVERIFY(!QFileInfo::exists(renamed));
+
+    const QString dirName = path(u"qt-dir/sub"_s);
+    QVERIFY(!QFileInfo(dirName).isDir());
+    QVERIFY(QDir().mkpath(dirName));
+    QVERIFY(QFileInfo(dirName).isDir());
+    QVERIFY(QDir().rmpath(dirName));
+    QVERIFY(!QFileInfo::exists(dirName));
+    QVERIFY(!QFileInfo::exists(path(u"qt-dir"_s)));
+}
+
+void tst_QFileSystemMetaDataCache::externalChanges()
+{
+    const QString fileName = path(u"external.txt"_s);
+    const QByteArray nativeName = QFile::encodeName(fileName);
+    QVERIFY(!QFileInfo::exists(fileName));
+
+    QVERIFY(writeFile(fileName, "abc"));
+    QTRY_VERIFY(QFileInfo::exists(fileName));
+    QCOMPARE(QFileInfo(fileName).size(), 3);
+
+    QVERIFY(writeFile(fileName, "defg", O_APPEND));
+    QTRY_COMPARE(QFileInfo(fileName).size(), 7);
+
+    const struct timespec times[2] = { { 1000000000, 0 }, { 1000000000, 0 } };
+    QCOMPARE(::utimensat(AT_FDCWD, nativeName.constData(), times, 0), 0);
+    QTRY_COMPARE(QFileInfo(fileName).lastModified().toSecsSinceEpoch(), 1000000000);
+
+    QCOMPARE(::chmod(nativeName.constData(), 0600), 0);
+    QTRY_COMPARE(QFileInfo(fileName).permissions() & QFile::ReadOther, QFile::Permissions());
+
+    const QString renamed = path(u"external-renamed.txt"_s);
+    QVERIFY(!QFileInfo::exists(renamed));
+    QCOMPARE(::rename(nativeName.constData(), QFile::encodeName(renamed).constData()), 0);
+    QTRY_VERIFY(!QFileInfo::exists(fileName));
+    QTRY_VERIFY(QFileInfo::exists(renamed));
+    QCOMPARE(QFileInfo(renamed).size(), 7);
+
+    QCOMPARE(::unlink(QFile::encodeName(renamed).constData()), 0);
+    QTRY_VERIFY(!QFileInfo::exists(renamed));
+}
+
+void tst_QFileSystemMetaDataCache::replacedFile()
+{
+    // the way editors and build tools save files: the inode behind the path
+    // changes, later changes must be seen on the new one
+    const QString fileName = path(u"replaced.txt"_s);
+    const QString temporary = path(u"replaced.txt.tmp"_s);
+    QVERIFY(writeFile(fileName, "1"));
+    QTRY_COMPARE(QFileInfo(fileName).size(), 1);
+
+    for (const char *contents : { "22", "333", "4444" }) {
+        QVERIFY(writeFile(temporary, contents));
+        QCOMPARE(::rename(QFile::encodeName(temporary).constData(),
+                          QFile::encodeName(fileName).constData()), 0);
+        const qint64 size = qint64(qstrlen(contents));
+        QTRY_COMPARE(QFileInfo(fileName).size(), size);
+
+        QVERIFY(writeFile(fileName, "+", O_APPEND));
+        QTRY_COMPARE(QFileInfo(fileName).size(), size + 1);
+    }
+}
+
+void tst_QFileSystemMetaDataCache::movedParentDirectory()
+{
+    const QString fileName = path(u"a/b/c/file.txt"_s);
+    QVERIFY(QDir().mkpath(path(u"a/b/c"_s)));
+    QVERIFY(writeFile(fileName, "x"));
+    QTRY_VERIFY(QFileInfo::exists(fileName));
+
+    // only the watch on "a" sees this
+    QCOMPARE(::rename(QFile::encodeName(path(u"a"_s)).constData(),
+                      QFile::encodeName(path(u"moved"_s)).constData()), 0);
+    QTRY_VERIFY(!QFileInfo::exists(fileName));
+    QTRY_VERIFY(QFileInfo::exists(path(u"moved/b/c/file.txt"_s)));
+
+    // and the same names can be used again
+    QVERIFY(QDir().mkpath(path(u"a/b/c"_s)));
+    QVERIFY(!QFileInfo::exists(fileName));
+    QVERIFY(writeFile(fileName, "yy"));
+    QTRY_COMPARE(QFileInfo(fileName).size(), 2);
+}
+
+void tst_QFileSystemMetaDataCache::symlinkedDirectory()
+{
+    // a path through a symlink is not cached: inotify reports its changes
+    // under the canonical name only
+    QVERIFY(QDir().mkpath(path(u"target"_s)));
+    QVERIFY(QFile::link(path(u"target"_s), path(u"link"_s)));
+    const QString fileName = path(u"link/file.txt"_s);
+    QVERIFY(writeFile(path(u"target/file.txt"_s), "abc"));
+    QCOMPARE(QFileInfo(fileName).size(), 3);
+    QVERIFY(writeFile(path(u"target/file.txt"_s), "abcdef"));
+    QCOMPARE(QFileInfo(fileName).size(), 6);
+    QCOMPARE(::unlink(QFile::encodeName(path(u"target/file.txt"_s)).constData()), 0);
+    QVERIFY(!QFileInfo::exists(fileName));
+}
+
+void tst_QFileSystemMetaDataCache::relativePaths()
+{
+    const QString fileName = path(u"relative.txt"_s);
+    QVERIFY(!QFileInfo::exists(fileName));
+
+    const QString oldCurrent = QDir::currentPath();
+    QVERIFY(QDir::setCurrent(root));
+    auto restore = qScopeGuard([&] { QDir::setCurrent(oldCurrent); });
+
+    // a change through a relative name invalidates the absolute one
+    QFile file(u"relative.txt"_s);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write("1234"), 4);
+    file.close();
+    QCOMPARE(QFileInfo(fileName).size(), 4);
+    QCOMPARE(QFileInfo(u"relative.txt"_s).size(), 4);
+    QCOMPARE(QFileInfo(u"./relative.txt"_s).size(), 4);
+
+    QVERIFY(QFile::remove(u"relative.txt"_s));
+    QVERIFY(!QFileInfo::exists(fileName));
+}
+
+void tst_QFileSystemMetaDataCache::concurrentLookups()
+{
+    constexpr int FileCount = 64;
+    constexpr int ThreadCount = 4;
+    QVERIFY(QDir().mkpath(path(u"concurrent"_s)));
+    QStringList fileNames;
+    for (int i = 0; i < FileCount; ++i) {
+        fileNames << path(u"concurrent/%1"_s.arg(i));
+        if (i % 2)
+            QVERIFY(writeFile(fileNames.last(), QByteArray(i, 'x').constData()));
+    }
+
+    // all threads miss at the same time, then hit
+    std::atomic<int> errors = 0;
+    std::unique_ptr<QThread> threads[ThreadCount];
+    for (auto &thread : threads) {
+        thread.reset(QThread::create([&] {
+            for (int round = 0; round < 50; ++round) {
+                for (int i = 0; i < FileCount; ++i) {
+                    const QFileInfo info(fileNames.at(i));
+                    if (info.exists() != bool(i % 2) || (i % 2 && info.size() != i))
+                        ++errors;
+                }
+            }
+        }));
+        thread->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    QCOMPARE(errors.load(), 0);
+
+    // changes made while other threads look are seen by all of them
+    std::atomic<bool> done = false;
+    for (auto &thread : threads) {
+        thread.reset(QThread::create([&] {
+            while (!done.load()) {
+                for (const QString &fileName : std::as_const(fileNames))
+                    QFileInfo(fileName).size();
+            }
+        }));
+        thread->start();
+    }
+    for (int i = 0; i < FileCount; ++i) {
+        QFile file(fileNames.at(i));
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(file.write(QByteArray(i + 1, 'y')), i + 1);
+    }
+    done = true;
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    for (int i = 0; i < FileCount; ++i)
+        QCOMPARE(QFileInfo(fileNames.at(i)).size(), i + 1);
+}
+
+QTEST_GUILESS_MAIN(tst_QFileSystemMetaDataCache)
+#include "tst_qfilesystemmetadatacache.moc"
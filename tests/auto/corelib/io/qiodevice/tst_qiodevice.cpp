@@ -38,6 +38,9 @@ private slots:
     void transaction_data();
     void transaction();
 
+    void writeVector();
+    void writeVectorShortWrite();
+
 private:
     QSharedPointer<QTemporaryDir> m_tempDir;
     QString m_previousCurrent;
@@ -823,5 +826,63 @@ void tst_QIODevice::transaction()
     }
 }
 
+void tst_QIODevice::writeVector()
+{
+    QByteArray data("0123456789");
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadWrite));
+    QVERIFY(buffer.seek(2));
+
+    const QByteArrayList chunks = { "ab", QByteArray(), "cde", "f" };
+    QCOMPARE(buffer.write(chunks), qint64(6));
+    QCOMPARE(buffer.pos(), qint64(8));
+    QCOMPARE(data, QByteArray("01abcdef89"));
+
+    QCOMPARE(buffer.write(QByteArrayList()), qint64(0));
+    QCOMPARE(buffer.write(QByteArrayList{ "xyz" }), qint64(3));
+    QCOMPARE(data, QByteArray("01abcdefxyz"));
+
+    buffer.close();
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): ReadOnly device");
+    QCOMPARE(buffer.write(chunks), qint64(-1));
+}
+
+class LimitedWriteBuffer : public QIODevice
+{
+public:
+    explicit LimitedWriteBuffer(qint64 capacity) : capacity(capacity) { }
+
+    bool isSequential() const override { return true; }
+    QByteArray written;
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+    qint64 writeData(const char *data, qint64 maxSize) override
+    {
+        maxSize = qMin(maxSize, capacity - written.size());
+        if (maxSize <= 0)
+            return -1;
+        written.append(data, maxSize);
+        return maxSize;
+    }
+
+private:
+    qint64 capacity;
+};
+
+void tst_QIODevice::writeVectorShortWrite()
+{
+    const QByteArrayList chunks = { "abc", "defg", "hi" };
+
+    LimitedWriteBuffer device(5);
+    QVERIFY(device.open(QIODevice::WriteOnly));
+    // stops after the short write of the second chunk
+    QCOMPARE(device.write(chunks), qint64(5));
+    QCOMPARE(device.written, QByteArray("abcde"));
+    // nothing could be written
+    QCOMPARE(device.write(chunks), qint64(-1));
+}
+
 QTEST_MAIN(tst_QIODevice)
 #include "tst_qiodevice.moc"
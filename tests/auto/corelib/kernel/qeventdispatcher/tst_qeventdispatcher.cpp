@@ -11,6 +11,9 @@
 #include <QAbstractEventDispatcher>
 #include <QTimer>
 #include <QThreadPool>
+#include <QElapsedTimer>
+#include <QScopeGuard>
+#include <QSemaphore>
 
 enum {
     PreciseTimerInterval    =   10,
@@ -56,6 +59,7 @@ private slots:
     void postedEventsPingPong();
     void eventLoopExit();
     void interruptTrampling();
+    void farFutureTimer();
 
 private:
     const bool isGuiEventDispatcher;
@@ -531,5 +535,71 @@ void tst_QEventDispatcher::interruptTrampling()
     QVERIFY(thread.isFinished());
 }
 
+// A timer that is due in more than INT_MAX milliseconds must neither fire nor
+// cut the dispatcher's wait short, and must not keep a short timer from firing.
+void tst_QEventDispatcher::farFutureTimer()
+{
+    using namespace std::chrono_literals;
+    // if the time left is truncated to an int, only the 400ms remain
+    constexpr auto FarAway = std::chrono::milliseconds(Q_INT64_C(1) << 32) + 400ms;
+
+    class TimerCounter : public QObject
+    {
+    public:
+        QList<int> fired;
+    protected:
+        void timerEvent(QTimerEvent *e) override { fired.append(e->timerId()); }
+    };
+
+    class WorkerThread : public QThread
+    {
+    public:
+        QSemaphore waiting;
+        qint64 waitedMSecs = -1;
+        bool shortFired = false;
+        bool farFired = false;
+
+        void run() override {
+            auto dispatcher = eventDispatcher();
+            QVERIFY(dispatcher);
+            TimerCounter counter;
+            const int farId = counter.startTimer(FarAway);
+            const int shortId = counter.startTimer(50ms);
+            QVERIFY(farId > 0 && shortId > 0);
+
+            QElapsedTimer timer;
+            timer.start();
+            while (!counter.fired.contains(shortId) && !timer.hasExpired(5000))
+                dispatcher->processEvents(QEventLoop::WaitForMoreEvents);
+            counter.killTimer(shortId);
+            QCoreApplication::sendPostedEvents();
+            shortFired = counter.fired.contains(shortId);
+
+            // only the far timer is left; nothing but wakeUp() ends this wait
+            waiting.release();
+            timer.restart();
+            dispatcher->processEvents(QEventLoop::WaitForMoreEvents);
+            waitedMSecs = timer.elapsed();
+            farFired = counter.fired.contains(farId);
+        }
+    };
+
+    // make QEventDispatcherUNIX use epoll in the worker thread, where the wait
+    // is converted to milliseconds; the other dispatchers ignore this
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    auto restore = qScopeGuard([] { qunsetenv("QT_EVENT_DISPATCHER_EPOLL"); });
+
+    WorkerThread thread;
+    thread.start();
+    QVERIFY(thread.waiting.tryAcquire(1, 10000));
+    QThread::sleep(1s);
+    thread.eventDispatcher()->wakeUp();
+    QVERIFY(thread.wait(10000));
+
+    QVERIFY(thread.shortFired);
+    QVERIFY(!thread.farFired);
+    QVERIFY2(thread.waitedMSecs >= 800, QByteArray::number(thread.waitedMSecs));
+}
+
 QTEST_MAIN(tst_QEventDispatcher)
 #include "tst_qeventdispatcher.moc"
@@ -146,10 +146,12 @@ private slots:
     void functorReferencesConnection();
     void disconnectDisconnects();
     void singleShotConnection();
+    void batchedConnection();
     void objectNameBinding();
     void emitToDestroyedClass();
     void declarativeData();
     void asyncCallbackHelper();
+    void allocationPool();
 };
 
 struct QObjectCreatedOnShutdown
@@ -8191,6 +8193,105 @@ void tst_QObject::singleShotConnection()
     }
 }
 
+void tst_QObject::batchedConnection()
+{
+    class Receiver : public QObject
+    {
+    public:
+        int metaCallEvents = 0;
+        QList<int> ints;
+        QStringList strings;
+
+        void slot(int i, const QString &s)
+        {
+            ints.append(i);
+            strings.append(s);
+        }
+
+    protected:
+        bool event(QEvent *e) override
+        {
+            if (e->type() == QEvent::MetaCall)
+                ++metaCallEvents;
+            return QObject::event(e);
+        }
+    };
+
+    const auto batched = Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection);
+    const auto latestOnly = Qt::ConnectionType(Qt::QueuedConnection | Qt::LatestValueOnlyConnection);
+
+    {
+        // all queued emissions are delivered from one event, in order
+        SenderObject sender;
+        Receiver receiver;
+        connect(&sender, &SenderObject::signal7, &receiver,
+                [&receiver](int i, const QString &s) { receiver.slot(i, s); }, batched);
+
+        emit sender.signal7(1, "one");
+        emit sender.signal7(2, "two");
+        emit sender.signal7(3, "three");
+        QVERIFY(receiver.ints.isEmpty());
+
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.metaCallEvents, 1);
+        QCOMPARE(receiver.ints, QList<int>({ 1, 2, 3 }));
+        QCOMPARE(receiver.strings, QStringList({ "one", "two", "three" }));
+
+        // once delivered, the next emission posts a new event
+        emit sender.signal7(4, "four");
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.metaCallEvents, 2);
+        QCOMPARE(receiver.ints, QList<int>({ 1, 2, 3, 4 }));
+    }
+
+    {
+        // only the latest values are delivered
+        SenderObject sender;
+        Receiver receiver;
+        connect(&sender, &SenderObject::signal7, &receiver,
+                [&receiver](int i, const QString &s) { receiver.slot(i, s); }, latestOnly);
+
+        for (int i = 0; i < 10; ++i)
+            emit sender.signal7(i, QString::number(i));
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.metaCallEvents, 1);
+        QCOMPARE(receiver.ints, QList<int>({ 9 }));
+        QCOMPARE(receiver.strings, QStringList({ "9" }));
+    }
+
+    {
+        // string-based connections to slots
+        SenderObject sender;
+        QVERIFY(connect(&sender, SIGNAL(signal1()), &sender, SLOT(aPublicSlot()), batched));
+        sender.emitSignal1();
+        sender.emitSignal1();
+        QCOMPARE(sender.aPublicSlotCalled, 0);
+        QCoreApplication::processEvents();
+        QCOMPARE(sender.aPublicSlotCalled, 2);
+    }
+
+    {
+        // emissions from another thread
+        SenderObject sender;
+        Receiver receiver;
+        connect(&sender, &SenderObject::signal7, &receiver,
+                [&receiver](int i, const QString &s) { receiver.slot(i, s); },
+                Qt::ConnectionType(Qt::AutoConnection | Qt::BatchedConnection));
+
+        const int count = 1000;
+        std::unique_ptr<QThread> thread(QThread::create([&sender] {
+            for (int i = 0; i < count; ++i)
+                emit sender.signal7(i, QString::number(i));
+        }));
+        thread->start();
+        QVERIFY(thread->wait());
+        QTRY_COMPARE(receiver.ints.size(), count);
+        QVERIFY(receiver.metaCallEvents <= count);
+        for (int i = 0; i < count; ++i)
+            QCOMPARE(receiver.ints.at(i), i);
+    }
+}
+
 void tst_QObject::objectNameBinding()
 {
     QObject obj;
@@ -8595,5 +8696,58 @@ void tst_QObject::asyncCallbackHelper()
     }
 }
 
+void tst_QObject::allocationPool()
+{
+#ifdef QT_BUILD_INTERNAL
+    QVERIFY(!QObjectAllocationPool::isEnabled());
+    QObjectAllocationPool::setEnabled(true);
+    auto cleanup = qScopeGuard([] { QObjectAllocationPool::setEnabled(false); });
+    QVERIFY(QObjectAllocationPool::isEnabled());
+
+    // the memory of a deleted object's private is recycled for the next one
+    QObjectPrivate *d = nullptr;
+    {
+        QObject object;
+        d = QObjectPrivate::get(&object);
+    }
+    {
+        QObject object;
+        QCOMPARE(QObjectPrivate::get(&object), d);
+    }
+
+    // connections and children still work as usual
+    for (int i = 0; i < 100; ++i) {
+        SenderObject sender;
+        ReceiverObject *receiver = new ReceiverObject;
+        receiver->reset();
+        receiver->setParent(&sender);
+        new QObject(receiver);
+        connect(&sender, &SenderObject::signal1, receiver, &ReceiverObject::slot1);
+        connect(&sender, &SenderObject::signal2, receiver, [receiver] { delete receiver; });
+        sender.emitSignal1();
+        QCOMPARE(receiver->count_slot1, 1);
+        sender.emitSignal2();
+        QVERIFY(sender.children().isEmpty());
+    }
+
+    // objects can be deleted in a thread other than the one that created them
+    QThread thread;
+    thread.start();
+    for (int i = 0; i < 100; ++i) {
+        QObject *object = new QObject;
+        connect(object, &QObject::objectNameChanged, object, [] {});
+        object->moveToThread(&thread);
+        object->deleteLater();
+    }
+    thread.quit();
+    QVERIFY(thread.wait());
+
+    QObjectAllocationPool::setEnabled(false);
+    QVERIFY(!QObjectAllocationPool::isEnabled());
+#else
+    QSKIP("Needs QT_BUILD_INTERNAL");
+#endif
+}
+
 QTEST_MAIN(tst_QObject)
 #include "tst_qobject.moc"
@@ -6,16 +6,20 @@
 #include <QtTest/QTestEventLoop>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QScopeGuard>
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QTemporaryFile>
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
 #include <private/qnativesocketengine_p.h>
 #define NATIVESOCKETENGINE QNativeSocketEngine
 #ifdef Q_OS_UNIX
+#include <private/qcore_unix_p.h>
 #include <private/qnet_unix_p.h>
 #include <sys/select.h>
+#include <sys/socket.h>
 #endif
 #include <limits>
 
@@ -26,6 +30,16 @@
 
 using namespace std::chrono_literals;
 
+#ifdef ENABLE_EPOLL
+// Run the whole test a second time on the epoll(7) backend of
+// QEventDispatcherUNIX, which has to be selected before the application exists.
+static bool epollEnabled = []() {
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    qputenv("QT_NO_GLIB", "1");
+    return true;
+}();
+#endif
+
 class tst_QSocketNotifier : public QObject
 {
     Q_OBJECT
@@ -35,6 +49,10 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+    void readWriteExceptionNotifiers();
+    void disableAndReenable();
+    void reuseClosedDescriptor();
+    void regularFile();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -336,6 +354,147 @@ void tst_QSocketNotifier::posixSockets()
     }
     qt_safe_close(posixSocket);
 }
+// Waits until the spy has recorded at least \a count activations, returns
+// whether it got there.
+static bool waitForActivations(QSignalSpy &spy, int count)
+{
+    return QTest::qWaitFor([&] { return spy.size() >= count; }, 5000);
+}
+
+void tst_QSocketNotifier::readWriteExceptionNotifiers()
+{
+    int fds[2];
+    QCOMPARE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    const auto cleanup = qScopeGuard([&] {
+        qt_safe_close(fds[0]);
+        if (fds[1] != -1)
+            qt_safe_close(fds[1]);
+    });
+
+    // Write readiness is reported as soon as the notifier is enabled.
+    QSocketNotifier wn(fds[1], QSocketNotifier::Write);
+    QSignalSpy writeSpy(&wn, &QSocketNotifier::activated);
+    QVERIFY(waitForActivations(writeSpy, 1));
+    QCOMPARE(writeSpy.at(0).at(0).value<QSocketDescriptor>(), QSocketDescriptor(fds[1]));
+    QCOMPARE(writeSpy.at(0).at(1).value<QSocketNotifier::Type>(), QSocketNotifier::Write);
+    wn.setEnabled(false);
+
+    QSocketNotifier rn(fds[0], QSocketNotifier::Read);
+    QSignalSpy readSpy(&rn, &QSocketNotifier::activated);
+    QSocketNotifier en(fds[0], QSocketNotifier::Exception);
+    QSignalSpy errorSpy(&en, &QSocketNotifier::activated);
+
+    QTest::qWait(20);
+    QCOMPARE(readSpy.size(), 0);
+    QCOMPARE(errorSpy.size(), 0);
+
+    QCOMPARE(qt_safe_write(fds[1], "hello", 5), 5);
+    QVERIFY(waitForActivations(readSpy, 1));
+    QCOMPARE(readSpy.at(0).at(1).value<QSocketNotifier::Type>(), QSocketNotifier::Read);
+    QCOMPARE(errorSpy.size(), 0);
+
+    char buffer[16];
+    QCOMPARE(qt_safe_read(fds[0], buffer, sizeof buffer), 5);
+    QCOMPARE(QByteArrayView(buffer, 5), "hello");
+
+    // Hanging up the peer is reported to the exception notifier.
+    qt_safe_close(fds[1]);
+    fds[1] = -1;
+    QVERIFY(waitForActivations(errorSpy, 1));
+    QCOMPARE(errorSpy.at(0).at(1).value<QSocketNotifier::Type>(), QSocketNotifier::Exception);
+}
+
+void tst_QSocketNotifier::disableAndReenable()
+{
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds), 0);
+    const auto cleanup = qScopeGuard([&] {
+        qt_safe_close(fds[0]);
+        qt_safe_close(fds[1]);
+    });
+
+    QSocketNotifier rn(fds[0], QSocketNotifier::Read);
+    QSignalSpy readSpy(&rn, &QSocketNotifier::activated);
+    // The data is never read, so the notifier stays ready the whole time.
+    connect(&rn, &QSocketNotifier::activated, &rn, [&rn] { rn.setEnabled(false); });
+
+    QCOMPARE(qt_safe_write(fds[1], "x", 1), 1);
+    QVERIFY(waitForActivations(readSpy, 1));
+
+    QTest::qWait(20);
+    QCOMPARE(readSpy.size(), 1);
+
+    rn.setEnabled(true);
+    QVERIFY(waitForActivations(readSpy, 2));
+    QVERIFY(!rn.isEnabled());
+}
+
+void tst_QSocketNotifier::reuseClosedDescriptor()
+{
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds), 0);
+    const int readFd = fds[0];
+
+    {
+        QSocketNotifier rn(readFd, QSocketNotifier::Read);
+        QSignalSpy readSpy(&rn, &QSocketNotifier::activated);
+        QCOMPARE(qt_safe_write(fds[1], "x", 1), 1);
+        QVERIFY(waitForActivations(readSpy, 1));
+
+        // Close the descriptor while its notifier is still enabled.
+        qt_safe_close(fds[0]);
+        qt_safe_close(fds[1]);
+    }
+
+    // The lowest free descriptor is handed out again.
+    QCOMPARE(qt_safe_pipe(fds), 0);
+    const auto cleanup = qScopeGuard([&] {
+        qt_safe_close(fds[0]);
+        qt_safe_close(fds[1]);
+    });
+    if (fds[0] != readFd)
+        QSKIP("The closed descriptor number was not reused");
+
+    QSocketNotifier rn(fds[0], QSocketNotifier::Read);
+    QSignalSpy readSpy(&rn, &QSocketNotifier::activated);
+    QTest::qWait(20);
+    QCOMPARE(readSpy.size(), 0);
+
+    QCOMPARE(qt_safe_write(fds[1], "y", 1), 1);
+    QVERIFY(waitForActivations(readSpy, 1));
+    QCOMPARE(readSpy.at(0).at(0).value<QSocketDescriptor>(), QSocketDescriptor(readFd));
+}
+
+void tst_QSocketNotifier::regularFile()
+{
+    // epoll(7) refuses regular files, poll(2) reports them as always ready.
+    QTemporaryFile file;
+    QVERIFY2(file.open(), qPrintable(file.errorString()));
+    QCOMPARE(file.write("data"), 4);
+    QVERIFY(file.flush());
+    QVERIFY(file.seek(0));
+
+    QSocketNotifier rn(file.handle(), QSocketNotifier::Read);
+    QSignalSpy readSpy(&rn, &QSocketNotifier::activated);
+    QVERIFY(waitForActivations(readSpy, 1));
+    rn.setEnabled(false);
+
+    // Notifiers on other descriptors keep working alongside it.
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds), 0);
+    const auto cleanup = qScopeGuard([&] {
+        qt_safe_close(fds[0]);
+        qt_safe_close(fds[1]);
+    });
+    QSocketNotifier pipeNotifier(fds[0], QSocketNotifier::Read);
+    QSignalSpy pipeSpy(&pipeNotifier, &QSocketNotifier::activated);
+    QTest::qWait(20);
+    QCOMPARE(pipeSpy.size(), 0);
+
+    QCOMPARE(qt_safe_write(fds[1], "x", 1), 1);
+    QVERIFY(waitForActivations(pipeSpy, 1));
+    QCOMPARE(readSpy.size(), 1);
+}
 #endif
 
 void tst_QSocketNotifier::async_readDatagramSlot()
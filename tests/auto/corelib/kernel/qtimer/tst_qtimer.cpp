@@ -16,11 +16,16 @@
 #include <qthread.h>
 #include <qelapsedtimer.h>
 #include <qproperty.h>
+#include <qdeadlinetimer.h>
 
 #if defined Q_OS_UNIX
+#include <QtCore/private/qeventdispatcher_unix_p.h>
+#include <QtCore/private/qtimerinfo_unix_p.h>
 #include <unistd.h>
 #endif
 
+using namespace std::chrono_literals;
+
 class tst_QTimer : public QObject
 {
     Q_OBJECT
@@ -69,6 +74,13 @@ private slots:
 
     void bindToTimer();
     void bindTimer();
+
+#ifdef Q_OS_UNIX
+    void timerWheelEnabled();
+    void timerWheelCascade();
+    void timerWheelUnregisterCascading();
+    void timerWheelRemainingTime();
+#endif
 };
 
 void tst_QTimer::zeroTimer()
@@ -1277,6 +1289,11 @@ static StaticSingleShotUser *s_staticSingleShotUser = nullptr;
 void tst_QTimer::initMain()
 {
     s_staticSingleShotUser = new StaticSingleShotUser;
+#ifdef ENABLE_TIMER_WHEEL
+    // run all tests with QEventDispatcherUNIX keeping coarse timers in a wheel
+    qputenv("QT_EVENT_DISPATCHER_TIMER_WHEEL", "1");
+    qputenv("QT_NO_GLIB", "1");
+#endif
 }
 
 void tst_QTimer::cleanupTestCase()
@@ -1290,6 +1307,156 @@ void tst_QTimer::singleShot_static()
     QCOMPARE(s_staticSingleShotUser->helper.calls, s_staticSingleShotUser->calls());
 }
 
+#ifdef Q_OS_UNIX
+class TimerEventRecorder : public QObject
+{
+public:
+    QList<int> timerIds;
+
+protected:
+    void timerEvent(QTimerEvent *event) override { timerIds.append(event->timerId()); }
+};
+
+// Drives \a timers the way QEventDispatcherUNIX does, until \a done returns
+// true or \a timeout expires.
+template <typename Done>
+static bool runTimers(QTimerInfoList &timers, Done done, std::chrono::milliseconds timeout)
+{
+    QDeadlineTimer deadline(timeout);
+    while (!done()) {
+        if (deadline.hasExpired())
+            return false;
+        timespec tm;
+        if (timers.timerWait(tm)) {
+            const qint64 usecs = qint64(tm.tv_sec) * 1000 * 1000 + tm.tv_nsec / 1000;
+            QThread::usleep(qMin(usecs, deadline.remainingTime() * 1000));
+        }
+        timers.activateTimers();
+    }
+    return true;
+}
+
+void tst_QTimer::timerWheelEnabled()
+{
+    auto dispatcher = qobject_cast<QEventDispatcherUNIX *>(QAbstractEventDispatcher::instance());
+    if (!dispatcher)
+        QSKIP("This test requires QEventDispatcherUNIX");
+
+    auto d = static_cast<QEventDispatcherUNIXPrivate *>(QObjectPrivate::get(dispatcher));
+    QCOMPARE(d->timerList.isTimerWheelEnabled(),
+             qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_TIMER_WHEEL") > 0);
+#ifdef ENABLE_TIMER_WHEEL
+    QVERIFY(d->timerList.isTimerWheelEnabled());
+#endif
+}
+
+void tst_QTimer::timerWheelCascade()
+{
+    QTimerInfoList timers;
+    timers.setTimerWheelEnabled(true);
+    QVERIFY(timers.isTimerWheelEnabled());
+
+    // The wheel's first level covers 64 ms and the second 4096 ms, so these
+    // timers cross one or two cascade boundaries before they fire.
+    TimerEventRecorder recorder;
+    const int intervals[] = { 1000, 100, 4200, 250, 30, 2500 };
+    for (int interval : intervals)
+        timers.registerTimer(interval, interval, Qt::CoarseTimer, &recorder);
+    QCOMPARE(timers.registeredTimers(&recorder).size(), qsizetype(std::size(intervals)));
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    QVERIFY(runTimers(timers, [&] { return recorder.timerIds.contains(4200); }, 10s));
+    QCOMPARE_GE(elapsed.elapsed(), 4200 * 95 / 100);
+
+    QList<int> sorted(std::begin(intervals), std::end(intervals));
+    std::sort(sorted.begin(), sorted.end());
+    // shorter timers fire again while the longer ones are waiting
+    QList<int> firsts;
+    for (int id : std::as_const(recorder.timerIds)) {
+        if (!firsts.contains(id))
+            firsts.append(id);
+    }
+    QCOMPARE(firsts, sorted);
+
+    QVERIFY(timers.unregisterTimers(&recorder));
+    QVERIFY(timers.registeredTimers(&recorder).isEmpty());
+}
+
+void tst_QTimer::timerWheelUnregisterCascading()
+{
+    QTimerInfoList timers;
+    timers.setTimerWheelEnabled(true);
+    TimerEventRecorder recorder;
+
+    // more than 64 ms away: waits in the second level until its block is reached
+    timers.registerTimer(1, 300ms, Qt::CoarseTimer, &recorder);
+    timers.registerTimer(2, 150ms, Qt::CoarseTimer, &recorder);
+    // in the third level, unregistered before anything happens
+    timers.registerTimer(3, 5000ms, Qt::CoarseTimer, &recorder);
+    QVERIFY(timers.unregisterTimer(3));
+    QVERIFY(!timers.unregisterTimer(3));
+
+    QVERIFY(runTimers(timers, [&] { return !recorder.timerIds.isEmpty(); }, 5s));
+    QCOMPARE(recorder.timerIds, QList<int>{ 2 });
+    QVERIFY(timers.unregisterTimer(2));
+    QVERIFY(timers.unregisterTimer(1));
+    QVERIFY(!timers.unregisterTimer(1));
+
+    timers.registerTimer(4, 400ms, Qt::CoarseTimer, &recorder);
+    QVERIFY(runTimers(timers, [&] { return recorder.timerIds.size() == 2; }, 5s));
+    QCOMPARE(recorder.timerIds, (QList<int>{ 2, 4 }));
+
+    const QList<QAbstractEventDispatcher::TimerInfo> registered = timers.registeredTimers(&recorder);
+    QCOMPARE(registered.size(), 1);
+    QCOMPARE(registered.first().timerId, 4);
+    QVERIFY(timers.unregisterTimers(&recorder));
+}
+
+void tst_QTimer::timerWheelRemainingTime()
+{
+    QTimerInfoList timers;
+    timers.setTimerWheelEnabled(true);
+    TimerEventRecorder recorder;
+
+    timers.registerTimer(1, 1000ms, Qt::CoarseTimer, &recorder);
+    timers.registerTimer(2, 4200ms, Qt::CoarseTimer, &recorder);
+    timers.registerTimer(3, 3s, Qt::VeryCoarseTimer, &recorder);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    // coarse timers may be moved by up to 5%, very coarse ones to a full second
+    const qint64 remaining1 = timers.timerRemainingTime(1);
+    const qint64 remaining2 = timers.timerRemainingTime(2);
+    const qint64 remaining3 = timers.timerRemainingTime(3);
+    QCOMPARE_GE(remaining1, 950);
+    QCOMPARE_LE(remaining1, 1050);
+    QCOMPARE_GE(remaining2, 3990);
+    QCOMPARE_LE(remaining2, 4410);
+    QCOMPARE_GE(remaining3, 2000);
+    QCOMPARE_LE(remaining3, 4000);
+
+    // crossing the first level's boundaries must not disturb the remaining time
+    QThread::msleep(300);
+    timers.activateTimers();
+    QVERIFY(recorder.timerIds.isEmpty());
+    const qint64 waited = elapsed.elapsed();
+    const std::pair<int, qint64> initial[] = { { 1, remaining1 }, { 2, remaining2 }, { 3, remaining3 } };
+    for (const auto &[timerId, before] : initial) {
+        const qint64 remaining = timers.timerRemainingTime(timerId);
+        QCOMPARE_LE(remaining, before - waited + 1);
+        QCOMPARE_GE(remaining, before - waited - 50);
+    }
+
+    QVERIFY(runTimers(timers, [&] { return !recorder.timerIds.isEmpty(); }, 5s));
+    QCOMPARE(recorder.timerIds, QList<int>{ 1 });
+    // rescheduled a full interval later
+    QCOMPARE_GE(timers.timerRemainingTime(1), 900);
+    QVERIFY(timers.unregisterTimers(&recorder));
+    QVERIFY(timers.registeredTimers(&recorder).isEmpty());
+}
+#endif
+
 QTEST_MAIN(tst_QTimer)
 
 #include "tst_qtimer.moc"
@@ -12,10 +12,19 @@ QT_WARNING_DISABLE_DEPRECATED
 #include "qjsonobject.h"
 #include "qjsonvalue.h"
 #include "qjsondocument.h"
+#include "qjsonlazydocument.h"
+#include "qjsonstreamreader.h"
+#include "qjsonstreamwriter.h"
+#include "qbuffer.h"
+#include "qcborvalue.h"
+#include "qrandom.h"
 #include "qregularexpression.h"
 #include "private/qnumeric_p.h"
+#include <functional>
 #include <limits>
 
+using namespace Qt::StringLiterals;
+
 #define INVALID_UNICODE "\xCE\xBA\xE1"
 #define UNICODE_NON_CHARACTER "\xEF\xBF\xBF"
 #define UNICODE_DJE "\320\202" // Character from the Serbian Cyrillic alphabet
@@ -158,6 +167,30 @@ private Q_SLOTS:
     void noLeakOnNameClash_data();
     void noLeakOnNameClash();
 
+    void lazyDocument();
+    void lazyDocumentMatchesDocument_data();
+    void lazyDocumentMatchesDocument();
+    void lazyDocumentStrings();
+    void lazyDocumentMalformedValues();
+    void lazyDocumentErrors_data();
+    void lazyDocumentErrors();
+
+    void streamReader();
+    void streamReaderMatchesDocument_data() { lazyDocumentMatchesDocument_data(); }
+    void streamReaderMatchesDocument();
+    void streamReaderIncremental_data() { lazyDocumentMatchesDocument_data(); }
+    void streamReaderIncremental();
+    void streamReaderSkipIncomplete();
+    void streamReaderErrors_data();
+    void streamReaderErrors();
+    void streamReaderGarbageAtEnd_data();
+    void streamReaderGarbageAtEnd();
+    void streamReaderTopLevelNumber();
+    void streamWriter_data() { lazyDocumentMatchesDocument_data(); }
+    void streamWriter();
+    void streamWriterDevice();
+    void streamWriterMisuse();
+
 private:
     QString testDataDir;
 };
@@ -3842,5 +3875,825 @@ void tst_QtJson::noLeakOnNameClash()
     // In particular it should not forget to deref the container for the inner objects.
 }
 
+void tst_QtJson::lazyDocument()
+{
+    const QByteArray json = R"({
+        "name": "Qt", "version": 6.7, "major": 6, "released": true, "license": null,
+        "empty": {}, "none": [],
+        "modules": [ "Core", "Gui", { "name": "Widgets", "deprecated": false } ],
+        "escaped\u00e9": "tab\tquote\"",
+        "big": 1e300, "negative": -42
+    })";
+
+    QJsonParseError error;
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QVERIFY(!doc.isNull());
+    QVERIFY(doc.isObject());
+    QVERIFY(!doc.isArray());
+
+    QCOMPARE(doc["name"].type(), QJsonValue::String);
+    QCOMPARE(doc["name"].toString(), u"Qt");
+    QCOMPARE(doc["name"].rawJson(), "\"Qt\"");
+    QCOMPARE(doc["version"].toDouble(), 6.7);
+    QCOMPARE(doc["version"].toInteger(-1), -1);
+    QCOMPARE(doc["major"].toInt(), 6);
+    QCOMPARE(doc["major"].toInteger(), 6);
+    QCOMPARE(doc["negative"].toInt(), -42);
+    QCOMPARE(doc["big"].toDouble(), 1e300);
+    QVERIFY(doc["released"].isBool());
+    QVERIFY(doc["released"].toBool());
+    QVERIFY(doc["license"].isNull());
+    QCOMPARE(doc[u"escaped\u00e9"].toString(), u"tab\tquote\"");
+    QCOMPARE(doc[QLatin1StringView("escaped\xe9")].toString(), u"tab\tquote\"");
+    QCOMPARE(doc["escaped\xc3\xa9"].toString(), u"tab\tquote\"");
+
+    QVERIFY(doc["empty"].isObject());
+    QCOMPARE(doc["empty"].size(), 0);
+    QVERIFY(doc["empty"].begin() == doc["empty"].end());
+    QVERIFY(doc["none"].isArray());
+    QCOMPARE(doc["none"].size(), 0);
+    QCOMPARE(doc["none"].rawJson(), "[]");
+
+    const QJsonLazyValue modules = doc["modules"];
+    QVERIFY(modules.isArray());
+    QCOMPARE(modules.size(), 3);
+    QCOMPARE(modules[0].toString(), u"Core");
+    QCOMPARE(modules[1].toString(), u"Gui");
+    QCOMPARE(modules[2]["name"].toString(), u"Widgets");
+    QVERIFY(!modules[2]["deprecated"].toBool(true));
+    QVERIFY(modules[3].isUndefined());
+    QVERIFY(modules[-1].isUndefined());
+    QVERIFY(modules["name"].isUndefined());
+    QCOMPARE(modules.toJsonValue(),
+             QJsonArray({ "Core", "Gui", QJsonObject{ { "name", "Widgets" },
+                                                      { "deprecated", false } } }));
+    QCOMPARE(modules[2].rawJson(), R"({ "name": "Widgets", "deprecated": false })");
+
+    QStringList names;
+    for (const QJsonLazyValue module : modules)
+        names.append(module.isObject() ? module["name"].toString() : module.toString());
+    QCOMPARE(names, QStringList({ "Core", "Gui", "Widgets" }));
+
+    QCOMPARE(doc.root().keys(),
+             QStringList({ "name", "version", "major", "released", "license", "empty", "none",
+                           "modules", u"escaped\u00e9"_s, "big", "negative" }));
+    QVERIFY(doc.root().contains("modules"));
+    QVERIFY(!doc.root().contains("Modules"));
+    QVERIFY(doc["missing"].isUndefined());
+    QCOMPARE(doc["missing"].toInt(7), 7);
+    QCOMPARE(doc["missing"].toString(u"default"_s), u"default");
+    QVERIFY(doc["name"]["name"].isUndefined());
+    QVERIFY(doc[0].isUndefined());
+    QCOMPARE(doc.root().toJsonValue(), QJsonDocument::fromJson(json).object());
+
+    // copies share the document
+    const QJsonLazyDocument copy = doc;
+    QCOMPARE(copy["modules"][1].toString(), u"Gui");
+
+    QJsonLazyDocument null;
+    QVERIFY(null.isNull());
+    QVERIFY(!null.isObject());
+    QVERIFY(null.root().isUndefined());
+    QVERIFY(null["name"].isUndefined());
+    QCOMPARE(null.root().size(), 0);
+
+    const QJsonLazyDocument array = QJsonLazyDocument::fromJson("[1, 2.5, \"three\"]");
+    QVERIFY(array.isArray());
+    QCOMPARE(array[0].toInt(), 1);
+    QCOMPARE(array[1].toDouble(), 2.5);
+    QCOMPARE(array[2].toString(), u"three");
+}
+
+static void compareLazyValue(const QJsonLazyValue &lazy, const QJsonValue &value)
+{
+    QCOMPARE(lazy.type(), value.type());
+    switch (value.type()) {
+    case QJsonValue::Object: {
+        const QJsonObject object = value.toObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            compareLazyValue(lazy[it.key()], it.value());
+            if (QTest::currentTestFailed())
+                return;
+        }
+        for (auto it = lazy.begin(); it != lazy.end(); ++it)
+            QVERIFY2(object.contains(it.key()), qPrintable(it.key()));
+        break;
+    }
+    case QJsonValue::Array: {
+        const QJsonArray array = value.toArray();
+        QCOMPARE(lazy.size(), array.size());
+        qsizetype i = 0;
+        for (const QJsonLazyValue element : lazy) {
+            compareLazyValue(element, array.at(i++));
+            if (QTest::currentTestFailed())
+                return;
+        }
+        break;
+    }
+    case QJsonValue::Double:
+        QCOMPARE(lazy.toDouble(), value.toDouble());
+        QCOMPARE(lazy.toInteger(-1), value.toInteger(-1));
+        break;
+    case QJsonValue::String:
+        QCOMPARE(lazy.toString(), value.toString());
+        break;
+    case QJsonValue::Bool:
+        QCOMPARE(lazy.toBool(), value.toBool());
+        break;
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        break;
+    }
+    QCOMPARE(lazy.toJsonValue(), value);
+}
+
+void tst_QtJson::lazyDocumentMatchesDocument_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    for (const char *file : { "test.json", "test2.json", "test3.json", "bom.json",
+                              "simple.duplicates.json", "test.duplicates.json",
+                              "test3.duplicates.json" }) {
+        QFile f(testDataDir + u'/' + QLatin1StringView(file));
+        QVERIFY(f.open(QFile::ReadOnly));
+        QTest::newRow(file) << f.readAll();
+    }
+
+    QTest::newRow("numbers") << QByteArray("[0, -0, 1, -1, 1.5, -1.5e-3, 1E10, 1e+2, 0.000, "
+                                           "9007199254740993, 9223372036854775807, "
+                                           "-9223372036854775808, 9223372036854775808, "
+                                           "18446744073709551616, 1.7976931348623157e308, 5e-324]");
+    QTest::newRow("whitespace") << QByteArray(" \t\r\n{ \"a\" \n:\t[ true ,false\r,null ] , "
+                                              "\"b\" : { } }\n ");
+    QTest::newRow("compact") << QByteArray("{\"a\":[1,{\"b\":[[],{}]},\"c\"],\"d\":\"e\"}");
+    QTest::newRow("unicode") << QByteArray("[\"" UNICODE_DJE "\", \"\\u0402\", "
+                                           "\"\\ud83d\\ude00\", {\"" UNICODE_DJE "\": 1}]");
+
+    QByteArray nested;
+    for (int i = 0; i < 1024; ++i)
+        nested.append(i % 2 ? "{\"a\":" : "[");
+    nested.append("null");
+    for (int i = 1023; i >= 0; --i)
+        nested.append(i % 2 ? "}" : "]");
+    QTest::newRow("deep") << nested;
+}
+
+void tst_QtJson::lazyDocumentMatchesDocument()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError error;
+    const QJsonDocument expected = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(doc.isObject(), expected.isObject());
+    QCOMPARE(doc.isArray(), expected.isArray());
+
+    compareLazyValue(doc.root(), expected.isObject() ? QJsonValue(expected.object())
+                                                     : QJsonValue(expected.array()));
+}
+
+void tst_QtJson::lazyDocumentStrings()
+{
+    // Strings full of quotes and backslashes, starting at every offset in a
+    // block of the index, so that escape sequences cross block boundaries.
+    QRandomGenerator rng(1);
+    const char16_t alphabet[] = u"\"\\\\\\ab/\u00e9\u0402\n";
+    for (int offset = 0; offset < 130; ++offset) {
+        QJsonArray strings;
+        strings.append(QString(offset, u'x'));
+        for (int i = 0; i < 20; ++i) {
+            QString string;
+            const int length = rng.bounded(40);
+            for (int j = 0; j < length; ++j)
+                string.append(QChar(alphabet[rng.bounded(int(std::size(alphabet)) - 1)]));
+            strings.append(string);
+        }
+        QByteArray json = QJsonDocument(strings).toJson(QJsonDocument::Compact);
+        // quotes and backslashes also written without escape sequences
+        json.insert(json.size() - 1, R"(,"\"\\\\\\\"")");
+        strings.append(u"\"\\\\\\\""_s);
+
+        QJsonParseError error;
+        const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        compareLazyValue(doc.root(), strings);
+        if (QTest::currentTestFailed())
+            return;
+    }
+}
+
+void tst_QtJson::lazyDocumentMalformedValues()
+{
+    // Only the structure is checked up front; values are checked when read.
+    const QByteArray json = "[tru, nulll, -, 01, 1.2.3, 1e, \"\\u12G4\", \"" INVALID_UNICODE "\", "
+                            "[1, 2x], {\"a\": falsey}, 12]";
+    QVERIFY(QJsonDocument::fromJson(json).isNull());
+
+    QJsonParseError error;
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    for (int i = 0; i < 6; ++i) {
+        QVERIFY(doc[i].isUndefined());
+        QCOMPARE(doc[i].toInt(-1), -1);
+        QCOMPARE(doc[i].toJsonValue(), QJsonValue(QJsonValue::Undefined));
+    }
+    for (int i = 6; i < 8; ++i) {
+        QVERIFY(doc[i].isString());
+        QVERIFY(doc[i].toString().isNull());
+        QCOMPARE(doc[i].toString(u"default"_s), u"default");
+        QCOMPARE(doc[i].toJsonValue(), QJsonValue(QJsonValue::Undefined));
+    }
+    QVERIFY(doc[8].isArray());
+    QCOMPARE(doc[8][0].toInt(), 1);
+    QVERIFY(doc[8][1].isUndefined());
+    QCOMPARE(doc[8].toJsonValue(), QJsonValue(QJsonValue::Undefined));
+    QVERIFY(doc[9]["a"].isUndefined());
+    QCOMPARE(doc[10].toInt(), 12);
+    QCOMPARE(doc.root().size(), 11);
+}
+
+void tst_QtJson::lazyDocumentErrors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+
+    QTest::newRow("empty") << QByteArray() << QJsonParseError::IllegalValue;
+    QTest::newRow("whitespace") << QByteArray(" \n ") << QJsonParseError::IllegalValue;
+    QTest::newRow("number") << QByteArray("1") << QJsonParseError::IllegalValue;
+    QTest::newRow("string") << QByteArray("\"a\"") << QJsonParseError::IllegalValue;
+    QTest::newRow("{") << QByteArray("{") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("[") << QByteArray("[") << QJsonParseError::UnterminatedArray;
+    QTest::newRow("[1,") << QByteArray("[1,") << QJsonParseError::UnterminatedArray;
+    QTest::newRow("{\"a\":\"b\" ") << QByteArray("{\"a\":\"b\" ") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("{\"a\"}") << QByteArray("{\"a\"}") << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("{\"a\" 1}") << QByteArray("{\"a\" 1}") << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("{\"a\":}") << QByteArray("{\"a\":}") << QJsonParseError::MissingObject;
+    QTest::newRow("{\"a\":1,}") << QByteArray("{\"a\":1,}") << QJsonParseError::MissingObject;
+    QTest::newRow("{\"a\":1]") << QByteArray("{\"a\":1]") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("{1:2}") << QByteArray("{1:2}") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("[1 2]") << QByteArray("[1 2]") << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("[1}") << QByteArray("[1}") << QJsonParseError::UnterminatedArray;
+    QTest::newRow("[1} ]") << QByteArray("[1} ]") << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("[1,]") << QByteArray("[1,]") << QJsonParseError::MissingObject;
+    QTest::newRow("[,1]") << QByteArray("[,1]") << QJsonParseError::IllegalValue;
+    QTest::newRow("[:]") << QByteArray("[:]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("[x]") << QByteArray("[x]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("unterminated string") << QByteArray("[\"abc]") << QJsonParseError::UnterminatedString;
+    QTest::newRow("escaped quote") << QByteArray("[\"abc\\\"]") << QJsonParseError::UnterminatedString;
+    QTest::newRow("[1]]") << QByteArray("[1]]") << QJsonParseError::GarbageAtEnd;
+    QTest::newRow("[] x") << QByteArray("[] x") << QJsonParseError::GarbageAtEnd;
+    QTest::newRow("{}{}") << QByteArray("{}{}") << QJsonParseError::GarbageAtEnd;
+    QTest::newRow("deep") << QByteArray(1025, '[') + QByteArray(1025, ']')
+                          << QJsonParseError::DeepNesting;
+}
+
+void tst_QtJson::lazyDocumentErrors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+
+    QJsonParseError expected;
+    QVERIFY(QJsonDocument::fromJson(json, &expected).isNull());
+    QCOMPARE(expected.error, error);
+
+    QJsonParseError actual;
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(json, &actual);
+    QVERIFY(doc.isNull());
+    QCOMPARE(actual.error, error);
+    QVERIFY(actual.offset >= 0);
+    QVERIFY(actual.offset <= json.size());
+}
+
+void tst_QtJson::streamReader()
+{
+    QJsonStreamReader reader(QByteArray("{\"a\": [1, 2.5, -9007199254740993, true, null], "
+                                        "\"b\\u00e9\": \"c\\nd\", \"e\": {}}"));
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.type(), QJsonStreamReader::Object);
+    QCOMPARE(reader.containerDepth(), 0);
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Invalid);
+    QVERIFY(reader.hasNext());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Object);
+
+    QVERIFY(reader.isString());
+    QCOMPARE(reader.currentOffset(), 1);
+    QCOMPARE(reader.readString(), u"a"_s);
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.containerDepth(), 2);
+    QVERIFY(reader.isDouble());
+    QCOMPARE(reader.toDouble(), 1.);
+    QCOMPARE(reader.toInteger(), 1);
+    QVERIFY(reader.next());
+    QCOMPARE(reader.toDouble(), 2.5);
+    QCOMPARE(reader.toInteger(-1), -1);
+    QVERIFY(reader.next());
+    QCOMPARE(reader.toInteger(), Q_INT64_C(-9007199254740993));
+    QVERIFY(reader.next());
+    QVERIFY(reader.isBool());
+    QVERIFY(reader.toBool());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isNull());
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.isValid());
+    QVERIFY(reader.leaveContainer());
+
+    QCOMPARE(reader.readString(), u"b\u00e9"_s);
+    QCOMPARE(reader.readString(), u"c\nd"_s);
+    QCOMPARE(reader.readString(), u"e"_s);
+    QCOMPARE(reader.readValue(), QJsonValue(QJsonObject()));
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+
+    // skipping containers
+    reader.reset();
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.readString(), u"a"_s);
+    QVERIFY(reader.next());
+    QCOMPARE(reader.readString(), u"b\u00e9"_s);
+    QVERIFY(reader.next());
+    QCOMPARE(reader.readString(), u"e"_s);
+    QVERIFY(reader.isObject());
+    reader.reset();
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.containerDepth(), 0);
+
+    // the top level can be any value
+    QJsonStreamReader scalar(QByteArray("\"abc\" \n"));
+    QCOMPARE(scalar.readValue(), QJsonValue(u"abc"_s));
+    QVERIFY(!scalar.hasNext());
+    QCOMPARE(scalar.lastError().error, QJsonParseError::NoError);
+}
+
+static QJsonValue expectedValue(const QByteArray &json)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    return doc.isObject() ? QJsonValue(doc.object()) : QJsonValue(doc.array());
+}
+
+void tst_QtJson::streamReaderMatchesDocument()
+{
+    QFETCH(QByteArray, json);
+    const QJsonValue expected = expectedValue(json);
+
+    {
+        QJsonStreamReader reader(json);
+        QCOMPARE(reader.readValue(), expected);
+        QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+        QVERIFY(!reader.hasNext());
+    }
+    {
+        QBuffer buffer(&json);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QJsonStreamReader reader(&buffer);
+        QCOMPARE(reader.device(), &buffer);
+        QCOMPARE(reader.readValue(), expected);
+        QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+        QVERIFY(!reader.hasNext());
+    }
+
+    // readValue() starts over until the value is complete
+    for (qsizetype chunkSize : { 1, 64, 4096 }) {
+        if (chunkSize == 1 && json.size() > 1000)
+            continue;
+        QJsonStreamReader reader;
+        QJsonValue value(QJsonValue::Undefined);
+        for (qsizetype i = 0; i < json.size() && value.isUndefined(); i += chunkSize) {
+            reader.addData(json.mid(i, chunkSize));
+            if (reader.isValid())
+                value = reader.readValue();
+        }
+        QCOMPARE(value, expected);
+    }
+}
+
+// Walks the document with the element API, waiting for more data whenever
+// the reader asks for it.
+static QStringList streamEvents(QJsonStreamReader &reader, const std::function<bool()> &feed)
+{
+    const auto wait = [&] {
+        while (reader.lastError().error == QJsonParseError::PrematureEndOfDocument) {
+            if (!feed())
+                return false;
+        }
+        return reader.lastError().error == QJsonParseError::NoError;
+    };
+
+    QStringList events;
+    const std::function<void()> walk = [&] {
+        switch (reader.type()) {
+        case QJsonStreamReader::Array:
+        case QJsonStreamReader::Object:
+            events << (reader.isArray() ? u"["_s : u"{"_s);
+            reader.enterContainer();
+            while (wait() && reader.hasNext())
+                walk();
+            reader.leaveContainer();
+            events << u"end"_s;
+            break;
+        case QJsonStreamReader::String:
+            events << u'"' + reader.readString();
+            break;
+        case QJsonStreamReader::Double:
+            events << QString::number(reader.toDouble()) + u' '
+                    + QString::number(reader.toInteger(-1));
+            reader.next();
+            break;
+        case QJsonStreamReader::Bool:
+            events << (reader.toBool() ? u"true"_s : u"false"_s);
+            reader.next();
+            break;
+        case QJsonStreamReader::Null:
+            events << u"null"_s;
+            reader.next();
+            break;
+        case QJsonStreamReader::Invalid:
+            events << u"error"_s;
+            feed();
+            break;
+        }
+    };
+
+    if (wait())
+        walk();
+    wait();
+    if (reader.lastError().error != QJsonParseError::NoError)
+        events << reader.lastError().errorString();
+    return events;
+}
+
+void tst_QtJson::streamReaderIncremental()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonStreamReader whole(json);
+    const QStringList expected = streamEvents(whole, [] { return false; });
+    QVERIFY(!expected.contains(u"error"_s));
+    QVERIFY(!whole.hasNext());
+
+    QJsonStreamReader reader;
+    QCOMPARE(reader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+    qsizetype fed = 0;
+    const QStringList events = streamEvents(reader, [&] {
+        if (fed == json.size())
+            return false;
+        reader.addData(json.mid(fed++, 1));
+        return true;
+    });
+    QCOMPARE(events, expected);
+    QVERIFY(!reader.hasNext());
+}
+
+void tst_QtJson::streamReaderSkipIncomplete()
+{
+    const QByteArray json = "[[1, {\"a\": [2, 3]}, \"x\"], {\"b\": 4}, 5]";
+
+    QJsonStreamReader reader;
+    qsizetype fed = 0;
+    const auto feedUntilComplete = [&] {
+        while (reader.lastError().error == QJsonParseError::PrematureEndOfDocument
+               && fed < json.size()) {
+            reader.addData(json.mid(fed++, 1));
+        }
+        QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    };
+
+    feedUntilComplete();
+    QVERIFY(reader.enterContainer());
+    feedUntilComplete();
+    QVERIFY(reader.isArray());
+    QVERIFY(!reader.next());        // the whole array isn't there yet
+    QCOMPARE(reader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+    feedUntilComplete();
+    QCOMPARE(reader.containerDepth(), 1);
+    QVERIFY(reader.isObject());
+
+    // readValue() stays on the object until all of it is there
+    QJsonValue object = reader.readValue();
+    QVERIFY(object.isUndefined());
+    QCOMPARE(reader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+    QVERIFY(reader.isObject());
+    while (object.isUndefined() && fed < json.size()) {
+        reader.addData(json.mid(fed++, 1));
+        object = reader.readValue();
+    }
+    QCOMPARE(object, QJsonValue(QJsonObject{ { u"b"_s, 4 } }));
+    feedUntilComplete();
+    QCOMPARE(reader.toInteger(), 5);
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(fed, json.size());
+}
+
+void tst_QtJson::streamReaderErrors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+
+    const auto premature = QJsonParseError::PrematureEndOfDocument;
+    QTest::newRow("empty") << QByteArray() << premature;
+    QTest::newRow("whitespace") << QByteArray(" \n ") << premature;
+    QTest::newRow("bom") << QByteArray("\xef\xbb") << premature;
+    QTest::newRow("{") << QByteArray("{") << premature;
+    QTest::newRow("[1,") << QByteArray("[1,") << premature;
+    QTest::newRow("[1") << QByteArray("[1") << premature;
+    QTest::newRow("[tru") << QByteArray("[tru") << premature;
+    QTest::newRow("{\"a\"") << QByteArray("{\"a\"") << premature;
+    QTest::newRow("unterminated string") << QByteArray("[\"abc]") << premature;
+    QTest::newRow("escaped quote") << QByteArray("[\"abc\\\"]") << premature;
+
+    // the same errors as QJsonDocument::fromJson()
+    QTest::newRow("{\"a\"}") << QByteArray("{\"a\"}") << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("{\"a\" 1}") << QByteArray("{\"a\" 1}") << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("{\"a\":}") << QByteArray("{\"a\":}") << QJsonParseError::MissingObject;
+    QTest::newRow("{\"a\":1,}") << QByteArray("{\"a\":1,}") << QJsonParseError::MissingObject;
+    QTest::newRow("{\"a\":1]") << QByteArray("{\"a\":1]") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("{1:2}") << QByteArray("{1:2}") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("[1 2]") << QByteArray("[1 2]") << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("[1}") << QByteArray("[1}") << QJsonParseError::UnterminatedArray;
+    QTest::newRow("[1,]") << QByteArray("[1,]") << QJsonParseError::MissingObject;
+    QTest::newRow("[,1]") << QByteArray("[,1]") << QJsonParseError::IllegalValue;
+    QTest::newRow("[:]") << QByteArray("[:]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("[x]") << QByteArray("[x]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("[trux]") << QByteArray("[trux]") << QJsonParseError::IllegalValue;
+    QTest::newRow("[-]") << QByteArray("[-]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("[1e400]") << QByteArray("[1e400]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("escape") << QByteArray("[\"\\u12\"]") << QJsonParseError::IllegalEscapeSequence;
+    QTest::newRow("utf8") << QByteArray("[\"" INVALID_UNICODE "\"]")
+                          << QJsonParseError::IllegalUTF8String;
+    QTest::newRow("deep") << QByteArray(1025, '[') + QByteArray(1025, ']')
+                          << QJsonParseError::DeepNesting;
+}
+
+void tst_QtJson::streamReaderErrors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+
+    if (error != QJsonParseError::PrematureEndOfDocument) {
+        QJsonParseError expected;
+        QVERIFY(QJsonDocument::fromJson(json, &expected).isNull());
+        QCOMPARE(expected.error, error);
+    }
+
+    // going through the elements finds the same error
+    QJsonStreamReader walker(json);
+    streamEvents(walker, [] { return false; });
+    QCOMPARE(walker.lastError().error, error);
+
+    QJsonStreamReader reader(json);
+    QVERIFY(reader.readValue().isUndefined());
+    const QJsonParseError actual = reader.lastError();
+    QCOMPARE(actual.error, error);
+    QVERIFY(actual.offset >= 0);
+    QVERIFY(actual.offset <= json.size());
+    QVERIFY(!reader.next());
+
+    // only running out of data can be recovered from
+    QCOMPARE(reader.hasNext(), error == QJsonParseError::PrematureEndOfDocument);
+    reader.reparse();
+    QVERIFY(reader.readValue().isUndefined());
+    QCOMPARE(reader.lastError().error, error);
+}
+
+void tst_QtJson::streamReaderGarbageAtEnd_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonValue>("value");
+    QTest::addColumn<int>("offset");
+
+    QTest::newRow("[1]]") << QByteArray("[1]]") << QJsonValue(QJsonArray{ 1 }) << 3;
+    QTest::newRow("[] x") << QByteArray("[] x") << QJsonValue(QJsonArray()) << 3;
+    QTest::newRow("{}{}") << QByteArray("{}{}") << QJsonValue(QJsonObject()) << 2;
+    QTest::newRow("string") << QByteArray("\"abc\" trailing data") << QJsonValue(u"abc"_s) << 6;
+    QTest::newRow("number") << QByteArray("1 x") << QJsonValue(1) << 2;
+}
+
+void tst_QtJson::streamReaderGarbageAtEnd()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonValue, value);
+    QFETCH(int, offset);
+
+    if (value.isArray() || value.isObject()) {
+        QJsonParseError expected;
+        QVERIFY(QJsonDocument::fromJson(json, &expected).isNull());
+        QCOMPARE(expected.error, QJsonParseError::GarbageAtEnd);
+    }
+
+    QJsonStreamReader walker(json);
+    streamEvents(walker, [] { return false; });
+    QCOMPARE(walker.lastError().error, QJsonParseError::GarbageAtEnd);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readValue(), value);
+    QCOMPARE(reader.lastError().error, QJsonParseError::GarbageAtEnd);
+    QCOMPARE(reader.lastError().offset, offset);
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.isValid());
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader deviceReader(&buffer);
+    QCOMPARE(deviceReader.readValue(), value);
+    QCOMPARE(deviceReader.lastError().error, QJsonParseError::GarbageAtEnd);
+
+    // it's also found when it arrives after the value
+    QJsonStreamReader incremental(json.left(offset));
+    QCOMPARE(incremental.readValue(), value);
+    QCOMPARE(incremental.lastError().error, QJsonParseError::NoError);
+    QVERIFY(!incremental.hasNext());
+    incremental.addData(json.mid(offset));
+    QCOMPARE(incremental.lastError().error, QJsonParseError::GarbageAtEnd);
+}
+
+void tst_QtJson::streamReaderTopLevelNumber()
+{
+    // a number ends with the data of a QByteArray...
+    QJsonStreamReader reader;
+    reader.addData("12");
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QVERIFY(reader.isDouble());
+    QCOMPARE(reader.toInteger(), 12);
+
+    // ...until more is added before advancing past it
+    reader.addData("3.5");
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.toDouble(), 123.5);
+    reader.addData(" \n");
+    QCOMPARE(reader.toDouble(), 123.5);
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+
+    reader.addData("4");
+    QCOMPARE(reader.lastError().error, QJsonParseError::GarbageAtEnd);
+
+    QJsonStreamReader whole(QByteArray("-7e2"));
+    QCOMPARE(whole.readValue(), QJsonValue(-700));
+    QCOMPARE(whole.lastError().error, QJsonParseError::NoError);
+    QVERIFY(!whole.hasNext());
+
+    // it's still checked once it's complete
+    QJsonStreamReader invalid(QByteArray("1-"));
+    QVERIFY(invalid.readValue().isUndefined());
+    QCOMPARE(invalid.lastError().error, QJsonParseError::IllegalNumber);
+}
+
+// Writes value with the element API rather than as a QJsonValue.
+static void writeElements(QJsonStreamWriter &writer, const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Array:
+        writer.startArray();
+        for (const QJsonValue element : value.toArray())
+            writeElements(writer, element);
+        QVERIFY(writer.endArray());
+        break;
+    case QJsonValue::Object: {
+        writer.startObject();
+        const QJsonObject object = value.toObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            writer.append(it.key());
+            writeElements(writer, it.value());
+        }
+        QVERIFY(writer.endObject());
+        break;
+    }
+    case QJsonValue::Double: {
+        const QCborValue number = QCborValue::fromJsonValue(value);
+        if (number.isInteger())
+            writer.append(number.toInteger());
+        else
+            writer.append(number.toDouble());
+        break;
+    }
+    case QJsonValue::String:
+        writer.append(value.toString());
+        break;
+    case QJsonValue::Bool:
+        writer.append(value.toBool());
+        break;
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        writer.appendNull();
+        break;
+    }
+}
+
+void tst_QtJson::streamWriter()
+{
+    QFETCH(QByteArray, json);
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    const QJsonValue value = expectedValue(json);
+
+    for (auto format : { QJsonDocument::Indented, QJsonDocument::Compact }) {
+        const QByteArray expected = doc.toJson(format);
+
+        QByteArray elements;
+        QJsonStreamWriter writer(&elements);
+        QCOMPARE(writer.format(), QJsonDocument::Indented);
+        writer.setFormat(format);
+        writeElements(writer, value);
+        QCOMPARE(elements, expected);
+
+        QByteArray values;
+        QJsonStreamWriter valueWriter(&values);
+        valueWriter.setFormat(format);
+        valueWriter.append(value);
+        QCOMPARE(values, expected);
+
+        // QJsonValue elements inside streamed containers
+        if (value.isArray()) {
+            QByteArray mixed;
+            QJsonStreamWriter mixedWriter(&mixed);
+            mixedWriter.setFormat(format);
+            mixedWriter.startArray();
+            for (const QJsonValue element : value.toArray())
+                mixedWriter.append(element);
+            mixedWriter.endArray();
+            QCOMPARE(mixed, expected);
+        }
+    }
+}
+
+void tst_QtJson::streamWriterDevice()
+{
+    constexpr int Records = 20000;
+    QJsonArray expected;
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::ReadWrite));
+    {
+        QJsonStreamWriter writer(&buffer);
+        QCOMPARE(writer.device(), &buffer);
+        writer.setFormat(QJsonDocument::Compact);
+        writer.startArray();
+        for (int i = 0; i < Records; ++i) {
+            const QString name = u"record \"%1\"\t\u00e9"_s.arg(i);
+            writer.startObject();
+            writer.append("id"_L1);
+            writer.append(i);
+            writer.appendTextString("name", 4);
+            writer.append(name);
+            writer.append(u"ratio"_s);
+            writer.append(i / 8.);
+            writer.endObject();
+            expected.append(QJsonObject{ { u"id"_s, i }, { u"name"_s, name },
+                                         { u"ratio"_s, i / 8. } });
+        }
+        // the text is written as it's produced, not all at the end
+        QCOMPARE_GT(buffer.size(), 0);
+        writer.endArray();
+    }
+    QCOMPARE(buffer.data(), QJsonDocument(expected).toJson(QJsonDocument::Compact));
+
+    // and read back one record at a time
+    buffer.seek(0);
+    QJsonStreamReader reader(&buffer);
+    QVERIFY(reader.enterContainer());
+    int count = 0;
+    while (reader.hasNext()) {
+        QCOMPARE(reader.readValue(), expected.at(count));
+        ++count;
+    }
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(count, Records);
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QtJson::streamWriterMisuse()
+{
+    QByteArray json;
+    QJsonStreamWriter writer(&json);
+    writer.setFormat(QJsonDocument::Compact);
+
+    writer.startObject();
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: the keys of an object must be strings");
+    writer.append(1);
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter::endArray: no array to end");
+    QVERIFY(!writer.endArray());
+    writer.append("a"_L1);
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter::endObject: the last key has no value");
+    QVERIFY(!writer.endObject());
+    writer.append(nullptr);
+    QVERIFY(writer.endObject());
+
+    // top-level values are written one per line
+    writer.append(qInf());
+    writer.append(u"b"_s);
+    QCOMPARE(json, QByteArray("{\"a\":null}\nnull\n\"b\""));
+}
+
 QTEST_MAIN(tst_QtJson)
 #include "tst_qtjson.moc"
@@ -1,6 +1,7 @@
 // Copyright (C) 2022 Intel Corporation.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
+#include <QtCore/qcborlazydocument.h>
 #include <QtCore/qcborvalue.h>
 #include <QTest>
 
@@ -13,6 +14,8 @@
 
 #include <QtCore/private/qbytearray_p.h>
 
+using namespace Qt::StringLiterals;
+
 Q_DECLARE_METATYPE(QCborKnownTags)
 Q_DECLARE_METATYPE(QCborValue)
 Q_DECLARE_METATYPE(QCborValue::EncodingOptions)
@@ -101,6 +104,15 @@ private slots:
     void toDiagnosticNotation_data();
     void toDiagnosticNotation();
 
+    void lazyDocument_data() { fromCbor_data(); }
+    void lazyDocument();
+    void lazyDocumentLookup();
+    void lazyDocumentInPlace();
+    void lazyDocumentValidation_data() { validation_data(); }
+    void lazyDocumentValidation();
+    void lazyDocumentRecursionLimit_data() { recursionLimit_data(); }
+    void lazyDocumentRecursionLimit();
+
     void cborValueRef_data();
     void cborValueRef();
     void cborValueConstRef_data() { cborValueRef_data(); }
@@ -2458,6 +2470,209 @@ void tst_QCborValue::recursionLimit()
     QCOMPARE(error.error, QCborError::NestingTooDeep);
 }
 
+// Compares everything a QCborLazyValue reads with the QCborValue decoded
+// from the same data.
+static void compareLazy(const QCborLazyValue &lazy, const QCborValue &expected)
+{
+    QCOMPARE(lazy.toCborValue(), expected);
+    if (expected.type() >= QCborValue::DateTime) {
+        // QCborLazyValue doesn't convert tags to extended types, and
+        // QCborValue normalizes their contents
+        QVERIFY(lazy.isTag());
+        return;
+    }
+    if (expected.isTag()) {
+        QCOMPARE(lazy.tag(), expected.tag());
+        compareLazy(lazy.taggedValue(), expected.taggedValue());
+        return;
+    }
+
+    QCOMPARE(lazy.type(), expected.type());
+    QCOMPARE(lazy.toInteger(-42), expected.toInteger(-42));
+    QCOMPARE(lazy.toDouble(-42), expected.toDouble(-42));
+    QCOMPARE(lazy.toBool(true), expected.toBool(true));
+    QCOMPARE(lazy.toSimpleType(), expected.toSimpleType());
+    QCOMPARE(lazy.toString(u"default"_s), expected.toString(u"default"_s));
+    QCOMPARE(lazy.toByteArray("default"), expected.toByteArray("default"));
+
+    if (expected.isArray()) {
+        const QCborArray array = expected.toArray();
+        QCOMPARE(lazy.size(), array.size());
+        qsizetype i = 0;
+        for (const QCborLazyValue element : lazy) {
+            QCOMPARE_LT(i, array.size());
+            compareLazy(element, array.at(i));
+            compareLazy(lazy.at(i), array.at(i));
+            ++i;
+        }
+        QCOMPARE(i, array.size());
+        QVERIFY(lazy.at(i).isInvalid());
+    } else if (expected.isMap()) {
+        const QCborMap map = expected.toMap();
+        QCOMPARE(lazy.size(), map.size());
+        auto it = lazy.begin();
+        for (auto e = map.begin(); e != map.end(); ++e, ++it) {
+            QVERIFY(it != lazy.end());
+            compareLazy(it.key(), e.key());
+            compareLazy(it.value(), e.value());
+            if (e.key().isInteger())
+                compareLazy(lazy.value(e.key().toInteger()), e.value());
+            else if (e.key().isString())
+                compareLazy(lazy.value(e.key().toString()), e.value());
+        }
+        QCOMPARE(it, lazy.end());
+    } else {
+        QCOMPARE(lazy.begin(), lazy.end());
+        QCOMPARE(lazy.size(), 0);
+    }
+}
+
+void tst_QCborValue::lazyDocument()
+{
+    auto doCheck = [](const QCborValue &expected, const QByteArray &data) {
+        const QCborLazyDocument doc = QCborLazyDocument::fromCbor(data);
+        QVERIFY(!doc.isNull());
+        QCOMPARE(doc.validate(), QCborError());
+        QCOMPARE(doc.root().rawCbor(), data);
+        compareLazy(doc.root(), expected);
+    };
+
+    fromCbor_common(doCheck);
+}
+
+void tst_QCborValue::lazyDocumentLookup()
+{
+    const QCborMap map = {
+        { 1, "one" },
+        { -2, 2.5 },
+        { u"array"_s, QCborArray{ 1, QCborArray{ 2, 3 }, QCborMap{ { u"x"_s, true } } } },
+        { u"map"_s, QCborMap{ { u"y"_s, nullptr } } },
+        { u"été"_s, QCborValue(QCborValue::Undefined) },
+        { QByteArray("bytes"), 4 },
+    };
+    const QByteArray data = QCborValue(map).toCbor();
+    const QCborLazyDocument doc = QCborLazyDocument::fromCbor(data);
+
+    QCOMPARE(doc[1].toString(), u"one"_s);
+    QCOMPARE(doc[-2].toDouble(), 2.5);
+    QVERIFY(doc.root().contains(1));
+    QVERIFY(!doc.root().contains(2));
+    QVERIFY(doc.root().contains(u"array"));
+    QVERIFY(doc.root().contains(QLatin1StringView("map")));
+    QVERIFY(doc.root().contains(u"été"_s));
+    QVERIFY(doc[u"été"_s].isUndefined());
+    QVERIFY(!doc.root().contains(u"bytes"));
+    QVERIFY(!doc.root().contains(u"missing"));
+
+    QCOMPARE(doc["array"].size(), 3);
+    QCOMPARE(doc["array"][0].toInteger(), 1);
+    QCOMPARE(doc["array"][1][1].toInteger(), 3);
+    QCOMPARE(doc["array"][2]["x"].toBool(), true);
+    QVERIFY(doc["array"][3].isInvalid());
+    QVERIFY(doc["array"][-1].isInvalid());
+    QVERIFY(doc["array"]["x"].isInvalid());
+    QVERIFY(doc["map"]["y"].isNull());
+    QVERIFY(doc["map"][0].isInvalid());
+    QVERIFY(doc["missing"].isInvalid());
+    QVERIFY(doc["missing"]["deeper"].isInvalid());
+    QVERIFY(doc[1]["x"].isInvalid());
+    QVERIFY(doc[1].taggedValue().isInvalid());
+
+    // chunked keys, duplicates and indefinite lengths
+    const QCborLazyDocument chunked = QCborLazyDocument::fromCbor(
+            raw("\xbf\x7f\x62" "ab" "\x61" "c\xff\x01" "\x63" "abc\x02" "\xff"));
+    QCOMPARE(chunked.validate(), QCborError());
+    QCOMPARE(chunked.root().size(), 2);
+    QCOMPARE(chunked["abc"].toInteger(), 1);        // the first of duplicates
+    QVERIFY(chunked.root().begin().key().toStringView().isNull());
+    QCOMPARE(chunked.root().begin().key().toString(), u"abc"_s);
+
+    // a null document
+    const QCborLazyDocument null;
+    QVERIFY(null.isNull());
+    QVERIFY(null.root().isInvalid());
+    QVERIFY(null["x"].isInvalid());
+    QCOMPARE(null.validate(), QCborError::EndOfFile);
+    QVERIFY(QCborLazyValue().toCborValue().isInvalid());
+    QVERIFY(QCborLazyValue().rawCbor().isNull());
+}
+
+void tst_QCborValue::lazyDocumentInPlace()
+{
+    const QCborMap map = {
+        { u"name"_s, u"a longer string value"_s },
+        { u"blob"_s, QByteArray(100, 'x') },
+        { u"empty"_s, u""_s },
+    };
+    const QByteArray encoded = QCborValue(map).toCbor();
+
+    // an externally owned buffer, as from QFile::map()
+    const QByteArray data = QByteArray::fromRawData(encoded.constData(), encoded.size());
+    const QCborLazyDocument doc = QCborLazyDocument::fromCbor(data);
+    const auto isInBuffer = [&](const char *p) {
+        return p >= encoded.constData() && p <= encoded.constData() + encoded.size();
+    };
+
+    const QUtf8StringView name = doc["name"].toStringView();
+    QVERIFY(name == "a longer string value");
+    QVERIFY(isInBuffer(name.data()));
+
+    const QByteArrayView blob = doc["blob"].toByteArrayView();
+    QCOMPARE(blob, QByteArray(100, 'x'));
+    QVERIFY(isInBuffer(blob.data()));
+
+    const QUtf8StringView empty = doc["empty"].toStringView();
+    QVERIFY(!empty.isNull());
+    QVERIFY(empty.isEmpty());
+    QVERIFY(!doc["empty"].toString().isNull());
+
+    const QByteArrayView raw = doc["blob"].rawCbor();
+    QVERIFY(isInBuffer(raw.data()));
+    QCOMPARE(raw.size(), 102);
+
+    // the wrong type
+    QVERIFY(doc["name"].toByteArrayView().isNull());
+    QVERIFY(doc["blob"].toStringView().isNull());
+    QVERIFY(doc.root().toStringView().isNull());
+}
+
+static void walkLazy(const QCborLazyValue &value)
+{
+    // read everything, without crashing
+    (void)value.toInteger();
+    (void)value.toDouble();
+    (void)value.toString();
+    (void)value.toByteArray();
+    (void)value.toStringView();
+    (void)value.rawCbor();
+    (void)value.size();
+    if (value.isTag())
+        walkLazy(value.taggedValue());
+    for (auto it = value.begin(), end = value.end(); it != end; ++it) {
+        walkLazy(it.key());
+        walkLazy(it.value());
+    }
+}
+
+void tst_QCborValue::lazyDocumentValidation()
+{
+    QFETCH(QByteArray, data);
+
+    const QCborLazyDocument doc = QCborLazyDocument::fromCbor(data);
+    QCOMPARE_NE(doc.validate(), QCborError::NoError);
+    QVERIFY(doc.root().toCborValue().isInvalid());
+    walkLazy(doc.root());
+}
+
+void tst_QCborValue::lazyDocumentRecursionLimit()
+{
+    QFETCH(QByteArray, data);
+
+    const QCborLazyDocument doc = QCborLazyDocument::fromCbor(data);
+    QCOMPARE_NE(doc.validate(), QCborError::NoError);
+    QVERIFY(doc.root().rawCbor().isNull());
+}
+
 void tst_QCborValue::toDiagnosticNotation_data()
 {
     QTest::addColumn<QCborValue>("v");
@@ -0,0 +1,338 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QBuffer>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QDataStream>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <qgadgetserializer.h>
+
+using namespace Qt::StringLiterals;
+
+struct Point
+{
+    Q_GADGET
+    Q_PROPERTY(int x MEMBER x)
+    Q_PROPERTY(int y MEMBER y)
+public:
+    int x = 0;
+    int y = 0;
+
+    friend bool operator==(const Point &lhs, const Point &rhs)
+    { return lhs.x == rhs.x && lhs.y == rhs.y; }
+    friend bool operator!=(const Point &lhs, const Point &rhs)
+    { return !(lhs == rhs); }
+};
+
+class Record
+{
+    Q_GADGET
+    Q_PROPERTY(QString name READ name WRITE setName)
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled)
+    Q_PROPERTY(uint flags MEMBER m_flags)
+    Q_PROPERTY(qint64 offset MEMBER m_offset)
+    Q_PROPERTY(quint64 size MEMBER m_size)
+    Q_PROPERTY(float ratio MEMBER m_ratio)
+    Q_PROPERTY(double value READ value WRITE setValue)
+    Q_PROPERTY(QByteArray data MEMBER m_data)
+    Q_PROPERTY(Point origin READ origin WRITE setOrigin)
+    Q_PROPERTY(QList<int> samples MEMBER m_samples)
+    Q_PROPERTY(Color color MEMBER m_color)
+    Q_PROPERTY(int transient MEMBER m_transient STORED false)
+    Q_PROPERTY(int computed READ computed)
+public:
+    enum Color { Red, Green, Blue };
+    Q_ENUM(Color)
+
+    const QString &name() const { return m_name; }
+    void setName(const QString &name) { m_name = name; }
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    double value() const { return m_value; }
+    void setValue(double value) { m_value = value; }
+    Point origin() const { return m_origin; }
+    void setOrigin(Point origin) { m_origin = origin; }
+    int computed() const { return m_samples.size(); }
+
+    friend bool operator==(const Record &lhs, const Record &rhs)
+    {
+        return lhs.m_name == rhs.m_name && lhs.m_enabled == rhs.m_enabled
+                && lhs.m_flags == rhs.m_flags && lhs.m_offset == rhs.m_offset
+                && lhs.m_size == rhs.m_size && lhs.m_ratio == rhs.m_ratio
+                && lhs.m_value == rhs.m_value && lhs.m_data == rhs.m_data
+                && lhs.m_origin == rhs.m_origin && lhs.m_samples == rhs.m_samples
+                && lhs.m_color == rhs.m_color && lhs.m_transient == rhs.m_transient;
+    }
+
+    QString m_name;
+    bool m_enabled = false;
+    uint m_flags = 0;
+    qint64 m_offset = 0;
+    quint64 m_size = 0;
+    float m_ratio = 0;
+    double m_value = 0;
+    QByteArray m_data;
+    Point m_origin;
+    QList<int> m_samples;
+    Color m_color = Red;
+    int m_transient = 0;
+};
+
+class Item : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count WRITE setCount)
+    Q_PROPERTY(QString label MEMBER m_label)
+public:
+    int count() const { return m_count; }
+    void setCount(int count) { m_count = count; }
+
+    int m_count = 0;
+    QString m_label;
+};
+
+class DerivedItem : public Item
+{
+    Q_OBJECT
+    Q_PROPERTY(Point position MEMBER m_position)
+public:
+    Point m_position;
+};
+
+static Record sampleRecord()
+{
+    Record r;
+    r.m_name = u"sample é"_s;
+    r.m_enabled = true;
+    r.m_flags = 0xdeadbeef;
+    r.m_offset = -(Q_INT64_C(1) << 40);
+    r.m_size = Q_UINT64_C(1) << 40;
+    r.m_ratio = 0.5f;
+    r.m_value = 3.25;
+    r.m_data = QByteArray("\x00\x01\xfe\xff", 4);
+    r.m_origin = { 3, -4 };
+    r.m_samples = { 1, 2, 3 };
+    r.m_color = Record::Blue;
+    r.m_transient = 42;
+    return r;
+}
+
+class tst_QGadgetSerializer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dataStream();
+    void dataStreamTruncated();
+    void cbor();
+    void cborPartial();
+    void cborNotAMap();
+    void json();
+    void jsonPartial();
+    void qobject();
+};
+
+void tst_QGadgetSerializer::dataStream()
+{
+    const Record r = sampleRecord();
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        QGadgetSerializer::save(stream, r);
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+
+    // the same bytes as streaming the stored properties one by one
+    QByteArray expected;
+    {
+        QDataStream stream(&expected, QIODevice::WriteOnly);
+        stream << r.m_name << r.m_enabled << r.m_flags << r.m_offset << r.m_size
+               << r.m_ratio << r.m_value << r.m_data << r.m_origin.x << r.m_origin.y
+               << r.m_samples << qint32(r.m_color);
+    }
+    QCOMPARE(data, expected);
+
+    Record loaded;
+    QDataStream stream(data);
+    QGadgetSerializer::load(stream, loaded);
+    QCOMPARE(stream.status(), QDataStream::Ok);
+    QVERIFY(stream.atEnd());
+
+    Record expectedRecord = r;
+    expectedRecord.m_transient = 0;         // not stored
+    QVERIFY(loaded == expectedRecord);
+}
+
+void tst_QGadgetSerializer::dataStreamTruncated()
+{
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        QGadgetSerializer::save(stream, sampleRecord());
+    }
+    data.chop(1);
+
+    Record loaded;
+    QDataStream stream(data);
+    QGadgetSerializer::load(stream, loaded);
+    QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+    // the properties before the error were loaded
+    QCOMPARE(loaded.m_name, sampleRecord().m_name);
+}
+
+void tst_QGadgetSerializer::cbor()
+{
+    const Record r = sampleRecord();
+
+    QByteArray data;
+    QCborStreamWriter writer(&data);
+    QGadgetSerializer::toCbor(writer, r);
+
+    const QCborMap expected = {
+        { u"name"_s, r.m_name },
+        { u"enabled"_s, true },
+        { u"flags"_s, qint64(r.m_flags) },
+        { u"offset"_s, r.m_offset },
+        { u"size"_s, qint64(r.m_size) },
+        { u"ratio"_s, 0.5 },
+        { u"value"_s, 3.25 },
+        { u"data"_s, r.m_data },
+        { u"origin"_s, QCborMap{ { u"x"_s, 3 }, { u"y"_s, -4 } } },
+        { u"samples"_s, QCborArray{ 1, 2, 3 } },
+        { u"color"_s, QCborValue::fromVariant(QVariant::fromValue(r.m_color)) },
+    };
+    QCOMPARE(QCborValue::fromCbor(data), QCborValue(expected));
+
+    Record loaded;
+    QCborStreamReader reader(data);
+    QVERIFY(QGadgetSerializer::fromCbor(reader, loaded));
+    QCOMPARE(reader.lastError(), QCborError::NoError);
+    QVERIFY(!reader.hasNext());
+
+    Record expectedRecord = r;
+    expectedRecord.m_transient = 0;
+    QVERIFY(loaded == expectedRecord);
+}
+
+void tst_QGadgetSerializer::cborPartial()
+{
+    // unknown keys and non-string keys are skipped, values of the wrong type
+    // and missing properties leave the current value
+    const QCborMap map = {
+        { u"unknown"_s, QCborArray{ 1, 2 } },
+        { 1, u"integer key"_s },
+        { u"name"_s, u"updated"_s },
+        { u"flags"_s, u"not a number"_s },
+        { u"value"_s, 7 },
+        { u"origin"_s, QCborMap{ { u"y"_s, 10 } } },
+    };
+
+    Record loaded = sampleRecord();
+    QCborStreamReader reader(map.toCborValue().toCbor());
+    QVERIFY(QGadgetSerializer::fromCbor(reader, loaded));
+
+    Record expected = sampleRecord();
+    expected.m_name = u"updated"_s;
+    expected.m_value = 7;
+    expected.m_origin.y = 10;
+    QVERIFY(loaded == expected);
+}
+
+void tst_QGadgetSerializer::cborNotAMap()
+{
+    Record loaded = sampleRecord();
+    QCborStreamReader reader(QCborValue(QCborArray{ 1, 2 }).toCbor());
+    QVERIFY(!QGadgetSerializer::fromCbor(reader, loaded));
+    QVERIFY(loaded == sampleRecord());
+}
+
+void tst_QGadgetSerializer::json()
+{
+    const Record r = sampleRecord();
+
+    const QJsonObject object = QGadgetSerializer::toJsonObject(r);
+    const QJsonObject expected = {
+        { u"name"_s, r.m_name },
+        { u"enabled"_s, true },
+        { u"flags"_s, qint64(r.m_flags) },
+        { u"offset"_s, r.m_offset },
+        { u"size"_s, qint64(r.m_size) },
+        { u"ratio"_s, 0.5 },
+        { u"value"_s, 3.25 },
+        { u"data"_s, u"AAH-_w"_s },
+        { u"origin"_s, QJsonObject{ { u"x"_s, 3 }, { u"y"_s, -4 } } },
+        { u"samples"_s, QJsonArray{ 1, 2, 3 } },
+        { u"color"_s, QJsonValue::fromVariant(QVariant::fromValue(r.m_color)) },
+    };
+    QCOMPARE(object, expected);
+
+    Record loaded;
+    QGadgetSerializer::fromJsonObject(object, loaded);
+    Record expectedRecord = r;
+    expectedRecord.m_transient = 0;
+    QVERIFY(loaded == expectedRecord);
+}
+
+void tst_QGadgetSerializer::jsonPartial()
+{
+    const QJsonObject object = {
+        { u"unknown"_s, 1 },
+        { u"enabled"_s, false },
+        { u"offset"_s, 1.5 },           // not an integer
+        { u"ratio"_s, u"text"_s },
+        { u"origin"_s, QJsonObject{ { u"x"_s, 8 } } },
+    };
+
+    Record loaded = sampleRecord();
+    QGadgetSerializer::fromJsonObject(object, loaded);
+
+    Record expected = sampleRecord();
+    expected.m_enabled = false;
+    expected.m_origin.x = 8;
+    QVERIFY(loaded == expected);
+}
+
+void tst_QGadgetSerializer::qobject()
+{
+    DerivedItem item;
+    item.setObjectName(u"not serialized"_s);
+    item.m_count = 5;
+    item.m_label = u"label"_s;
+    item.m_position = { 1, 2 };
+
+    const QJsonObject object = QGadgetSerializer::toJsonObject(item);
+    const QJsonObject expected = {
+        { u"count"_s, 5 },
+        { u"label"_s, u"label"_s },
+        { u"position"_s, QJsonObject{ { u"x"_s, 1 }, { u"y"_s, 2 } } },
+    };
+    QCOMPARE(object, expected);
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        QGadgetSerializer::save(stream, item);
+    }
+
+    DerivedItem loaded;
+    QDataStream stream(data);
+    QGadgetSerializer::load(stream, loaded);
+    QCOMPARE(stream.status(), QDataStream::Ok);
+    QCOMPARE(loaded.m_count, 5);
+    QCOMPARE(loaded.m_label, u"label"_s);
+    QVERIFY(loaded.m_position == item.m_position);
+    QVERIFY(loaded.objectName().isEmpty());
+
+    // the base class uses its own plan
+    QCOMPARE(QGadgetSerializer::toJsonObject<Item>(item).size(), 2);
+}
+
+QTEST_MAIN(tst_QGadgetSerializer)
+#include "tst_qgadgetserializer.moc"
@@ -1236,6 +1236,26 @@ void tst_QLocale::doubleToString_data()
     QTest::newRow("C 12000000 g -") << QString("C") << QString("1.2e+07") << 12e6 << 'g' << shortest;
     QTest::newRow("C 10000 g -")   << QString("C") << QString("10000") << 1e4 << 'g' << shortest;
     QTest::newRow("C 100000 g -")  << QString("C") << QString("1e+05") << 1e5 << 'g' << shortest;
+    // Shortest representations at the edges of the range:
+    QTest::newRow("C 0.1 g -") << QString("C") << QString("0.1") << 0.1 << 'g' << shortest;
+    QTest::newRow("C 1/3 g -")
+        << QString("C") << QString("0.3333333333333333") << 1.0 / 3 << 'g' << shortest;
+    QTest::newRow("C 1e23 g -") << QString("C") << QString("1e+23") << 1e23 << 'g' << shortest;
+    QTest::newRow("C 2^53 f -")
+        << QString("C") << QString("9007199254740992") << 9007199254740992.0 << 'f' << shortest;
+    QTest::newRow("C max e -")
+        << QString("C") << QString("1.7976931348623157e+308")
+        << std::numeric_limits<double>::max() << 'e' << shortest;
+    QTest::newRow("C min e -")
+        << QString("C") << QString("2.2250738585072014e-308")
+        << std::numeric_limits<double>::min() << 'e' << shortest;
+    QTest::newRow("C denorm_min g -")
+        << QString("C") << QString("5e-324")
+        << std::numeric_limits<double>::denorm_min() << 'g' << shortest;
+    QTest::newRow("C 2^-1022 - 2^-1074 g -")
+        << QString("C") << QString("2.225073858507201e-308")
+        << std::numeric_limits<double>::min() - std::numeric_limits<double>::denorm_min()
+        << 'g' << shortest;
 
     QTest::newRow("C 12456789012 f 0")  << QString("C") << QString("12456789012")      << 12456789012.0 << 'f' << 0;
     QTest::newRow("C 12456789012 f -")  << QString("C") << QString("12456789012")      << 12456789012.0 << 'f' << shortest;
@@ -1299,14 +1319,44 @@ void tst_QLocale::strtod_data()
     QTest::newRow("3.945e-6")        << QString("3.945e-6")        << 0.000003945   << 8  << true;
     QTest::newRow("12456789012")     << QString("12456789012")     << 12456789012.0 << 11 << true;
     QTest::newRow("1.2456789012e10") << QString("1.2456789012e10") << 12456789012.0 << 15 << true;
+    QTest::newRow("-0.5")            << QString("-0.5")            << -0.5          << 4  << true;
+    QTest::newRow(".5")              << QString(".5")              << 0.5           << 2  << true;
+    QTest::newRow("+5.")             << QString("+5.")             << 5.0           << 3  << true;
+
+    // Correct rounding, including numbers with more significant digits than
+    // fit in 64 bits:
+    QTest::newRow("2^53 + 1")        << QString("9007199254740993") << 9007199254740992.0 << 16 << true;
+    QTest::newRow("2^53 + 3")        << QString("9007199254740995") << 9007199254740996.0 << 16 << true;
+    QTest::newRow("1 + 2^-53")
+        << QString("1.00000000000000011102230246251565404236316680908203125") << 1.0 << 55 << true;
+    QTest::newRow("1 + 2^-53 + 10^-56")
+        << QString("1.00000000000000011102230246251565404236316680908203126")
+        << 1.0000000000000002 << 55 << true;
+    QTest::newRow("0.1 with 25 digits")
+        << QString("0.1000000000000000055511151") << 0.1 << 27 << true;
+    QTest::newRow("min")
+        << QString("2.2250738585072014e-308") << std::numeric_limits<double>::min() << 23 << true;
+    QTest::newRow("below min")
+        << QString("2.2250738585072011e-308")
+        << std::numeric_limits<double>::min() - std::numeric_limits<double>::denorm_min()
+        << 23 << true;
+    QTest::newRow("denorm_min")
+        << QString("4.9406564584124654e-324") << std::numeric_limits<double>::denorm_min()
+        << 23 << true;
+    QTest::newRow("5e-324") << QString("5e-324") << std::numeric_limits<double>::denorm_min()
+        << 6 << true;
+    QTest::newRow("max")
+        << QString("1.7976931348623157e308") << std::numeric_limits<double>::max() << 22 << true;
 
     // Overflow - fails but reports right length:
+    QTest::newRow("above max")       << QString("1.7976931348623159e308") << qInf() << 22 << false;
     QTest::newRow("1e2000")          << QString("1e2000")          << qInf()        << 6  << false;
     QTest::newRow("-1e2000")         << QString("-1e2000")         << -qInf()       << 7  << false;
 
     // Underflow - fails but reports right length:
     QTest::newRow("1e-2000")         << QString("1e-2000")         << 0.0           << 7  << false;
     QTest::newRow("-1e-2000")        << QString("-1e-2000")        << 0.0           << 8  << false;
+    QTest::newRow("denorm_min / 2")  << QString("2.4703282292062327e-324") << 0.0 << 23 << false;
 
     // starts with junk, fails
     QTest::newRow("a0")               << QString("a0")               << 0.0 << 0 << false;
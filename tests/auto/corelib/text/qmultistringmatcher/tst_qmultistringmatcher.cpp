@@ -0,0 +1,281 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtCore/QMultiStringMatcher>
+#include <QtCore/QRandomGenerator>
+
+#include <algorithm>
+
+using namespace Qt::StringLiterals;
+
+using Match = QMultiStringMatcher::Match;
+using MatchList = QList<Match>;
+
+namespace QTest {
+template <> char *toString(const Match &match)
+{
+    return qstrdup(QByteArray("Match(" + QByteArray::number(match.offset) + ", "
+                              + QByteArray::number(match.length) + ", "
+                              + QByteArray::number(match.patternIndex) + ')'));
+}
+}
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void basics_data();
+    void basics();
+    void overlapping();
+    void duplicatePatterns();
+    void caseInsensitive();
+    void utf8();
+    void from();
+    void indexInPrefersLowestOffset();
+    void compareWithIndexOf_data();
+    void compareWithIndexOf();
+};
+
+// The reference: one indexOf() per pattern and position
+static MatchList naiveMatchAll(QStringView text, const QStringList &patterns,
+                               Qt::CaseSensitivity cs, qsizetype from = 0)
+{
+    MatchList result;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        if (patterns.at(i).isEmpty())
+            continue;
+        for (qsizetype pos = text.indexOf(patterns.at(i), from, cs); pos >= 0;
+             pos = text.indexOf(patterns.at(i), pos + 1, cs)) {
+            result.append({ pos, patterns.at(i).size(), i });
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Match &lhs, const Match &rhs) {
+        return lhs.offset < rhs.offset
+                || (lhs.offset == rhs.offset && lhs.patternIndex < rhs.patternIndex);
+    });
+    return result;
+}
+
+static MatchList naiveMatchAll(QByteArrayView text, const QStringList &patterns,
+                               Qt::CaseSensitivity cs)
+{
+    const QByteArray haystack = cs == Qt::CaseSensitive ? text.toByteArray()
+                                                        : text.toByteArray().toLower();
+    MatchList result;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QByteArray needle = cs == Qt::CaseSensitive ? patterns.at(i).toUtf8()
+                                                          : patterns.at(i).toUtf8().toLower();
+        if (needle.isEmpty())
+            continue;
+        for (qsizetype pos = haystack.indexOf(needle); pos >= 0;
+             pos = haystack.indexOf(needle, pos + 1)) {
+            result.append({ pos, needle.size(), i });
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Match &lhs, const Match &rhs) {
+        return lhs.offset < rhs.offset
+                || (lhs.offset == rhs.offset && lhs.patternIndex < rhs.patternIndex);
+    });
+    return result;
+}
+
+void tst_QMultiStringMatcher::empty()
+{
+    const QMultiStringMatcher none;
+    QVERIFY(none.patterns().isEmpty());
+    QCOMPARE(none.caseSensitivity(), Qt::CaseSensitive);
+    QVERIFY(!none.indexIn(u"text").isValid());
+    QVERIFY(!none.indexIn("text"_ba).isValid());
+    QVERIFY(none.matchAll(u"text").isEmpty());
+    QVERIFY(!none.containsAny(u"text"));
+
+    const QMultiStringMatcher emptyPatterns({ QString(), u""_s });
+    QVERIFY(!emptyPatterns.indexIn(u"text").isValid());
+    QVERIFY(emptyPatterns.matchAll("text"_ba).isEmpty());
+
+    const QMultiStringMatcher matcher({ u"a"_s });
+    QVERIFY(!matcher.indexIn(u"").isValid());
+    QVERIFY(!matcher.indexIn(QStringView()).isValid());
+    QVERIFY(!matcher.indexIn(QByteArrayView()).isValid());
+    QCOMPARE(matcher.indexIn(u"a"), Match({ 0, 1, 0 }));
+}
+
+void tst_QMultiStringMatcher::basics_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<MatchList>("expected");
+
+    QTest::newRow("one") << QStringList{ u"needle"_s } << u"haystack with a needle in it"_s
+                         << MatchList{ { 16, 6, 0 } };
+    QTest::newRow("none") << QStringList{ u"needle"_s, u"pin"_s } << u"haystack"_s
+                          << MatchList{};
+    QTest::newRow("several") << QStringList{ u"error"_s, u"warning"_s, u"fatal"_s }
+                             << u"warning: fatal error, another error"_s
+                             << MatchList{ { 0, 7, 1 }, { 9, 5, 2 }, { 15, 5, 0 }, { 30, 5, 0 } };
+    QTest::newRow("single-character") << QStringList{ u"x"_s, u"y"_s } << u"xyzzyx"_s
+                                      << MatchList{ { 0, 1, 0 }, { 1, 1, 1 }, { 4, 1, 1 },
+                                                    { 5, 1, 0 } };
+    QTest::newRow("at-end") << QStringList{ u"end"_s } << u"the end"_s << MatchList{ { 4, 3, 0 } };
+    QTest::newRow("non-latin1") << QStringList{ u"中文"_s, u"ж"_s }
+                                << u"ж text 中文 ж"_s
+                                << MatchList{ { 0, 1, 1 }, { 7, 2, 0 }, { 10, 1, 1 } };
+    QTest::newRow("surrogates") << QStringList{ u"\U0001F600"_s } << u"a\U0001F600b"_s
+                                << MatchList{ { 1, 2, 0 } };
+
+    // more patterns than the SIMD prefilter takes
+    QStringList many;
+    for (int i = 0; i < 100; ++i)
+        many.append(u"key%1;"_s.arg(i));
+    QTest::newRow("many") << many << u"key7; key42; key99; key100;"_s
+                          << MatchList{ { 0, 5, 7 }, { 6, 6, 42 }, { 13, 6, 99 } };
+}
+
+void tst_QMultiStringMatcher::basics()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QString, text);
+    QFETCH(MatchList, expected);
+
+    const QMultiStringMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.matchAll(text), expected);
+    QCOMPARE(matcher.indexIn(text), expected.value(0));
+    QCOMPARE(matcher.containsAny(text), !expected.isEmpty());
+
+    // the same, padded so that the SIMD code sees it
+    const QString padding(40, u'.');
+    const MatchList padded = matcher.matchAll(padding + text + padding);
+    QCOMPARE(padded.size(), expected.size());
+    for (qsizetype i = 0; i < padded.size(); ++i)
+        QCOMPARE(padded.at(i), Match({ expected.at(i).offset + padding.size(),
+                                       expected.at(i).length, expected.at(i).patternIndex }));
+}
+
+void tst_QMultiStringMatcher::overlapping()
+{
+    const QStringList patterns = { u"he"_s, u"she"_s, u"his"_s, u"hers"_s };
+    const QMultiStringMatcher matcher(patterns);
+    const MatchList expected = { { 1, 3, 1 }, { 2, 2, 0 }, { 2, 4, 3 } };
+    QCOMPARE(matcher.matchAll(u"ushers"), expected);
+    QCOMPARE(matcher.indexIn(u"ushers"), Match({ 1, 3, 1 }));
+
+    // one pattern inside another, and repetitions
+    const QMultiStringMatcher nested({ u"aaa"_s, u"a"_s, u"aa"_s });
+    QCOMPARE(nested.matchAll(u"aaaa"),
+             MatchList({ { 0, 3, 0 }, { 0, 1, 1 }, { 0, 2, 2 }, { 1, 3, 0 }, { 1, 1, 1 },
+                         { 1, 2, 2 }, { 2, 1, 1 }, { 2, 2, 2 }, { 3, 1, 1 } }));
+}
+
+void tst_QMultiStringMatcher::duplicatePatterns()
+{
+    const QMultiStringMatcher matcher({ u"dup"_s, u"other"_s, u"dup"_s });
+    QCOMPARE(matcher.matchAll(u"a dup"), MatchList({ { 2, 3, 0 }, { 2, 3, 2 } }));
+    QCOMPARE(matcher.indexIn(u"a dup"), Match({ 2, 3, 0 }));
+}
+
+void tst_QMultiStringMatcher::caseInsensitive()
+{
+    const QStringList patterns = { u"Error"_s, u"ÉtÉ"_s, u"Ж"_s };
+    const QMultiStringMatcher sensitive(patterns);
+    const QMultiStringMatcher insensitive(patterns, Qt::CaseInsensitive);
+    QCOMPARE(insensitive.caseSensitivity(), Qt::CaseInsensitive);
+
+    const QString text = u"ERROR error été ж"_s;
+    QCOMPARE(sensitive.matchAll(text), MatchList());
+    QCOMPARE(insensitive.matchAll(text),
+             MatchList({ { 0, 5, 0 }, { 6, 5, 0 }, { 12, 3, 1 }, { 16, 1, 2 } }));
+
+    // UTF-8: only ASCII letters are folded
+    const QByteArray utf8 = text.toUtf8();
+    QCOMPARE(insensitive.matchAll(utf8), MatchList({ { 0, 5, 0 }, { 6, 5, 0 } }));
+    QCOMPARE(insensitive.matchAll(u"ÉtÉ Ж"_s.toUtf8()),
+             MatchList({ { 0, 5, 1 }, { 6, 2, 2 } }));
+}
+
+void tst_QMultiStringMatcher::utf8()
+{
+    const QStringList patterns = { u"café"_s, u"中"_s, u"ok"_s };
+    const QMultiStringMatcher matcher(patterns);
+    const QByteArray text = u"ok café 中"_s.toUtf8();
+    // offsets and lengths in bytes
+    QCOMPARE(matcher.matchAll(text), MatchList({ { 0, 2, 2 }, { 3, 5, 0 }, { 9, 3, 1 } }));
+    QCOMPARE(matcher.indexIn(text, 1), Match({ 3, 5, 0 }));
+    QVERIFY(matcher.containsAny(QByteArrayView(text)));
+    QVERIFY(!matcher.containsAny("none here"_ba));
+}
+
+void tst_QMultiStringMatcher::from()
+{
+    const QMultiStringMatcher matcher({ u"ab"_s });
+    const QString text = u"ab ab ab"_s;
+    QCOMPARE(matcher.indexIn(text, -5), Match({ 0, 2, 0 }));
+    QCOMPARE(matcher.indexIn(text, 1), Match({ 3, 2, 0 }));
+    QCOMPARE(matcher.indexIn(text, 6), Match({ 6, 2, 0 }));
+    QVERIFY(!matcher.indexIn(text, 7).isValid());
+    QVERIFY(!matcher.indexIn(text, 100).isValid());
+    QCOMPARE(matcher.matchAll(text, 2), MatchList({ { 3, 2, 0 }, { 6, 2, 0 } }));
+}
+
+void tst_QMultiStringMatcher::indexInPrefersLowestOffset()
+{
+    // the automaton sees the end of "bc" before that of "abcdef"
+    QStringList patterns = { u"bc"_s, u"abcdef"_s };
+    for (int i = 0; i < 20; ++i)
+        patterns.append(u"filler%1"_s.arg(i));
+    const QMultiStringMatcher matcher(patterns);
+    QCOMPARE(matcher.indexIn(u"xabcdefx"), Match({ 1, 6, 1 }));
+    QCOMPARE(matcher.indexIn(u"xabcdex"), Match({ 2, 2, 0 }));
+}
+
+void tst_QMultiStringMatcher::compareWithIndexOf_data()
+{
+    QTest::addColumn<int>("patternCount");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    for (int count : { 1, 3, 8, 50, 300 }) {
+        QTest::addRow("%d-sensitive", count) << count << Qt::CaseSensitive;
+        QTest::addRow("%d-insensitive", count) << count << Qt::CaseInsensitive;
+    }
+}
+
+void tst_QMultiStringMatcher::compareWithIndexOf()
+{
+    QFETCH(int, patternCount);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    // a small alphabet, so that there are many (overlapping) matches
+    static const char16_t alphabet[] = u"abcAB éÉ中";
+    QRandomGenerator rng(patternCount);
+    const auto randomString = [&](int minLength, int maxLength) {
+        QString result;
+        for (int n = rng.bounded(minLength, maxLength + 1); n; --n)
+            result.append(QChar(alphabet[rng.bounded(int(std::size(alphabet)) - 1)]));
+        return result;
+    };
+
+    QStringList patterns;
+    for (int i = 0; i < patternCount; ++i)
+        patterns.append(randomString(1, 6));
+    const QMultiStringMatcher matcher(patterns, cs);
+
+    for (int round = 0; round < 50; ++round) {
+        const QString text = randomString(0, 200);
+        const MatchList expected = naiveMatchAll(text, patterns, cs);
+        QCOMPARE(matcher.matchAll(text), expected);
+        QCOMPARE(matcher.indexIn(text), expected.value(0));
+
+        const qsizetype from = rng.bounded(text.size() + 1);
+        QCOMPARE(matcher.matchAll(text, from), naiveMatchAll(text, patterns, cs, from));
+
+        const QByteArray utf8 = text.toUtf8();
+        QCOMPARE(matcher.matchAll(utf8), naiveMatchAll(QByteArrayView(utf8), patterns, cs));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+#include "tst_qmultistringmatcher.moc"
@@ -63,6 +63,10 @@ private slots:
     void QStringAndQStringViewEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void compiledPatternCache();
+    void matchEach_data();
+    void matchEach();
+    void matchEachKeepsMatches();
 
     void returnsViewsIntoOriginalString();
     void wildcard_data();
@@ -2414,6 +2418,144 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::compiledPatternCache()
+{
+    // The same pattern with different options must not share the compiled code
+    {
+        QRegularExpression sensitive("abc");
+        QRegularExpression insensitive("abc", QRegularExpression::CaseInsensitiveOption);
+        QVERIFY(sensitive.match("ABC").hasMatch() == false);
+        QVERIFY(insensitive.match("ABC").hasMatch());
+        QVERIFY(sensitive.match("abc").hasMatch());
+    }
+
+    // Invalid patterns are cached with their error
+    for (int i = 0; i < 2; ++i) {
+        QRegularExpression re("a(b");
+        QVERIFY(!re.isValid());
+        QCOMPARE(re.patternErrorOffset(), 3);
+        QCOMPARE(re.errorString(), QRegularExpression("a(b").errorString());
+    }
+
+    // A pattern evicted from the cache stays usable
+    QRegularExpression first("^first(\\d+)$");
+    QVERIFY(first.isValid());
+    for (int i = 0; i < 1000; ++i) {
+        QRegularExpression re(QString::number(i) + "x(y*)");
+        QCOMPARE(re.match(QString::number(i) + "xyy").captured(1), "yy");
+    }
+    QCOMPARE(first.match("first42").captured(1), "42");
+    QCOMPARE(first.captureCount(), 1);
+
+    // Detaching a copy to change the pattern options recompiles it correctly
+    QRegularExpression copy = first;
+    copy.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(copy.match("FIRST1").hasMatch());
+    QVERIFY(!first.match("FIRST1").hasMatch());
+
+    // Many threads compiling the same patterns at the same time
+    const int threadCount = qMax(QThread::idealThreadCount(), 4);
+    QList<QThread *> threads;
+    QAtomicInt failures;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.append(QThread::create([&failures] {
+            for (int j = 0; j < 500; ++j) {
+                QRegularExpression re(QString::number(j % 50) + "(a|b)+z",
+                                      QRegularExpression::CaseInsensitiveOption);
+                const auto match = re.match("--" + QString::number(j % 50) + "abABz--");
+                if (!match.hasMatch() || match.capturedStart() != 2)
+                    failures.ref();
+            }
+        }));
+        threads.last()->start();
+    }
+    for (QThread *thread : std::as_const(threads))
+        QVERIFY(thread->wait());
+    qDeleteAll(threads);
+    QCOMPARE(failures.loadRelaxed(), 0);
+}
+
+void tst_QRegularExpression::matchEach_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QRegularExpression::MatchType>("matchType");
+
+    QTest::newRow("no-captures") << "b+" << QRegularExpression::NormalMatch;
+    QTest::newRow("captures") << "(\\w+)=(\\d*)" << QRegularExpression::NormalMatch;
+    QTest::newRow("named") << "(?<key>\\w+)=(?<value>\\d*)" << QRegularExpression::NormalMatch;
+    QTest::newRow("many-captures") << "(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)(k)(l)(m)(n)(o)(p)(q)(r)?"
+                                   << QRegularExpression::NormalMatch;
+    QTest::newRow("partial") << "abc=\\d+" << QRegularExpression::PartialPreferCompleteMatch;
+    QTest::newRow("nomatch") << "a" << QRegularExpression::NoMatch;
+}
+
+void tst_QRegularExpression::matchEach()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QRegularExpression::MatchType, matchType);
+
+    const QStringList subjects = {
+        QString(), "", "abc=123", "no match here", "bbb", "key=", "abc",
+        "abcdefghijklmnopqr", "abcdefghijklmnopq", "x=1 y=2", QString(1000, u'b'),
+    };
+
+    const QRegularExpression re(pattern);
+    QVERIFY(re.isValid());
+
+    qsizetype calls = 0;
+    re.matchEach(subjects, [&](qsizetype i, const QRegularExpressionMatch &match) {
+        QCOMPARE(i, calls);
+        ++calls;
+        const QRegularExpressionMatch expected = re.match(subjects.at(i), 0, matchType);
+        QCOMPARE(match.isValid(), expected.isValid());
+        QCOMPARE(match.hasMatch(), expected.hasMatch());
+        QCOMPARE(match.hasPartialMatch(), expected.hasPartialMatch());
+        QCOMPARE(match.matchType(), matchType);
+        QCOMPARE(match.lastCapturedIndex(), expected.lastCapturedIndex());
+        QCOMPARE(match.capturedTexts(), expected.capturedTexts());
+        for (int n = 0; n <= match.lastCapturedIndex(); ++n)
+            QCOMPARE(match.capturedStart(n), expected.capturedStart(n));
+        for (const QString &name : re.namedCaptureGroups()) {
+            if (!name.isEmpty())
+                QCOMPARE(match.captured(name), expected.captured(name));
+        }
+    }, matchType);
+    QCOMPARE(calls, subjects.size());
+}
+
+void tst_QRegularExpression::matchEachKeepsMatches()
+{
+    const QStringList subjects = { "a=1", "b=22", "nope", "c=333" };
+    const QRegularExpression re("(\\w)=(\\d+)");
+
+    // Matches copied by the callback keep their results and their subject
+    QList<QRegularExpressionMatch> matches;
+    re.matchEach(subjects, [&](qsizetype, const QRegularExpressionMatch &match) {
+        matches.append(match);
+    });
+    QCOMPARE(matches.size(), subjects.size());
+    QCOMPARE(matches.at(0).captured(2), "1");
+    QCOMPARE(matches.at(1).captured(2), "22");
+    QVERIFY(!matches.at(2).hasMatch());
+    QCOMPARE(matches.at(3).captured(1), "c");
+    QCOMPARE(matches.at(3).captured(2), "333");
+    QCOMPARE(matches.at(3).regularExpression(), re);
+
+    // QStringList::filter() is implemented on top of matchEach()
+    QCOMPARE(subjects.filter(re), QStringList({ "a=1", "b=22", "c=333" }));
+
+    // Invalid regular expressions report invalid matches
+    const QRegularExpression invalid("(");
+    qsizetype calls = 0;
+    QTest::ignoreMessage(QtWarningMsg, "QRegularExpressionPrivate::doMatch(): called on an invalid "
+                                       "QRegularExpression object (pattern is '(')");
+    invalid.matchEach({ "x" }, [&](qsizetype, const QRegularExpressionMatch &match) {
+        ++calls;
+        QVERIFY(!match.isValid());
+    });
+    QCOMPARE(calls, 1);
+}
+
 void tst_QRegularExpression::returnsViewsIntoOriginalString()
 {
     // https://bugreports.qt.io/browse/QTBUG-98653
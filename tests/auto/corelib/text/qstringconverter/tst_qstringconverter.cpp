@@ -7,6 +7,7 @@
 #include <QtCore/private/qglobal_p.h>
 #include <qstringconverter.h>
 #include <private/qstringconverter_p.h>
+#include <qrandom.h>
 #include <qthreadpool.h>
 
 #include <array>
@@ -129,6 +130,7 @@ private slots:
     void convertUtf8();
     void convertUtf8CharByChar_data() { convertUtf8_data(); }
     void convertUtf8CharByChar();
+    void convertUtf8LongMixed();
     void roundtrip_data();
     void roundtrip();
 
@@ -355,6 +357,66 @@ void tst_QStringConverter::convertUtf8CharByChar()
     QCOMPARE(reencoded, ba);
 }
 
+void tst_QStringConverter::convertUtf8LongMixed()
+{
+    // Long inputs go through the vectorized code, the pieces they are made of
+    // are too short for it, so both must give the same results. An invalid
+    // piece is followed by an ASCII character, so that the replacement
+    // characters it produces do not depend on what comes after it.
+    static const char *const pieces[] = {
+        "a", "bc", "plain ASCII text", "\xc3\xa9", "\xd0\x96\xd0\xb8", "\xdf\xbf", "\xc2\x80",
+        "\xe4\xb8\xad", "\xe2\x82\xac", "\xe0\xa0\x80", "\xee\x80\x80", "\xef\xbf\xbf",
+        "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf",
+        // invalid from here on
+        "\x80", "\xbf\xbf", "\xc3", "\xe4\xb8", "\xc0\xaf", "\xe0\x80\x80", "\xed\xa0\x80",
+        "\xed\xbf\xbf", "\xf8\x88\x80\x80\x80", "\xff",
+    };
+    constexpr int ValidPieces = 14;
+    constexpr int PieceCount = int(std::size(pieces));
+
+    QRandomGenerator rng(0x5eed);
+    for (int round = 0; round < 2000; ++round) {
+        // a third of the inputs have errors
+        const int choices = round % 3 ? ValidPieces : PieceCount;
+        QByteArray utf8;
+        QString expected;
+        bool valid = true;
+        for (int n = rng.bounded(1, 100); n; --n) {
+            const int i = rng.bounded(choices);
+            QByteArray piece(pieces[i]);
+            if (i >= ValidPieces || rng.bounded(4) == 0)
+                piece += '!';
+            utf8 += piece;
+            expected += QString::fromUtf8(piece);
+            valid = valid && i < ValidPieces;
+        }
+
+        QCOMPARE(QString::fromUtf8(utf8), expected);
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QCOMPARE(decoder.decode(utf8), expected);
+        QCOMPARE(QUtf8StringView(utf8).isValidUtf8(), valid);
+
+        // lone surrogates must be replaced, everything else encoded back
+        QString utf16 = expected;
+        if (round % 2)
+            utf16.insert(rng.bounded(utf16.size() + 1), QChar(char16_t(rng.bounded(0xd800, 0xe000))));
+        QByteArray reencoded;
+        QByteArray reencodedByEncoder;  // replaces with U+FFFD instead of '?'
+        for (qsizetype i = 0; i < utf16.size(); ++i) {
+            const bool pair = utf16.at(i).isHighSurrogate() && i + 1 < utf16.size()
+                    && utf16.at(i + 1).isLowSurrogate();
+            const QStringView character = QStringView(utf16).sliced(i, pair ? 2 : 1);
+            reencoded += character.toUtf8();
+            reencodedByEncoder += QStringEncoder(QStringEncoder::Utf8, QStringEncoder::Flag::Stateless)
+                                          .encode(character);
+            i += pair;
+        }
+        QCOMPARE(utf16.toUtf8(), reencoded);
+        QStringEncoder encoder(QStringEncoder::Utf8, QStringEncoder::Flag::Stateless);
+        QCOMPARE(encoder.encode(utf16), reencodedByEncoder);
+    }
+}
+
 void tst_QStringConverter::convertL1U16()
 {
     const QLatin1StringView latin1("some plain latin1 text");
@@ -0,0 +1,290 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QLocale>
+#include <QStringBuilder>
+#include <QStringFormat>
+
+#include <limits>
+
+using namespace Qt::StringLiterals;
+
+// The parser is constexpr, so malformed format strings are rejected at
+// compile time; check that it reports the expected errors.
+namespace {
+using QtPrivate::QFormatStringError;
+
+template <qsizetype N>
+constexpr QFormatStringError formatError(const char16_t (&format)[N])
+{
+    return QtPrivate::parseFormatString<N>(QStringView(format)).error;
+}
+
+template <qsizetype N>
+constexpr int formatArgumentCount(const char16_t (&format)[N])
+{
+    return QtPrivate::parseFormatString<N>(QStringView(format)).argumentCount;
+}
+
+static_assert(formatError(u"plain text") == QFormatStringError::NoError);
+static_assert(formatError(u"{} and {}") == QFormatStringError::NoError);
+static_assert(formatError(u"{{}}") == QFormatStringError::NoError);
+static_assert(formatError(u"%1 {") == QFormatStringError::NoError);
+static_assert(formatError(u"{") == QFormatStringError::UnmatchedBrace);
+static_assert(formatError(u"}") == QFormatStringError::UnmatchedBrace);
+static_assert(formatError(u"{0") == QFormatStringError::UnmatchedBrace);
+static_assert(formatError(u"{x}") == QFormatStringError::InvalidPlaceholder);
+static_assert(formatError(u"{0:x}") == QFormatStringError::InvalidPlaceholder);
+static_assert(formatError(u"{100}") == QFormatStringError::InvalidPlaceholder);
+static_assert(formatError(u"{} {1}") == QFormatStringError::MixedNumbering);
+static_assert(formatError(u"%0") == QFormatStringError::ZeroPlaceholder);
+
+static_assert(formatArgumentCount(u"no placeholders") == 0);
+static_assert(formatArgumentCount(u"{} {} {:L}") == 3);
+static_assert(formatArgumentCount(u"{2} {0}") == 3);
+static_assert(formatArgumentCount(u"%2 %L1") == 2);
+static_assert(formatArgumentCount(u"%12") == 12);
+} // unnamed namespace
+
+class tst_QStringFormat : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup() { QLocale::setDefault(QLocale::c()); }
+
+    void percentStyle();
+    void braceStyle();
+    void escapedBraces();
+    void noPlaceholders();
+    void strings();
+    void characters();
+    void integers_data();
+    void integers();
+    void floatingPoint_data();
+    void floatingPoint();
+    void localized();
+    void size();
+    void stringBuilder();
+    void formatToString();
+    void formatToVarLengthArray();
+};
+
+void tst_QStringFormat::percentStyle()
+{
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%1 of %2"), 3, 10).toString(), u"3 of 10"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%2, %1!"), u"world"_s, u"Hello"_s).toString(),
+             u"Hello, world!"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%1%1%1"), u"ab"_s).toString(), u"ababab"_s);
+    // Braces are not special in this style, and a lone % is kept
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{%1} 100% }"), 5).toString(), u"{5} 100% }"_s);
+    // Two-digit placeholders, as in QString::arg()
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%10-%1"), 1, 2, 3, 4, 5, 6, 7, 8, 9, 10).toString(),
+             u"10-1"_s);
+    // Arguments that the format string does not use are ignored
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%2"), 1, 2, 3).toString(), u"2"_s);
+
+    // Same result as QString::arg()
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%1: %2 (%3)"), u"name"_s, 42, 1.5).toString(),
+             u"%1: %2 (%3)"_s.arg(u"name"_s).arg(42).arg(1.5));
+}
+
+void tst_QStringFormat::braceStyle()
+{
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{} of {}"), 3, 10).toString(), u"3 of 10"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{1}, {0}!"), u"world"_s, u"Hello"_s).toString(),
+             u"Hello, world!"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{0}{0}"), u"ab"_s).toString(), u"abab"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), u"whole"_s).toString(), u"whole"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"100%: {}"), 1).toString(), u"100%: 1"_s);
+}
+
+void tst_QStringFormat::escapedBraces()
+{
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{{}}")).toString(), u"{}"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{{{}}}"), 7).toString(), u"{7}"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"a{{b}}c{}"), u'd').toString(), u"a{b}cd"_s);
+}
+
+void tst_QStringFormat::noPlaceholders()
+{
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"")).toString(), QString());
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"constant")).toString(), u"constant"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"constant"), 1, 2).toString(), u"constant"_s);
+}
+
+void tst_QStringFormat::strings()
+{
+    const QString utf16 = u"Grüße"_s;
+    const QByteArray utf8 = utf16.toUtf8();
+    const QLatin1StringView latin1("caf\xe9");
+
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"[{}]"), utf16).toString(), u"[Grüße]"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"[{}]"), QStringView(utf16).first(3)).toString(),
+             u"[Grü]"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"[{}]"), QUtf8StringView(utf8)).toString(), u"[Grüße]"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"[{}]"), latin1).toString(), u"[café]"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"[{}]"), "ascii").toString(), u"[ascii]"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"[{}]"), u"utf16 literal").toString(),
+             u"[utf16 literal]"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"[{}]"), QString()).toString(), u"[]"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}{}{}"), utf16, QUtf8StringView(utf8), latin1)
+                     .toString(),
+             utf16 + utf16 + u"café"_s);
+}
+
+void tst_QStringFormat::characters()
+{
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}{}{}{}"), QChar(u'a'), u'b', QLatin1Char('c'), 'd')
+                     .toString(),
+             u"abcd"_s);
+    // char is Latin-1, not UTF-8
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), char(0xe9)).toString(), u"é"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), QChar::Nbsp).toString(), QString(QChar::Nbsp));
+}
+
+void tst_QStringFormat::integers_data()
+{
+    QTest::addColumn<qlonglong>("value");
+
+    QTest::newRow("0") << 0LL;
+    QTest::newRow("1") << 1LL;
+    QTest::newRow("-1") << -1LL;
+    QTest::newRow("1234567890") << 1234567890LL;
+    QTest::newRow("-987654321") << -987654321LL;
+    QTest::newRow("min") << std::numeric_limits<qlonglong>::min();
+    QTest::newRow("max") << std::numeric_limits<qlonglong>::max();
+}
+
+void tst_QStringFormat::integers()
+{
+    QFETCH(qlonglong, value);
+
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), value).toString(), QString::number(value));
+    if (value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max()) {
+        QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), int(value)).toString(),
+                 QString::number(int(value)));
+    }
+    if (value >= 0) {
+        QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), qulonglong(value)).toString(),
+                 QString::number(qulonglong(value)));
+    }
+}
+
+void tst_QStringFormat::floatingPoint_data()
+{
+    QTest::addColumn<double>("value");
+
+    QTest::newRow("0") << 0.0;
+    QTest::newRow("-0") << -0.0;
+    QTest::newRow("1") << 1.0;
+    QTest::newRow("0.1") << 0.1;
+    QTest::newRow("-2.5") << -2.5;
+    QTest::newRow("1/3") << 1.0 / 3;
+    QTest::newRow("100000") << 100000.0;
+    QTest::newRow("1e6") << 1e6;
+    QTest::newRow("1.5e-5") << 1.5e-5;
+    QTest::newRow("0.0001") << 0.0001;
+    QTest::newRow("1e100") << 1e100;
+    QTest::newRow("-1.25e-300") << -1.25e-300;
+    QTest::newRow("max") << std::numeric_limits<double>::max();
+    QTest::newRow("denorm_min") << std::numeric_limits<double>::denorm_min();
+    QTest::newRow("lowest") << std::numeric_limits<double>::lowest();
+    QTest::newRow("inf") << qInf();
+    QTest::newRow("-inf") << -qInf();
+    QTest::newRow("nan") << qQNaN();
+}
+
+void tst_QStringFormat::floatingPoint()
+{
+    QFETCH(double, value);
+
+    const QString expected = QString::number(value, 'g', QLocale::FloatingPointShortest);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), value).toString(), expected);
+    if (qIsFinite(value))
+        QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), value).toString().toDouble(), value);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), float(value)).toString(),
+             QString::number(double(float(value)), 'g', QLocale::FloatingPointShortest));
+}
+
+void tst_QStringFormat::localized()
+{
+    QLocale::setDefault(QLocale(QLocale::German, QLocale::Germany));
+
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{:L}"), 1234567).toString(), u"1.234.567"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%L1"), 1234567).toString(), u"1.234.567"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{:L}"), 1.5).toString(), u"1,5"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{0} {0:L}"), 1234.5).toString(), u"1234.5 1.234,5"_s);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%1 %L1"), 1234.5).toString(), u"1234.5 1.234,5"_s);
+    // Strings are not affected by the locale
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{:L}"), u"1234"_s).toString(), u"1234"_s);
+
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%L1"), 1234567).toString(),
+             u"%L1"_s.arg(1234567));
+}
+
+void tst_QStringFormat::size()
+{
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"")).size(), 0);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{{}}")).size(), 2);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}-{}"), 123, u"ab"_s).size(), 6);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"%1%1"), 123).size(), 6);
+
+    // UTF-8 arguments give an upper bound
+    const QByteArray utf8 = u"ü"_s.toUtf8();
+    QVERIFY(qFormat(QT_FORMAT_STRING(u"{}"), QUtf8StringView(utf8)).size() >= 1);
+    QCOMPARE(qFormat(QT_FORMAT_STRING(u"{}"), QUtf8StringView(utf8)).toString().size(), 1);
+}
+
+void tst_QStringFormat::stringBuilder()
+{
+    const QString name = u"world"_s;
+    const QString s = u"Hello, "_s % qFormat(QT_FORMAT_STRING(u"{} #{}"), name, 1) % u'!';
+    QCOMPARE(s, u"Hello, world #1!"_s);
+
+    const QByteArray utf8 = u"Grüße"_s.toUtf8();
+    const QString t = qFormat(QT_FORMAT_STRING(u"<{}>"), QUtf8StringView(utf8))
+            % QLatin1StringView("...");
+    QCOMPARE(t, u"<Grüße>..."_s);
+}
+
+void tst_QStringFormat::formatToString()
+{
+    QString buffer = u"prefix:"_s;
+    QStringView appended = qFormatTo(buffer, QT_FORMAT_STRING(u"{}={}"), u"key"_s, 42);
+    QCOMPARE(appended, u"key=42"_s);
+    QCOMPARE(buffer, u"prefix:key=42"_s);
+
+    const QByteArray utf8 = u"Grüße"_s.toUtf8();
+    appended = qFormatTo(buffer, QT_FORMAT_STRING(u";{}"), QUtf8StringView(utf8));
+    QCOMPARE(appended, u";Grüße"_s);
+    QCOMPARE(buffer, u"prefix:key=42;Grüße"_s);
+
+    // Reusing the buffer does not reallocate
+    buffer.clear();
+    buffer.reserve(64);
+    const QChar *data = buffer.constData();
+    for (int i = 0; i < 10; ++i) {
+        buffer.resize(0);
+        qFormatTo(buffer, QT_FORMAT_STRING(u"line {} of {}"), i, 10);
+    }
+    QCOMPARE(buffer, u"line 9 of 10"_s);
+    QCOMPARE(buffer.constData(), data);
+}
+
+void tst_QStringFormat::formatToVarLengthArray()
+{
+    QVarLengthArray<char16_t, 64> buffer;
+    QStringView appended = qFormatTo(buffer, QT_FORMAT_STRING(u"{} + {}"), 1, 2.5);
+    QCOMPARE(appended, u"1 + 2.5"_s);
+    appended = qFormatTo(buffer, QT_FORMAT_STRING(u" = {}"), 3.5);
+    QCOMPARE(appended, u" = 3.5"_s);
+    QCOMPARE(QStringView(buffer.data(), buffer.size()), u"1 + 2.5 = 3.5"_s);
+    QCOMPARE(buffer.capacity(), 64);
+}
+
+QTEST_APPLESS_MAIN(tst_QStringFormat)
+
+#include "tst_qstringformat.moc"
@@ -27,6 +27,7 @@
 #include <list>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <set>
 
 // COM interface macro.
@@ -243,6 +244,8 @@ private slots:
     void continuationOverride();
     void continuationsDontLeak();
     void cancelAfterFinishWithContinuations();
+    void continuationRacesFinish_data();
+    void continuationRacesFinish();
 
     void unwrap();
 
@@ -5052,6 +5055,75 @@ void tst_QFuture::cancelAfterFinishWithContinuations()
     QVERIFY(!cancelCalled);
 }
 
+enum class FinishMode { ReportFinished, Cancel, DestroyPromise };
+
+void tst_QFuture::continuationRacesFinish_data()
+{
+    QTest::addColumn<FinishMode>("mode");
+    QTest::newRow("reportFinished") << FinishMode::ReportFinished;
+    QTest::newRow("cancel") << FinishMode::Cancel;
+    QTest::newRow("destroy promise") << FinishMode::DestroyPromise;
+}
+
+void tst_QFuture::continuationRacesFinish()
+{
+#if !QT_CONFIG(cxx11_future)
+    QSKIP("This test requires QThread::create");
+#else
+    QFETCH(FinishMode, mode);
+
+    // then() and onCanceled() on one thread race the future finishing on
+    // another; the continuation must run exactly once either way
+    for (int i = 0; i < 1000; ++i) {
+        std::optional<QPromise<int>> promise(std::in_place);
+        promise->start();
+        QFuture<int> future = promise->future();
+        std::atomic<bool> go = false;
+        std::atomic<int> runs = 0;
+
+        QScopedPointer<QThread> finisher(QThread::create([&] {
+            while (!go.load(std::memory_order_acquire))
+                QThread::yieldCurrentThread();
+            switch (mode) {
+            case FinishMode::ReportFinished:
+                promise->addResult(i);
+                promise->finish();
+                break;
+            case FinishMode::Cancel:
+                future.cancel();
+                promise->finish();
+                break;
+            case FinishMode::DestroyPromise:
+                promise.reset();
+                break;
+            }
+        }));
+        finisher->start();
+        go.store(true, std::memory_order_release);
+        // vary which side comes first
+        for (volatile int spin = 0; spin < (i % 32) * 16; spin = spin + 1) { }
+
+        QFuture<int> next;
+        if (mode == FinishMode::ReportFinished) {
+            next = future.then([&runs](int value) {
+                ++runs;
+                return value;
+            });
+        } else {
+            next = future.onCanceled([&runs] {
+                ++runs;
+                return -1;
+            });
+        }
+        QVERIFY(finisher->wait(DefaultWaitTime));
+        QTRY_VERIFY(next.isFinished());
+        QVERIFY2(runs.load() == 1, qPrintable(u"iteration %1 ran the continuation %2 times"_s
+                                                  .arg(i).arg(runs.load())));
+        QCOMPARE(next.result(), mode == FinishMode::ReportFinished ? i : -1);
+    }
+#endif
+}
+
 void tst_QFuture::unwrap()
 {
     // The nested future succeeds
@@ -14,6 +14,8 @@
 #include <qwaitcondition.h>
 #include <private/qvolatile_p.h>
 
+#include <memory>
+
 using namespace std::chrono_literals;
 
 class tst_QMutex : public QObject
@@ -42,6 +44,7 @@ private slots:
     void tryLockNegative_data();
     void tryLockNegative();
     void moreStress();
+    void adaptiveMutex();
 };
 
 static const int iterations = 100;
@@ -1190,5 +1193,37 @@ void tst_QMutex::moreStress()
 }
 
 
+void tst_QMutex::adaptiveMutex()
+{
+    QAdaptiveMutex mutex(1000);
+    QCOMPARE(mutex.spinCount(), 1000);
+    mutex.setSpinCount(0);
+    QCOMPARE(mutex.spinCount(), 0);
+    mutex.setSpinCount(-1);
+    QVERIFY(mutex.spinCount() >= 0);
+    mutex.setSpinCount(1000);
+
+    QVERIFY(mutex.tryLock());
+    QVERIFY(!mutex.tryLock(QDeadlineTimer(10ms)));
+    mutex.unlock();
+
+    constexpr int ThreadCount = 4;
+    constexpr int Iterations = 20000;
+    int counter = 0;
+    std::unique_ptr<QThread> threads[ThreadCount];
+    for (auto &thread : threads) {
+        thread.reset(QThread::create([&] {
+            for (int i = 0; i < Iterations; ++i) {
+                QMutexLocker locker(&mutex);
+                ++counter;
+            }
+        }));
+        thread->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    QCOMPARE(counter, ThreadCount * Iterations);
+}
+
 QTEST_MAIN(tst_QMutex)
 #include "tst_qmutex.moc"
@@ -26,6 +26,11 @@
 
 #include <stdio.h>
 
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
 using namespace std::chrono_literals;
 
 class tst_QReadWriteLock : public QObject
@@ -70,6 +75,11 @@ private slots:
     // recursive locking tests
     void recursiveReadLock();
     void recursiveWriteLock();
+
+    // QShardedReadWriteLock tests
+    void shardedLockUnlock();
+    void shardedTryLock();
+    void shardedCountingTest();
 };
 
 void tst_QReadWriteLock::constructDestruct()
@@ -1068,6 +1078,116 @@ void tst_QReadWriteLock::recursiveWriteLock()
     QVERIFY(thread.wait());
 }
 
+void tst_QReadWriteLock::shardedLockUnlock()
+{
+    QShardedReadWriteLock rwlock;
+    rwlock.lockForRead();
+    rwlock.unlock();
+    rwlock.lockForWrite();
+    rwlock.unlock();
+    {
+        std::shared_lock locker(rwlock);
+    }
+    {
+        std::unique_lock locker(rwlock);
+    }
+    QVERIFY(rwlock.tryLockForWrite());
+    rwlock.unlock();
+}
+
+void tst_QReadWriteLock::shardedTryLock()
+{
+    QShardedReadWriteLock rwlock;
+
+    // readers of other threads block writers, but not other readers
+    rwlock.lockForRead();
+    QVERIFY(rwlock.tryLockForRead());
+    rwlock.unlock();
+    bool locked = true;
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        locked = rwlock.tryLockForWrite(QDeadlineTimer(50ms));
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QVERIFY(!locked);
+    thread.reset(QThread::create([&] {
+        locked = rwlock.tryLockForRead();
+        if (locked)
+            rwlock.unlock();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QVERIFY(locked);
+    rwlock.unlock();
+
+    // a writer blocks everybody else
+    rwlock.lockForWrite();
+    thread.reset(QThread::create([&] {
+        locked = rwlock.tryLockForRead(QDeadlineTimer(50ms)) || rwlock.tryLockForWrite();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QVERIFY(!locked);
+
+    // a waiting reader gets the lock once the writer unlocks
+    QSemaphore started;
+    thread.reset(QThread::create([&] {
+        started.release();
+        locked = rwlock.tryLockForRead(QDeadlineTimer(QDeadlineTimer::Forever));
+        if (locked)
+            rwlock.unlock();
+    }));
+    thread->start();
+    started.acquire();
+    QThread::sleep(20ms);
+    rwlock.unlock();
+    QVERIFY(thread->wait());
+    QVERIFY(locked);
+}
+
+/*
+    Writers increment a variable from 0 to maxval, then reset it to 0.
+    Readers verify that the variable remains at 0.
+*/
+void tst_QReadWriteLock::shardedCountingTest()
+{
+    constexpr int readerThreads = 16;
+    constexpr int writerThreads = 2;
+    constexpr int iterations = 2000;
+    constexpr int maxval = 100;
+
+    QShardedReadWriteLock testLock;
+    volatile int count = 0;
+    QAtomicInt errors;
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < readerThreads; ++i) {
+        threads.emplace_back(QThread::create([&] {
+            for (int j = 0; j < iterations; ++j) {
+                testLock.lockForRead();
+                if (count != 0)
+                    errors.ref();
+                testLock.unlock();
+            }
+        }));
+    }
+    for (int i = 0; i < writerThreads; ++i) {
+        threads.emplace_back(QThread::create([&] {
+            for (int j = 0; j < iterations / 10; ++j) {
+                testLock.lockForWrite();
+                for (int k = 0; k < maxval; ++k)
+                    QtPrivate::volatilePreIncrement(count);
+                count = 0;
+                testLock.unlock();
+            }
+        }));
+    }
+    for (auto &thread : threads)
+        thread->start();
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    QCOMPARE(errors.loadRelaxed(), 0);
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 
 #include "tst_qreadwritelock.moc"
@@ -8,6 +8,7 @@
 #include <qsemaphore.h>
 
 #include <chrono>
+#include <memory>
 
 using namespace std::chrono_literals;
 
@@ -27,6 +28,7 @@ private slots:
     void producerConsumer();
     void raii();
     void stdCompat();
+    void adaptiveSemaphore();
 };
 
 static QSemaphore *semaphore = nullptr;
@@ -608,5 +610,39 @@ void tst_QSemaphore::stdCompat()
     QCOMPARE(sem.available(), 0);
 }
 
+void tst_QSemaphore::adaptiveSemaphore()
+{
+    QAdaptiveSemaphore sem(1, 1000);
+    QCOMPARE(sem.spinCount(), 1000);
+    sem.setSpinCount(-1);
+    QVERIFY(sem.spinCount() >= 0);
+    sem.setSpinCount(1000);
+
+    QVERIFY(sem.tryAcquire());
+    QVERIFY(!sem.tryAcquire(1, QDeadlineTimer(10ms)));
+    sem.release(2);
+    QCOMPARE(sem.available(), 2);
+    sem.acquire(2);
+    QCOMPARE(sem.available(), 0);
+
+    // ping-pong between two threads
+    constexpr int Iterations = 10000;
+    QAdaptiveSemaphore ping, pong;
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            ping.acquire();
+            pong.release();
+        }
+    }));
+    thread->start();
+    for (int i = 0; i < Iterations; ++i) {
+        ping.release();
+        QVERIFY(pong.tryAcquire(1, QDeadlineTimer(10s)));
+    }
+    QVERIFY(thread->wait());
+    QCOMPARE(ping.available(), 0);
+    QCOMPARE(pong.available(), 0);
+}
+
 QTEST_MAIN(tst_QSemaphore)
 #include "tst_qsemaphore.moc"
@@ -11,11 +11,15 @@
 #include <qstring.h>
 #include <qmutex.h>
 
+#include <functional>
+#include <memory>
+
 #ifdef Q_OS_UNIX
 #include <unistd.h>
 #endif
 
 using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
 
 typedef void (*FunctionPointer)();
 
@@ -88,6 +92,12 @@ private slots:
     void waitForDoneAfterTake();
     void threadReuse();
     void nullFunctions();
+    void workStealingRecursiveStart();
+    void workStealingWaitForDone();
+    void workStealingClear();
+    void workStealingTryTake();
+    void workStealingPriorities();
+    void workStealingToggle();
 
 private:
     QMutex m_functionTestMutex;
@@ -1491,5 +1501,242 @@ void tst_QThreadPool::nullFunctions()
     }
 }
 
+// Counts its runs and its destruction.
+class TrackedRunnable : public QRunnable
+{
+public:
+    TrackedRunnable(QAtomicInt &runs, QAtomicInt &deletions)
+        : runs(runs), deletions(deletions) {}
+    ~TrackedRunnable() override { deletions.ref(); }
+    void run() override { runs.ref(); }
+
+private:
+    QAtomicInt &runs;
+    QAtomicInt &deletions;
+};
+
+void tst_QThreadPool::workStealingRecursiveStart()
+{
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(4);
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+    QVERIFY(threadPool.property("workStealingEnabled").toBool());
+
+    // each task starts two more from the pool's threads, down to the leaves
+    constexpr int Depth = 10;
+    QAtomicInt leaves = 0;
+    QAtomicInt tasks = 0;
+    std::function<void(int)> split = [&](int depth) {
+        tasks.ref();
+        if (depth == 0) {
+            leaves.ref();
+            return;
+        }
+        threadPool.start([&split, depth] { split(depth - 1); });
+        threadPool.start([&split, depth] { split(depth - 1); });
+    };
+    threadPool.start([&split] { split(Depth); });
+
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(leaves.loadRelaxed(), 1 << Depth);
+    QCOMPARE(tasks.loadRelaxed(), (2 << Depth) - 1);
+}
+
+// Runs startChildren in a task of threadPool, which then waits for release.
+// Runnables started with the default priority stay in that thread's queue
+// while no other thread of the pool is idle.
+[[nodiscard]] static bool startFromPoolThread(QThreadPool &threadPool, QSemaphore &release,
+                                              const std::function<void(QThreadPool &)> &startChildren)
+{
+    QSemaphore started;
+    threadPool.start([&] {
+        startChildren(threadPool);
+        started.release();
+        release.acquire();
+    });
+    return started.tryAcquire(1, 10s);
+}
+
+void tst_QThreadPool::workStealingWaitForDone()
+{
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QAtomicInt runs = 0;
+    QAtomicInt deletions = 0;
+    QSemaphore release;
+    const QSemaphoreReleaser releaser(release);
+    QVERIFY(startFromPoolThread(threadPool, release, [&](QThreadPool &pool) {
+        for (int i = 0; i < 100; ++i)
+            pool.start(new TrackedRunnable(runs, deletions));
+    }));
+    QCOMPARE(runs.loadRelaxed(), 0);
+    QVERIFY(!threadPool.waitForDone(100));
+
+    release.release();
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(runs.loadRelaxed(), 100);
+    QCOMPARE(deletions.loadRelaxed(), 100);
+    QCOMPARE(threadPool.activeThreadCount(), 0);
+}
+
+void tst_QThreadPool::workStealingClear()
+{
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QAtomicInt runs = 0;
+    QAtomicInt deletions = 0;
+    QAtomicInt keptRuns = 0;
+    QAtomicInt keptDeletions = 0;
+    auto kept = std::make_unique<TrackedRunnable>(keptRuns, keptDeletions);
+    kept->setAutoDelete(false);
+
+    QSemaphore release;
+    const QSemaphoreReleaser releaser(release);
+    QVERIFY(startFromPoolThread(threadPool, release, [&](QThreadPool &pool) {
+        for (int i = 0; i < 100; ++i)
+            pool.start(new TrackedRunnable(runs, deletions));
+        pool.start(kept.get());
+    }));
+
+    // clear() deletes the auto-deleting runnables of the thread's queue
+    threadPool.clear();
+    QCOMPARE(deletions.loadRelaxed(), 100);
+
+    release.release();
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(runs.loadRelaxed(), 0);
+    QCOMPARE(keptRuns.loadRelaxed(), 0);
+    QCOMPARE(keptDeletions.loadRelaxed(), 0);
+}
+
+void tst_QThreadPool::workStealingTryTake()
+{
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(2);
+    threadPool.setWorkStealingEnabled(true);
+
+    // keep the other thread busy, so that nothing gets stolen
+    QSemaphore release;
+    const QSemaphoreReleaser releaser(release, 2);
+    QSemaphore blockerStarted;
+    threadPool.start([&] {
+        blockerStarted.release();
+        release.acquire();
+    });
+    QVERIFY(blockerStarted.tryAcquire(1, 10s));
+
+    QAtomicInt runs = 0;
+    QAtomicInt deletions = 0;
+    TrackedRunnable taken(runs, deletions);
+    taken.setAutoDelete(false);
+    TrackedRunnable left(runs, deletions);
+    left.setAutoDelete(false);
+    QVERIFY(startFromPoolThread(threadPool, release, [&](QThreadPool &pool) {
+        pool.start(&taken);
+        pool.start(&left);
+    }));
+
+    // the runnables sit in the queue of a pool thread, not of this one
+    QVERIFY(threadPool.tryTake(&taken));
+    QVERIFY(!threadPool.tryTake(&taken));
+
+    release.release(2);
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(runs.loadRelaxed(), 1);
+    QCOMPARE(deletions.loadRelaxed(), 0);
+    QVERIFY(!threadPool.tryTake(&left));
+}
+
+void tst_QThreadPool::workStealingPriorities()
+{
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QMutex mutex;
+    QStringList order;
+    const auto record = [&](const QString &name) {
+        return [&, name] {
+            QMutexLocker locker(&mutex);
+            order << name;
+        };
+    };
+
+    QSemaphore release;
+    const QSemaphoreReleaser releaser(release);
+    QVERIFY(startFromPoolThread(threadPool, release, [&](QThreadPool &pool) {
+        for (int i = 0; i < 3; ++i)
+            pool.start(record(u"local%1"_s.arg(i)));
+    }));
+    threadPool.start(record(u"shared"_s));
+    threadPool.start(record(u"high"_s), 10);
+
+    release.release();
+    WAIT_FOR_DONE(threadPool);
+
+    // the higher priority runnable goes first, the thread's own queue is
+    // run newest first
+    QCOMPARE(order.size(), 5);
+    QCOMPARE(order.first(), u"high"_s);
+    QCOMPARE_LT(order.indexOf(u"local2"_s), order.indexOf(u"local1"_s));
+    QCOMPARE_LT(order.indexOf(u"local1"_s), order.indexOf(u"local0"_s));
+    QVERIFY(order.contains(u"shared"_s));
+}
+
+void tst_QThreadPool::workStealingToggle()
+{
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QAtomicInt runs = 0;
+    QAtomicInt deletions = 0;
+    const auto startTen = [&](QThreadPool &pool) {
+        for (int i = 0; i < 10; ++i)
+            pool.start(new TrackedRunnable(runs, deletions));
+    };
+    {
+        // disabling it hands the thread's queue over to the shared one...
+        QSemaphore release;
+        const QSemaphoreReleaser releaser(release);
+        QVERIFY(startFromPoolThread(threadPool, release, startTen));
+        threadPool.setWorkStealingEnabled(false);
+        QVERIFY(!threadPool.isWorkStealingEnabled());
+
+        // ... where clear() finds them
+        threadPool.clear();
+        QCOMPARE(deletions.loadRelaxed(), 10);
+    }
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(runs.loadRelaxed(), 0);
+
+    {
+        // enabling it leaves the shared queue as it is
+        QSemaphore release;
+        const QSemaphoreReleaser releaser(release);
+        QVERIFY(startFromPoolThread(threadPool, release, startTen));
+        threadPool.setWorkStealingEnabled(true);
+    }
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(runs.loadRelaxed(), 10);
+
+    {
+        QSemaphore release;
+        const QSemaphoreReleaser releaser(release);
+        QVERIFY(startFromPoolThread(threadPool, release, startTen));
+        threadPool.setWorkStealingEnabled(false);
+        threadPool.setWorkStealingEnabled(true);
+    }
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(runs.loadRelaxed(), 20);
+    QCOMPARE(deletions.loadRelaxed(), 30);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
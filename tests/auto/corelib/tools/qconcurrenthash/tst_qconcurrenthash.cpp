@@ -0,0 +1,307 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <qconcurrenthash.h>
+#include <qatomic.h>
+#include <qstring.h>
+#include <qscopeguard.h>
+#include <qthread.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace Qt::StringLiterals;
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void shardCount_data();
+    void shardCount();
+    void insertAndLookup();
+    void remove();
+    void clear();
+    void computeIfAbsent();
+    void snapshot();
+    void forEach();
+    void globalSeedChange();
+    void concurrentInsert();
+    void concurrentComputeIfAbsent();
+    void concurrentReadWrite();
+};
+
+static std::vector<std::unique_ptr<QThread>> startThreads(int count, const std::function<void(int)> &f)
+{
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < count; ++i) {
+        threads.emplace_back(QThread::create(f, i));
+        threads.back()->start();
+    }
+    return threads;
+}
+
+static void joinThreads(std::vector<std::unique_ptr<QThread>> &threads)
+{
+    for (auto &thread : threads)
+        QVERIFY(thread->wait(QDeadlineTimer(60000)));
+}
+
+void tst_QConcurrentHash::shardCount_data()
+{
+    QTest::addColumn<qsizetype>("requested");
+    QTest::addColumn<qsizetype>("expected");
+
+    QTest::newRow("default") << QConcurrentHash<int, int>::DefaultShardCount
+                             << QConcurrentHash<int, int>::DefaultShardCount;
+    QTest::newRow("0") << qsizetype(0) << qsizetype(1);
+    QTest::newRow("1") << qsizetype(1) << qsizetype(1);
+    QTest::newRow("3") << qsizetype(3) << qsizetype(4);
+    QTest::newRow("16") << qsizetype(16) << qsizetype(16);
+    QTest::newRow("too many") << qsizetype(100000) << QConcurrentHash<int, int>::MaxShardCount;
+}
+
+void tst_QConcurrentHash::shardCount()
+{
+    QFETCH(qsizetype, requested);
+    QFETCH(qsizetype, expected);
+
+    QConcurrentHash<int, int> hash(requested);
+    QCOMPARE(hash.shardCount(), expected);
+    QVERIFY(hash.isEmpty());
+
+    // must work with any number of shards
+    for (int i = 0; i < 1000; ++i)
+        QVERIFY(hash.insertOrAssign(i, i * 2));
+    QCOMPARE(hash.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i), i * 2);
+}
+
+void tst_QConcurrentHash::insertAndLookup()
+{
+    QConcurrentHash<QString, int> hash;
+    QVERIFY(!hash.contains(u"a"_s));
+    QCOMPARE(hash.value(u"a"_s), 0);
+    QCOMPARE(hash.value(u"a"_s, -1), -1);
+
+    QVERIFY(hash.insertOrAssign(u"a"_s, 1));
+    QVERIFY(hash.insertOrAssign(u"b"_s, 2));
+    QVERIFY(hash.contains(u"a"_s));
+    QCOMPARE(hash.value(u"a"_s), 1);
+    QCOMPARE(hash.value(u"b"_s, -1), 2);
+    QCOMPARE(hash.size(), 2);
+
+    QVERIFY(!hash.insertOrAssign(u"a"_s, 3));
+    QCOMPARE(hash.value(u"a"_s), 3);
+    QCOMPARE(hash.size(), 2);
+}
+
+void tst_QConcurrentHash::remove()
+{
+    QConcurrentHash<int, QString> hash(4);
+    QVERIFY(!hash.remove(1));
+    for (int i = 0; i < 100; ++i)
+        hash.insertOrAssign(i, QString::number(i));
+
+    for (int i = 0; i < 100; i += 2)
+        QVERIFY(hash.remove(i));
+    QVERIFY(!hash.remove(0));
+    QCOMPARE(hash.size(), 50);
+    for (int i = 0; i < 100; ++i) {
+        QCOMPARE(hash.contains(i), i % 2 == 1);
+        QCOMPARE(hash.value(i), i % 2 ? QString::number(i) : QString());
+    }
+}
+
+void tst_QConcurrentHash::clear()
+{
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insertOrAssign(i, i);
+    QCOMPARE(hash.size(), 100);
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.contains(42));
+    QVERIFY(hash.insertOrAssign(42, 1));
+    QCOMPARE(hash.value(42), 1);
+}
+
+void tst_QConcurrentHash::computeIfAbsent()
+{
+    QConcurrentHash<QString, QString> hash;
+    int calls = 0;
+    const auto factory = [&calls] { ++calls; return u"computed"_s; };
+
+    QCOMPARE(hash.computeIfAbsent(u"key"_s, factory), u"computed"_s);
+    QCOMPARE(calls, 1);
+    QCOMPARE(hash.computeIfAbsent(u"key"_s, factory), u"computed"_s);
+    QCOMPARE(calls, 1);
+
+    hash.insertOrAssign(u"other"_s, u"inserted"_s);
+    QCOMPARE(hash.computeIfAbsent(u"other"_s, factory), u"inserted"_s);
+    QCOMPARE(calls, 1);
+    QCOMPARE(hash.size(), 2);
+}
+
+void tst_QConcurrentHash::snapshot()
+{
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insertOrAssign(i, -i);
+
+    const QHash<int, int> copy = hash.snapshot();
+    QCOMPARE(copy.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(copy.value(i, 1), -i);
+
+    // later changes must not show in the snapshot
+    hash.insertOrAssign(0, 42);
+    hash.insertOrAssign(1000, 1000);
+    hash.remove(1);
+    QCOMPARE(copy.size(), 1000);
+    QCOMPARE(copy.value(0), 0);
+    QVERIFY(!copy.contains(1000));
+    QCOMPARE(copy.value(1), -1);
+    QCOMPARE(hash.value(0), 42);
+    QVERIFY(!hash.contains(1));
+}
+
+void tst_QConcurrentHash::forEach()
+{
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insertOrAssign(i, i);
+
+    qint64 sum = 0;
+    int count = 0;
+    hash.forEach([&](int key, int value) {
+        QCOMPARE(key, value);
+        sum += value;
+        ++count;
+        // no lock is held, so changing the table from the callback is fine
+        hash.insertOrAssign(key + 1000, value);
+    });
+    QCOMPARE(count, 1000);
+    QCOMPARE(sum, 999 * 1000 / 2);
+    QCOMPARE(hash.size(), 2000);
+}
+
+void tst_QConcurrentHash::globalSeedChange()
+{
+    QConcurrentHash<QString, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insertOrAssign(QString::number(i), i);
+
+    // shards created after the change hash with a seed different from the
+    // one used to select the shard
+    QHashSeed::setDeterministicGlobalSeed();
+    const auto cleanup = qScopeGuard([] { QHashSeed::resetRandomGlobalSeed(); });
+    for (int i = 100; i < 1000; ++i)
+        hash.insertOrAssign(QString::number(i), i);
+
+    QCOMPARE(hash.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(QString::number(i), -1), i);
+    for (int i = 0; i < 1000; i += 2)
+        QVERIFY(hash.remove(QString::number(i)));
+    QCOMPARE(hash.size(), 500);
+}
+
+void tst_QConcurrentHash::concurrentInsert()
+{
+    constexpr int ThreadCount = 8;
+    constexpr int PerThread = 5000;
+    QConcurrentHash<int, int> hash;
+    QAtomicInt inserted;
+
+    auto threads = startThreads(ThreadCount, [&](int t) {
+        for (int i = 0; i < PerThread; ++i) {
+            // every key is written by two threads
+            const int key = (t / 2) * PerThread + i;
+            if (hash.insertOrAssign(key, key))
+                inserted.ref();
+        }
+    });
+    joinThreads(threads);
+
+    QCOMPARE(inserted.loadRelaxed(), ThreadCount / 2 * PerThread);
+    QCOMPARE(hash.size(), ThreadCount / 2 * PerThread);
+    for (int key = 0; key < ThreadCount / 2 * PerThread; ++key)
+        QCOMPARE(hash.value(key, -1), key);
+}
+
+void tst_QConcurrentHash::concurrentComputeIfAbsent()
+{
+    constexpr int ThreadCount = 8;
+    constexpr int KeyCount = 1000;
+    QConcurrentHash<QString, int> hash(8);
+    QAtomicInt calls;
+    QAtomicInt failures;
+
+    auto threads = startThreads(ThreadCount, [&](int) {
+        for (int i = 0; i < KeyCount; ++i) {
+            const int value = hash.computeIfAbsent(QString::number(i), [&] {
+                calls.ref();
+                return i;
+            });
+            if (value != i)
+                failures.ref();
+        }
+    });
+    joinThreads(threads);
+
+    QCOMPARE(failures.loadRelaxed(), 0);
+    QCOMPARE(calls.loadRelaxed(), KeyCount);
+    QCOMPARE(hash.size(), KeyCount);
+}
+
+void tst_QConcurrentHash::concurrentReadWrite()
+{
+    constexpr int ThreadCount = 6;
+    constexpr int KeyCount = 512;
+    QConcurrentHash<int, QString> hash(4);
+    for (int i = 0; i < KeyCount; ++i)
+        hash.insertOrAssign(i, QString::number(i));
+
+    QAtomicInt failures;
+    auto threads = startThreads(ThreadCount, [&](int t) {
+        for (int round = 0; round < 20; ++round) {
+            for (int i = 0; i < KeyCount; ++i) {
+                switch (t % 3) {
+                case 0: {   // readers: a value is either absent or correct
+                    const QString v = hash.value(i);
+                    if (!v.isNull() && v != QString::number(i))
+                        failures.ref();
+                    break;
+                }
+                case 1:     // writers
+                    if (i % 2)
+                        hash.remove(i);
+                    else
+                        hash.insertOrAssign(i, QString::number(i));
+                    break;
+                case 2:     // snapshots must be consistent too
+                    if (i % 64 == 0) {
+                        hash.forEach([&](int key, const QString &value) {
+                            if (value != QString::number(key))
+                                failures.ref();
+                        });
+                    } else {
+                        hash.insertOrAssign(i, QString::number(i));
+                    }
+                    break;
+                }
+            }
+        }
+    });
+    joinThreads(threads);
+
+    QCOMPARE(failures.loadRelaxed(), 0);
+    hash.forEach([](int key, const QString &value) { QCOMPARE(value, QString::number(key)); });
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentHash)
+#include "tst_qconcurrenthash.moc"
@@ -2,10 +2,10 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #define QT_USE_QSTRINGBUILDER
-#define QFLATMAP_ENABLE_STL_COMPATIBLE_INSERT
 
 #include <QTest>
 
+#include <qflatmap.h>
 #include <private/qflatmap_p.h>
 #include <qbytearray.h>
 #include <qstring.h>
@@ -50,6 +50,8 @@ private slots:
     void try_emplace_and_insert_or_assign();
     void viewIterators();
     void varLengthArray();
+    void bulkConstruction();
+    void implicitSharing();
 
 private:
     template <typename Compare>
@@ -728,5 +730,43 @@ void tst_QFlatMap::varLengthArray()
     QVERIFY(m.isEmpty());
 }
 
+void tst_QFlatMap::bulkConstruction()
+{
+    using Map = QFlatMap<QString, int>;
+
+    // unsorted, with duplicates: the first occurrence wins
+    const QList<std::pair<QString, int>> items = {
+        { "c", 3 }, { "a", 1 }, { "b", 2 }, { "a", 4 }, { "c", 5 }
+    };
+    const Map map(items.cbegin(), items.cend());
+    QCOMPARE(map.keys(), QStringList({ "a", "b", "c" }));
+    QCOMPARE(map.values(), QList<int>({ 1, 2, 3 }));
+
+    // already sorted, with duplicates
+    const Map sorted(QStringList{ "a", "a", "b", "c" }, QList<int>{ 1, 4, 2, 3 });
+    QCOMPARE(sorted, map);
+
+    // already sorted and unique
+    const Map ordered(Qt::OrderedUniqueRange, QStringList{ "a", "b", "c" }, QList<int>{ 1, 2, 3 });
+    QCOMPARE(ordered, map);
+    QVERIFY(ordered != Map({ { "a", 1 } }));
+}
+
+void tst_QFlatMap::implicitSharing()
+{
+    using Map = QFlatMap<int, QString>;
+    Map map{ { 1, "een" }, { 2, "twee" } };
+    const Map copy = map;
+    QVERIFY(copy.keys().isSharedWith(map.keys()));
+    QVERIFY(copy.values().isSharedWith(map.values()));
+
+    map[3] = "dree";
+    QVERIFY(!copy.keys().isSharedWith(map.keys()));
+    QCOMPARE(copy.size(), 2);
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(copy.value(3), QString());
+    QCOMPARE(map.value(3), "dree");
+}
+
 QTEST_APPLESS_MAIN(tst_QFlatMap)
 #include "tst_qflatmap.moc"
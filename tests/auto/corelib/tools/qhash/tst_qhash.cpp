@@ -66,6 +66,7 @@ private slots:
     void emplace();
 
     void badHashFunction();
+    void clusteredHashes();
     void hashOfHash();
 
     void stdHash();
@@ -2556,6 +2557,62 @@ void tst_QHash::badHashFunction()
 
 }
 
+// Hashes that gather around the end of the first span, so that probing wraps
+// around, with only two different tags
+struct ClusteredKey {
+    int k;
+    ClusteredKey(int i) : k(i) {}
+    bool operator==(const ClusteredKey &other) const
+    {
+        return k == other.k;
+    }
+};
+
+size_t qHash(ClusteredKey key, size_t)
+{
+    return (size_t(key.k % 2) << (std::numeric_limits<size_t>::digits - 1)) | size_t(124 + key.k % 5);
+}
+
+void tst_QHash::clusteredHashes()
+{
+    QHash<ClusteredKey, int> hash;
+    const auto check = [&](int count, auto isErased) {
+        for (int i = 0; i < count; ++i) {
+            if (isErased(i))
+                QVERIFY2(!hash.contains(i), QByteArray::number(i));
+            else
+                QCOMPARE(hash.value(i, -1), i);
+        }
+        for (int i = count; i < count + 20; ++i)
+            QVERIFY(!hash.contains(i));
+    };
+
+    // stays within one span
+    for (int i = 0; i < 60; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), 64);
+    check(60, [](int) { return false; });
+
+    // erasing moves the following entries back, across the end of the span
+    for (int i = 0; i < 60; i += 3)
+        hash.remove(i);
+    QCOMPARE(hash.size(), 40);
+    check(60, [](int i) { return i % 3 == 0; });
+
+    for (int i = 0; i < 60; i += 3)
+        hash.insert(i, i);
+    for (int i = 60; i < 300; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.size(), 300);
+    check(300, [](int) { return false; });
+
+    const QHash<ClusteredKey, int> copy = hash;
+    hash.reserve(1000);
+    for (int i = 0; i < 300; ++i)
+        QCOMPARE(copy.value(i, -1), i);
+    check(300, [](int) { return false; });
+}
+
 void tst_QHash::hashOfHash()
 {
     QHash<int, int> hash;
@@ -76,6 +76,7 @@ private slots:
     void skip();
 
     void readBufferOverflow();
+    void writeVector();
 
     void simpleCommandProtocol1();
     void simpleCommandProtocol2();
@@ -903,6 +904,35 @@ void tst_QLocalSocket::readBufferOverflow()
     QCOMPARE(client.bytesAvailable(), 0);
 }
 
+void tst_QLocalSocket::writeVector()
+{
+    const QString serverName = QLatin1String("writeVectorServer");
+    LocalServer server;
+    QVERIFY(server.listen(serverName));
+
+    LocalSocket client;
+    client.connectToServer(serverName);
+    QVERIFY(server.waitForNewConnection(3000));
+    QCOMPARE(client.state(), QLocalSocket::ConnectedState);
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+
+    QByteArray received;
+    connect(&client, &QLocalSocket::readyRead, this, [&] { received += client.readAll(); });
+
+    QByteArray payload(100000, Qt::Uninitialized);
+    for (qsizetype i = 0; i < payload.size(); ++i)
+        payload[i] = char(i);
+    const QByteArrayList chunks = { "header", payload, QByteArray(), "trailer" };
+
+    QCOMPARE(serverSocket->write(chunks), qint64(payload.size() + 13));
+    QCOMPARE(serverSocket->write(QByteArrayList{ "a", "b" }), qint64(2));
+    const QByteArray expected = chunks.join() + "ab";
+    QTRY_COMPARE(received.size(), expected.size());
+    QCOMPARE(received, expected);
+    QCOMPARE(serverSocket->bytesToWrite(), qint64(0));
+}
+
 static qint64 writeCommand(const QVariant &command, QIODevice *device, int commandCounter)
 {
     QByteArray block;
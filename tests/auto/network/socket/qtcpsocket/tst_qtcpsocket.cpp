@@ -176,6 +176,10 @@ private slots:
     void serverDisconnectWithBuffered();
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
+    void writeByteArrayList_data();
+    void writeByteArrayList();
+    void writeByteArrayListPartially_data() { writeByteArrayList_data(); }
+    void writeByteArrayListPartially();
     void readNotificationsAfterBind();
 
 protected slots:
@@ -3196,6 +3200,109 @@ void tst_QTcpSocket::writeOnReadBufferOverflow()
     delete socket;
 }
 
+void tst_QTcpSocket::writeByteArrayList_data()
+{
+    QTest::addColumn<bool>("unbuffered");
+
+    QTest::newRow("buffered") << false;
+    QTest::newRow("unbuffered") << true;
+}
+
+void tst_QTcpSocket::writeByteArrayList()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(bool, unbuffered);
+
+    QTcpServer tcpServer;
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort(),
+                          unbuffered ? QIODevice::ReadWrite | QIODevice::Unbuffered
+                                     : QIODevice::ReadWrite);
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    std::unique_ptr<QTcpSocket> peer(tcpServer.nextPendingConnection());
+    QVERIFY(peer);
+
+    qint64 bytesWritten = 0;
+    connect(socket.get(), &QIODevice::bytesWritten, this, [&](qint64 bytes) { bytesWritten += bytes; });
+
+    const QByteArrayList data = { "header", QByteArray(1000, 'x'), QByteArray(), "trailer" };
+    const QByteArray expected = data.join();
+    QCOMPARE(socket->write(data), expected.size());
+    QCOMPARE(socket->write(QByteArrayList()), Q_INT64_C(0));
+    QCOMPARE(socket->write(QByteArrayList{ QByteArray(), QByteArray() }), Q_INT64_C(0));
+    QCOMPARE(socket->write(QByteArrayList{ "end" }), Q_INT64_C(3));
+
+    QByteArray received;
+    connect(peer.get(), &QIODevice::readyRead, this, [&] { received += peer->readAll(); });
+    QTRY_COMPARE(received, expected + "end");
+    QCOMPARE(socket->bytesToWrite(), Q_INT64_C(0));
+    // Data that an unbuffered socket sends right away is not reported, as
+    // with write(const char *, qint64).
+    if (!unbuffered)
+        QCOMPARE(bytesWritten, expected.size() + 3);
+    else
+        QCOMPARE_LE(bytesWritten, expected.size() + 3);
+}
+
+void tst_QTcpSocket::writeByteArrayListPartially()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(bool, unbuffered);
+
+    QTcpServer tcpServer;
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort(),
+                          unbuffered ? QIODevice::ReadWrite | QIODevice::Unbuffered
+                                     : QIODevice::ReadWrite);
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    std::unique_ptr<QTcpSocket> peer(tcpServer.nextPendingConnection());
+    QVERIFY(peer);
+    // a slow reader, which stops reading once it holds 64 KiB
+    peer->setReadBufferSize(64 * 1024);
+
+    qint64 bytesWritten = 0;
+    connect(socket.get(), &QIODevice::bytesWritten, this, [&](qint64 bytes) { bytesWritten += bytes; });
+
+    // More than the kernel buffers on both ends hold, so some of it has to
+    // wait in the socket's write buffer. Every chunk has its own contents,
+    // to detect reordering.
+    QByteArrayList data;
+    for (int i = 0; i < 256; ++i)
+        data.append(QByteArray(64 * 1024 - i, char(i)));
+    const QByteArray expected = data.join();
+    QCOMPARE(socket->write(data), expected.size());
+
+    const qint64 pending = socket->bytesToWrite();
+    QCOMPARE_GT(pending, Q_INT64_C(0));
+    QCOMPARE_LT(pending, expected.size() + 1);
+    if (!unbuffered)
+        QCOMPARE(pending, expected.size());
+
+    QByteArray received;
+    QTest::qWait(100);
+    QCOMPARE_GT(socket->bytesToWrite(), Q_INT64_C(0));
+    received += peer->read(1024);
+
+    connect(peer.get(), &QIODevice::readyRead, this, [&] { received += peer->readAll(); });
+    peer->setReadBufferSize(0);
+    received += peer->readAll();
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), expected.size(), 30000);
+    QVERIFY(received == expected);
+    QCOMPARE(socket->bytesToWrite(), Q_INT64_C(0));
+    // Only the buffered part is reported, as with write(const char *, qint64).
+    QCOMPARE(bytesWritten, pending);
+}
+
 // Test that the socket does not enable the read notifications in bind()
 void tst_QTcpSocket::readNotificationsAfterBind()
 {
@@ -0,0 +1,149 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <qcborarray.h>
+#include <qcborlazydocument.h>
+#include <qcbormap.h>
+#include <qcborvalue.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_bench_QCborValue : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void parseLarge();
+    void openLargeLazy();
+    void readFieldsLarge();
+    void readFieldsLargeLazy();
+    void iterateLarge();
+    void iterateLargeLazy();
+    void findStringLarge();
+    void findStringLargeLazy();
+
+private:
+    QByteArray largeCbor;
+};
+
+void tst_bench_QCborValue::initTestCase()
+{
+    // The same records as tst_bench_qtjson's large document: a few fields
+    // around a large array, with the one read last after the array.
+    QCborArray items;
+    for (int i = 0; i < 50000; ++i) {
+        items.append(QCborMap{
+            { u"id"_s, i },
+            { u"name"_s, u"item "_s + QString::number(i) },
+            { u"description"_s,
+              u"A \"quoted\" description of the item, long enough to be realistic"_s },
+            { u"price"_s, i * 0.25 },
+            { u"tags"_s, QCborArray{ u"alpha"_s, u"beta"_s, u"gamma"_s } },
+            { u"available"_s, true },
+            { u"dimensions"_s, QCborMap{ { u"width"_s, 1.5 }, { u"height"_s, 20 },
+                                         { u"depth"_s, nullptr } } },
+        });
+    }
+    const QCborMap document = {
+        { u"status"_s, u"ok"_s },
+        { u"count"_s, 50000 },
+        { u"items"_s, items },
+        { u"next"_s, u"cursor-50000"_s },
+    };
+    largeCbor = QCborValue(document).toCbor();
+}
+
+void tst_bench_QCborValue::parseLarge()
+{
+    QBENCHMARK {
+        const QCborValue value = QCborValue::fromCbor(largeCbor);
+        QVERIFY(value.isMap());
+    }
+}
+
+void tst_bench_QCborValue::openLargeLazy()
+{
+    QBENCHMARK {
+        const QCborLazyDocument doc = QCborLazyDocument::fromCbor(largeCbor);
+        QVERIFY(doc.root().isMap());
+    }
+}
+
+void tst_bench_QCborValue::readFieldsLarge()
+{
+    QBENCHMARK {
+        const QCborMap map = QCborValue::fromCbor(largeCbor).toMap();
+        QCOMPARE(map[u"status"_s].toString(), u"ok");
+        QCOMPARE(map[u"count"_s].toInteger(), 50000);
+        QCOMPARE(map[u"next"_s].toString(), u"cursor-50000");
+    }
+}
+
+void tst_bench_QCborValue::readFieldsLargeLazy()
+{
+    QBENCHMARK {
+        const QCborLazyDocument doc = QCborLazyDocument::fromCbor(largeCbor);
+        QVERIFY(doc["status"].toStringView() == "ok");
+        QCOMPARE(doc["count"].toInteger(), 50000);
+        QVERIFY(doc["next"].toStringView() == "cursor-50000");
+    }
+}
+
+void tst_bench_QCborValue::iterateLarge()
+{
+    QBENCHMARK {
+        const QCborArray items = QCborValue::fromCbor(largeCbor)[u"items"_s].toArray();
+        double total = 0;
+        for (const QCborValue item : items)
+            total += item[u"price"_s].toDouble();
+        QCOMPARE(total, 0.25 * 49999 * 50000 / 2);
+    }
+}
+
+void tst_bench_QCborValue::iterateLargeLazy()
+{
+    QBENCHMARK {
+        const QCborLazyDocument doc = QCborLazyDocument::fromCbor(largeCbor);
+        double total = 0;
+        for (const QCborLazyValue item : doc["items"])
+            total += item["price"].toDouble();
+        QCOMPARE(total, 0.25 * 49999 * 50000 / 2);
+    }
+}
+
+void tst_bench_QCborValue::findStringLarge()
+{
+    QBENCHMARK {
+        const QCborArray items = QCborValue::fromCbor(largeCbor)[u"items"_s].toArray();
+        qint64 id = -1;
+        for (const QCborValue item : items) {
+            if (item[u"name"_s].toString() == u"item 49999") {
+                id = item[u"id"_s].toInteger();
+                break;
+            }
+        }
+        QCOMPARE(id, 49999);
+    }
+}
+
+void tst_bench_QCborValue::findStringLargeLazy()
+{
+    QBENCHMARK {
+        const QCborLazyDocument doc = QCborLazyDocument::fromCbor(largeCbor);
+        qint64 id = -1;
+        for (const QCborLazyValue item : doc["items"]) {
+            if (item["name"].toStringView() == "item 49999") {
+                id = item["id"].toInteger();
+                break;
+            }
+        }
+        QCOMPARE(id, 49999);
+    }
+}
+
+QTEST_MAIN(tst_bench_QCborValue)
+
+#include "tst_bench_qcborvalue.moc"
@@ -3,6 +3,7 @@
 #include <QDebug>
 #include <QDirIterator>
 #include <QString>
+#include <QTemporaryDir>
 #include <qplatformdefs.h>
 
 #ifdef Q_OS_WIN
@@ -37,6 +38,11 @@ private slots:
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
     void stdRecursiveDirectoryIterator_data() { data(); }
+    void traversal_data();
+    void traversal();
+
+private:
+    QTemporaryDir generatedTree;
 };
 
 void tst_QDirIterator::data()
@@ -232,6 +238,68 @@ void tst_QDirIterator::stdRecursiveDirectoryIterator()
 #endif
 }
 
+static void generateTree(const QString &path, int depth)
+{
+    QDir().mkpath(path);
+    for (int i = 0; i < 100; ++i) {
+        QFile file(path + "/file" + QString::number(i));
+        file.open(QIODevice::WriteOnly);
+    }
+    if (depth < 3) {
+        for (int i = 0; i < 8; ++i)
+            generateTree(path + "/dir" + QString::number(i), depth + 1);
+    }
+}
+
+void tst_QDirIterator::traversal_data()
+{
+    QTest::addColumn<QString>("dirpath");
+    QTest::addColumn<QDirIterator::IteratorFlags>("flags");
+    QTest::addColumn<bool>("readSize");
+
+    // 585 directories of 100 files each
+    QVERIFY(generatedTree.isValid());
+    const QString tree = generatedTree.path() + "/tree";
+    if (!QFileInfo::exists(tree))
+        generateTree(tree, 0);
+
+    const struct {
+        const char *name;
+        QDirIterator::IteratorFlags flags;
+    } modes[] = {
+        { "sequential", QDirIterator::Subdirectories },
+        { "parallel", QDirIterator::Subdirectories | QDirIterator::ParallelTraversal },
+        { "parallel-unordered", QDirIterator::Subdirectories | QDirIterator::ParallelTraversal
+                                | QDirIterator::UnorderedResults },
+    };
+    for (const auto &mode : modes) {
+        QTest::addRow("tree-%s", mode.name) << tree << mode.flags << false;
+        QTest::addRow("tree-size-%s", mode.name) << tree << mode.flags << true;
+    }
+}
+
+void tst_QDirIterator::traversal()
+{
+    QFETCH(QString, dirpath);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(bool, readSize);
+
+    int count = 0;
+    qint64 size = 0;
+    QBENCHMARK {
+        count = 0;
+        QDirIterator it(dirpath, QDir::Files, flags);
+        while (it.hasNext()) {
+            const QFileInfo fi = it.nextFileInfo();
+            if (readSize)
+                size += fi.size();
+            ++count;
+        }
+    }
+    QCOMPARE(count, 58500);
+    Q_UNUSED(size);
+}
+
 QTEST_MAIN(tst_QDirIterator)
 
 #include "tst_bench_qdiriterator.moc"
@@ -81,6 +81,9 @@ private slots:
     void readBigFile_posix() { readBigFile(); }
     void readBigFile_Win32() { readBigFile(); }
 
+    void writeMessages_data();
+    void writeMessages();
+
 private:
     void readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -588,6 +591,57 @@ void tst_qfile::readSmallFiles()
     }
 }
 
+void tst_qfile::writeMessages_data()
+{
+    QTest::addColumn<bool>("vectored");
+    QTest::addColumn<QIODevice::OpenMode>("mode");
+    QTest::addColumn<int>("payloadSize");
+
+    for (int payloadSize : { 64, 4096, 65536 }) {
+        for (bool unbuffered : { false, true }) {
+            const QIODevice::OpenMode mode = unbuffered
+                    ? QIODevice::WriteOnly | QIODevice::Unbuffered : QIODevice::WriteOnly;
+            const QByteArray name = QByteArray::number(payloadSize)
+                    + (unbuffered ? "-unbuffered" : "-buffered");
+            QTest::addRow("%s-write", name.constData()) << false << mode << payloadSize;
+            QTest::addRow("%s-vectored", name.constData()) << true << mode << payloadSize;
+        }
+    }
+}
+
+// A header, a payload and a trailer for each message, as protocol encoders
+// write them.
+void tst_qfile::writeMessages()
+{
+    QFETCH(bool, vectored);
+    QFETCH(QIODevice::OpenMode, mode);
+    QFETCH(int, payloadSize);
+
+    const QByteArray header(8, 'h');
+    const QByteArray payload(payloadSize, 'p');
+    const QByteArray trailer(4, 't');
+    const int count = 1000;
+
+    QTemporaryFile tmp;
+    QVERIFY(tmp.open());
+    QFile file(tmp.fileName());
+
+    QBENCHMARK {
+        QVERIFY(file.open(mode | QIODevice::Truncate));
+        for (int i = 0; i < count; ++i) {
+            if (vectored) {
+                file.write({ header, payload, trailer });
+            } else {
+                file.write(header);
+                file.write(payload);
+                file.write(trailer);
+            }
+        }
+        file.close();
+    }
+    QCOMPARE(file.size(), qint64(count) * (header.size() + payload.size() + trailer.size()));
+}
+
 QTEST_MAIN(tst_qfile)
 
 #include "tst_bench_qfile.moc"
@@ -6,6 +6,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFileInfo>
 #include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
 
 #include "private/qfsfileengine_p.h"
 #include "../../../../shared/filesystem.h"
@@ -16,6 +17,8 @@ class tst_QFileInfo : public QObject
 private slots:
     void existsTemporary();
     void existsStatic();
+    void repeatedLookups_data();
+    void repeatedLookups();
 #if defined(Q_OS_WIN)
     void symLinkTargetPerformanceLNK();
     void junctionTargetPerformanceMountpoint();
@@ -34,6 +37,43 @@ void tst_QFileInfo::existsStatic()
     QBENCHMARK { QFileInfo::exists(appPath); }
 }
 
+void tst_QFileInfo::repeatedLookups_data()
+{
+    QTest::addColumn<int>("fileCount");
+    QTest::newRow("10") << 10;
+    QTest::newRow("1000") << 1000;
+}
+
+// What build tools do: stat the same set of inputs, some of them missing, over
+// and over. Run with QT_FILESYSTEM_METADATA_CACHE=1 to measure the process-wide
+// metadata cache.
+void tst_QFileInfo::repeatedLookups()
+{
+    QFETCH(int, fileCount);
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString root = QFileInfo(dir.path()).canonicalFilePath();
+    QStringList fileNames;
+    for (int i = 0; i < fileCount; ++i) {
+        fileNames << root + QLatin1StringView("/file") + QString::number(i);
+        if (i % 4)
+            continue;
+        QFile file(fileNames.last());
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("data");
+    }
+
+    QBENCHMARK {
+        for (const QString &fileName : std::as_const(fileNames)) {
+            const QFileInfo info(fileName);
+            if (info.exists()) {
+                [[maybe_unused]] const qint64 size = info.size();
+                [[maybe_unused]] const QDateTime modified = info.lastModified();
+            }
+        }
+    }
+}
+
 #if defined(Q_OS_WIN)
 void tst_QFileInfo::symLinkTargetPerformanceLNK()
 {
@@ -3,8 +3,15 @@
 
 #include <QTest>
 #include <QVariantMap>
+#include <qbuffer.h>
+#include <qjsonarray.h>
 #include <qjsondocument.h>
+#include <qjsonlazydocument.h>
 #include <qjsonobject.h>
+#include <qjsonstreamreader.h>
+#include <qjsonstreamwriter.h>
+
+using namespace Qt::StringLiterals;
 
 class BenchmarkQtJson: public QObject
 {
@@ -24,6 +31,20 @@ private Q_SLOTS:
 
     void jsonObjectInsert();
     void variantMapInsert();
+
+    void parseLarge();
+    void indexLargeLazy();
+    void readFieldsLarge();
+    void readFieldsLargeLazy();
+    void iterateLarge();
+    void iterateLargeLazy();
+    void iterateLargeStream();
+    void iterateLargeStreamElements();
+    void writeLarge();
+    void writeLargeStream();
+
+private:
+    QByteArray largeJson;
 };
 
 BenchmarkQtJson::BenchmarkQtJson(QObject *parent) : QObject(parent)
@@ -33,7 +54,21 @@ BenchmarkQtJson::BenchmarkQtJson(QObject *parent) : QObject(parent)
 
 void BenchmarkQtJson::initTestCase()
 {
-
+    // An API response of about 11 MB: a few fields around a large array of
+    // records, with the one read last after the array.
+    largeJson = "{\"status\": \"ok\", \"count\": 50000, \"items\": [";
+    for (int i = 0; i < 50000; ++i) {
+        if (i)
+            largeJson += ',';
+        largeJson += "\n  {\"id\": " + QByteArray::number(i)
+                + ", \"name\": \"item " + QByteArray::number(i)
+                + "\", \"description\": \"A \\\"quoted\\\" description of the item, "
+                  "long enough to be realistic\", \"price\": "
+                + QByteArray::number(i * 0.25, 'f', 2)
+                + ", \"tags\": [\"alpha\", \"beta\", \"gamma\"], \"available\": true, "
+                  "\"dimensions\": {\"width\": 1.5, \"height\": 20, \"depth\": null}}";
+    }
+    largeJson += "],\n\"next\": \"cursor-50000\"}";
 }
 
 void BenchmarkQtJson::cleanupTestCase()
@@ -117,6 +152,153 @@ void BenchmarkQtJson::variantMapInsert()
     }
 }
 
+void BenchmarkQtJson::parseLarge()
+{
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(largeJson);
+        QVERIFY(doc.isObject());
+    }
+}
+
+void BenchmarkQtJson::indexLargeLazy()
+{
+    QBENCHMARK {
+        QJsonLazyDocument doc = QJsonLazyDocument::fromJson(largeJson);
+        QVERIFY(doc.isObject());
+    }
+}
+
+void BenchmarkQtJson::readFieldsLarge()
+{
+    QBENCHMARK {
+        const QJsonObject object = QJsonDocument::fromJson(largeJson).object();
+        QCOMPARE(object["status"].toString(), u"ok");
+        QCOMPARE(object["count"].toInt(), 50000);
+        QCOMPARE(object["next"].toString(), u"cursor-50000");
+    }
+}
+
+void BenchmarkQtJson::readFieldsLargeLazy()
+{
+    QBENCHMARK {
+        const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(largeJson);
+        QCOMPARE(doc["status"].toString(), u"ok");
+        QCOMPARE(doc["count"].toInt(), 50000);
+        QCOMPARE(doc["next"].toString(), u"cursor-50000");
+    }
+}
+
+void BenchmarkQtJson::iterateLarge()
+{
+    QBENCHMARK {
+        const QJsonArray items = QJsonDocument::fromJson(largeJson)["items"].toArray();
+        double total = 0;
+        for (const QJsonValue item : items)
+            total += item["price"].toDouble();
+        QCOMPARE(total, 0.25 * 49999 * 50000 / 2);
+    }
+}
+
+void BenchmarkQtJson::iterateLargeLazy()
+{
+    QBENCHMARK {
+        const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(largeJson);
+        double total = 0;
+        for (const QJsonLazyValue item : doc["items"])
+            total += item["price"].toDouble();
+        QCOMPARE(total, 0.25 * 49999 * 50000 / 2);
+    }
+}
+
+void BenchmarkQtJson::iterateLargeStream()
+{
+    QBENCHMARK {
+        QBuffer buffer(&largeJson);
+        buffer.open(QIODevice::ReadOnly);
+        QJsonStreamReader reader(&buffer);
+        double total = 0;
+        reader.enterContainer();
+        while (reader.hasNext()) {
+            if (reader.readString() != u"items") {
+                reader.next();
+                continue;
+            }
+            reader.enterContainer();
+            while (reader.hasNext())
+                total += reader.readValue()["price"].toDouble();
+            reader.leaveContainer();
+        }
+        QVERIFY(reader.leaveContainer());
+        QCOMPARE(total, 0.25 * 49999 * 50000 / 2);
+    }
+}
+
+void BenchmarkQtJson::iterateLargeStreamElements()
+{
+    QBENCHMARK {
+        QBuffer buffer(&largeJson);
+        buffer.open(QIODevice::ReadOnly);
+        QJsonStreamReader reader(&buffer);
+        double total = 0;
+        reader.enterContainer();
+        while (reader.hasNext()) {
+            if (reader.readString() != u"items") {
+                reader.next();
+                continue;
+            }
+            reader.enterContainer();
+            while (reader.hasNext()) {
+                reader.enterContainer();
+                while (reader.hasNext()) {
+                    if (reader.readString() == u"price")
+                        total += reader.toDouble();
+                    reader.next();
+                }
+                reader.leaveContainer();
+            }
+            reader.leaveContainer();
+        }
+        QVERIFY(reader.leaveContainer());
+        QCOMPARE(total, 0.25 * 49999 * 50000 / 2);
+    }
+}
+
+void BenchmarkQtJson::writeLarge()
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(largeJson);
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        buffer.write(doc.toJson(QJsonDocument::Compact));
+        QVERIFY(buffer.size() > 0);
+    }
+}
+
+void BenchmarkQtJson::writeLargeStream()
+{
+    const QJsonArray items = QJsonDocument::fromJson(largeJson)["items"].toArray();
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QJsonStreamWriter writer(&buffer);
+        writer.setFormat(QJsonDocument::Compact);
+        writer.startObject();
+        writer.append(u"status"_s);
+        writer.append(u"ok"_s);
+        writer.append(u"count"_s);
+        writer.append(50000);
+        writer.append(u"items"_s);
+        writer.startArray();
+        for (const QJsonValue item : items)
+            writer.append(item);
+        writer.endArray();
+        writer.append(u"next"_s);
+        writer.append(u"cursor-50000"_s);
+        writer.endObject();
+        QVERIFY(buffer.size() > 0);
+    }
+}
+
 QTEST_MAIN(BenchmarkQtJson)
 #include "tst_bench_qtjson.moc"
 
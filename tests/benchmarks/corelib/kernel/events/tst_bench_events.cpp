@@ -5,6 +5,9 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#include <memory>
+#include <vector>
+
 class PingPong : public QObject
 {
 public:
@@ -58,6 +61,25 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+class EventCounter : public QObject
+{
+public:
+    void expect(int count) { m_remaining = count; }
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() != QEvent::User)
+            return QObject::event(e);
+        if (--m_remaining == 0)
+            QTestEventLoop::instance().exitLoop();
+        return true;
+    }
+
+private:
+    int m_remaining = 0;
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -71,6 +93,8 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void postEventFromThreads_data();
+    void postEventFromThreads();
 };
 
 void EventsBench::initTestCase()
@@ -145,6 +169,38 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::postEventFromThreads_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::newRow("1 producer") << 1;
+    QTest::newRow("2 producers") << 2;
+    QTest::newRow("4 producers") << 4;
+    QTest::newRow("8 producers") << 8;
+}
+
+void EventsBench::postEventFromThreads()
+{
+    QFETCH(int, producers);
+    const int eventsPerProducer = 100000;
+    EventCounter counter;
+
+    QBENCHMARK {
+        counter.expect(producers * eventsPerProducer);
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < producers; ++i) {
+            threads.emplace_back(QThread::create([&counter] {
+                for (int j = 0; j < eventsPerProducer; ++j)
+                    QCoreApplication::postEvent(&counter, new QEvent(QEvent::User));
+            }));
+            threads.back()->start();
+        }
+        QTestEventLoop::instance().enterLoop(60);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "tst_bench_events.moc"
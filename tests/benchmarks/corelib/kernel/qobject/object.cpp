@@ -28,3 +28,9 @@ void Object::slot8()
 { }
 void Object::slot9()
 { }
+void Object::intSlot(int)
+{ }
+void Object::intDoubleSlot(int, double)
+{ }
+void Object::intDoubleStringSlot(int, double, const QString &)
+{ }
@@ -22,6 +22,9 @@ signals:
     void signal7();
     void signal8();
     void signal9();
+    void intSignal(int);
+    void intDoubleSignal(int, double);
+    void intDoubleStringSignal(int, double, const QString &);
 public slots:
     void slot0();
     void slot1();
@@ -33,6 +36,9 @@ public slots:
     void slot7();
     void slot8();
     void slot9();
+    void intSlot(int);
+    void intDoubleSlot(int, double);
+    void intDoubleStringSlot(int, double, const QString &);
 };
 
 #endif // OBJECT_H
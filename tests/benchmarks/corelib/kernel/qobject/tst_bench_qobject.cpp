@@ -4,9 +4,30 @@
 #include <QtWidgets/QTreeView>
 #include <qtest.h>
 #include "object.h"
+#include <private/qobject_p.h>
 #include <qcoreapplication.h>
 #include <qdatetime.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// count the allocations of the whole process, to see what queued calls cost
+static std::atomic<qint64> allocationCount = 0;
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
 enum {
     CreationDeletionBenckmarkConstant = 34567,
     SignalsAndSlotsBenchmarkConstant = 456789
@@ -26,6 +47,14 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void queued_signal_benchmark_data();
+    void queued_signal_benchmark();
+    void queued_signal_allocations_data();
+    void queued_signal_allocations();
+    void object_lifecycle_data();
+    void object_lifecycle();
+    void object_lifecycle_allocations_data();
+    void object_lifecycle_allocations();
 
     void stdAllocator();
 };
@@ -280,6 +309,184 @@ void tst_QObject::receiver_destroyed_benchmark()
     }
 }
 
+void tst_QObject::queued_signal_benchmark_data()
+{
+    QTest::addColumn<int>("arguments");
+    QTest::newRow("()") << 0;
+    QTest::newRow("(int)") << 1;
+    QTest::newRow("(int, double)") << 2;
+    QTest::newRow("(int, double, QString)") << 3;
+}
+
+static void connectQueued(Object *sender, Object *receiver, int arguments)
+{
+    switch (arguments) {
+    case 0:
+        QObject::connect(sender, &Object::signal0, receiver, &Object::slot0, Qt::QueuedConnection);
+        break;
+    case 1:
+        QObject::connect(sender, &Object::intSignal, receiver, &Object::intSlot,
+                         Qt::QueuedConnection);
+        break;
+    case 2:
+        QObject::connect(sender, &Object::intDoubleSignal, receiver, &Object::intDoubleSlot,
+                         Qt::QueuedConnection);
+        break;
+    case 3:
+        QObject::connect(sender, &Object::intDoubleStringSignal, receiver,
+                         &Object::intDoubleStringSlot, Qt::QueuedConnection);
+        break;
+    }
+}
+
+// Emits count signals, delivering them every burst emissions.
+static void emitQueued(Object *sender, int arguments, int count, int burst)
+{
+    const QString string = QStringLiteral("string");
+    for (int i = 0; i < count; ++i) {
+        switch (arguments) {
+        case 0:
+            emit sender->signal0();
+            break;
+        case 1:
+            emit sender->intSignal(i);
+            break;
+        case 2:
+            emit sender->intDoubleSignal(i, 0.5);
+            break;
+        case 3:
+            emit sender->intDoubleStringSignal(i, 0.5, string);
+            break;
+        }
+        if ((i + 1) % burst == 0)
+            QCoreApplication::processEvents();
+    }
+    QCoreApplication::processEvents();
+}
+
+void tst_QObject::queued_signal_benchmark()
+{
+    QFETCH(int, arguments);
+    Object sender;
+    Object receiver;
+    connectQueued(&sender, &receiver, arguments);
+
+    QBENCHMARK {
+        emitQueued(&sender, arguments, 1000, 1000);
+    }
+}
+
+void tst_QObject::queued_signal_allocations_data()
+{
+    // the per-thread free list of QMetaCallEvent holds 32 events, so bursts
+    // of up to 32 emissions are delivered without allocating
+    QTest::addColumn<int>("arguments");
+    QTest::addColumn<int>("burst");
+    const char *signatures[] = { "()", "(int)", "(int, double)", "(int, double, QString)" };
+    for (int arguments = 0; arguments < 4; ++arguments) {
+        for (int burst : { 1, 32, 1000 })
+            QTest::addRow("%s, burst %d", signatures[arguments], burst) << arguments << burst;
+    }
+}
+
+void tst_QObject::queued_signal_allocations()
+{
+    QFETCH(int, arguments);
+    QFETCH(int, burst);
+    Object sender;
+    Object receiver;
+    connectQueued(&sender, &receiver, arguments);
+
+    // warm up, so that only the allocations per call are counted
+    emitQueued(&sender, arguments, 1000, burst);
+
+    const int count = 1000;
+    const qint64 before = allocationCount.load();
+    emitQueued(&sender, arguments, count, burst);
+    const qint64 allocations = allocationCount.load() - before;
+    QTest::setBenchmarkResult(qreal(allocations) / count, QTest::Events);
+}
+
+enum ObjectLifecycle { CreateDestroy, CreateConnectDestroy, CreateChildrenDestroy };
+
+void tst_QObject::object_lifecycle_data()
+{
+    QTest::addColumn<bool>("pool");
+    QTest::addColumn<int>("lifecycle");
+    for (bool pool : { false, true }) {
+        const char *suffix = pool ? "pool" : "no pool";
+        QTest::addRow("create/destroy, %s", suffix) << pool << int(CreateDestroy);
+        QTest::addRow("create/connect/destroy, %s", suffix) << pool << int(CreateConnectDestroy);
+        QTest::addRow("create children/destroy, %s", suffix) << pool << int(CreateChildrenDestroy);
+    }
+}
+
+static void runObjectLifecycle(ObjectLifecycle lifecycle, int count)
+{
+    switch (lifecycle) {
+    case CreateDestroy:
+        for (int i = 0; i < count; ++i)
+            delete new Object;
+        break;
+    case CreateConnectDestroy: {
+        Object sender;
+        for (int i = 0; i < count; ++i) {
+            Object receiver;
+            QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0);
+            QObject::connect(&receiver, &Object::signal1, &sender, &Object::slot1);
+        }
+        break;
+    }
+    case CreateChildrenDestroy: {
+        constexpr int Children = 100;
+        for (int i = 0; i < count / Children; ++i) {
+            QObject parent;
+            for (int j = 0; j < Children; ++j)
+                new QObject(&parent);
+        }
+        break;
+    }
+    }
+}
+
+void tst_QObject::object_lifecycle()
+{
+    QFETCH(bool, pool);
+    QFETCH(int, lifecycle);
+    const bool wasEnabled = QObjectAllocationPool::isEnabled();
+    QObjectAllocationPool::setEnabled(pool);
+
+    QBENCHMARK {
+        runObjectLifecycle(ObjectLifecycle(lifecycle), 1000000);
+    }
+
+    QObjectAllocationPool::setEnabled(wasEnabled);
+}
+
+void tst_QObject::object_lifecycle_allocations_data()
+{
+    object_lifecycle_data();
+}
+
+void tst_QObject::object_lifecycle_allocations()
+{
+    QFETCH(bool, pool);
+    QFETCH(int, lifecycle);
+    const bool wasEnabled = QObjectAllocationPool::isEnabled();
+    QObjectAllocationPool::setEnabled(pool);
+
+    // warm up, so that only the allocations in steady state are counted
+    runObjectLifecycle(ObjectLifecycle(lifecycle), 1000);
+
+    const int count = 100000;
+    const qint64 before = allocationCount.load();
+    runObjectLifecycle(ObjectLifecycle(lifecycle), count);
+    const qint64 allocations = allocationCount.load() - before;
+    QTest::setBenchmarkResult(qreal(allocations) / count, QTest::Events);
+
+    QObjectAllocationPool::setEnabled(wasEnabled);
+}
+
 QTEST_MAIN(tst_QObject)
 
 #include "tst_bench_qobject.moc"
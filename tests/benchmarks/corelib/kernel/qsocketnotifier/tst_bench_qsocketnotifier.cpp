@@ -0,0 +1,134 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qsocketnotifier.h>
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// Measures the per-wakeup cost of the event dispatcher as a function of the
+// number of idle socket notifiers. On Linux, run once as is and once with
+// QT_EVENT_DISPATCHER_EPOLL=1 (and QT_NO_GLIB=1) to compare the poll() and
+// epoll() backends of QEventDispatcherUNIX.
+
+class tst_QSocketNotifier : public QObject
+{
+    Q_OBJECT
+private slots:
+    void activateOne_data();
+    void activateOne();
+    void toggleAll_data();
+    void toggleAll();
+
+private:
+    struct Pipe
+    {
+        int fds[2] = { -1, -1 };
+        std::unique_ptr<QSocketNotifier> notifier;
+        ~Pipe()
+        {
+            notifier.reset();
+            for (int fd : fds) {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        }
+    };
+
+    static bool createPipes(std::vector<Pipe> &pipes, int count);
+};
+
+bool tst_QSocketNotifier::createPipes(std::vector<Pipe> &pipes, int count)
+{
+    rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY
+            && limit.rlim_cur < rlim_t(2 * count + 64)) {
+        limit.rlim_cur = qMin(limit.rlim_max, rlim_t(2 * count + 64));
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+        if (limit.rlim_cur < rlim_t(2 * count + 64))
+            return false;
+    }
+
+    pipes = std::vector<Pipe>(count);
+    for (Pipe &p : pipes) {
+        if (::pipe(p.fds) != 0)
+            return false;
+        ::fcntl(p.fds[0], F_SETFL, O_NONBLOCK);
+        p.notifier.reset(new QSocketNotifier(p.fds[0], QSocketNotifier::Read));
+    }
+    return true;
+}
+
+void tst_QSocketNotifier::activateOne_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("1") << 1;
+    QTest::newRow("16") << 16;
+    QTest::newRow("256") << 256;
+    QTest::newRow("4096") << 4096;
+    QTest::newRow("16384") << 16384;
+}
+
+// One notifier becomes ready per event loop iteration, while all others stay idle.
+void tst_QSocketNotifier::activateOne()
+{
+    QFETCH(int, count);
+
+    std::vector<Pipe> pipes;
+    if (!createPipes(pipes, count))
+        QSKIP("Not enough file descriptors available");
+
+    int activations = 0;
+    for (Pipe &p : pipes) {
+        connect(p.notifier.get(), &QSocketNotifier::activated, this,
+                [&activations](QSocketDescriptor fd) {
+            char buf[16];
+            while (::read(int(fd), buf, sizeof(buf)) > 0) {}
+            ++activations;
+        });
+    }
+
+    int next = 0;
+    QBENCHMARK {
+        const char c = 0;
+        QCOMPARE(::write(pipes[next].fds[1], &c, 1), 1);
+        next = (next + 1) % count;
+
+        const int expected = activations + 1;
+        while (activations < expected)
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+}
+
+void tst_QSocketNotifier::toggleAll_data()
+{
+    activateOne_data();
+}
+
+// Disabling and re-enabling notifiers, e.g. while a socket's write buffer drains.
+void tst_QSocketNotifier::toggleAll()
+{
+    QFETCH(int, count);
+
+    std::vector<Pipe> pipes;
+    if (!createPipes(pipes, count))
+        QSKIP("Not enough file descriptors available");
+
+    QBENCHMARK {
+        for (Pipe &p : pipes)
+            p.notifier->setEnabled(false);
+        for (Pipe &p : pipes)
+            p.notifier->setEnabled(true);
+        QCoreApplication::processEvents();
+    }
+}
+
+QTEST_MAIN(tst_QSocketNotifier)
+
+#include "tst_bench_qsocketnotifier.moc"
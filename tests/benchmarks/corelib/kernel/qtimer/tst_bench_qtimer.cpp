@@ -0,0 +1,106 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QTest>
+
+#include <vector>
+
+// Registers, unregisters and fires large numbers of timers, as servers with
+// per-connection idle and keep-alive timers do. On Unix, run once as is and
+// once with QT_EVENT_DISPATCHER_TIMER_WHEEL=1 (and QT_NO_GLIB=1) to compare
+// the sorted timer list with the timer wheel used for coarse timers.
+
+class TimerObject : public QObject
+{
+public:
+    int *fired = nullptr;
+
+protected:
+    void timerEvent(QTimerEvent *event) override
+    {
+        killTimer(event->timerId());
+        ++*fired;
+    }
+};
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void registerUnregister_data();
+    void registerUnregister();
+    void fire_data();
+    void fire();
+};
+
+void tst_QTimer::registerUnregister_data()
+{
+    QTest::addColumn<Qt::TimerType>("type");
+    QTest::addColumn<int>("count");
+
+    for (int count : { 1000, 10000, 100000 }) {
+        const QByteArray n = QByteArray::number(count);
+        QTest::newRow(("precise:" + n).constData()) << Qt::PreciseTimer << count;
+        QTest::newRow(("coarse:" + n).constData()) << Qt::CoarseTimer << count;
+        QTest::newRow(("verycoarse:" + n).constData()) << Qt::VeryCoarseTimer << count;
+    }
+}
+
+void tst_QTimer::registerUnregister()
+{
+    QFETCH(Qt::TimerType, type);
+    QFETCH(int, count);
+
+    QObject object;
+    std::vector<int> ids(count);
+
+    QBENCHMARK {
+        // spread the timeouts, like idle timers restarted at different times
+        for (int i = 0; i < count; ++i)
+            ids[i] = object.startTimer(30000 + (i % 1000) * 37, type);
+        for (int id : ids)
+            object.killTimer(id);
+    }
+}
+
+void tst_QTimer::fire_data()
+{
+    QTest::addColumn<Qt::TimerType>("type");
+    QTest::addColumn<int>("count");
+
+    for (int count : { 1000, 10000, 100000 }) {
+        const QByteArray n = QByteArray::number(count);
+        QTest::newRow(("precise:" + n).constData()) << Qt::PreciseTimer << count;
+        QTest::newRow(("coarse:" + n).constData()) << Qt::CoarseTimer << count;
+    }
+}
+
+void tst_QTimer::fire()
+{
+    QFETCH(Qt::TimerType, type);
+    QFETCH(int, count);
+
+    int fired = 0;
+    std::vector<TimerObject> objects(count);
+    for (TimerObject &o : objects)
+        o.fired = &fired;
+
+    QBENCHMARK {
+        fired = 0;
+        for (int i = 0; i < count; ++i)
+            objects[i].startTimer(50 + i % 50, type);
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        while (fired < count) {
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+            QVERIFY2(elapsed.elapsed() < 60000, "Timers did not fire in time");
+        }
+    }
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
@@ -0,0 +1,319 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QDataStream>
+#include <QJsonObject>
+#include <QMetaProperty>
+#include <qgadgetserializer.h>
+
+using namespace Qt::StringLiterals;
+
+struct Dimensions
+{
+    Q_GADGET
+    Q_PROPERTY(double width MEMBER width)
+    Q_PROPERTY(double height MEMBER height)
+public:
+    double width = 0;
+    double height = 0;
+
+    friend bool operator==(const Dimensions &lhs, const Dimensions &rhs)
+    { return lhs.width == rhs.width && lhs.height == rhs.height; }
+    friend bool operator!=(const Dimensions &lhs, const Dimensions &rhs)
+    { return !(lhs == rhs); }
+};
+
+class Product
+{
+    Q_GADGET
+    Q_PROPERTY(int id READ id WRITE setId)
+    Q_PROPERTY(QString name READ name WRITE setName)
+    Q_PROPERTY(QString description MEMBER description)
+    Q_PROPERTY(double price MEMBER price)
+    Q_PROPERTY(qint64 stock MEMBER stock)
+    Q_PROPERTY(bool available MEMBER available)
+    Q_PROPERTY(QByteArray sku MEMBER sku)
+    Q_PROPERTY(Dimensions dimensions MEMBER dimensions)
+public:
+    int id() const { return m_id; }
+    void setId(int id) { m_id = id; }
+    const QString &name() const { return m_name; }
+    void setName(const QString &name) { m_name = name; }
+
+    int m_id = 0;
+    QString m_name;
+    QString description;
+    double price = 0;
+    qint64 stock = 0;
+    bool available = false;
+    QByteArray sku;
+    Dimensions dimensions;
+};
+
+// The generic route: every property goes through a QVariant
+namespace ViaMetaProperty {
+static bool isGadget(QMetaType type)
+{
+    return type.flags() & QMetaType::IsGadget;
+}
+
+static void save(QDataStream &stream, const QMetaObject *mo, const void *gadget)
+{
+    for (int i = 0; i < mo->propertyCount(); ++i) {
+        const QMetaProperty property = mo->property(i);
+        const QVariant value = property.readOnGadget(gadget);
+        if (isGadget(property.metaType()))
+            save(stream, property.metaType().metaObject(), value.constData());
+        else
+            property.metaType().save(stream, value.constData());
+    }
+}
+
+static void load(QDataStream &stream, const QMetaObject *mo, void *gadget)
+{
+    for (int i = 0; i < mo->propertyCount(); ++i) {
+        const QMetaProperty property = mo->property(i);
+        QVariant value(property.metaType());
+        if (isGadget(property.metaType()))
+            load(stream, property.metaType().metaObject(), value.data());
+        else
+            property.metaType().load(stream, value.data());
+        property.writeOnGadget(gadget, std::move(value));
+    }
+}
+
+static void toCbor(QCborStreamWriter &writer, const QMetaObject *mo, const void *gadget)
+{
+    writer.startMap(mo->propertyCount());
+    for (int i = 0; i < mo->propertyCount(); ++i) {
+        const QMetaProperty property = mo->property(i);
+        writer.append(QLatin1StringView(property.name()));
+        const QVariant value = property.readOnGadget(gadget);
+        if (isGadget(property.metaType()))
+            toCbor(writer, property.metaType().metaObject(), value.constData());
+        else
+            QCborValue::fromVariant(value).toCbor(writer);
+    }
+    writer.endMap();
+}
+
+static void fromCbor(const QCborMap &map, const QMetaObject *mo, void *gadget)
+{
+    for (int i = 0; i < mo->propertyCount(); ++i) {
+        const QMetaProperty property = mo->property(i);
+        const QCborValue value = map.value(QLatin1StringView(property.name()));
+        if (isGadget(property.metaType())) {
+            QVariant nested = property.readOnGadget(gadget);
+            fromCbor(value.toMap(), property.metaType().metaObject(), nested.data());
+            property.writeOnGadget(gadget, std::move(nested));
+        } else {
+            property.writeOnGadget(gadget, value.toVariant());
+        }
+    }
+}
+
+static QJsonObject toJson(const QMetaObject *mo, const void *gadget)
+{
+    QJsonObject object;
+    for (int i = 0; i < mo->propertyCount(); ++i) {
+        const QMetaProperty property = mo->property(i);
+        const QVariant value = property.readOnGadget(gadget);
+        if (isGadget(property.metaType()))
+            object.insert(QLatin1StringView(property.name()),
+                          toJson(property.metaType().metaObject(), value.constData()));
+        else
+            object.insert(QLatin1StringView(property.name()), QJsonValue::fromVariant(value));
+    }
+    return object;
+}
+
+static void fromJson(const QJsonObject &object, const QMetaObject *mo, void *gadget)
+{
+    for (int i = 0; i < mo->propertyCount(); ++i) {
+        const QMetaProperty property = mo->property(i);
+        const QJsonValue value = object.value(QLatin1StringView(property.name()));
+        if (isGadget(property.metaType())) {
+            QVariant nested = property.readOnGadget(gadget);
+            fromJson(value.toObject(), property.metaType().metaObject(), nested.data());
+            property.writeOnGadget(gadget, std::move(nested));
+        } else {
+            property.writeOnGadget(gadget, value.toVariant());
+        }
+    }
+}
+} // namespace ViaMetaProperty
+
+class tst_bench_QGadgetSerializer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void dataStreamSave_data() { routes(); }
+    void dataStreamSave();
+    void dataStreamLoad_data() { routes(); }
+    void dataStreamLoad();
+    void cborWrite_data() { routes(); }
+    void cborWrite();
+    void cborRead_data() { routes(); }
+    void cborRead();
+    void jsonWrite_data() { routes(); }
+    void jsonWrite();
+    void jsonRead_data() { routes(); }
+    void jsonRead();
+
+private:
+    void routes();
+
+    QList<Product> products;
+};
+
+void tst_bench_QGadgetSerializer::initTestCase()
+{
+    for (int i = 0; i < 10000; ++i) {
+        Product p;
+        p.m_id = i;
+        p.m_name = u"item "_s + QString::number(i);
+        p.description = u"A description of the item, long enough to be realistic"_s;
+        p.price = i * 0.25;
+        p.stock = i * 3;
+        p.available = i % 2;
+        p.sku = "SKU-" + QByteArray::number(i);
+        p.dimensions = { 1.5, 20 };
+        products.append(p);
+    }
+}
+
+void tst_bench_QGadgetSerializer::routes()
+{
+    QTest::addColumn<bool>("metaProperty");
+    QTest::newRow("QMetaProperty") << true;
+    QTest::newRow("QGadgetSerializer") << false;
+}
+
+void tst_bench_QGadgetSerializer::dataStreamSave()
+{
+    QFETCH(bool, metaProperty);
+    QBENCHMARK {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        for (const Product &p : std::as_const(products)) {
+            if (metaProperty)
+                ViaMetaProperty::save(stream, &Product::staticMetaObject, &p);
+            else
+                QGadgetSerializer::save(stream, p);
+        }
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+}
+
+void tst_bench_QGadgetSerializer::dataStreamLoad()
+{
+    QFETCH(bool, metaProperty);
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        for (const Product &p : std::as_const(products))
+            QGadgetSerializer::save(stream, p);
+    }
+
+    QBENCHMARK {
+        QDataStream stream(data);
+        Product p;
+        for (qsizetype i = 0; i < products.size(); ++i) {
+            if (metaProperty)
+                ViaMetaProperty::load(stream, &Product::staticMetaObject, &p);
+            else
+                QGadgetSerializer::load(stream, p);
+        }
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QCOMPARE(p.sku, products.last().sku);
+    }
+}
+
+void tst_bench_QGadgetSerializer::cborWrite()
+{
+    QFETCH(bool, metaProperty);
+    QBENCHMARK {
+        QByteArray data;
+        QCborStreamWriter writer(&data);
+        writer.startArray(products.size());
+        for (const Product &p : std::as_const(products)) {
+            if (metaProperty)
+                ViaMetaProperty::toCbor(writer, &Product::staticMetaObject, &p);
+            else
+                QGadgetSerializer::toCbor(writer, p);
+        }
+        writer.endArray();
+    }
+}
+
+void tst_bench_QGadgetSerializer::cborRead()
+{
+    QFETCH(bool, metaProperty);
+    QByteArray data;
+    {
+        QCborStreamWriter writer(&data);
+        writer.startArray(products.size());
+        for (const Product &p : std::as_const(products))
+            QGadgetSerializer::toCbor(writer, p);
+        writer.endArray();
+    }
+
+    QBENCHMARK {
+        QCborStreamReader reader(data);
+        QVERIFY(reader.enterContainer());
+        Product p;
+        while (reader.hasNext()) {
+            if (metaProperty) {
+                const QCborMap map = QCborValue::fromCbor(reader).toMap();
+                ViaMetaProperty::fromCbor(map, &Product::staticMetaObject, &p);
+            } else {
+                QGadgetSerializer::fromCbor(reader, p);
+            }
+        }
+        QVERIFY(reader.leaveContainer());
+        QCOMPARE(p.sku, products.last().sku);
+    }
+}
+
+void tst_bench_QGadgetSerializer::jsonWrite()
+{
+    QFETCH(bool, metaProperty);
+    QBENCHMARK {
+        for (const Product &p : std::as_const(products)) {
+            const QJsonObject object = metaProperty
+                    ? ViaMetaProperty::toJson(&Product::staticMetaObject, &p)
+                    : QGadgetSerializer::toJsonObject(p);
+            Q_UNUSED(object);
+        }
+    }
+}
+
+void tst_bench_QGadgetSerializer::jsonRead()
+{
+    QFETCH(bool, metaProperty);
+    QList<QJsonObject> objects;
+    for (const Product &p : std::as_const(products))
+        objects.append(QGadgetSerializer::toJsonObject(p));
+
+    QBENCHMARK {
+        Product p;
+        for (const QJsonObject &object : std::as_const(objects)) {
+            if (metaProperty)
+                ViaMetaProperty::fromJson(object, &Product::staticMetaObject, &p);
+            else
+                QGadgetSerializer::fromJsonObject(object, p);
+        }
+        QCOMPARE(p.name(), products.last().name());
+    }
+}
+
+QTEST_MAIN(tst_bench_QGadgetSerializer)
+#include "tst_bench_qgadgetserializer.moc"
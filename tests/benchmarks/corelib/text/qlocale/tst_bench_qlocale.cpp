@@ -37,6 +37,17 @@ private Q_SLOTS:
     void toULongLong();
     void toDouble_data();
     void toDouble();
+    void doubleToString_data() { shortestDouble_data(); }
+    void doubleToString();
+    void number_QString_double_data() { shortestDouble_data(); }
+    void number_QString_double();
+    void number_QByteArray_double_data() { shortestDouble_data(); }
+    void number_QByteArray_double();
+    void toDouble_QByteArray_data() { shortestDouble_data(); }
+    void toDouble_QByteArray();
+
+private:
+    void shortestDouble_data();
 };
 
 static QString data()
@@ -530,6 +541,15 @@ void tst_QLocale::toDouble_data()
             << (QString(961, u'0') + u'1' + QString(64, u'0') + u".0e-64"_s)
             << u"C"_s << true << 1.0;
     QTest::newRow("C: 12345678.9") << u"12345678.9"_s << u"C"_s << true << 12345678.9;
+    QTest::newRow("C: 0.1") << u"0.1"_s << u"C"_s << true << 0.1;
+    QTest::newRow("C: pi") << u"3.141592653589793"_s << u"C"_s << true << 3.141592653589793;
+    QTest::newRow("C: 1/3") << u"0.3333333333333333"_s << u"C"_s << true << 1.0 / 3;
+    QTest::newRow("C: max")
+            << u"1.7976931348623157e+308"_s << u"C"_s << true << std::numeric_limits<double>::max();
+    QTest::newRow("C: denorm_min")
+            << u"5e-324"_s << u"C"_s << true << std::numeric_limits<double>::denorm_min();
+    QTest::newRow("C: 25 digits")
+            << u"1.234567890123456789012345"_s << u"C"_s << true << 1.234567890123456789012345;
 
     // With and without grouping, en vs de for flipped separators:
     QTest::newRow("en: 12345678.9") << u"12345678.9"_s << u"en"_s << true << 12345678.9;
@@ -588,6 +608,69 @@ void tst_QLocale::toDouble()
     QCOMPARE(actual, expected);
 }
 
+void tst_QLocale::shortestDouble_data()
+{
+    QTest::addColumn<double>("value");
+
+    QTest::newRow("0.1") << 0.1;
+    QTest::newRow("1/3") << 1.0 / 3;
+    QTest::newRow("pi") << 3.141592653589793;
+    QTest::newRow("12345678.9") << 12345678.9;
+    QTest::newRow("123") << 123.0;
+    QTest::newRow("2^53") << 9007199254740992.0;
+    QTest::newRow("1e-300") << 1e-300;
+    QTest::newRow("max") << std::numeric_limits<double>::max();
+    QTest::newRow("denorm_min") << std::numeric_limits<double>::denorm_min();
+}
+
+void tst_QLocale::doubleToString()
+{
+    QFETCH(double, value);
+
+    const QLocale c = QLocale::c();
+    QString s;
+    QBENCHMARK {
+        s = c.toString(value, 'g', QLocale::FloatingPointShortest);
+    }
+    QCOMPARE(s.toDouble(), value);
+}
+
+void tst_QLocale::number_QString_double()
+{
+    QFETCH(double, value);
+
+    QString s;
+    QBENCHMARK {
+        s = QString::number(value, 'g', QLocale::FloatingPointShortest);
+    }
+    QCOMPARE(s.toDouble(), value);
+}
+
+void tst_QLocale::number_QByteArray_double()
+{
+    QFETCH(double, value);
+
+    QByteArray s;
+    QBENCHMARK {
+        s = QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+    }
+    QCOMPARE(s.toDouble(), value);
+}
+
+void tst_QLocale::toDouble_QByteArray()
+{
+    QFETCH(double, value);
+
+    const QByteArray text = QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+    double actual = 0;
+    bool ok = false;
+    QBENCHMARK {
+        actual = text.toDouble(&ok);
+    }
+    QVERIFY(ok);
+    QCOMPARE(actual, value);
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
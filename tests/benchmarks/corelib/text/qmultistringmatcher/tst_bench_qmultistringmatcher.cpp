@@ -0,0 +1,173 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+
+#include <QMultiStringMatcher>
+#include <QRandomGenerator>
+#include <QStringMatcher>
+
+using namespace Qt::StringLiterals;
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_QMultiStringMatcher();
+
+private slots:
+    void indexOfLoop_data() { data(); }
+    void indexOfLoop();
+    void stringMatcherLoop_data() { data(); }
+    void stringMatcherLoop();
+    void multiStringMatcher_data() { data(); }
+    void multiStringMatcher();
+    void multiStringMatcherUtf8_data() { data(); }
+    void multiStringMatcherUtf8();
+    void construct_data() { data(); }
+    void construct();
+
+private:
+    void data();
+
+    QString text;
+};
+
+static QString randomWord(QRandomGenerator &rng)
+{
+    QString word;
+    const int length = rng.bounded(2, 10);
+    for (int i = 0; i < length; ++i)
+        word += QChar(u'a' + rng.bounded(26));
+    return word;
+}
+
+tst_QMultiStringMatcher::tst_QMultiStringMatcher()
+{
+    // Pseudo source code: random identifiers with a sprinkling of keywords
+    // and punctuation, about 256 KB of UTF-16.
+    QRandomGenerator rng(42);
+    const QString keywords[] = { u"if"_s, u"for"_s, u"return"_s, u"const"_s, u"while"_s };
+    while (text.size() < 128 * 1024) {
+        if (rng.bounded(8) == 0)
+            text += keywords[rng.bounded(int(std::size(keywords)))];
+        else
+            text += randomWord(rng);
+        text += rng.bounded(6) == 0 ? u"();\n"_s : u" "_s;
+    }
+}
+
+void tst_QMultiStringMatcher::data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<bool>("caseInsensitive");
+
+    const QStringList few = { u"return"_s, u"while"_s, u"nullptr"_s, u"TODO"_s };
+    const QStringList cppKeywords = {
+        u"alignas"_s, u"auto"_s, u"bool"_s, u"break"_s, u"case"_s, u"catch"_s, u"char"_s,
+        u"class"_s, u"const"_s, u"constexpr"_s, u"continue"_s, u"default"_s, u"delete"_s,
+        u"do"_s, u"double"_s, u"else"_s, u"enum"_s, u"explicit"_s, u"false"_s, u"for"_s,
+        u"friend"_s, u"if"_s, u"inline"_s, u"int"_s, u"namespace"_s, u"new"_s,
+        u"noexcept"_s, u"nullptr"_s, u"private"_s, u"public"_s, u"return"_s, u"static"_s,
+        u"struct"_s, u"switch"_s, u"template"_s, u"this"_s, u"true"_s, u"typename"_s,
+        u"using"_s, u"virtual"_s, u"void"_s, u"while"_s,
+    };
+    QRandomGenerator rng(4711);
+    QStringList many;
+    while (many.size() < 500) {
+        QString word = randomWord(rng).left(4);
+        if (word.size() >= 3)
+            many.append(std::move(word));
+    }
+
+    QTest::newRow("4-keywords") << few << false;
+    QTest::newRow("42-keywords") << cppKeywords << false;
+    QTest::newRow("42-keywords-ci") << cppKeywords << true;
+    QTest::newRow("500-words") << many << false;
+}
+
+void tst_QMultiStringMatcher::indexOfLoop()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(bool, caseInsensitive);
+    const Qt::CaseSensitivity cs = caseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive;
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &pattern : std::as_const(patterns)) {
+            for (qsizetype i = text.indexOf(pattern, 0, cs); i >= 0;
+                 i = text.indexOf(pattern, i + 1, cs)) {
+                ++found;
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::stringMatcherLoop()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(bool, caseInsensitive);
+    const Qt::CaseSensitivity cs = caseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive;
+
+    QList<QStringMatcher> matchers;
+    for (const QString &pattern : std::as_const(patterns))
+        matchers.emplace_back(pattern, cs);
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QStringMatcher &matcher : std::as_const(matchers)) {
+            for (qsizetype i = matcher.indexIn(text); i >= 0; i = matcher.indexIn(text, i + 1))
+                ++found;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::multiStringMatcher()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(bool, caseInsensitive);
+    const QMultiStringMatcher matcher(patterns,
+                                      caseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive);
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = matcher.matchAll(text).size();
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::multiStringMatcherUtf8()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(bool, caseInsensitive);
+    const QMultiStringMatcher matcher(patterns,
+                                      caseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive);
+    const QByteArray utf8 = text.toUtf8();
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = matcher.matchAll(utf8).size();
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::construct()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(bool, caseInsensitive);
+
+    QBENCHMARK {
+        QMultiStringMatcher matcher(patterns,
+                                    caseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive);
+        Q_UNUSED(matcher);
+    }
+}
+
+QTEST_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_bench_qmultistringmatcher.moc"
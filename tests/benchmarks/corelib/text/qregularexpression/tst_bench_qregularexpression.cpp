@@ -34,6 +34,10 @@ private slots:
 
     void matchCustom();
     void matchCustomOptimized();
+    void matchCustomUncached();
+
+    void matchManySubjects();
+    void matchEachManySubjects();
 
     void globalMatchDefault();
     void globalMatchDefaultOptimized();
@@ -124,7 +128,8 @@ void tst_QRegularExpressionBenchmark::matchDefaultOptimized()
     with pattern compilation for an object with custom pattern and pattern
     options.
     We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    does not get cached in the object. It is still found in the process-wide
+    compiled pattern cache; matchCustomUncached() measures the compilation.
 */
 void tst_QRegularExpressionBenchmark::matchCustom()
 {
@@ -151,6 +156,62 @@ void tst_QRegularExpressionBenchmark::matchCustomOptimized()
     }
 }
 
+/*!
+    \internal This benchmark measures the performance of the match() together
+    with the pattern compilation for an object with custom pattern and pattern
+    options, using a different pattern for every iteration so that it is
+    never found in the compiled pattern cache.
+*/
+void tst_QRegularExpressionBenchmark::matchCustomUncached()
+{
+    int counter = 0;
+    QBENCHMARK {
+        QRegularExpression re(nonEmptyPattern + QString::number(++counter) + "?",
+                              nonEmptyPatternOptions);
+        auto matchResult = re.match(textToMatch);
+        Q_UNUSED(matchResult);
+    }
+}
+
+static QStringList manySubjects()
+{
+    QStringList subjects;
+    for (int i = 0; i < 1000; ++i)
+        subjects.append(textToMatch.sliced(i % 10) + QString::number(i));
+    return subjects;
+}
+
+/*!
+    \internal This benchmark measures the performance of calling match() on
+    each of many subjects, to be compared with matchEachManySubjects().
+*/
+void tst_QRegularExpressionBenchmark::matchManySubjects()
+{
+    QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+    re.optimize();
+    const QStringList subjects = manySubjects();
+    QBENCHMARK {
+        qsizetype matched = 0;
+        for (const QString &subject : subjects)
+            matched += re.match(subject).capturedLength();
+        Q_UNUSED(matched);
+    }
+}
+
+void tst_QRegularExpressionBenchmark::matchEachManySubjects()
+{
+    QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+    re.optimize();
+    const QStringList subjects = manySubjects();
+    QBENCHMARK {
+        qsizetype matched = 0;
+        re.matchEach(subjects, [&](qsizetype, const QRegularExpressionMatch &match) {
+            matched += match.capturedLength();
+        });
+        Q_UNUSED(matched);
+    }
+}
+
 /*!
     \internal This benchmark measures the performance of the globalMatch()
     together with the pattern compilation for a default-constructed object.
@@ -190,7 +251,8 @@ void tst_QRegularExpressionBenchmark::globalMatchDefaultOptimized()
     together with the pattern compilation for an object with custom pattern
     and pattern options.
     We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    does not get cached in the object (it is still found in the process-wide
+    compiled pattern cache).
 */
 void tst_QRegularExpressionBenchmark::globalMatchCustom()
 {
@@ -0,0 +1,139 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+
+#include <QStringBuilder>
+#include <QStringFormat>
+
+using namespace Qt::StringLiterals;
+
+class tst_QStringFormat : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void argChain();
+    void argMulti();
+    void stringBuilder();
+    void format();
+    void formatTo();
+    void formatToVarLengthArray();
+
+    void argDouble();
+    void formatDouble();
+
+private:
+    const QString name = u"temperature"_s;
+    const QString unit = u"degrees"_s;
+};
+
+static constexpr int Rows = 1000;
+
+void tst_QStringFormat::argChain()
+{
+    qsizetype total = 0;
+    QBENCHMARK {
+        total = 0;
+        for (int i = 0; i < Rows; ++i)
+            total += u"%1 #%2: %3 %4"_s.arg(name).arg(i).arg(i * 7).arg(unit).size();
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_QStringFormat::argMulti()
+{
+    qsizetype total = 0;
+    QBENCHMARK {
+        total = 0;
+        for (int i = 0; i < Rows; ++i) {
+            total += u"%1 #%2: %3 %4"_s
+                    .arg(name, QString::number(i), QString::number(i * 7), unit).size();
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_QStringFormat::stringBuilder()
+{
+    qsizetype total = 0;
+    QBENCHMARK {
+        total = 0;
+        for (int i = 0; i < Rows; ++i) {
+            const QString s = name % u" #" % QString::number(i) % u": "
+                    % QString::number(i * 7) % u' ' % unit;
+            total += s.size();
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_QStringFormat::format()
+{
+    qsizetype total = 0;
+    QBENCHMARK {
+        total = 0;
+        for (int i = 0; i < Rows; ++i) {
+            const QString s = qFormat(QT_FORMAT_STRING(u"{} #{}: {} {}"), name, i, i * 7, unit);
+            total += s.size();
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_QStringFormat::formatTo()
+{
+    qsizetype total = 0;
+    QString buffer;
+    QBENCHMARK {
+        total = 0;
+        for (int i = 0; i < Rows; ++i) {
+            buffer.resize(0);
+            total += qFormatTo(buffer, QT_FORMAT_STRING(u"{} #{}: {} {}"), name, i, i * 7, unit)
+                    .size();
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_QStringFormat::formatToVarLengthArray()
+{
+    qsizetype total = 0;
+    QBENCHMARK {
+        total = 0;
+        for (int i = 0; i < Rows; ++i) {
+            QVarLengthArray<char16_t, 128> buffer;
+            total += qFormatTo(buffer, QT_FORMAT_STRING(u"{} #{}: {} {}"), name, i, i * 7, unit)
+                    .size();
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_QStringFormat::argDouble()
+{
+    qsizetype total = 0;
+    QBENCHMARK {
+        total = 0;
+        for (int i = 0; i < Rows; ++i) {
+            total += u"%1 = %2"_s.arg(name)
+                    .arg(i / 7.0, 0, 'g', QLocale::FloatingPointShortest).size();
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_QStringFormat::formatDouble()
+{
+    qsizetype total = 0;
+    QBENCHMARK {
+        total = 0;
+        for (int i = 0; i < Rows; ++i)
+            total += qFormat(QT_FORMAT_STRING(u"{} = {}"), name, i / 7.0).toString().size();
+    }
+    QVERIFY(total > 0);
+}
+
+QTEST_MAIN(tst_QStringFormat)
+
+#include "tst_bench_qstringformat.moc"
@@ -36,7 +36,15 @@ private slots:
     void compareStringsWithErrors_data();
     void compareStringsWithErrors();
 
+    void fromUtf8_data() { transcoding_data(); }
+    void fromUtf8();
+    void toUtf8_data() { transcoding_data(); }
+    void toUtf8();
+    void isValidUtf8_data() { transcoding_data(); }
+    void isValidUtf8();
+
 private:
+    void transcoding_data();
     void equalStrings_data();
     void compareStringsCaseSensitive_data();
     void compareStringsCaseInsensitive_data();
@@ -258,6 +266,61 @@ void tst_QUtf8StringView::compareStringsWithErrors()
     QCOMPARE(-result, rhv.compare(lhv, cs));
 }
 
+void tst_QUtf8StringView::transcoding_data()
+{
+    QTest::addColumn<QString>("text");
+
+    // about 64 kB of UTF-8 each, so the loops dominate over the allocations
+    const auto repeat = [](QStringView piece) {
+        QString result;
+        while (result.size() * 2 < 64 * 1024)
+            result += piece;
+        return result;
+    };
+    QTest::newRow("ascii") << repeat(u"2023-08-14 12:00:01 INFO request served in 3 ms\n");
+    QTest::newRow("latin1") << repeat(u"Der Bäcker ließ ausrichten, daß er später öffnet. ");
+    QTest::newRow("cyrillic") << repeat(u"Съешь же ещё этих мягких французских булок, да выпей чаю. ");
+    QTest::newRow("cjk") << repeat(u"日本語のテキストと中文文本的混合，한국어 문장도 있습니다。");
+    QTest::newRow("mixed-json")
+            << repeat(u"{\"id\": 42, \"name\": \"Иван Петров\", \"city\": \"東京\", \"ok\": true}, ");
+    QTest::newRow("emoji") << repeat(u"status: \U0001F600 \U0001F680 done \U0001F44D ");
+}
+
+void tst_QUtf8StringView::fromUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+    QString result;
+
+    QBENCHMARK {
+        result = QString::fromUtf8(utf8);
+    }
+    QCOMPARE(result, text);
+}
+
+void tst_QUtf8StringView::toUtf8()
+{
+    QFETCH(QString, text);
+    QByteArray result;
+
+    QBENCHMARK {
+        result = text.toUtf8();
+    }
+    QCOMPARE(QString::fromUtf8(result), text);
+}
+
+void tst_QUtf8StringView::isValidUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+    bool result = false;
+
+    QBENCHMARK {
+        result = QUtf8StringView(utf8).isValidUtf8();
+    }
+    QVERIFY(result);
+}
+
 QTEST_MAIN(tst_QUtf8StringView)
 
 #include "tst_bench_qutf8stringview.moc"
@@ -28,6 +28,8 @@ private slots:
 #endif
     void then();
     void thenVoid();
+    void continuationChain_data();
+    void continuationChain();
     void onCanceled();
     void onCanceledVoid();
 #ifndef QT_NO_EXCEPTIONS
@@ -156,6 +158,31 @@ void tst_QFuture::thenVoid()
     }
 }
 
+void tst_QFuture::continuationChain_data()
+{
+    QTest::addColumn<QtFuture::Launch>("policy");
+    QTest::newRow("Sync") << QtFuture::Launch::Sync;
+    QTest::newRow("Async") << QtFuture::Launch::Async;
+}
+
+void tst_QFuture::continuationChain()
+{
+    QFETCH(QtFuture::Launch, policy);
+    constexpr int Stages = 16;
+
+    QBENCHMARK {
+        QPromise<int> promise;
+        QFuture<int> future = promise.future();
+        for (int i = 0; i < Stages; ++i)
+            future = future.then(policy, [](int value) { return value + 1; });
+
+        promise.start();
+        promise.addResult(0);
+        promise.finish();
+        QCOMPARE(future.result(), Stages);
+    }
+}
+
 void tst_QFuture::onCanceled()
 {
     QFutureInterface<int> fi;
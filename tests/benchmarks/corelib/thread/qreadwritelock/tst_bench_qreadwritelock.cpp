@@ -82,6 +82,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
+    void readMostly_data();
+    void readMostly();
     // void readWrite();
 };
 
@@ -123,6 +125,12 @@ void tst_QReadWriteLock::uncontended_data()
         << FunctionPtrHolder(testUncontended<QReadWriteLock, QReadLocker>);
     QTest::newRow("QReadWriteLock, write")
         << FunctionPtrHolder(testUncontended<QReadWriteLock, QWriteLocker>);
+    QTest::newRow("QShardedReadWriteLock, read") << FunctionPtrHolder(
+        testUncontended<QShardedReadWriteLock,
+                        LockerWrapper<std::shared_lock<QShardedReadWriteLock>>>);
+    QTest::newRow("QShardedReadWriteLock, write") << FunctionPtrHolder(
+        testUncontended<QShardedReadWriteLock,
+                        LockerWrapper<std::unique_lock<QShardedReadWriteLock>>>);
 #define ROW(n) \
     QTest::addRow("QReadWriteLock, %s, recursive: %d", "read", n) \
         << FunctionPtrHolder(testUncontended<QRecursiveReadWriteLock, QRecursiveReadLocker<n>>); \
@@ -199,6 +207,9 @@ void tst_QReadWriteLock::readOnly_data()
     QTest::newRow("nothing") << FunctionPtrHolder(testReadOnly<int, FakeLock>);
     QTest::newRow("QMutex") << FunctionPtrHolder(testReadOnly<QMutex, QMutexLocker<QMutex>>);
     QTest::newRow("QReadWriteLock") << FunctionPtrHolder(testReadOnly<QReadWriteLock, QReadLocker>);
+    QTest::newRow("QShardedReadWriteLock") << FunctionPtrHolder(
+        testReadOnly<QShardedReadWriteLock,
+                     LockerWrapper<std::shared_lock<QShardedReadWriteLock>>>);
 #define ROW(n) \
     QTest::addRow("QReadWriteLock, recursive: %d", n) \
         << FunctionPtrHolder(testReadOnly<QRecursiveReadWriteLock, QRecursiveReadLocker<n>>)
@@ -294,5 +305,86 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+static QHash<int, int> global_table;
+
+// Readers look up a table that is modified once every WriteInterval operations;
+// the total number of operations is split among the threads.
+template <typename Mutex, typename ReadLocker, typename WriteLocker>
+void testReadMostly(int threads)
+{
+    enum { Operations = 1 << 20, WriteInterval = 1024, TableSize = 1024 };
+    struct Thread : QThread
+    {
+        Mutex *lock;
+        int operations;
+        void run() override
+        {
+            for (int i = 0; i < operations; ++i) {
+                const int key = (i * 37) % TableSize; // Do something outside the lock
+                if (i % WriteInterval == WriteInterval - 1) {
+                    WriteLocker locker(lock);
+                    ++global_table[key];
+                } else {
+                    ReadLocker locker(lock);
+                    global_table.value(key);
+                }
+            }
+        }
+    };
+    global_table.clear();
+    for (int i = 0; i < TableSize; ++i)
+        global_table.insert(i, i);
+
+    Mutex lock;
+    std::vector<std::unique_ptr<Thread>> pool;
+    for (int i = 0; i < threads; ++i) {
+        auto t = std::make_unique<Thread>();
+        t->lock = &lock;
+        t->operations = Operations / threads;
+        pool.push_back(std::move(t));
+    }
+    QBENCHMARK {
+        for (auto &t : pool) {
+            t->start();
+        }
+        for (auto &t : pool) {
+            t->wait();
+        }
+    }
+}
+
+void tst_QReadWriteLock::readMostly_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<FunctionPtrHolder>("holder");
+
+    using ReadMostlyFunction = void (*)(int);
+    const auto holder = [](ReadMostlyFunction f) {
+        return FunctionPtrHolder(reinterpret_cast<QFunctionPointer>(f));
+    };
+
+    for (int threads = 1; threads <= 128; threads *= 2) {
+        QTest::addRow("QReadWriteLock, %d threads", threads) << threads
+            << holder(testReadMostly<QReadWriteLock, QReadLocker, QWriteLocker>);
+        QTest::addRow("QShardedReadWriteLock, %d threads", threads) << threads
+            << holder(testReadMostly<QShardedReadWriteLock,
+                                     LockerWrapper<std::shared_lock<QShardedReadWriteLock>>,
+                                     LockerWrapper<std::unique_lock<QShardedReadWriteLock>>>);
+#ifdef __cpp_lib_shared_mutex
+        QTest::addRow("std::shared_mutex, %d threads", threads) << threads
+            << holder(testReadMostly<std::shared_mutex,
+                                     LockerWrapper<std::shared_lock<std::shared_mutex>>,
+                                     LockerWrapper<std::unique_lock<std::shared_mutex>>>);
+#endif
+    }
+}
+
+void tst_QReadWriteLock::readMostly()
+{
+    QFETCH(int, threads);
+    QFETCH(FunctionPtrHolder, holder);
+    reinterpret_cast<void (*)(int)>(holder.value)(threads);
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_bench_qreadwritelock.moc"
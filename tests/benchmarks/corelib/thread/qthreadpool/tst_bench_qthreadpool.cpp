@@ -15,6 +15,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void recursiveTasks_data();
+    void recursiveTasks();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -50,6 +52,61 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+// Splits itself in two until depth reaches zero, as divide-and-conquer
+// algorithms on top of QThreadPool do.
+class SplittingRunnable : public QRunnable
+{
+public:
+    SplittingRunnable(QThreadPool *pool, int depth, QAtomicInt *leaves)
+        : pool(pool), depth(depth), leaves(leaves)
+    {}
+
+    void run() override
+    {
+        if (depth == 0) {
+            leaves->ref();
+            return;
+        }
+        pool->start(new SplittingRunnable(pool, depth - 1, leaves));
+        pool->start(new SplittingRunnable(pool, depth - 1, leaves));
+    }
+
+private:
+    QThreadPool *pool;
+    int depth;
+    QAtomicInt *leaves;
+};
+
+void tst_QThreadPool::recursiveTasks_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<bool>("workStealing");
+
+    for (int threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+        const QByteArray n = QByteArray::number(threads);
+        QTest::newRow(("shared queue, " + n + " threads").constData()) << threads << false;
+        QTest::newRow(("work stealing, " + n + " threads").constData()) << threads << true;
+    }
+}
+
+void tst_QThreadPool::recursiveTasks()
+{
+    QFETCH(int, threads);
+    QFETCH(bool, workStealing);
+
+    const int depth = 14;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threads);
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    QBENCHMARK {
+        QAtomicInt leaves;
+        threadPool.start(new SplittingRunnable(&threadPool, depth, &leaves));
+        threadPool.waitForDone();
+        QCOMPARE(leaves.loadRelaxed(), 1 << depth);
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
@@ -10,6 +10,10 @@
 
 #include <limits.h>
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 using namespace std::chrono_literals;
 
 class tst_QWaitCondition : public QObject
@@ -32,12 +36,25 @@ private slots:
     void oscillate_std_condition_variable_any_QMutex();
     void oscillate_std_condition_variable_any_QReadWriteLock_data() { oscillate_mutex_data(); }
     void oscillate_std_condition_variable_any_QReadWriteLock();
+    void handoffLatency_data();
+    void handoffLatency();
 
 private:
     void oscillate_mutex_data();
 };
 
 
+struct FunctionPtrHolder
+{
+    using Function = std::vector<qint64> (*)();
+    FunctionPtrHolder(Function value = nullptr)
+        : value(value)
+    {
+    }
+    Function value;
+};
+Q_DECLARE_METATYPE(FunctionPtrHolder)
+
 int turn;
 const int threadCount = 10;
 QWaitCondition cond;
@@ -169,6 +186,125 @@ void tst_QWaitCondition::oscillate_std_condition_variable_any_QReadWriteLock()
     oscillate<std::condition_variable_any, QReadWriteLock, WriteLocker>(timeout);
 }
 
+// Measures the time from one thread signalling a handoff until the thread
+// waiting for it runs again. The median is reported as the benchmark result,
+// the distribution as a histogram with power-of-two buckets.
+static qint64 nowNSecs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+enum { HandoffRounds = 20000 };
+
+template <class Cond, class Mutex>
+std::vector<qint64> conditionHandoff()
+{
+    Mutex mutex;
+    Cond posted, consumed;
+    bool ready = false;
+    qint64 stamp = 0;
+    std::vector<qint64> latencies;
+    latencies.reserve(HandoffRounds);
+
+    std::unique_ptr<QThread> consumer(QThread::create([&] {
+        for (int i = 0; i < HandoffRounds; ++i) {
+            std::unique_lock locker(mutex);
+            while (!ready)
+                posted.wait(locker);
+            latencies.push_back(nowNSecs() - stamp);
+            ready = false;
+            consumed.notify_one();
+        }
+    }));
+    consumer->start();
+    for (int i = 0; i < HandoffRounds; ++i) {
+        std::unique_lock locker(mutex);
+        stamp = nowNSecs();
+        ready = true;
+        posted.notify_one();
+        while (ready)
+            consumed.wait(locker);
+    }
+    consumer->wait();
+    return latencies;
+}
+
+// QWaitCondition has no overload taking a std::unique_lock
+struct QtCondition : QWaitCondition
+{
+    template <class Mutex>
+    void wait(std::unique_lock<Mutex> &locker) { QWaitCondition::wait(locker.mutex()); }
+};
+
+template <class Semaphore>
+std::vector<qint64> semaphoreHandoff()
+{
+    Semaphore posted, consumed;
+    std::atomic<qint64> stamp = 0;
+    std::vector<qint64> latencies;
+    latencies.reserve(HandoffRounds);
+
+    std::unique_ptr<QThread> consumer(QThread::create([&] {
+        for (int i = 0; i < HandoffRounds; ++i) {
+            posted.acquire();
+            latencies.push_back(nowNSecs() - stamp.load());
+            consumed.release();
+        }
+    }));
+    consumer->start();
+    for (int i = 0; i < HandoffRounds; ++i) {
+        stamp.store(nowNSecs());
+        posted.release();
+        consumed.acquire();
+    }
+    consumer->wait();
+    return latencies;
+}
+
+void tst_QWaitCondition::handoffLatency_data()
+{
+    QTest::addColumn<FunctionPtrHolder>("holder");
+
+    QTest::newRow("QWaitCondition, QMutex")
+            << FunctionPtrHolder(conditionHandoff<QtCondition, QMutex>);
+    QTest::newRow("QWaitCondition, QAdaptiveMutex")
+            << FunctionPtrHolder(conditionHandoff<QtCondition, QAdaptiveMutex>);
+    QTest::newRow("std::condition_variable, std::mutex")
+            << FunctionPtrHolder(conditionHandoff<std::condition_variable, std::mutex>);
+    QTest::newRow("QSemaphore") << FunctionPtrHolder(semaphoreHandoff<QSemaphore>);
+    QTest::newRow("QAdaptiveSemaphore") << FunctionPtrHolder(semaphoreHandoff<QAdaptiveSemaphore>);
+}
+
+void tst_QWaitCondition::handoffLatency()
+{
+    QFETCH(FunctionPtrHolder, holder);
+    std::vector<qint64> latencies = holder.value();
+    QCOMPARE(latencies.size(), size_t(HandoffRounds));
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](int p) { return latencies[(latencies.size() - 1) * p / 100]; };
+
+    int buckets[64] = {};
+    int lastBucket = 0;
+    for (qint64 latency : latencies) {
+        const int bucket = latency > 0 ? 63 - qCountLeadingZeroBits(quint64(latency)) : 0;
+        ++buckets[bucket];
+        lastBucket = qMax(lastBucket, bucket);
+    }
+    for (int bucket = 0; bucket <= lastBucket; ++bucket) {
+        if (buckets[bucket]) {
+            qDebug("%10lld ns .. %10lld ns: %6d %s", 1LL << bucket, (2LL << bucket) - 1,
+                   buckets[bucket],
+                   QByteArray(buckets[bucket] * 50 / HandoffRounds, '#').constData());
+        }
+    }
+    qDebug("p50: %lld ns, p90: %lld ns, p99: %lld ns, max: %lld ns",
+           percentile(50), percentile(90), percentile(99), latencies.back());
+
+    QTest::setBenchmarkResult(percentile(50), QTest::WalltimeNanoseconds);
+}
+
 QTEST_MAIN(tst_QWaitCondition)
 
 #include "tst_bench_qwaitcondition.moc"
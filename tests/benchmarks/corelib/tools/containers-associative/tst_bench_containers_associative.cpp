@@ -3,6 +3,7 @@
 #include <QString>
 #include <QMap>
 #include <QHash>
+#include <QFlatMap>
 
 #include <qtest.h>
 
@@ -14,8 +15,16 @@ private slots:
     void insert();
     void lookup_data();
     void lookup();
+    void build_data();
+    void build();
+    void stringLookup_data();
+    void stringLookup();
+    void iterate_data();
+    void iterate();
 };
 
+enum Container { Hash, Map, FlatMap };
+
 template <typename T>
 void testInsert(int size)
 {
@@ -27,32 +36,41 @@ void testInsert(int size)
     }
 }
 
-void tst_associative_containers::insert_data()
+static void addContainerRows()
 {
-    QTest::addColumn<bool>("useHash");
+    QTest::addColumn<int>("container");
     QTest::addColumn<int>("size");
 
     for (int size = 10; size < 20000; size += 100) {
 
         const QByteArray sizeString = QByteArray::number(size);
 
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
+        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << int(Hash) << size;
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << int(Map) << size;
+        QTest::newRow(QByteArray("flatmap--" + sizeString).constData()) << int(FlatMap) << size;
     }
 }
 
+void tst_associative_containers::insert_data()
+{
+    addContainerRows();
+}
+
 void tst_associative_containers::insert()
 {
-    QFETCH(bool, useHash);
+    QFETCH(int, container);
     QFETCH(int, size);
 
-    QHash<int, int> testHash;
-    QMap<int, int> testMap;
-
-    if (useHash) {
+    switch (container) {
+    case Hash:
         testInsert<QHash<int, int> >(size);
-    } else {
+        break;
+    case Map:
         testInsert<QMap<int, int> >(size);
+        break;
+    case FlatMap:
+        testInsert<QFlatMap<int, int> >(size);
+        break;
     }
 }
 
@@ -61,16 +79,7 @@ void tst_associative_containers::lookup_data()
 //    setReportType(LineChartReport);
 //    setChartTitle("Time to call value(), with an increasing number of items in the container");
 
-    QTest::addColumn<bool>("useHash");
-    QTest::addColumn<int>("size");
-
-    for (int size = 10; size < 20000; size += 100) {
-
-        const QByteArray sizeString = QByteArray::number(size);
-
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
-    }
+    addContainerRows();
 }
 
 template <typename T>
@@ -93,13 +102,147 @@ void testLookup(int size)
 
 void tst_associative_containers::lookup()
 {
-    QFETCH(bool, useHash);
+    QFETCH(int, container);
     QFETCH(int, size);
 
-    if (useHash) {
+    switch (container) {
+    case Hash:
         testLookup<QHash<int, int> >(size);
-    } else {
+        break;
+    case Map:
         testLookup<QMap<int, int> >(size);
+        break;
+    case FlatMap:
+        testLookup<QFlatMap<int, int> >(size);
+        break;
+    }
+}
+
+// Configuration-style tables: string keys, built once in arbitrary order
+static QList<std::pair<QString, int>> makeStringItems(int size)
+{
+    QList<std::pair<QString, int>> items;
+    items.reserve(size);
+    for (int i = 0; i < size; ++i)
+        items.emplaceBack(QStringLiteral("section/key-%1").arg((i * 7919) % size), i);
+    return items;
+}
+
+static void addStringRows()
+{
+    QTest::addColumn<int>("container");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 16, 256, 4096, 65536 }) {
+        const QByteArray sizeString = QByteArray::number(size);
+        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << int(Hash) << size;
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << int(Map) << size;
+        QTest::newRow(QByteArray("flatmap--" + sizeString).constData()) << int(FlatMap) << size;
+    }
+}
+
+void tst_associative_containers::build_data()
+{
+    addStringRows();
+}
+
+void tst_associative_containers::build()
+{
+    QFETCH(int, container);
+    QFETCH(int, size);
+    const auto items = makeStringItems(size);
+
+    switch (container) {
+    case Hash:
+        QBENCHMARK {
+            QHash<QString, int> hash;
+            for (const auto &[key, value] : items)
+                hash.insert(key, value);
+        }
+        break;
+    case Map:
+        QBENCHMARK {
+            QMap<QString, int> map;
+            for (const auto &[key, value] : items)
+                map.insert(key, value);
+        }
+        break;
+    case FlatMap:
+        QBENCHMARK {
+            QFlatMap<QString, int> map(items.cbegin(), items.cend());
+        }
+        break;
+    }
+}
+
+template <typename T>
+void testStringLookup(const T &container, const QList<std::pair<QString, int>> &items)
+{
+    size_t sum = 0;
+    QBENCHMARK {
+        for (const auto &item : items)
+            sum += container.value(item.first);
+    }
+    QVERIFY(sum);
+}
+
+void tst_associative_containers::stringLookup_data()
+{
+    addStringRows();
+}
+
+void tst_associative_containers::stringLookup()
+{
+    QFETCH(int, container);
+    QFETCH(int, size);
+    const auto items = makeStringItems(size);
+
+    switch (container) {
+    case Hash:
+        testStringLookup(QHash<QString, int>(items.cbegin(), items.cend()), items);
+        break;
+    case Map:
+        testStringLookup(QMap<QString, int>(std::map<QString, int>(items.cbegin(), items.cend())),
+                         items);
+        break;
+    case FlatMap:
+        testStringLookup(QFlatMap<QString, int>(items.cbegin(), items.cend()), items);
+        break;
+    }
+}
+
+template <typename T>
+void testIterate(const T &container)
+{
+    size_t length = 0;
+    QBENCHMARK {
+        for (auto it = container.begin(); it != container.end(); ++it)
+            length += it.key().size() + it.value();
+    }
+    QVERIFY(length);
+}
+
+void tst_associative_containers::iterate_data()
+{
+    addStringRows();
+}
+
+void tst_associative_containers::iterate()
+{
+    QFETCH(int, container);
+    QFETCH(int, size);
+    const auto items = makeStringItems(size);
+
+    switch (container) {
+    case Hash:
+        testIterate(QHash<QString, int>(items.cbegin(), items.cend()));
+        break;
+    case Map:
+        testIterate(QMap<QString, int>(std::map<QString, int>(items.cbegin(), items.cend())));
+        break;
+    case FlatMap:
+        testIterate(QFlatMap<QString, int>(items.cbegin(), items.cend()));
+        break;
     }
 }
 
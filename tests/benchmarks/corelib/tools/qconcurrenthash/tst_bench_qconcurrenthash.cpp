@@ -0,0 +1,204 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QConcurrentHash>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+// The baseline: a QHash behind one lock, as multi-threaded caches do today
+class LockedHash
+{
+public:
+    bool contains(const QString &key) const
+    {
+        QReadLocker locker(&lock);
+        return hash.contains(key);
+    }
+    int value(const QString &key) const
+    {
+        QReadLocker locker(&lock);
+        return hash.value(key);
+    }
+    void insertOrAssign(const QString &key, int value)
+    {
+        QWriteLocker locker(&lock);
+        hash.insert(key, value);
+    }
+    template <typename Factory>
+    int computeIfAbsent(const QString &key, Factory factory)
+    {
+        {
+            QReadLocker locker(&lock);
+            auto it = hash.constFind(key);
+            if (it != hash.cend())
+                return *it;
+        }
+        QWriteLocker locker(&lock);
+        auto it = hash.find(key);
+        if (it == hash.end())
+            it = hash.insert(key, factory());
+        return *it;
+    }
+
+private:
+    mutable QReadWriteLock lock;
+    QHash<QString, int> hash;
+};
+
+enum Container { Locked, Concurrent };
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void lookup_data() { scaling_data(); }
+    void lookup();
+    void readMostly_data() { scaling_data(); }
+    void readMostly();
+    void writeHeavy_data() { scaling_data(); }
+    void writeHeavy();
+    void computeIfAbsent_data() { scaling_data(); }
+    void computeIfAbsent();
+
+private:
+    void scaling_data();
+    template <typename Hash>
+    void run(Hash &hash, int threads, int writeInterval);
+
+    QStringList keys;
+};
+
+enum { Operations = 1 << 19, TableSize = 4096 };
+
+void tst_QConcurrentHash::initTestCase()
+{
+    keys.reserve(TableSize);
+    for (int i = 0; i < TableSize; ++i)
+        keys.append(QStringLiteral("/cache/entries/%1").arg(i, 6, 10, QLatin1Char('0')));
+}
+
+void tst_QConcurrentHash::scaling_data()
+{
+    QTest::addColumn<Container>("container");
+    QTest::addColumn<int>("threads");
+
+    for (int threads = 1; threads <= 32; threads *= 2) {
+        QTest::addRow("QHash+QReadWriteLock, %d threads", threads) << Locked << threads;
+        QTest::addRow("QConcurrentHash, %d threads", threads) << Concurrent << threads;
+    }
+}
+
+// Each thread does Operations / threads operations on random keys; a write
+// every writeInterval operations, a lookup otherwise. With perfect scaling,
+// the time goes down as the thread count goes up, up to the number of cores.
+template <typename Hash>
+void tst_QConcurrentHash::run(Hash &hash, int threads, int writeInterval)
+{
+    for (int i = 0; i < TableSize; ++i)
+        hash.insertOrAssign(keys.at(i), i);
+
+    const auto work = [&hash, this, writeInterval](int operations, uint seed) {
+        size_t found = 0;
+        for (int i = 0; i < operations; ++i) {
+            seed = seed * 1103515245 + 12345; // cheap LCG, outside of any lock
+            const QString &key = keys.at((seed >> 8) % TableSize);
+            if (writeInterval && i % writeInterval == 0)
+                hash.insertOrAssign(key, i);
+            else
+                found += hash.contains(key);
+        }
+        return found;
+    };
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> pool;
+        for (int t = 0; t < threads; ++t)
+            pool.emplace_back(QThread::create(work, Operations / threads, uint(t + 1)));
+        for (auto &t : pool)
+            t->start();
+        for (auto &t : pool)
+            t->wait();
+    }
+}
+
+void tst_QConcurrentHash::lookup()
+{
+    QFETCH(Container, container);
+    QFETCH(int, threads);
+    if (container == Locked) {
+        LockedHash hash;
+        run(hash, threads, 0);
+    } else {
+        QConcurrentHash<QString, int> hash;
+        run(hash, threads, 0);
+    }
+}
+
+void tst_QConcurrentHash::readMostly()
+{
+    QFETCH(Container, container);
+    QFETCH(int, threads);
+    if (container == Locked) {
+        LockedHash hash;
+        run(hash, threads, 64);
+    } else {
+        QConcurrentHash<QString, int> hash;
+        run(hash, threads, 64);
+    }
+}
+
+void tst_QConcurrentHash::writeHeavy()
+{
+    QFETCH(Container, container);
+    QFETCH(int, threads);
+    if (container == Locked) {
+        LockedHash hash;
+        run(hash, threads, 2);
+    } else {
+        QConcurrentHash<QString, int> hash;
+        run(hash, threads, 2);
+    }
+}
+
+// Every thread asks for every key once; the first to ask creates the value
+void tst_QConcurrentHash::computeIfAbsent()
+{
+    QFETCH(Container, container);
+    QFETCH(int, threads);
+
+    const auto work = [this](auto *hash) {
+        int sum = 0;
+        for (const QString &key : std::as_const(keys))
+            sum += hash->computeIfAbsent(key, [&key] { return int(key.size()); });
+        return sum;
+    };
+
+    QBENCHMARK {
+        LockedHash locked;
+        QConcurrentHash<QString, int> concurrent;
+        std::vector<std::unique_ptr<QThread>> pool;
+        for (int t = 0; t < threads; ++t) {
+            if (container == Locked)
+                pool.emplace_back(QThread::create(work, &locked));
+            else
+                pool.emplace_back(QThread::create(work, &concurrent));
+        }
+        for (auto &t : pool)
+            t->start();
+        for (auto &t : pool)
+            t->wait();
+    }
+}
+
+QTEST_MAIN(tst_QConcurrentHash)
+#include "tst_bench_qconcurrenthash.moc"
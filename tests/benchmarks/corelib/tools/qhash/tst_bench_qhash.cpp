@@ -36,8 +36,16 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void lookupHit_data() { lookupData(); }
+    void lookupHit();
+    void lookupMiss_data() { lookupData(); }
+    void lookupMiss();
+    void keyComparisons_data() { lookupData(); }
+    void keyComparisons();
+
 private:
     void data();
+    void lookupData();
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
 
@@ -45,6 +53,7 @@ private:
     QStringList uuids;
     QStringList dict;
     QStringList numbers;
+    QStringList urls;
 };
 
 ///////////////////// QHash /////////////////////
@@ -101,6 +110,14 @@ void tst_QHash::initTestCase()
     // string versions of numbers.
     for (int i = 5000000; i < 5005001; ++i)
         numbers.append(QString::number(i));
+
+    // long keys of the same length with a long common prefix, like the
+    // ones of a URL routing table
+    for (int i = 0; i < 5000; ++i) {
+        urls.append(QStringLiteral("https://api.example.com/v2/tenants/%1/resources/%2/revisions")
+                            .arg(i % 50, 4, 10, QLatin1Char('0'))
+                            .arg(i, 6, 10, QLatin1Char('0')));
+    }
 }
 
 void tst_QHash::data()
@@ -144,6 +161,101 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::lookupData()
+{
+    QTest::addColumn<QStringList>("items");
+    QTest::newRow("paths-small") << smallFilePaths;
+    QTest::newRow("uuids-list") << uuids;
+    QTest::newRow("numbers") << numbers;
+    QTest::newRow("urls") << urls;
+}
+
+// keys of the same length as the ones in the hash, that aren't in it
+static QStringList missingKeys(const QStringList &items)
+{
+    QStringList result;
+    result.reserve(items.size());
+    for (QString item : items) {
+        if (item.isEmpty())
+            continue;
+        item.back() = QChar(0x7f);
+        result.append(item);
+    }
+    return result;
+}
+
+static QHash<QString, int> makeHash(const QStringList &items)
+{
+    QHash<QString, int> hash;
+    for (int i = 0, n = items.size(); i != n; ++i)
+        hash.insert(items.at(i), i);
+    return hash;
+}
+
+void tst_QHash::lookupHit()
+{
+    QFETCH(QStringList, items);
+    const QHash<QString, int> hash = makeHash(items);
+
+    size_t found = 0;
+    QBENCHMARK {
+        for (const QString &item : std::as_const(items))
+            found += hash.contains(item);
+    }
+    QVERIFY(found);
+}
+
+void tst_QHash::lookupMiss()
+{
+    QFETCH(QStringList, items);
+    const QHash<QString, int> hash = makeHash(items);
+    const QStringList missing = missingKeys(items);
+
+    size_t found = 0;
+    QBENCHMARK {
+        for (const QString &item : missing)
+            found += hash.contains(item);
+    }
+    QCOMPARE_LT(found, size_t(missing.size()));
+}
+
+namespace {
+// a string key counting how often it is compared
+qint64 keyComparisonCount = 0;
+struct CountingKey
+{
+    QString string;
+    friend bool operator==(const CountingKey &lhs, const CountingKey &rhs)
+    {
+        ++keyComparisonCount;
+        return lhs.string == rhs.string;
+    }
+    friend size_t qHash(const CountingKey &key, size_t seed = 0)
+    {
+        return qHash(key.string, seed);
+    }
+};
+} // unnamed namespace
+
+void tst_QHash::keyComparisons()
+{
+    QFETCH(QStringList, items);
+    QHash<CountingKey, int> hash;
+    for (int i = 0, n = items.size(); i != n; ++i)
+        hash.insert(CountingKey{ items.at(i) }, i);
+
+    QList<CountingKey> keys;
+    for (const QString &item : items)
+        keys.append(CountingKey{ item });
+    for (const QString &item : missingKeys(items))
+        keys.append(CountingKey{ item });
+
+    keyComparisonCount = 0;
+    for (const CountingKey &key : std::as_const(keys))
+        (void)hash.contains(key);
+    QTest::setBenchmarkResult(qreal(keyComparisonCount) / keys.size(), QTest::Events);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "tst_bench_qhash.moc"
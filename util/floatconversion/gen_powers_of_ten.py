@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# Copyright (C) 2023 The Qt Company Ltd.
+# SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+"""Generate the powers of ten used by QtCore's double <-> decimal conversions
+
+For each q in [MinPowerOfTen, MaxPowerOfTen], the table holds the 128
+leading bits of 10^q, that is floor(10^q * 2^e) for the unique e such that
+2^127 <= 10^q * 2^e < 2^128, as a pair of 64-bit halves.
+
+The range covers what both users of the table need: q in [-342, 308] for
+the Eisel-Lemire parser (below 10^-342 every decimal rounds to zero, above
+10^308 to infinity) and q in [-292, 324] for the Schubfach formatter
+(10^-k for the decimal exponents k of all finite doubles).
+
+Usage: gen_powers_of_ten.py > src/corelib/text/qfloatconversion_data_p.h
+"""
+
+from fractions import Fraction
+
+MinPowerOfTen = -342
+MaxPowerOfTen = 324
+
+
+def leading_bits(q):
+    value = Fraction(10) ** q
+    e = 127 - (value.numerator.bit_length() - value.denominator.bit_length())
+    while value * Fraction(2) ** e >= 2 ** 128:
+        e -= 1
+    while value * Fraction(2) ** e < 2 ** 127:
+        e += 1
+    scaled = value * Fraction(2) ** e
+    return scaled.numerator // scaled.denominator
+
+
+def main():
+    print("""// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFLOATCONVERSION_DATA_P_H
+#define QFLOATCONVERSION_DATA_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of qfloatconversion.cpp.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+/* This file was generated by util/floatconversion/gen_powers_of_ten.py */
+
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFloatConversion {
+
+constexpr int MinPowerOfTen = %d;
+constexpr int MaxPowerOfTen = %d;
+
+// The 128 leading bits of 10^q, rounded down, for q from MinPowerOfTen to
+// MaxPowerOfTen: high 64 bits first, then low 64 bits.
+static constexpr quint64 powersOfTen[2 * (MaxPowerOfTen - MinPowerOfTen + 1)] = {""" %
+          (MinPowerOfTen, MaxPowerOfTen))
+    for q in range(MinPowerOfTen, MaxPowerOfTen + 1):
+        bits = leading_bits(q)
+        print("    0x%016XU, 0x%016XU, // 1e%d" % (bits >> 64, bits & (2 ** 64 - 1), q))
+    print("""};
+
+} // namespace QFloatConversion
+
+QT_END_NAMESPACE
+
+#endif // QFLOATCONVERSION_DATA_P_H""")
+
+
+if __name__ == '__main__':
+    main()